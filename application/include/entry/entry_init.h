@@ -13,6 +13,7 @@
 #include "types.h"
 #include "error_codes.h"
 #include "mem_pool.h"
+#include "scratch_arena.h"
 #include "trace.h"
 #include "app_init.h"
 
@@ -31,10 +32,57 @@ typedef struct {
     uint8_t event_subscription_count;
 } AegisEntryConfig;
 
+/* ==================== 主循环批处理预算 ==================== */
+#ifndef ENTRY_BATCH_MAX_COMMANDS
+#define ENTRY_BATCH_MAX_COMMANDS  16U   /* 默认每次迭代最多执行的命令数 */
+#endif
+
+#ifndef ENTRY_BATCH_MAX_EVENTS
+#define ENTRY_BATCH_MAX_EVENTS    16U   /* 默认每次迭代最多处理的异步事件数 */
+#endif
+
+#ifndef ENTRY_BATCH_MAX_COMPACTION
+#define ENTRY_BATCH_MAX_COMPACTION 4U   /* 默认每次迭代最多执行的仓储压缩步数 */
+#endif
+
+/* 主循环暂存区字节数：处理器的大型临时对象从此分配，每次 aegis_entry_main_loop_once 结束时整体复位 */
+#ifndef ENTRY_SCRATCH_SIZE
+#define ENTRY_SCRATCH_SIZE  512U
+#endif
+
+/* 时间源：返回单调递增计数（毫秒tick、微秒或周期计数器均可，单位与 time_budget 一致） */
+typedef uint32_t (*AegisEntryClockFn)(void* ctx);
+
+typedef struct {
+    uint16_t max_commands;          /* 每次迭代命令上限（0=不限） */
+    uint16_t max_events;            /* 每次迭代事件上限（0=不限） */
+    uint16_t max_compaction;        /* 每次迭代仓储压缩步数（0=不压缩；仓储未提供 compact 时忽略） */
+    uint32_t time_budget;           /* 时间预算（clock_fn 计数单位，0=不限） */
+    AegisEntryClockFn clock_fn;     /* 时间源（NULL=不做时间预算） */
+    void* clock_ctx;
+} AegisEntryBudget;
+
+typedef struct {
+    uint16_t commands_executed;     /* 已执行命令数（含执行失败的命令） */
+    uint16_t command_errors;        /* 执行失败的命令数 */
+    uint16_t events_processed;      /* 已处理的异步事件数 */
+    uint32_t elapsed;               /* 耗时（clock_fn 计数单位；无时间源时为0） */
+    uint8_t commands_pending;       /* 迭代结束时剩余的命令数 */
+    uint8_t events_pending;         /* 迭代结束时剩余的异步事件数 */
+    uint16_t repo_holes;            /* 迭代结束时仓储中待压缩的空洞数（本次未压缩时为0） */
+    uint32_t scratch_peak;          /* 暂存区自上次复位以来的峰值字节数 */
+    AegisMemPoolIndex mem_corrupted;  /* 本次迭代内存池增量巡检发现的损坏块数 */
+    bool_t budget_exhausted;        /* 预算耗尽时仍有积压 */
+} AegisEntryLoopStats;
+
 typedef struct {
     AegisMemPool mem_pool;
     AegisTraceLog trace;
     AegisAppRuntime app;
+    AegisEntryBudget budget;        /* aegis_entry_main_loop_once 使用的预算（初始化后可由组合根调整） */
+    AegisEntryLoopStats last_stats; /* 最近一次 aegis_entry_main_loop_once 的统计 */
+    AegisScratchArena scratch;      /* 主循环暂存区（经处理器 ctx 注入给需要临时对象的用例） */
+    uint8_t scratch_buf[ENTRY_SCRATCH_SIZE];
     bool_t is_initialized;
 } AegisEntryRuntime;
 
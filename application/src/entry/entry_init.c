@@ -23,12 +23,17 @@ AegisErrorCode aegis_entry_init_all(AegisEntryRuntime* runtime, const AegisEntry
         return ret;
     }
 
-    /* 2. 初始化内存池 */
+    /* 2. 初始化内存池与主循环暂存区 */
     ret = aegis_mem_pool_init(&runtime->mem_pool, &runtime->trace);
     if (ret != ERR_OK) {
         return ret;
     }
 
+    ret = aegis_scratch_arena_init(&runtime->scratch, runtime->scratch_buf, (uint32_t)ENTRY_SCRATCH_SIZE);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
     /* 3. 初始化应用层（注入仓储/事件订阅/trace） */
     if (config->write_repo == NULL) {
         return ERR_NULL_PTR;
@@ -43,6 +48,14 @@ AegisErrorCode aegis_entry_init_all(AegisEntryRuntime* runtime, const AegisEntry
         return ret;
     }
 
+    /* 4. 主循环默认预算：仅按数量限制，时间源由组合根按需注入 */
+    runtime->budget.max_commands = (uint16_t)ENTRY_BATCH_MAX_COMMANDS;
+    runtime->budget.max_events = (uint16_t)ENTRY_BATCH_MAX_EVENTS;
+    runtime->budget.max_compaction = (uint16_t)ENTRY_BATCH_MAX_COMPACTION;
+    runtime->budget.time_budget = 0U;
+    runtime->budget.clock_fn = NULL;
+    runtime->budget.clock_ctx = NULL;
+
     runtime->is_initialized = TRUE;
 
     aegis_trace_log_event(&runtime->trace, TRACE_EVENT_SYSTEM_INIT, "SYSTEM-INIT-OK", 0, 0);
@@ -7,8 +7,9 @@
 #include "demo_application.h"
 #include <string.h>
 #include "app_macros.h"
+#include "demo_cmd_table.h"
 
-static AegisErrorCode handle_create_charger(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
+AegisErrorCode demo_handle_create_charger(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
     DemoUseCaseDeps* deps;
     DemoCreateChargerCmd payload;
     AegisEntityId created_id;
@@ -27,7 +28,7 @@ static AegisErrorCode handle_create_charger(const AegisCommand* cmd, AegisComman
     }
 
     created_id = ENTITY_ID_INVALID;
-    ret = demo_domain_charger_create(deps->repo, deps->bus,
+    ret = demo_domain_charger_create(deps->repo, deps->bus, deps->scratch,
                                      payload.charger_model,
                                      payload.initial_power_level,
                                      &created_id);
@@ -37,7 +38,7 @@ static AegisErrorCode handle_create_charger(const AegisCommand* cmd, AegisComman
     return ret;
 }
 
-static AegisErrorCode handle_set_power(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
+AegisErrorCode demo_handle_set_power(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
     DemoUseCaseDeps* deps;
     DemoSetPowerCmd payload;
     AegisErrorCode ret;
@@ -59,7 +60,7 @@ static AegisErrorCode handle_set_power(const AegisCommand* cmd, AegisCommandResu
         return ERR_INVALID_PARAM;
     }
 
-    ret = demo_domain_charger_set_power_level(deps->repo, deps->bus,
+    ret = demo_domain_charger_set_power_level(deps->repo, deps->bus, deps->scratch,
                                               cmd->entity_id,
                                               payload.new_power_level);
     result->result = ret;
@@ -85,7 +86,7 @@ static AegisErrorCode handle_get_charger(const AegisQueryRequest* req, AegisQuer
     }
 
     memset(&state, 0, sizeof(DemoChargerState));
-    ret = demo_domain_charger_get(&deps->repo->read, req->entity_id, &state);
+    ret = demo_domain_charger_get(&deps->repo->read, deps->scratch, req->entity_id, &state);
     if (ret != ERR_OK) {
         resp->result = ret;
         resp->payload_size = 0U;
@@ -110,7 +111,6 @@ static AegisErrorCode handle_get_charger(const AegisQueryRequest* req, AegisQuer
 AegisErrorCode demo_application_register(AegisAppRuntime* app, void* ctx) {
     AegisErrorCode ret;
     DemoApplicationModule* module;
-    AegisAppCmdHandlerDef cmd_defs[2];
     AegisAppQueryHandlerDef query_defs[1];
 
     if (app == NULL || !app->is_initialized) {
@@ -126,9 +126,8 @@ AegisErrorCode demo_application_register(AegisAppRuntime* app, void* ctx) {
     module->deps.repo = app->write_repo;
     module->deps.bus = &app->event_bus;
 
-    APP_CMD_HANDLER_DEF_SET(&cmd_defs[0], DEMO_CMD_CREATE_CHARGER, handle_create_charger, &module->deps);
-    APP_CMD_HANDLER_DEF_SET(&cmd_defs[1], DEMO_CMD_SET_POWER_LEVEL, handle_set_power, &module->deps);
-    APP_REGISTER_CMD_HANDLERS(ret, &app->cmd_service, cmd_defs);
+    /* 命令处理器走生成的静态分发表（demo_dispatch.json -> demo_cmd_table.c），无需逐条注册 */
+    ret = aegis_app_cmd_service_bind_table(&app->cmd_service, &demo_cmd_table, &module->deps);
     if (ret != ERR_OK) {
         return ret;
     }
@@ -45,6 +45,7 @@ typedef struct {
 typedef struct {
     const AegisDomainRepositoryWriteInterface* repo;
     AegisDomainEventBus* bus;
+    AegisScratchArena* scratch;     /* 由组合根注入（AegisEntryRuntime.scratch） */
 } DemoUseCaseDeps;
 
 typedef struct {
@@ -0,0 +1,24 @@
+/*
+ * @file: demo_cmd_table.c
+ * @brief: demo 模块静态命令分发表（由 tools/gen_dispatch_table.py 生成，请勿手改）
+ * @author: jack liu
+ */
+
+#include "demo_cmd_table.h"
+#include "compile_time.h"
+#include "demo_application.h"
+
+/* 描述文件中的类型值必须与头文件中的宏一致 */
+FW_STATIC_ASSERT(DEMO_CMD_CREATE_CHARGER == (AegisCommandType)1U, demo_cmd_create_charger_matches_desc);
+FW_STATIC_ASSERT(DEMO_CMD_SET_POWER_LEVEL == (AegisCommandType)2U, demo_cmd_set_power_level_matches_desc);
+
+static const AppCmdHandler demo_cmd_handlers[2] = {
+    demo_handle_create_charger,   /* DEMO_CMD_CREATE_CHARGER */
+    demo_handle_set_power   /* DEMO_CMD_SET_POWER_LEVEL */
+};
+
+const AegisAppCmdStaticTable demo_cmd_table = {
+    (AegisCommandType)1U,
+    2U,
+    demo_cmd_handlers
+};
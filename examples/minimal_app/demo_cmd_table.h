@@ -0,0 +1,27 @@
+/*
+ * @file: demo_cmd_table.h
+ * @brief: demo 模块静态命令分发表（由 tools/gen_dispatch_table.py 生成，请勿手改）
+ * @author: jack liu
+ */
+
+#ifndef DEMO_CMD_TABLE_H
+#define DEMO_CMD_TABLE_H
+
+#include "app_cmd_service.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 命令处理器（由模块实现，需为外部链接） */
+AegisErrorCode demo_handle_create_charger(const AegisCommand* cmd, AegisCommandResult* result, void* ctx);
+AegisErrorCode demo_handle_set_power(const AegisCommand* cmd, AegisCommandResult* result, void* ctx);
+
+/* 覆盖命令类型 [1, 3) */
+extern const AegisAppCmdStaticTable demo_cmd_table;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEMO_CMD_TABLE_H */
@@ -14,52 +14,87 @@ static AegisErrorCode validate_power_level(uint8_t level) {
     return ERR_OK;
 }
 
-static AegisErrorCode publish_entity_created(AegisDomainEventBus* bus, AegisEntityId id, AegisEntityType type) {
-    AegisDomainEvent event;
+static AegisErrorCode publish_entity_created(AegisDomainEventBus* bus, AegisScratchArena* scratch,
+                                             AegisEntityId id, AegisEntityType type) {
+    AegisDomainEvent* event;
 
     if (bus == NULL) {
         return ERR_NULL_PTR;
     }
 
-    memset(&event, 0, sizeof(AegisDomainEvent));
-    event.type = DOMAIN_EVENT_ENTITY_CREATED;
-    event.aggregate_id = id;
-    event.aegis_trace_id = "REQ-DEMO-CHARGER-CREATE";
-    event.data.entity_created.entity_type = type;
+    /* 事件发布时被复制进事件总线，暂存区中的副本随调用方回退 */
+    event = SCRATCH_NEW(scratch, AegisDomainEvent);
+    if (event == NULL) {
+        return ERR_MEM_POOL_FULL;
+    }
+
+    memset(event, 0, sizeof(AegisDomainEvent));
+    event->type = DOMAIN_EVENT_ENTITY_CREATED;
+    event->aggregate_id = id;
+    event->aegis_trace_id = "REQ-DEMO-CHARGER-CREATE";
+    event->data.entity_created.entity_type = type;
 
-    return aegis_domain_event_publish(bus, &event);
+    return aegis_domain_event_publish(bus, event);
 }
 
-static AegisErrorCode publish_power_changed(AegisDomainEventBus* bus, AegisEntityId id, uint8_t old_power, uint8_t new_power) {
-    AegisDomainEvent event;
+static AegisErrorCode publish_power_changed(AegisDomainEventBus* bus, AegisScratchArena* scratch,
+                                            AegisEntityId id, uint8_t old_power, uint8_t new_power) {
+    AegisDomainEvent* event;
     DemoPowerChangedEventData payload;
 
     if (bus == NULL) {
         return ERR_NULL_PTR;
     }
 
-    memset(&event, 0, sizeof(AegisDomainEvent));
-    event.type = DEMO_EVENT_POWER_LEVEL_CHANGED;
-    event.aggregate_id = id;
-    event.aegis_trace_id = "REQ-DEMO-POWER-CHANGED";
+    event = SCRATCH_NEW(scratch, AegisDomainEvent);
+    if (event == NULL) {
+        return ERR_MEM_POOL_FULL;
+    }
+
+    memset(event, 0, sizeof(AegisDomainEvent));
+    event->type = DEMO_EVENT_POWER_LEVEL_CHANGED;
+    event->aggregate_id = id;
+    event->aegis_trace_id = "REQ-DEMO-POWER-CHANGED";
 
     payload.old_power = old_power;
     payload.new_power = new_power;
-    memcpy(event.data.custom_data, &payload, sizeof(DemoPowerChangedEventData));
+    memcpy(event->data.custom_data, &payload, sizeof(DemoPowerChangedEventData));
+
+    return aegis_domain_event_publish(bus, event);
+}
+
+/*
+ * 把实体读到调用方副本：优先快照读（不受并发写入影响），仓储不支持时拷贝 get 的结果
+ */
+static AegisErrorCode load_entity_copy(const AegisDomainRepositoryReadInterface* repo,
+                                       AegisEntityId id, AegisDomainEntity* copy) {
+    AegisDomainEntity* stored;
+
+    if (repo->snapshot != NULL) {
+        return repo->snapshot(repo, id, copy);
+    }
+
+    stored = NULL;
+    if (repo->get(repo, id, &stored) != ERR_OK || stored == NULL) {
+        return ERR_NOT_FOUND;
+    }
 
-    return aegis_domain_event_publish(bus, &event);
+    memcpy(copy, stored, sizeof(AegisDomainEntity));
+    return ERR_OK;
 }
 
 AegisErrorCode demo_domain_charger_create(const AegisDomainRepositoryWriteInterface* repo,
                                      AegisDomainEventBus* bus,
+                                     AegisScratchArena* scratch,
                                      uint16_t charger_model,
                                      uint8_t initial_power_level,
                                      AegisEntityId* out_id) {
     AegisErrorCode ret;
-    AegisDomainEntity entity;
+    AegisDomainEntity* entity;
+    AegisScratchArenaMark mark;
     DemoChargerState state;
 
-    if (repo == NULL || bus == NULL || out_id == NULL) {
+    if (repo == NULL || bus == NULL || scratch == NULL || out_id == NULL) {
         return ERR_NULL_PTR;
     }
 
@@ -68,31 +103,37 @@ AegisErrorCode demo_domain_charger_create(const AegisDomainRepositoryWriteInterf
         return ret;
     }
 
-    memset(&entity, 0, sizeof(AegisDomainEntity));
-    (void)aegis_domain_entity_init(&entity.base, ENTITY_ID_INVALID, DEMO_ENTITY_TYPE_CHARGER);
+    /* 新实体只在写入仓储前暂存：从暂存区分配，返回前回退 */
+    mark = aegis_scratch_arena_mark(scratch);
+    entity = SCRATCH_NEW(scratch, AegisDomainEntity);
+    if (entity == NULL) {
+        return ERR_MEM_POOL_FULL;
+    }
+
+    memset(entity, 0, sizeof(AegisDomainEntity));
+    (void)aegis_domain_entity_init(&entity->base, ENTITY_ID_INVALID, DEMO_ENTITY_TYPE_CHARGER);
 
     state.charger_model = charger_model;
     state.power_level = initial_power_level;
-    ret = aegis_domain_entity_payload_set(&entity, &state, (uint16_t)sizeof(DemoChargerState));
-    if (ret != ERR_OK) {
-        return ret;
-    }
-
-    ret = repo->create(repo, &entity);
-    if (ret != ERR_OK) {
-        return ret;
+    ret = aegis_domain_entity_payload_set(entity, &state, (uint16_t)sizeof(DemoChargerState));
+    if (ret == ERR_OK) {
+        ret = repo->create(repo, entity);
     }
 
-    *out_id = entity.base.id;
+    if (ret == ERR_OK) {
+        *out_id = entity->base.id;
 
-    (void)publish_entity_created(bus, entity.base.id, entity.base.type);
-    (void)publish_power_changed(bus, entity.base.id, 0U, initial_power_level);
+        (void)publish_entity_created(bus, scratch, entity->base.id, entity->base.type);
+        (void)publish_power_changed(bus, scratch, entity->base.id, 0U, initial_power_level);
+    }
 
-    return ERR_OK;
+    (void)aegis_scratch_arena_release(scratch, mark);
+    return ret;
 }
 
 AegisErrorCode demo_domain_charger_set_power_level(const AegisDomainRepositoryWriteInterface* repo,
                                               AegisDomainEventBus* bus,
+                                              AegisScratchArena* scratch,
                                               AegisEntityId charger_id,
                                               uint8_t new_power_level) {
     AegisErrorCode ret;
@@ -100,9 +141,10 @@ AegisErrorCode demo_domain_charger_set_power_level(const AegisDomainRepositoryWr
     const void* payload;
     uint16_t payload_size;
     DemoChargerState state;
+    AegisScratchArenaMark mark;
     uint8_t old_power;
 
-    if (repo == NULL || bus == NULL) {
+    if (repo == NULL || bus == NULL || scratch == NULL) {
         return ERR_NULL_PTR;
     }
 
@@ -111,75 +153,87 @@ AegisErrorCode demo_domain_charger_set_power_level(const AegisDomainRepositoryWr
         return ret;
     }
 
-    entity = NULL;
-    ret = repo->read.get(&repo->read, charger_id, &entity);
-    if (ret != ERR_OK || entity == NULL) {
-        return ERR_NOT_FOUND;
+    /* get 返回的是仓储内部存储（只读）：在暂存区的副本上修改，再经 update 写回 */
+    mark = aegis_scratch_arena_mark(scratch);
+    entity = SCRATCH_NEW(scratch, AegisDomainEntity);
+    if (entity == NULL) {
+        return ERR_MEM_POOL_FULL;
     }
 
     payload = NULL;
     payload_size = 0U;
-    ret = aegis_domain_entity_payload_get(entity, &payload, &payload_size);
-    if (ret != ERR_OK) {
-        return ret;
-    }
-
-    if (payload_size != (uint16_t)sizeof(DemoChargerState)) {
-        return ERR_INVALID_STATE;
-    }
-
-    memcpy(&state, payload, sizeof(DemoChargerState));
-    old_power = state.power_level;
-
-    if (old_power == new_power_level) {
-        return ERR_OK;
-    }
-
-    state.power_level = new_power_level;
-    ret = aegis_domain_entity_payload_set(entity, &state, (uint16_t)sizeof(DemoChargerState));
-    if (ret != ERR_OK) {
-        return ret;
-    }
-
-    ret = repo->update(repo, entity);
-    if (ret != ERR_OK) {
-        return ret;
-    }
-
-    (void)publish_power_changed(bus, charger_id, old_power, new_power_level);
-    return ERR_OK;
+    ret = load_entity_copy(&repo->read, charger_id, entity);
+    if (ret == ERR_OK) {
+        ret = aegis_domain_entity_payload_get(entity, &payload, &payload_size);
+        if (ret == ERR_OK && payload_size != (uint16_t)sizeof(DemoChargerState)) {
+            ret = ERR_INVALID_STATE;
+        }
+    }
+
+    if (ret == ERR_OK) {
+        memcpy(&state, payload, sizeof(DemoChargerState));
+        old_power = state.power_level;
+
+        if (old_power != new_power_level) {
+            state.power_level = new_power_level;
+            ret = aegis_domain_entity_payload_set(entity, &state, (uint16_t)sizeof(DemoChargerState));
+            if (ret == ERR_OK) {
+                ret = repo->update(repo, entity);
+            }
+            if (ret == ERR_OK) {
+                (void)publish_power_changed(bus, scratch, charger_id, old_power, new_power_level);
+            }
+        }
+    }
+
+    (void)aegis_scratch_arena_release(scratch, mark);
+    return ret;
 }
 
 AegisErrorCode demo_domain_charger_get(const AegisDomainRepositoryReadInterface* repo,
+                                  AegisScratchArena* scratch,
                                   AegisEntityId charger_id,
                                   DemoChargerState* out_state) {
     AegisErrorCode ret;
     AegisDomainEntity* entity;
+    AegisDomainEntity* copy;
+    AegisScratchArenaMark mark;
     const void* payload;
     uint16_t payload_size;
 
-    if (repo == NULL || out_state == NULL) {
+    if (repo == NULL || scratch == NULL || out_state == NULL) {
         return ERR_NULL_PTR;
     }
 
+    /* 优先使用快照读：拷贝期间不关中断，结果不受并发写入影响；快照副本放在暂存区 */
+    mark = aegis_scratch_arena_mark(scratch);
     entity = NULL;
-    ret = repo->get(repo, charger_id, &entity);
-    if (ret != ERR_OK || entity == NULL) {
-        return ERR_NOT_FOUND;
+    if (repo->snapshot != NULL) {
+        copy = SCRATCH_NEW(scratch, AegisDomainEntity);
+        if (copy == NULL) {
+            return ERR_MEM_POOL_FULL;
+        }
+        ret = repo->snapshot(repo, charger_id, copy);
+        entity = copy;
+    } else {
+        ret = repo->get(repo, charger_id, &entity);
     }
 
-    payload = NULL;
-    payload_size = 0U;
-    ret = aegis_domain_entity_payload_get(entity, &payload, &payload_size);
-    if (ret != ERR_OK) {
-        return ret;
-    }
-
-    if (payload_size != (uint16_t)sizeof(DemoChargerState)) {
-        return ERR_INVALID_STATE;
-    }
-
-    memcpy(out_state, payload, sizeof(DemoChargerState));
-    return ERR_OK;
+    if (ret != ERR_OK || entity == NULL) {
+        ret = ERR_NOT_FOUND;
+    } else {
+        payload = NULL;
+        payload_size = 0U;
+        ret = aegis_domain_entity_payload_get(entity, &payload, &payload_size);
+        if (ret == ERR_OK && payload_size != (uint16_t)sizeof(DemoChargerState)) {
+            ret = ERR_INVALID_STATE;
+        }
+        if (ret == ERR_OK) {
+            memcpy(out_state, payload, sizeof(DemoChargerState));
+        }
+    }
+
+    (void)aegis_scratch_arena_release(scratch, mark);
+    return ret;
 }
 
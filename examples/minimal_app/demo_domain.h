@@ -12,6 +12,7 @@
 #include "domain_entity.h"
 #include "domain_event.h"
 #include "domain_repository_write.h"
+#include "scratch_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,18 +36,22 @@ typedef struct {
 } DemoPowerChangedEventData;
 
 /* ==================== 领域行为（Domain Service/Factory） ==================== */
+/* scratch：实体副本/待发布事件等临时对象的暂存区（通常为主循环的 AegisEntryRuntime.scratch），函数返回前回退 */
 AegisErrorCode demo_domain_charger_create(const AegisDomainRepositoryWriteInterface* repo,
                                      AegisDomainEventBus* bus,
+                                     AegisScratchArena* scratch,
                                      uint16_t charger_model,
                                      uint8_t initial_power_level,
                                      AegisEntityId* out_id);
 
 AegisErrorCode demo_domain_charger_set_power_level(const AegisDomainRepositoryWriteInterface* repo,
                                               AegisDomainEventBus* bus,
+                                              AegisScratchArena* scratch,
                                               AegisEntityId charger_id,
                                               uint8_t new_power_level);
 
 AegisErrorCode demo_domain_charger_get(const AegisDomainRepositoryReadInterface* repo,
+                                  AegisScratchArena* scratch,
                                   AegisEntityId charger_id,
                                   DemoChargerState* out_state);
 
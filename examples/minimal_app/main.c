@@ -129,6 +129,7 @@ int main(void) {
     }
 
     memset(&demo_module, 0, sizeof(DemoApplicationModule));
+    demo_module.deps.scratch = &runtime.scratch;
     APP_MODULE_SET(&modules[0], demo_application_register, &demo_module);
 
     APP_REGISTER_MODULES(ret, &runtime.app, modules);
@@ -137,6 +138,13 @@ int main(void) {
         return (int)ret;
     }
 
+    /* 注册完成：封存注册表，之后命令/查询分发查找无锁 */
+    ret = aegis_app_init_seal(&runtime.app);
+    if (ret != ERR_OK) {
+        printf("错误: 封存注册表失败, 错误码=%d\n", ret);
+        return (int)ret;
+    }
+
     /* 1) 发起创建命令：CreateCharger(model=1001, initial_power=10) */
     memset(&cmd, 0, sizeof(AegisCommand));
     APP_CMD_INIT(&cmd, DEMO_CMD_CREATE_CHARGER);
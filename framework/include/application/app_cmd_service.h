@@ -16,6 +16,7 @@
 
 #include "types.h"
 #include "error_codes.h"
+#include "dispatch_index.h"
 #include "app_command.h"
 #include "domain_entity.h"
 
@@ -29,15 +30,43 @@ typedef AegisErrorCode (*AppCmdHandler)(const AegisCommand* cmd, AegisCommandRes
 #define APP_CMD_SERVICE_MAX_HANDLERS 16U
 #endif
 
+/* 可绑定的静态分发表数量（通常每个模块一张） */
+#ifndef APP_CMD_SERVICE_MAX_TABLES
+#define APP_CMD_SERVICE_MAX_TABLES 4U
+#endif
+
 typedef struct {
     AegisCommandType type;
     AppCmdHandler handler;
     void* ctx;
 } AegisAppCmdServiceHandlerEntry;
 
+/*
+ * 静态分发表（const，可放在 Flash）：覆盖连续类型区间 [first_type, first_type + count)，
+ * handlers[type - first_type] 为对应处理器，区间内未使用的类型填 NULL。
+ * 通常由 tools/gen_dispatch_table.py 根据模块描述生成，无需运行时注册。
+ */
+typedef struct {
+    AegisCommandType first_type;
+    uint16_t count;
+    const AppCmdHandler* handlers;
+} AegisAppCmdStaticTable;
+
+typedef struct {
+    const AegisAppCmdStaticTable* table;
+    void* ctx;                  /* 表内所有处理器共享的业务上下文 */
+} AegisAppCmdServiceTableBinding;
+
+#define APP_CMD_SERVICE_INDEX_SIZE  DISPATCH_INDEX_SIZE(APP_CMD_SERVICE_MAX_HANDLERS)
+
 typedef struct {
     AegisAppCmdServiceHandlerEntry handlers[APP_CMD_SERVICE_MAX_HANDLERS];
+    uint16_t index_keys[APP_CMD_SERVICE_INDEX_SIZE];
+    uint8_t index_slots[APP_CMD_SERVICE_INDEX_SIZE];
     uint8_t handler_count;
+    AegisAppCmdServiceTableBinding tables[APP_CMD_SERVICE_MAX_TABLES];
+    uint8_t table_count;
+    bool_t is_sealed;
 } AegisAppCmdService;
 
 /* ==================== 批量注册（提升敏捷开发效率） ==================== */
@@ -68,6 +97,16 @@ AegisErrorCode aegis_app_cmd_service_register_handlers(AegisAppCmdService* servi
  */
 AegisErrorCode aegis_app_cmd_service_init(AegisAppCmdService* service);
 
+/*
+ * @brief: 封存命令处理器注册表（之后注册返回 ERR_INVALID_STATE，分发查找不再进入临界区）
+ * @return: 错误码
+ * @req: REQ-APP-106
+ * @design: DES-APP-106
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_cmd_service_seal(AegisAppCmdService* service);
+
 /*
  * @brief: 注册命令处理器
  * @param type: 命令类型
@@ -84,6 +123,20 @@ AegisErrorCode aegis_app_cmd_service_register_handler(AegisAppCmdService* servic
                                            AppCmdHandler handler,
                                            void* ctx);
 
+/*
+ * @brief: 绑定静态分发表（表本身不拷贝，调用方保证其生命周期；静态表优先于运行时注册）
+ * @param table: 静态分发表（通常为生成的 const 对象）
+ * @param ctx: 表内处理器共享的业务上下文
+ * @return: 错误码，区间非法/与已绑定表重叠返回 ERR_INVALID_PARAM，表数已满返回 ERR_OUT_OF_RANGE，已封存返回 ERR_INVALID_STATE
+ * @req: REQ-APP-111
+ * @design: DES-APP-111
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_cmd_service_bind_table(AegisAppCmdService* service,
+                                                const AegisAppCmdStaticTable* table,
+                                                void* ctx);
+
 /*
  * @brief: 执行一个命令（同步，主循环调用）
  * @param cmd: 命令
@@ -1,6 +1,6 @@
 /*
  * @file: aegis_app_command.h
- * @brief: CQRS命令系统接口（ISR安全的命令队列）
+ * @brief: CQRS命令系统接口（ISR安全的变长记录命令队列）
  * @author: jack liu
  * @req: REQ-APP-001
  * @design: DES-APP-001
@@ -13,8 +13,8 @@
 #include "types.h"
 #include "error_codes.h"
 #include "domain_entity.h"
-#include "ring_buffer.h"
 #include "trace.h"
+#include "object_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,7 +22,7 @@ extern "C" {
 
 /* ==================== 命令队列配置 ==================== */
 #ifndef CMD_QUEUE_SIZE
-#define CMD_QUEUE_SIZE  16      /* 命令队列大小 */
+#define CMD_QUEUE_SIZE  16      /* 命令队列容量（按满payload命令折算的RAM预算，1~255） */
 #endif
 
 /* 单条命令payload上限（由使用方定义二进制结构） */
@@ -49,6 +49,26 @@ typedef struct {
     uint8_t payload[APP_CMD_PAYLOAD_MAX];
 } AegisCommand;
 
+/* 命令记录区字节数（默认与 CMD_QUEUE_SIZE 条满payload命令等量的RAM） */
+#ifndef APP_CMD_QUEUE_BYTES
+#define APP_CMD_QUEUE_BYTES  ((uint32_t)CMD_QUEUE_SIZE * (uint32_t)sizeof(AegisCommand))
+#endif
+
+/* 记录区按4字节对齐取整；尾部额外预留 APP_CMD_PAYLOAD_MAX 字节，保证末尾记录按完整 AegisCommand 访问不越界 */
+#define APP_CMD_ARENA_CAPACITY  ((uint32_t)(APP_CMD_QUEUE_BYTES) & ~(uint32_t)3U)
+#define APP_CMD_ARENA_WORDS     ((APP_CMD_ARENA_CAPACITY + (uint32_t)APP_CMD_PAYLOAD_MAX + 3U) / 4U)
+
+/*
+ * 命令对象池：在队列之外构造/暂存完整命令（批量组装、延迟重试）时使用，每槽位恰好一个 AegisCommand。
+ * 生成 aegis_app_cmd_pool_init/alloc/free/get_stats。队列本身仍使用命令区（arena），本池为可选项，由业务侧定义实例。
+ * @req: REQ-APP-112
+ * @isr_safe
+ */
+#ifndef APP_CMD_POOL_SIZE
+#define APP_CMD_POOL_SIZE  4U
+#endif
+AEGIS_OBJECT_POOL_DECLARE(AegisCommandPool, aegis_app_cmd_pool, AegisCommand, APP_CMD_POOL_SIZE)
+
 /* ==================== 命令结果 ==================== */
 typedef struct {
     AegisErrorCode result;                   /* 执行结果 */
@@ -58,9 +78,22 @@ typedef struct {
 } AegisCommandResult;
 
 /* ==================== 可注入实例（严格依赖注入） ==================== */
+/*
+ * 变长记录队列：记录 = 4字节记录头（长度+状态）+ 命令头部 + 实际使用的payload，按4字节对齐。
+ * 生产者 reserve -> 原地填写 -> commit；消费者 peek -> 原地执行 -> release。
+ * peek 返回的是记录区内的视图，只保证 payload[0..payload_size) 有效。
+ * 记录在物理上总是连续的：末尾放不下时写入填充记录并回绕到起点。
+ * 临界区只覆盖偏移/状态更新，命令内容的读写都在临界区之外完成。
+ * 多个生产者（ISR + 主循环）可同时持有预留记录，消费顺序始终为预留顺序。
+ */
 typedef struct {
-    AegisRingBuffer ring;
-    uint8_t buffer[CMD_QUEUE_SIZE * sizeof(AegisCommand)];
+    uint32_t arena[APP_CMD_ARENA_WORDS];    /* 记录区（uint32_t 保证记录对齐） */
+    uint16_t head;              /* 下一条记录的起始偏移（生产者） */
+    uint16_t tail;              /* 最早的未释放记录偏移（消费者） */
+    uint16_t used;              /* 已占用字节数（含回绕填充） */
+    uint16_t ready;             /* 已提交待消费的命令数 */
+    uint16_t reserving;         /* 已预留、尚未 commit/cancel 的记录数 */
+    bool_t peeked;              /* tail 记录是否已被 peek 借出 */
     AegisTraceLog* trace;
     bool_t is_initialized;
 } AegisAppCmdQueue;
@@ -77,7 +110,7 @@ typedef struct {
 AegisErrorCode aegis_app_cmd_init(AegisAppCmdQueue* queue, AegisTraceLog* trace);
 
 /*
- * @brief: 入队命令（ISR安全）
+ * @brief: 入队命令（ISR安全；内部为 reserve + 拷贝有效payload + commit）
  * @param cmd: 命令指针
  * @return: 错误码
  * @req: REQ-APP-003
@@ -88,8 +121,8 @@ AegisErrorCode aegis_app_cmd_init(AegisAppCmdQueue* queue, AegisTraceLog* trace)
 AegisErrorCode aegis_app_cmd_enqueue(AegisAppCmdQueue* queue, const AegisCommand* cmd);
 
 /*
- * @brief: 执行下一个命令（主循环调用）
- * @param result: 输出命令结果
+ * @brief: 出队下一个命令（主循环调用；内部为 peek + 拷贝 + release）
+ * @param cmd: 输出命令
  * @return: 错误码，ERR_EMPTY表示队列为空
  * @req: REQ-APP-004
  * @design: DES-APP-004
@@ -98,9 +131,76 @@ AegisErrorCode aegis_app_cmd_enqueue(AegisAppCmdQueue* queue, const AegisCommand
  */
 AegisErrorCode aegis_app_cmd_dequeue(AegisAppCmdQueue* queue, AegisCommand* cmd);
 
+/* ==================== 零拷贝接口 ==================== */
+/*
+ * @brief: 预留一条命令记录（生产者，ISR安全；按 APP_CMD_PAYLOAD_MAX 预留，commit 时收缩到实际长度）
+ * @param cmd: 输出记录指针，调用方原地填写后必须 commit 或 cancel
+ * @return: 错误码，队列满返回 ERR_OUT_OF_RANGE
+ * @req: REQ-APP-100
+ * @design: DES-APP-100
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_app_cmd_reserve(AegisAppCmdQueue* queue, AegisCommand** cmd);
+
+/*
+ * @brief: 按payload长度预留一条命令记录（生产者，ISR安全）
+ * @param payload_capacity: 可写payload字节数，调用方不得写入超出该长度的payload
+ * @param cmd: 输出记录指针，调用方原地填写后必须 commit 或 cancel
+ * @return: 错误码，长度超限返回 ERR_INVALID_PARAM，队列满返回 ERR_OUT_OF_RANGE
+ * @req: REQ-APP-105
+ * @design: DES-APP-105
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_app_cmd_reserve_sized(AegisAppCmdQueue* queue, uint16_t payload_capacity, AegisCommand** cmd);
+
+/*
+ * @brief: 提交预留记录（生产者，ISR安全；写入时间戳）
+ * @param cmd: reserve 返回的记录指针
+ * @return: 错误码，命令类型非法/payload超出预留长度时该记录被作废并返回 ERR_INVALID_PARAM
+ * @req: REQ-APP-101
+ * @design: DES-APP-101
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_app_cmd_commit(AegisAppCmdQueue* queue, AegisCommand* cmd);
+
+/*
+ * @brief: 作废预留记录（生产者，ISR安全；消费者会自动跳过）
+ * @param cmd: reserve 返回的记录指针
+ * @return: 错误码
+ * @req: REQ-APP-102
+ * @design: DES-APP-102
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_app_cmd_cancel(AegisAppCmdQueue* queue, AegisCommand* cmd);
+
+/*
+ * @brief: 借出最早的已提交命令（消费者，主循环调用）
+ * @param cmd: 输出只读命令视图（仅 payload_size 范围内有效），release 之前保持有效
+ * @return: 错误码，ERR_EMPTY表示无可执行命令
+ * @req: REQ-APP-103
+ * @design: DES-APP-103
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_cmd_peek(AegisAppCmdQueue* queue, const AegisCommand** cmd);
+
+/*
+ * @brief: 释放 peek 借出的命令记录（消费者）
+ * @return: 错误码，未 peek 时返回 ERR_INVALID_STATE
+ * @req: REQ-APP-104
+ * @design: DES-APP-104
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_cmd_release(AegisAppCmdQueue* queue);
+
 /*
  * @brief: 获取队列状态
- * @param count: 输出当前队列中的命令数
+ * @param count: 输出当前队列中已提交的命令数（超过255时饱和为255）
  * @return: 错误码
  * @req: REQ-APP-005
  * @design: DES-APP-005
@@ -111,7 +211,7 @@ AegisErrorCode aegis_app_cmd_get_count(const AegisAppCmdQueue* queue, uint8_t* c
 
 /*
  * @brief: 清空命令队列
- * @return: 错误码
+ * @return: 错误码，仍有未 commit/cancel 的预留记录时返回 ERR_BUSY（队列保持不变）
  * @req: REQ-APP-006
  * @design: DES-APP-006
  * @asil: ASIL-B
@@ -12,6 +12,7 @@
 
 #include "types.h"
 #include "error_codes.h"
+#include "dispatch_index.h"
 #include "domain_entity.h"
 #include "app_dto.h"
 
@@ -33,9 +34,14 @@ typedef struct {
     void* ctx;
 } AegisAppAssemblerEntry;
 
+#define APP_ASSEMBLER_INDEX_SIZE  DISPATCH_INDEX_SIZE(APP_ASSEMBLER_MAX)
+
 typedef struct {
     AegisAppAssemblerEntry entries[APP_ASSEMBLER_MAX];
+    uint16_t index_keys[APP_ASSEMBLER_INDEX_SIZE];
+    uint8_t index_slots[APP_ASSEMBLER_INDEX_SIZE];
     uint8_t aegis_entry_count;
+    bool_t is_sealed;
 } AegisAppAssembler;
 
 /*
@@ -48,6 +54,16 @@ typedef struct {
  */
 AegisErrorCode aegis_app_asm_init(AegisAppAssembler* assembler);
 
+/*
+ * @brief: 封存Assembler 注册表（之后注册返回 ERR_INVALID_STATE，分发查找不再进入临界区）
+ * @return: 错误码
+ * @req: REQ-APP-108
+ * @design: DES-APP-108
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_asm_seal(AegisAppAssembler* assembler);
+
 /*
  * @brief: 注册 Assembler（按 DTO 类型）
  * @param dto_type: DTO 类型
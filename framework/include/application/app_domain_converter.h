@@ -12,6 +12,7 @@
 
 #include "types.h"
 #include "error_codes.h"
+#include "dispatch_index.h"
 #include "domain_entity.h"
 #include "app_dto.h"
 
@@ -33,9 +34,14 @@ typedef struct {
     void* ctx;
 } AegisAppConverterEntry;
 
+#define APP_CONVERTER_INDEX_SIZE  DISPATCH_INDEX_SIZE(APP_CONVERTER_MAX)
+
 typedef struct {
     AegisAppConverterEntry entries[APP_CONVERTER_MAX];
+    uint16_t index_keys[APP_CONVERTER_INDEX_SIZE];
+    uint8_t index_slots[APP_CONVERTER_INDEX_SIZE];
     uint8_t aegis_entry_count;
+    bool_t is_sealed;
 } AegisAppConverter;
 
 /*
@@ -48,6 +54,16 @@ typedef struct {
  */
 AegisErrorCode aegis_app_conv_init(AegisAppConverter* converter);
 
+/*
+ * @brief: 封存Converter 注册表（之后注册返回 ERR_INVALID_STATE，分发查找不再进入临界区）
+ * @return: 错误码
+ * @req: REQ-APP-109
+ * @design: DES-APP-109
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_conv_seal(AegisAppConverter* converter);
+
 /*
  * @brief: 注册 Converter（按 DTO 类型）
  * @param dto_type: DTO 类型
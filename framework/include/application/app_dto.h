@@ -12,6 +12,7 @@
 
 #include "types.h"
 #include "error_codes.h"
+#include "object_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +32,17 @@ typedef struct {
     uint8_t payload[APP_DTO_PAYLOAD_MAX];
 } AegisAppDto;
 
+/*
+ * DTO 对象池：查询/转换过程中需要临时 DTO 又不宜放在栈上时使用，每槽位恰好一个 AegisAppDto。
+ * 生成 aegis_app_dto_pool_init/alloc/free/get_stats；框架内不实例化，由业务侧按需定义静态池。
+ * @req: REQ-APP-063
+ * @isr_safe
+ */
+#ifndef APP_DTO_POOL_SIZE
+#define APP_DTO_POOL_SIZE  4U
+#endif
+AEGIS_OBJECT_POOL_DECLARE(AegisAppDtoPool, aegis_app_dto_pool, AegisAppDto, APP_DTO_POOL_SIZE)
+
 /*
  * @brief: 写入DTO payload（会设置payload_size；超出上限返回ERR_OUT_OF_RANGE）
  * @req: REQ-APP-061
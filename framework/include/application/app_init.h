@@ -69,6 +69,16 @@ AegisErrorCode aegis_app_init_all(AegisAppRuntime* runtime, const AegisAppInitCo
  */
 uint8_t aegis_app_init_process_domain_events(AegisAppRuntime* runtime, uint8_t max_events);
 
+/*
+ * @brief: 封存应用层注册表（命令/查询/Assembler/Converter；注册完成后调用，之后分发查找无锁）
+ * @return: 错误码
+ * @req: REQ-APP-110
+ * @design: DES-APP-110
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_init_seal(AegisAppRuntime* runtime);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@
 
 #include "types.h"
 #include "error_codes.h"
+#include "dispatch_index.h"
 #include "domain_entity.h"
 
 #ifdef __cplusplus
@@ -55,9 +56,14 @@ typedef struct {
     void* ctx;
 } AegisAppQueryHandlerEntry;
 
+#define APP_QUERY_INDEX_SIZE  DISPATCH_INDEX_SIZE(APP_QUERY_MAX_HANDLERS)
+
 typedef struct {
     AegisAppQueryHandlerEntry handlers[APP_QUERY_MAX_HANDLERS];
+    uint16_t index_keys[APP_QUERY_INDEX_SIZE];
+    uint8_t index_slots[APP_QUERY_INDEX_SIZE];
     uint8_t handler_count;
+    bool_t is_sealed;
 } AegisAppQueryDispatcher;
 
 /* ==================== 批量注册（提升敏捷开发效率） ==================== */
@@ -88,6 +94,16 @@ AegisErrorCode aegis_app_query_register_handlers(AegisAppQueryDispatcher* dispat
  */
 AegisErrorCode aegis_app_query_init(AegisAppQueryDispatcher* dispatcher);
 
+/*
+ * @brief: 封存查询处理器注册表（之后注册返回 ERR_INVALID_STATE，分发查找不再进入临界区）
+ * @return: 错误码
+ * @req: REQ-APP-107
+ * @design: DES-APP-107
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_app_query_seal(AegisAppQueryDispatcher* dispatcher);
+
 /*
  * @brief: 注册查询处理器
  * @param type: 查询类型
@@ -0,0 +1,78 @@
+/*
+ * @file: atomic_ops.h
+ * @brief: 单核/多线程共享索引的原子访问抽象（acquire/release 语义）
+ * @author: jack liu
+ * @req: REQ-COMMON-007
+ * @design: DES-COMMON-007
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - GCC/Clang：使用 __atomic 内建（与 C11 内存模型一致，C89 下可用）。
+ * - 其他编译器（Keil/IAR）：volatile 访问 + 端口提供的 aegis_critical_barrier()（Cortex-M 上为 DMB）。
+ * - 仅用于自然对齐的 32 位字，Cortex-M 与 x86 上单次访问天然不可分割。
+ * - 定义 AEGIS_ATOMIC_USE_BARRIER=1 可强制使用屏障后端（用于验证移植）。
+ */
+
+#ifndef ATOMIC_OPS_H
+#define ATOMIC_OPS_H
+
+#include "types.h"
+#include "critical.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef AEGIS_ATOMIC_USE_BARRIER
+#if defined(__GNUC__)
+#define AEGIS_ATOMIC_USE_BARRIER  0
+#else
+#define AEGIS_ATOMIC_USE_BARRIER  1
+#endif
+#endif
+
+#if !AEGIS_ATOMIC_USE_BARRIER
+
+/* 本端索引读取（无需同步） */
+#define AEGIS_ATOMIC_LOAD_RELAXED(p)        __atomic_load_n((p), __ATOMIC_RELAXED)
+/* 读取对端发布的索引：之后的数据读取不会被提前 */
+#define AEGIS_ATOMIC_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+/* 发布本端索引：之前的数据写入对对端可见 */
+#define AEGIS_ATOMIC_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#else
+
+#define AEGIS_ATOMIC_LOAD_RELAXED(p)        (*(p))
+#define AEGIS_ATOMIC_LOAD_ACQUIRE(p)        aegis_atomic_load_acquire_u32(p)
+#define AEGIS_ATOMIC_STORE_RELEASE(p, v)    aegis_atomic_store_release_u32((p), (v))
+
+#endif
+
+/* ==================== 屏障后端接口 ==================== */
+/*
+ * @brief: 读取32位字后插入内存屏障（acquire）
+ * @param p: 对端发布的索引地址
+ * @return: 读取值
+ * @req: REQ-ATOMIC-001
+ * @design: DES-ATOMIC-001
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint32_t aegis_atomic_load_acquire_u32(const volatile uint32_t* p);
+
+/*
+ * @brief: 插入内存屏障后写入32位字（release）
+ * @param p: 本端索引地址
+ * @param v: 写入值
+ * @req: REQ-ATOMIC-002
+ * @design: DES-ATOMIC-002
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+void aegis_atomic_store_release_u32(volatile uint32_t* p, uint32_t v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATOMIC_OPS_H */
@@ -0,0 +1,41 @@
+/*
+ * @file: crc32.h
+ * @brief: CRC-32（IEEE 802.3，反射多项式 0xEDB88320）
+ * @author: jack liu
+ * @req: REQ-COMMON-011
+ * @design: DES-COMMON-011
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 半字节查表（16项常量表，64字节 ROM），每字节两次查表，适合无硬件 CRC 的 MCU。
+ * - 可分段计算：crc = aegis_crc32_update(crc, part, len)，首段传入 0，结果与一次性计算相同。
+ * - 本模块无状态，可在任意上下文调用。
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief: 计算/续算 CRC-32
+ * @param crc: 上一段的结果（首段传 0）
+ * @param data: 数据（len 为 0 时可为 NULL）
+ * @param len: 字节数
+ * @return: 截至本段的 CRC-32（"123456789" 的结果为 0xCBF43926）
+ * @req: REQ-COMMON-011
+ * @design: DES-COMMON-011
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint32_t aegis_crc32_update(uint32_t crc, const void* data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32_H */
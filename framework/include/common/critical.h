@@ -33,6 +33,15 @@ void aegis_critical_enter(void);
  */
 void aegis_critical_exit(void);
 
+/*
+ * @brief: 内存屏障（不关中断；用于无锁 SPSC 索引发布）
+ * @req: REQ-CRITICAL-003
+ * @design: DES-CRITICAL-003
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+void aegis_critical_barrier(void);
+
 /* 便捷宏定义 */
 #define ENTER_CRITICAL()    aegis_critical_enter()
 #define EXIT_CRITICAL()     aegis_critical_exit()
@@ -0,0 +1,120 @@
+/*
+ * @file: dispatch_index.h
+ * @brief: 处理器分发索引（16位类型键 -> 注册表槽位，开放寻址哈希）
+ * @author: jack liu
+ * @req: REQ-COMMON-009
+ * @design: DES-COMMON-009
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 索引在注册时增量构建，查找为 O(1)（桶数 >= 2 倍注册表容量，负载因子 <= 0.5）。
+ * - 存储由使用方静态提供（keys/slots 两个平行数组），本模块无状态，可随宿主结构体拷贝。
+ * - 只支持插入，不支持删除（注册表均无注销接口）。
+ * - 插入/清空不加锁（宿主注册表在临界区内调用）；分发查找统一经 aegis_dispatch_index_find_sealed，
+ *   宿主注册表 seal 之后只读，查找无锁进行。
+ */
+
+#ifndef DISPATCH_INDEX_H
+#define DISPATCH_INDEX_H
+
+#include "types.h"
+#include "error_codes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 空桶标记（注册表容量因此不得超过 254） */
+#define DISPATCH_INDEX_EMPTY  0xFFU
+
+/* 编译期向上取整到2的幂（n <= 0x10000） */
+#define DISPATCH_INDEX_SMEAR1_(n)   ((n) | ((n) >> 1))
+#define DISPATCH_INDEX_SMEAR2_(n)   (DISPATCH_INDEX_SMEAR1_(n) | (DISPATCH_INDEX_SMEAR1_(n) >> 2))
+#define DISPATCH_INDEX_SMEAR4_(n)   (DISPATCH_INDEX_SMEAR2_(n) | (DISPATCH_INDEX_SMEAR2_(n) >> 4))
+#define DISPATCH_INDEX_SMEAR8_(n)   (DISPATCH_INDEX_SMEAR4_(n) | (DISPATCH_INDEX_SMEAR4_(n) >> 8))
+
+/* 容量为 max_entries 的注册表所需桶数（2的幂，>= 2 * max_entries） */
+#define DISPATCH_INDEX_SIZE(max_entries) \
+    (DISPATCH_INDEX_SMEAR8_((uint32_t)(max_entries) * 2U - 1U) + 1U)
+
+/*
+ * @brief: 清空索引（所有桶置空）
+ * @param slots: 槽位数组
+ * @param size: 桶数（2的幂）
+ * @req: REQ-DISPATCH-001
+ * @design: DES-DISPATCH-001
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+void aegis_dispatch_index_clear(uint8_t* slots, uint16_t size);
+
+/*
+ * @brief: 插入 key -> slot 映射（调用方保证 key 尚未插入）
+ * @param keys: 键数组
+ * @param slots: 槽位数组
+ * @param size: 桶数（2的幂）
+ * @param key: 类型键
+ * @param slot: 注册表槽位（< DISPATCH_INDEX_EMPTY）
+ * @return: 错误码，索引已满返回 ERR_OUT_OF_RANGE
+ * @req: REQ-DISPATCH-002
+ * @design: DES-DISPATCH-002
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_dispatch_index_insert(uint16_t* keys, uint8_t* slots, uint16_t size,
+                                           uint16_t key, uint8_t slot);
+
+/*
+ * @brief: 查找 key 对应的注册表槽位
+ * @param keys: 键数组
+ * @param slots: 槽位数组
+ * @param size: 桶数（2的幂）
+ * @param key: 类型键
+ * @return: 槽位，未注册返回 DISPATCH_INDEX_EMPTY
+ * @req: REQ-DISPATCH-003
+ * @design: DES-DISPATCH-003
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint8_t aegis_dispatch_index_find(const uint16_t* keys, const uint8_t* slots, uint16_t size,
+                                  uint16_t key);
+
+/*
+ * @brief: 按封存状态进入/退出分发查找的临界区
+ * @param sealed: 宿主注册表的封存标志（调用方只读一次后传入）
+ * @return: lock 返回是否已进入临界区，须原样传给 unlock
+ * @note: 封存后注册表只读，查找无需临界区；未封存时注册可能并发改写索引与注册项，
+ *        查找与注册项读取须在同一临界区内完成。封存标志只读一次，进入与退出的判断才能一致。
+ * @req: REQ-DISPATCH-004
+ * @design: DES-DISPATCH-004
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+bool_t aegis_dispatch_index_lock(bool_t sealed);
+void aegis_dispatch_index_unlock(bool_t locked);
+
+/*
+ * @brief: 宿主注册表的分发查找：查找 key 并拷出对应注册项（加锁规则见 aegis_dispatch_index_lock）
+ * @param keys: 键数组
+ * @param slots: 槽位数组
+ * @param size: 桶数（2的幂）
+ * @param key: 类型键
+ * @param sealed: 宿主注册表的封存标志
+ * @param entries: 注册项数组（下标即索引槽位）
+ * @param entry_size: 单个注册项字节数
+ * @param out: 输出注册项拷贝（未注册时不写）
+ * @return: 槽位，未注册返回 DISPATCH_INDEX_EMPTY
+ * @req: REQ-DISPATCH-005
+ * @design: DES-DISPATCH-005
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint8_t aegis_dispatch_index_find_sealed(const uint16_t* keys, const uint8_t* slots, uint16_t size,
+                                         uint16_t key, bool_t sealed,
+                                         const void* entries, uint16_t entry_size, void* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DISPATCH_INDEX_H */
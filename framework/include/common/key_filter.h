@@ -0,0 +1,79 @@
+/*
+ * @file: key_filter.h
+ * @brief: 16位键过滤核（在稠密键数组中查找等于给定值的元素，输出位掩码/计数）
+ * @author: jack liu
+ * @req: REQ-COMMON-010
+ * @design: DES-COMMON-010
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 编译期选择实现：定义 __AVX2__ 时一次比较16个键，定义 __SSE2__ 时一次比较8个键，
+ *   否则为可移植的标量实现（MCU 端口）。各实现结果逐位一致。
+ * - 本模块无状态、不加锁；调用方负责键数组在扫描期间的一致性。
+ * - 典型用法：仓储 SoA 布局按类型过滤（hot_type 数组）。
+ */
+
+#ifndef KEY_FILTER_H
+#define KEY_FILTER_H
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 单次掩码覆盖的键数（uint32_t 位宽） */
+#define KEY_FILTER_BLOCK  32U
+
+/*
+ * @brief: 比较 keys[0..count)，返回匹配位掩码（bit i 对应 keys[i]）
+ * @param keys: 键数组
+ * @param count: 键数（<= KEY_FILTER_BLOCK，超出部分忽略）
+ * @param key: 目标键
+ * @return: 匹配位掩码；keys 为 NULL 返回0
+ * @req: REQ-FILTER-001
+ * @design: DES-FILTER-001
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint32_t aegis_key_filter_mask(const uint16_t* keys, uint8_t count, uint16_t key);
+
+/*
+ * @brief: 统计 keys[0..count) 中等于 key 的元素个数
+ * @param keys: 键数组
+ * @param count: 键数
+ * @param key: 目标键
+ * @return: 匹配个数；keys 为 NULL 返回0
+ * @req: REQ-FILTER-002
+ * @design: DES-FILTER-002
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint32_t aegis_key_filter_count(const uint16_t* keys, uint32_t count, uint16_t key);
+
+/*
+ * @brief: 取出掩码最低置位的下标并清除该位（用于把掩码转换为结果下标）
+ * @param mask: 位掩码（调用方保证非0）
+ * @return: 最低置位下标（0..31）；mask 为 NULL 或为0时返回 KEY_FILTER_BLOCK
+ * @req: REQ-FILTER-003
+ * @design: DES-FILTER-003
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint8_t aegis_key_filter_pop(uint32_t* mask);
+
+/*
+ * @brief: 当前编译所选的实现名称（"avx2" / "sse2" / "scalar"），用于基准与诊断输出
+ * @return: 实现名称
+ * @req: REQ-FILTER-004
+ * @design: DES-FILTER-004
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+const char* aegis_key_filter_kernel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KEY_FILTER_H */
@@ -20,7 +20,7 @@ extern "C" {
 
 /* ==================== 内存池配置 ==================== */
 /* 通过 CMake 传入，提供默认值 */
-/* 单一内存块，按区域划分为：小块、中块、大块、超大块 */
+/* 单一内存块，按尺寸类（size class）划分区域；默认4个尺寸类：小块、中块、大块、超大块 */
 
 /* 小块配置 */
 #ifndef MEM_POOL_SMALL_SIZE
@@ -54,35 +54,118 @@ extern "C" {
 #define MEM_POOL_XLARGE_COUNT   2       /* 超大块数量 */
 #endif
 
-/* 计算总内存池大小（编译期计算） */
-#define MEM_POOL_TOTAL_SIZE \
-    ((MEM_POOL_SMALL_SIZE * MEM_POOL_SMALL_COUNT) + \
-     (MEM_POOL_MEDIUM_SIZE * MEM_POOL_MEDIUM_COUNT) + \
-     (MEM_POOL_LARGE_SIZE * MEM_POOL_LARGE_COUNT) + \
-     (MEM_POOL_XLARGE_SIZE * MEM_POOL_XLARGE_COUNT))
+/*
+ * 尺寸类表：MEM_POOL_CLASS_LIST(X) 对每个尺寸类展开一次 X(块大小, 块数)，块大小严格递增。
+ * 默认由上面4组宏组成；需要更多尺寸类时（如网关构建），把 MEM_POOL_CLASS_CONFIG 定义为一个头文件名
+ * （CMake: -DMEM_POOL_CLASS_CONFIG=xxx.h），在其中定义 MEM_POOL_CLASS_LIST，
+ * 以及首/末尺寸类的块大小 MEM_POOL_CLASS_MIN_SIZE / MEM_POOL_CLASS_MAX_SIZE（init 时校验）。
+ */
+#ifdef MEM_POOL_CLASS_CONFIG
+#include MEM_POOL_CLASS_CONFIG
+#endif
+
+#ifndef MEM_POOL_CLASS_LIST
+#define MEM_POOL_CLASS_LIST(X) \
+    X(MEM_POOL_SMALL_SIZE, MEM_POOL_SMALL_COUNT) \
+    X(MEM_POOL_MEDIUM_SIZE, MEM_POOL_MEDIUM_COUNT) \
+    X(MEM_POOL_LARGE_SIZE, MEM_POOL_LARGE_COUNT) \
+    X(MEM_POOL_XLARGE_SIZE, MEM_POOL_XLARGE_COUNT)
+#define MEM_POOL_CLASS_MIN_SIZE  MEM_POOL_SMALL_SIZE
+#define MEM_POOL_CLASS_MAX_SIZE  MEM_POOL_XLARGE_SIZE
+#elif !defined(MEM_POOL_CLASS_MIN_SIZE) || !defined(MEM_POOL_CLASS_MAX_SIZE)
+#error "MEM_POOL_CLASS_LIST requires MEM_POOL_CLASS_MIN_SIZE and MEM_POOL_CLASS_MAX_SIZE"
+#endif
 
-#define MEM_POOL_TOTAL_BLOCKS \
-    (MEM_POOL_SMALL_COUNT + MEM_POOL_MEDIUM_COUNT + \
-     MEM_POOL_LARGE_COUNT + MEM_POOL_XLARGE_COUNT)
+/* 由尺寸类表在编译期展开的汇总量（尺寸类数、总字节数、总块数） */
+#define MEM_POOL_X_ONE(size, count)     + 1
+#define MEM_POOL_X_BYTES(size, count)   + ((size) * (count))
+#define MEM_POOL_X_BLOCKS(size, count)  + (count)
+
+#define MEM_POOL_CLASS_COUNT   (0 MEM_POOL_CLASS_LIST(MEM_POOL_X_ONE))
+#define MEM_POOL_TOTAL_SIZE    (0 MEM_POOL_CLASS_LIST(MEM_POOL_X_BYTES))
+#define MEM_POOL_TOTAL_BLOCKS  (0 MEM_POOL_CLASS_LIST(MEM_POOL_X_BLOCKS))
+
+/* 每块头尾魔法数占用的字节数（用户可用大小 = 块大小 - MEM_POOL_GUARD_SIZE） */
+#define MEM_POOL_GUARD_SIZE    4U
+#define MEM_POOL_MAX_ALLOC     ((uint32_t)(MEM_POOL_CLASS_MAX_SIZE) - MEM_POOL_GUARD_SIZE)
+
+/*
+ * 块下标宽度（块数、空闲链表链接、统计）：总块数 <= 254 时默认 uint8_t（MCU 省 RAM），
+ * 否则 uint16_t（总块数上限 65534）。也可定义 MEM_POOL_INDEX_16 强制使用 16 位下标。
+ */
+#if defined(MEM_POOL_INDEX_16) || ((MEM_POOL_TOTAL_BLOCKS) > 254)
+typedef uint16_t AegisMemPoolIndex;
+#define MEM_POOL_INDEX_NONE  ((AegisMemPoolIndex)0xFFFFU)
+#else
+typedef uint8_t AegisMemPoolIndex;
+#define MEM_POOL_INDEX_NONE  ((AegisMemPoolIndex)0xFFU)
+#endif
+
+/*
+ * 请求大小 -> 尺寸类 查找表：按 2^MEM_POOL_CLASS_GRANULE_SHIFT 字节分桶，每桶1字节，
+ * 查表后最多再比较一次，与尺寸类数无关；要求相邻尺寸类块大小之差 >= 分桶粒度（init 校验）。
+ */
+#ifndef MEM_POOL_CLASS_GRANULE_SHIFT
+#define MEM_POOL_CLASS_GRANULE_SHIFT  3
+#endif
+#define MEM_POOL_CLASS_GRANULE  (1U << (MEM_POOL_CLASS_GRANULE_SHIFT))
+#define MEM_POOL_SIZE_MAP_SIZE  ((MEM_POOL_MAX_ALLOC + MEM_POOL_CLASS_GRANULE - 1U) >> (MEM_POOL_CLASS_GRANULE_SHIFT))
+
+/* 有空闲块的尺寸类位图（每32个尺寸类一个字），最佳尺寸类耗尽时按位图找下一个更大的尺寸类 */
+#define MEM_POOL_CLASS_WORDS    ((MEM_POOL_CLASS_COUNT + 31) / 32)
+
+/* 2的幂块大小模式：要求全部块大小均为2的幂（编译期断言）；
+ * 开启后 指针->区域 通过查表完成，块索引使用移位代替除法 */
+#ifndef MEM_POOL_POW2_BLOCKS
+#define MEM_POOL_POW2_BLOCKS    0
+#endif
+
+#if MEM_POOL_POW2_BLOCKS
+/* 区域映射表粒度：以最小块大小为单位（更大的2的幂块必为其整数倍） */
+#define MEM_POOL_REGION_MAP_SIZE  (MEM_POOL_TOTAL_SIZE / MEM_POOL_CLASS_MIN_SIZE)
+#endif
+
+/*
+ * 每上下文分配缓存（magazine，见 AegisMemPoolCache）：每个尺寸类最多缓存 MEM_POOL_CACHE_DEPTH 个空闲块，
+ * 缓存为空/已满时在一次临界区内与共享空闲链表批量交换 MEM_POOL_CACHE_BATCH 块。
+ */
+#ifndef MEM_POOL_CACHE_DEPTH
+#define MEM_POOL_CACHE_DEPTH    4U
+#endif
+#ifndef MEM_POOL_CACHE_BATCH
+#define MEM_POOL_CACHE_BATCH    ((MEM_POOL_CACHE_DEPTH + 1U) / 2U)
+#endif
+
+/*
+ * 增量魔法数巡检（aegis_mem_pool_scrub_step）：每次调用检查 MEM_POOL_SCRUB_BATCH 块，
+ * 保证 MEM_POOL_SCRUB_SWEEP_CALLS 次调用内扫完全部块；每块单独进入一次临界区。
+ */
+#ifndef MEM_POOL_SCRUB_SWEEP_CALLS
+#define MEM_POOL_SCRUB_SWEEP_CALLS  16U
+#endif
+#define MEM_POOL_SCRUB_BATCH  (((uint32_t)(MEM_POOL_TOTAL_BLOCKS) + (MEM_POOL_SCRUB_SWEEP_CALLS) - 1U) / \
+                               (MEM_POOL_SCRUB_SWEEP_CALLS))
 
 /* ==================== 内存池统计信息 ==================== */
 typedef struct {
-    uint8_t total_blocks;       /* 总块数 */
-    uint8_t used_blocks;        /* 已用块数 */
-    uint8_t free_blocks;        /* 空闲块数 */
-    uint8_t peak_usage;         /* 峰值使用量 */
-
-    /* 各类型块统计 */
-    uint8_t small_used;         /* 小块已用 */
-    uint8_t medium_used;        /* 中块已用 */
-    uint8_t large_used;         /* 大块已用 */
-    uint8_t xlarge_used;        /* 超大块已用 */
+    AegisMemPoolIndex total_blocks;     /* 总块数 */
+    AegisMemPoolIndex used_blocks;      /* 已用块数 */
+    AegisMemPoolIndex free_blocks;      /* 空闲块数 */
+    AegisMemPoolIndex peak_usage;       /* 峰值使用量（从共享空闲链表取出的块数，含缓存块） */
+    AegisMemPoolIndex cached_blocks;    /* 各上下文缓存中的空闲块数（total = used + cached + free） */
+    AegisMemPoolIndex scrub_corrupted;  /* 最近一次完整巡检发现的损坏块数 */
+    uint32_t scrub_sweeps;              /* 已完成的完整巡检轮数 */
+
+    /* 各尺寸类已用块数（按块大小递增；默认配置下依次为小/中/大/超大块） */
+    AegisMemPoolIndex class_used[MEM_POOL_CLASS_COUNT];
 } AegisMemPoolStats;
 
 /* ==================== 可注入实例（严格依赖注入） ==================== */
+typedef struct AegisMemPoolCache AegisMemPoolCache;
+
 typedef struct {
     bool_t is_used;
-    uint8_t block_type;
+    uint8_t block_type;         /* 所属尺寸类 */
     const char* alloc_file;
     uint32_t alloc_line;
 } AegisMemPoolBlockMeta;
@@ -90,25 +173,58 @@ typedef struct {
 typedef struct {
     uint8_t* start_addr;
     uint16_t block_size;
-    uint8_t block_count;
-    uint8_t used_count;
-    uint8_t peak_usage;
-    uint8_t free_list_head;
+    AegisMemPoolIndex block_count;
+    AegisMemPoolIndex used_count;
+    AegisMemPoolIndex peak_usage;
+    AegisMemPoolIndex free_list_head;
+    AegisMemPoolIndex meta_base;    /* 本区域首块在 meta[] 中的全局索引（init 预计算） */
+    uint8_t block_shift;            /* log2(block_size)；非2的幂时为0（回退除法） */
+    uint32_t start_offset;          /* 区域起始偏移（相对 buffer） */
+    uint32_t end_offset;            /* 区域结束偏移（相对 buffer，不含） */
 } AegisMemPoolRegion;
 
 typedef struct {
     uint8_t buffer[MEM_POOL_TOTAL_SIZE];
     AegisMemPoolBlockMeta meta[MEM_POOL_TOTAL_BLOCKS];
-    AegisMemPoolRegion regions[4];
+    AegisMemPoolRegion regions[MEM_POOL_CLASS_COUNT];
+    uint8_t size_class[MEM_POOL_SIZE_MAP_SIZE];     /* (请求大小-1)/分桶粒度 -> 候选尺寸类 */
+    uint32_t class_avail[MEM_POOL_CLASS_WORDS];     /* 第 c 位=尺寸类 c 有空闲块 */
+#if MEM_POOL_POW2_BLOCKS
+    uint8_t region_map[MEM_POOL_REGION_MAP_SIZE];   /* 偏移/最小块大小 -> 区域索引 */
+#endif
     bool_t is_initialized;
-    uint8_t peak_usage;
+    AegisMemPoolIndex used_blocks;
+    AegisMemPoolIndex peak_usage;
+    AegisMemPoolCache* caches;      /* 已注册的每上下文缓存（单链表，供统计与 flush） */
+    uint8_t scrub_region;           /* 巡检游标：区域 */
+    AegisMemPoolIndex scrub_block;  /* 巡检游标：区域内块索引 */
+    AegisMemPoolIndex scrub_found;  /* 本轮巡检已发现的损坏块数 */
+    AegisMemPoolIndex scrub_last;   /* 上一轮完整巡检发现的损坏块数 */
+    uint32_t scrub_sweeps;
     AegisTraceLog* trace;
 } AegisMemPool;
 
+/*
+ * 每上下文分配缓存：每个 ISR 优先级、主循环、工作线程各持有一个，且只由所属上下文访问。
+ * 命中缓存时分配不进入全局临界区（只写本块的魔法数与元数据），释放只在检查并清除 is_used 时
+ * 进入一次短临界区（防止并发重复释放同一块）；
+ * 未命中时批量从共享空闲链表取回（refill），缓存满时批量归还（flush），每批一次临界区。
+ * 从共享池看，缓存中的块已被取出；它们计入 cached_blocks，不计入 used_blocks。
+ */
+struct AegisMemPoolCache {
+    AegisMemPool* pool;
+    AegisMemPoolCache* next;
+    AegisMemPoolIndex blocks[MEM_POOL_CLASS_COUNT][MEM_POOL_CACHE_DEPTH];  /* 各尺寸类缓存的块下标（栈） */
+    uint8_t count[MEM_POOL_CLASS_COUNT];
+    uint32_t hits;          /* 未访问共享空闲链表完成的分配/释放次数 */
+    uint32_t refills;       /* 批量取回次数 */
+    uint32_t flushes;       /* 批量归还次数 */
+};
+
 /* ==================== 内存池接口 ==================== */
 /*
  * @brief: 初始化内存池（幂等操作）
- * @return: 错误码
+ * @return: 错误码（尺寸类表不满足递增/分桶粒度/首末块大小约束时返回 ERR_INVALID_PARAM）
  * @req: REQ-MEM-002
  * @design: DES-MEM-002
  * @asil: ASIL-B
@@ -117,7 +233,7 @@ typedef struct {
 AegisErrorCode aegis_mem_pool_init(AegisMemPool* pool, AegisTraceLog* trace);
 
 /*
- * @brief: 分配内存块（自动选择最合适的块大小）
+ * @brief: 分配内存块（查表选择最小的可容纳尺寸类，该尺寸类耗尽时依次使用更大的尺寸类）
  * @param size: 请求大小（字节）
  * @param file: 分配发起文件名（用于追溯）
  * @param line: 分配发起行号（用于追溯）
@@ -191,12 +307,78 @@ AegisErrorCode aegis_mem_pool_check_magic(const AegisMemPool* pool, const void*
  * @asil: ASIL-B
  * @isr_unsafe
  */
-AegisErrorCode aegis_mem_pool_check_all_magic(const AegisMemPool* pool, uint8_t* corrupted_count);
+AegisErrorCode aegis_mem_pool_check_all_magic(const AegisMemPool* pool, AegisMemPoolIndex* corrupted_count);
+
+/*
+ * @brief: 初始化每上下文缓存并注册到内存池（须在 aegis_mem_pool_init 之后、缓存首次使用之前调用）
+ * @param cache: 缓存实例（未使用或已 flush）
+ * @param pool: 共享内存池
+ * @return: 错误码
+ * @req: REQ-MEM-010
+ * @design: DES-MEM-010
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_mem_pool_cache_init(AegisMemPoolCache* cache, AegisMemPool* pool);
+
+/*
+ * @brief: 经每上下文缓存分配内存块（尺寸类选择与 aegis_mem_pool_alloc 相同）
+ * @param size: 请求大小（字节）
+ * @param file: 分配发起文件名（用于追溯）
+ * @param line: 分配发起行号（用于追溯）
+ * @return: 用户内存指针，失败返回 NULL
+ * @note: 只能由缓存所属上下文调用；缓存路径不写追溯日志。最佳尺寸类在缓存与共享链表中均耗尽时，
+ *        先用本缓存中更大尺寸类的块，再从共享池向上借用（不进缓存）。
+ * @req: REQ-MEM-011
+ * @design: DES-MEM-011
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+void* aegis_mem_pool_cache_alloc(AegisMemPoolCache* cache, uint32_t size, const char* file, uint32_t line);
+
+/*
+ * @brief: 经每上下文缓存释放内存块（块可来自任意上下文的缓存或 aegis_mem_pool_alloc）
+ * @param ptr: 待释放的用户指针
+ * @return: 错误码（校验与 aegis_mem_pool_free 相同）
+ * @note: 只能由缓存所属上下文调用；检查并清除 is_used 在一次短临界区内完成，
+ *        其他上下文并发释放同一指针时只有一方成功，另一方返回 ERR_MEM_POOL_DOUBLE_FREE。
+ * @req: REQ-MEM-012
+ * @design: DES-MEM-012
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_mem_pool_cache_free(AegisMemPoolCache* cache, void* ptr);
+
+/*
+ * @brief: 把缓存中的全部块归还共享池（上下文退出、或需要让其它上下文使用这些块时调用）
+ * @return: 错误码
+ * @note: 只能由缓存所属上下文调用。
+ * @req: REQ-MEM-013
+ * @design: DES-MEM-013
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_mem_pool_cache_flush(AegisMemPoolCache* cache);
+
+/*
+ * @brief: 增量巡检：从游标处检查 MEM_POOL_SCRUB_BATCH 个块的魔法数后推进游标（供空闲路径周期调用）
+ *         每块单独进入一次临界区，关中断时间与池大小无关；发现损坏时写入 trace
+ *         （TRACE_EVENT_MEM_CORRUPT，trace_id=分配文件，param1=分配行号，param2=用户指针低32位）
+ * @param corrupted_count: 输出本次调用发现的损坏块数（可为NULL）
+ * @return: 错误码，ERR_OK表示本次检查的块均完整
+ * @req: REQ-MEM-014
+ * @design: DES-MEM-014
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_mem_pool_scrub_step(AegisMemPool* pool, AegisMemPoolIndex* corrupted_count);
 
 /* ==================== 便捷分配宏 ==================== */
 /* 自动记录文件名和行号 */
 #define MEM_ALLOC(pool, size)     aegis_mem_pool_alloc((pool), (size), __FILE__, __LINE__)
 #define MEM_FREE(pool, ptr)       aegis_mem_pool_free((pool), (ptr))
+#define MEM_CACHE_ALLOC(cache, size)  aegis_mem_pool_cache_alloc((cache), (size), __FILE__, __LINE__)
+#define MEM_CACHE_FREE(cache, ptr)    aegis_mem_pool_cache_free((cache), (ptr))
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,207 @@
+/*
+ * @file: object_pool.h
+ * @brief: 按类型生成的定长对象池（每槽位恰好容纳一个结构体，O(1) 分配/释放）
+ * @author: jack liu
+ * @req: REQ-COMMON-012
+ * @design: DES-COMMON-012
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 与 AegisMemPool 相比：槽位按 sizeof(类型) 划分，不向上取整到尺寸类；不写头尾魔法数、不记录文件/行号。
+ * - 空闲槽位以侵入式链表串联（链接保存在槽位本身）；另有每槽位1位的已分配位图，用于拒绝重复释放。
+ * - OBJECT_POOL_GUARD=1（默认）时每个槽位在对象之后附加一个保护字，init 时写入，释放与 check_guards 时校验，
+ *   用于发现对象越界写；MCU 上可设为0省去每槽位4字节。
+ *
+ * 用法（头文件声明类型与接口，某一个 .c 中生成实现）：
+ *   AEGIS_OBJECT_POOL_DECLARE(AegisFooPool, aegis_foo_pool, AegisFoo, 8)
+ *   AEGIS_OBJECT_POOL_DEFINE(AegisFooPool, aegis_foo_pool, AegisFoo, 8)
+ * 生成：
+ *   AegisErrorCode aegis_foo_pool_init(AegisFooPool* pool);
+ *   AegisFoo* aegis_foo_pool_alloc(AegisFooPool* pool);
+ *   AegisErrorCode aegis_foo_pool_free(AegisFooPool* pool, AegisFoo* obj);
+ *   AegisErrorCode aegis_foo_pool_get_stats(const AegisFooPool* pool, AegisObjectPoolStats* stats);
+ * 宏只生成类型与函数，不定义池实例：由使用方按需定义 static AegisFooPool 变量，未定义实例时不占 RAM。
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <stddef.h>
+#include "types.h"
+#include "error_codes.h"
+#include "compile_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== 配置 ==================== */
+#ifndef OBJECT_POOL_GUARD
+#define OBJECT_POOL_GUARD  1
+#endif
+
+#define OBJECT_POOL_GUARD_WORD  0xA5C3E10FUL
+
+/* 槽位下标（单个对象池容量上限 65534） */
+typedef uint16_t AegisObjectPoolIndex;
+#define OBJECT_POOL_INDEX_NONE  ((AegisObjectPoolIndex)0xFFFFU)
+
+#define OBJECT_POOL_MAP_WORDS(capacity)  (((capacity) + 31U) / 32U)
+
+/* ==================== 类型无关的核心 ==================== */
+typedef struct {
+    AegisObjectPoolIndex capacity;
+    AegisObjectPoolIndex used;
+    AegisObjectPoolIndex peak;
+} AegisObjectPoolStats;
+
+typedef struct {
+    uint8_t* slots;                 /* 槽位数组首地址 */
+    uint32_t* used_map;             /* 已分配位图（每槽位1位） */
+    uint16_t stride;                /* 槽位大小（对象 + 保护字，含对齐填充） */
+    uint16_t guard_offset;          /* 保护字在槽位内的偏移（OBJECT_POOL_GUARD=0 时不用） */
+    AegisObjectPoolIndex capacity;
+    AegisObjectPoolIndex free_head;
+    AegisObjectPoolIndex used;
+    AegisObjectPoolIndex peak;
+    bool_t is_initialized;
+} AegisObjectPool;
+
+/*
+ * @brief: 初始化对象池核心（由生成的 <prefix>_init 调用）
+ * @param slots: 槽位数组（capacity * stride 字节）
+ * @param used_map: 已分配位图（OBJECT_POOL_MAP_WORDS(capacity) 个字）
+ * @param stride: 槽位大小（>= sizeof(AegisObjectPoolIndex)）
+ * @param guard_offset: 保护字偏移
+ * @param capacity: 槽位数（1 ~ 65534）
+ * @return: 错误码
+ * @req: REQ-OBJPOOL-001
+ * @design: DES-OBJPOOL-001
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_object_pool_init(AegisObjectPool* pool, void* slots, uint32_t* used_map,
+                                      uint16_t stride, uint16_t guard_offset, AegisObjectPoolIndex capacity);
+
+/*
+ * @brief: 取出一个空闲槽位（O(1)）
+ * @return: 槽位下标，OBJECT_POOL_INDEX_NONE 表示已耗尽
+ * @req: REQ-OBJPOOL-002
+ * @design: DES-OBJPOOL-002
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisObjectPoolIndex aegis_object_pool_take(AegisObjectPool* pool);
+
+/*
+ * @brief: 归还槽位（O(1)）
+ * @param index: 槽位下标
+ * @return: ERR_OK；下标越界返回 ERR_OUT_OF_RANGE，未分配返回 ERR_MEM_POOL_DOUBLE_FREE，
+ *          保护字被改写返回 ERR_MEM_POOL_INVALID（此时槽位不回收）
+ * @req: REQ-OBJPOOL-003
+ * @design: DES-OBJPOOL-003
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_object_pool_release(AegisObjectPool* pool, AegisObjectPoolIndex index);
+
+/*
+ * @brief: 获取使用统计
+ * @req: REQ-OBJPOOL-004
+ * @design: DES-OBJPOOL-004
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_object_pool_get_stats(const AegisObjectPool* pool, AegisObjectPoolStats* stats);
+
+/*
+ * @brief: 校验全部槽位的保护字（OBJECT_POOL_GUARD=0 时恒为 ERR_OK）
+ * @param corrupted: 输出保护字被改写的槽位数
+ * @return: 错误码，ERR_OK 表示全部完整
+ * @req: REQ-OBJPOOL-005
+ * @design: DES-OBJPOOL-005
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_object_pool_check_guards(const AegisObjectPool* pool, AegisObjectPoolIndex* corrupted);
+
+/* ==================== 按类型生成 ==================== */
+#if OBJECT_POOL_GUARD
+#define AEGIS_OBJECT_POOL_GUARD_MEMBER  uint32_t guard;
+#define AEGIS_OBJECT_POOL_GUARD_OFFSET(Slot)  ((uint16_t)offsetof(Slot, guard))
+#else
+#define AEGIS_OBJECT_POOL_GUARD_MEMBER
+#define AEGIS_OBJECT_POOL_GUARD_OFFSET(Slot)  ((uint16_t)0)
+#endif
+
+/*
+ * 声明对象池类型 Name（槽位 Name##Slot）与接口 prefix##_init/alloc/free/get_stats。
+ * 槽位为 { union { Type obj; 空闲链接 }; 保护字 }：对象按 Type 自身对齐，空闲时复用对象空间存链接。
+ */
+#define AEGIS_OBJECT_POOL_DECLARE(Name, prefix, Type, capacity) \
+    typedef struct { \
+        union { \
+            Type obj; \
+            AegisObjectPoolIndex next; \
+        } u; \
+        AEGIS_OBJECT_POOL_GUARD_MEMBER \
+    } Name##Slot; \
+    typedef struct { \
+        AegisObjectPool core; \
+        Name##Slot slots[capacity]; \
+        uint32_t used_map[OBJECT_POOL_MAP_WORDS(capacity)]; \
+    } Name; \
+    AegisErrorCode prefix##_init(Name* pool); \
+    Type* prefix##_alloc(Name* pool); \
+    AegisErrorCode prefix##_free(Name* pool, Type* obj); \
+    AegisErrorCode prefix##_get_stats(const Name* pool, AegisObjectPoolStats* stats);
+
+/*
+ * 生成 AEGIS_OBJECT_POOL_DECLARE 声明的接口实现（参数须与声明一致，只在一个 .c 中展开）。
+ * 对象位于槽位起始处：free 按编译期常量 sizeof(Name##Slot) 把指针换算为下标，并拒绝非槽位起始的指针。
+ * 容量与槽位大小在编译期校验：下标/步长均为16位，超限时下方强制转换会静默截断。
+ */
+#define AEGIS_OBJECT_POOL_DEFINE(Name, prefix, Type, capacity) \
+    FW_STATIC_ASSERT((capacity) > 0U && (capacity) < OBJECT_POOL_INDEX_NONE, prefix##_capacity_fits); \
+    FW_STATIC_ASSERT(sizeof(Name##Slot) <= 0xFFFFU, prefix##_slot_size_fits); \
+    AegisErrorCode prefix##_init(Name* pool) { \
+        if (pool == NULL) { \
+            return ERR_NULL_PTR; \
+        } \
+        return aegis_object_pool_init(&pool->core, pool->slots, pool->used_map, \
+                                      (uint16_t)sizeof(Name##Slot), AEGIS_OBJECT_POOL_GUARD_OFFSET(Name##Slot), \
+                                      (AegisObjectPoolIndex)(capacity)); \
+    } \
+    Type* prefix##_alloc(Name* pool) { \
+        AegisObjectPoolIndex index; \
+        if (pool == NULL) { \
+            return NULL; \
+        } \
+        index = aegis_object_pool_take(&pool->core); \
+        return (index == OBJECT_POOL_INDEX_NONE) ? NULL : &pool->slots[index].u.obj; \
+    } \
+    AegisErrorCode prefix##_free(Name* pool, Type* obj) { \
+        ulong_t offset; \
+        if (pool == NULL || obj == NULL) { \
+            return ERR_NULL_PTR; \
+        } \
+        offset = (ulong_t)obj - (ulong_t)pool->slots; \
+        if ((ulong_t)obj < (ulong_t)pool->slots || offset >= (ulong_t)sizeof(pool->slots) || \
+            offset % (ulong_t)sizeof(Name##Slot) != 0UL) { \
+            return ERR_MEM_POOL_INVALID; \
+        } \
+        return aegis_object_pool_release(&pool->core, \
+                                         (AegisObjectPoolIndex)(offset / (ulong_t)sizeof(Name##Slot))); \
+    } \
+    AegisErrorCode prefix##_get_stats(const Name* pool, AegisObjectPoolStats* stats) { \
+        if (pool == NULL) { \
+            return ERR_NULL_PTR; \
+        } \
+        return aegis_object_pool_get_stats(&pool->core, stats); \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OBJECT_POOL_H */
@@ -24,13 +24,36 @@ extern "C" {
 #define RING_BUFFER_SIZE  256  /* 缓冲区大小（字节），建议2的幂次 */
 #endif
 
+/* 2的幂容量：init 时自动检测，使用掩码 + 自由递增16位索引（无取模、无 count 维护）
+ * RING_BUFFER_POW2_ONLY=1：只编译掩码路径，非2的幂容量 init 失败；
+ * 同时 RING_BUFFER_STORAGE_SIZE 向上取整到2的幂，使追溯日志/命令队列/事件队列自动走掩码路径 */
+#ifndef RING_BUFFER_POW2_ONLY
+#define RING_BUFFER_POW2_ONLY  0
+#endif
+
+/* 编译期向上取整到2的幂（n <= 32768） */
+#define RING_BUFFER_SMEAR1_(x)  ((x) | ((x) >> 1))
+#define RING_BUFFER_SMEAR2_(x)  (RING_BUFFER_SMEAR1_(x) | (RING_BUFFER_SMEAR1_(x) >> 2))
+#define RING_BUFFER_SMEAR4_(x)  (RING_BUFFER_SMEAR2_(x) | (RING_BUFFER_SMEAR2_(x) >> 4))
+#define RING_BUFFER_SMEAR8_(x)  (RING_BUFFER_SMEAR4_(x) | (RING_BUFFER_SMEAR4_(x) >> 8))
+#define RING_BUFFER_POW2_CEIL(n)  (RING_BUFFER_SMEAR8_((n) - 1U) + 1U)
+
+/* 上层模块静态存储大小（按需取整） */
+#if RING_BUFFER_POW2_ONLY
+#define RING_BUFFER_STORAGE_SIZE(n)  RING_BUFFER_POW2_CEIL(n)
+#else
+#define RING_BUFFER_STORAGE_SIZE(n)  (n)
+#endif
+
 /* ==================== 环形缓冲区结构 ==================== */
 typedef struct {
     uint8_t* buffer;        /* 缓冲区指针（DMA可直接访问） */
     uint16_t size;          /* 缓冲区总大小 */
-    uint16_t head;          /* 写入位置（生产者） */
-    uint16_t tail;          /* 读取位置（消费者） */
-    uint16_t count;         /* 当前数据量 */
+    uint16_t mask;          /* 2的幂模式：size - 1 */
+    uint16_t head;          /* 写入位置（生产者）；2的幂模式下为自由递增计数 */
+    uint16_t tail;          /* 读取位置（消费者）；2的幂模式下为自由递增计数 */
+    uint16_t count;         /* 当前数据量（仅非2的幂模式维护） */
+    bool_t is_pow2;         /* 是否使用掩码索引 */
 } AegisRingBuffer;
 
 /* ==================== 环形缓冲区接口 ==================== */
@@ -38,7 +61,7 @@ typedef struct {
  * @brief: 初始化环形缓冲区
  * @param rb: 环形缓冲区指针
  * @param buffer: 静态缓冲区指针（必须对齐）
- * @param size: 缓冲区大小
+ * @param size: 缓冲区大小（2的幂时自动使用掩码索引）
  * @return: 错误码
  * @req: REQ-RING-001
  * @design: DES-RING-001
@@ -0,0 +1,165 @@
+/*
+ * @file: ring_buffer_spsc.h
+ * @brief: 无锁单生产者/单消费者环形缓冲区接口
+ * @author: jack liu
+ * @req: REQ-COMMON-008
+ * @design: DES-COMMON-008
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 生产者只写 head，消费者只写 tail，双方通过 acquire/release 发布索引，全程不关中断。
+ * - 典型用法：UART/DMA 中断作为生产者，主循环作为消费者（或反之）。
+ * - 容量必须为2的幂；head/tail 为自由递增的32位计数，使用掩码取下标，满/空无需额外 count 字段。
+ * - 生产者接口只能由同一个上下文调用，消费者接口同理；clear 需双方都空闲时调用。
+ */
+
+#ifndef RING_BUFFER_SPSC_H
+#define RING_BUFFER_SPSC_H
+
+#include "types.h"
+#include "error_codes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== SPSC 环形缓冲区结构 ==================== */
+typedef struct {
+    uint8_t* buffer;            /* 缓冲区指针（DMA可直接访问） */
+    uint32_t mask;              /* size - 1 */
+    uint16_t size;              /* 缓冲区总大小（2的幂） */
+    volatile uint32_t head;     /* 已发布的写入计数（仅生产者写） */
+    volatile uint32_t tail;     /* 已发布的读取计数（仅消费者写） */
+} AegisRingBufferSpsc;
+
+/* ==================== 初始化 ==================== */
+/*
+ * @brief: 初始化 SPSC 环形缓冲区
+ * @param rb: 环形缓冲区指针
+ * @param buffer: 静态缓冲区指针
+ * @param size: 缓冲区大小（必须为2的幂）
+ * @return: 错误码，非2的幂返回 ERR_INVALID_PARAM
+ * @req: REQ-RING-SPSC-001
+ * @design: DES-RING-SPSC-001
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_ring_buffer_spsc_init(AegisRingBufferSpsc* rb, uint8_t* buffer, uint16_t size);
+
+/* ==================== 生产者接口 ==================== */
+/*
+ * @brief: 写入单字节（生产者，无锁）
+ * @return: 错误码，已满返回 ERR_OUT_OF_RANGE
+ * @req: REQ-RING-SPSC-002
+ * @design: DES-RING-SPSC-002
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_ring_buffer_spsc_put(AegisRingBufferSpsc* rb, uint8_t data);
+
+/*
+ * @brief: 批量写入（生产者，无锁）
+ * @return: 实际写入长度
+ * @req: REQ-RING-SPSC-003
+ * @design: DES-RING-SPSC-003
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint16_t aegis_ring_buffer_spsc_write(AegisRingBufferSpsc* rb, const uint8_t* data, uint16_t len);
+
+/*
+ * @brief: 获取连续可写空间（生产者，DMA使用）
+ * @param ptr: 输出缓冲区指针
+ * @return: 连续可写长度
+ * @req: REQ-RING-SPSC-004
+ * @design: DES-RING-SPSC-004
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint16_t aegis_ring_buffer_spsc_get_write_ptr(AegisRingBufferSpsc* rb, uint8_t** ptr);
+
+/*
+ * @brief: 提交写入（生产者，DMA完成后调用）
+ * @return: 错误码，超过可写空间返回 ERR_OUT_OF_RANGE
+ * @req: REQ-RING-SPSC-005
+ * @design: DES-RING-SPSC-005
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_ring_buffer_spsc_commit_write(AegisRingBufferSpsc* rb, uint16_t len);
+
+/* ==================== 消费者接口 ==================== */
+/*
+ * @brief: 读取单字节（消费者，无锁）
+ * @return: 错误码，为空返回 ERR_OUT_OF_RANGE
+ * @req: REQ-RING-SPSC-006
+ * @design: DES-RING-SPSC-006
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_ring_buffer_spsc_get(AegisRingBufferSpsc* rb, uint8_t* data);
+
+/*
+ * @brief: 批量读取（消费者，无锁）
+ * @return: 实际读取长度
+ * @req: REQ-RING-SPSC-007
+ * @design: DES-RING-SPSC-007
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint16_t aegis_ring_buffer_spsc_read(AegisRingBufferSpsc* rb, uint8_t* data, uint16_t len);
+
+/*
+ * @brief: 获取连续可读空间（消费者，DMA使用）
+ * @param ptr: 输出缓冲区指针
+ * @return: 连续可读长度
+ * @req: REQ-RING-SPSC-008
+ * @design: DES-RING-SPSC-008
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint16_t aegis_ring_buffer_spsc_get_read_ptr(AegisRingBufferSpsc* rb, uint8_t** ptr);
+
+/*
+ * @brief: 提交读取（消费者，DMA完成后调用）
+ * @return: 错误码，超过可读数据返回 ERR_OUT_OF_RANGE
+ * @req: REQ-RING-SPSC-009
+ * @design: DES-RING-SPSC-009
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_ring_buffer_spsc_commit_read(AegisRingBufferSpsc* rb, uint16_t len);
+
+/* ==================== 查询 ==================== */
+/*
+ * @brief: 获取当前数据量（快照；任一端调用均安全）
+ * @req: REQ-RING-SPSC-010
+ * @design: DES-RING-SPSC-010
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint16_t aegis_ring_buffer_spsc_get_count(const AegisRingBufferSpsc* rb);
+
+/*
+ * @brief: 获取剩余空间（快照；任一端调用均安全）
+ * @req: REQ-RING-SPSC-011
+ * @design: DES-RING-SPSC-011
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+uint16_t aegis_ring_buffer_spsc_get_free(const AegisRingBufferSpsc* rb);
+
+/*
+ * @brief: 清空缓冲区（生产者与消费者均空闲时调用）
+ * @req: REQ-RING-SPSC-012
+ * @design: DES-RING-SPSC-012
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+void aegis_ring_buffer_spsc_clear(AegisRingBufferSpsc* rb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RING_BUFFER_SPSC_H */
@@ -0,0 +1,126 @@
+/*
+ * @file: scratch_arena.h
+ * @brief: 临时对象暂存区（指针递增分配，整体复位）
+ * @author: jack liu
+ * @req: REQ-COMMON-013
+ * @design: DES-COMMON-013
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 用于处理器内的大型临时对象（实体副本、待发布事件、DTO），代替栈上局部变量，降低最坏栈深度。
+ * - 分配 O(1)：对齐后前移偏移；不能单独释放，只能回退到某个标记或整体复位。
+ * - 每个暂存区只属于一个执行上下文（通常是主循环），接口不进入临界区，不可在 ISR 中使用。
+ * - 分配的内存不清零，调用方自行初始化。
+ */
+
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include "types.h"
+#include "error_codes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== 配置 ==================== */
+/* 分配对齐（2的幂；按实际地址对齐，缓冲区本身无对齐要求） */
+#ifndef SCRATCH_ARENA_ALIGN
+#define SCRATCH_ARENA_ALIGN  8U
+#endif
+
+/* ==================== 数据结构 ==================== */
+/* 回退标记（即当时的已用字节数） */
+typedef uint32_t AegisScratchArenaMark;
+
+typedef struct {
+    uint32_t capacity;      /* 总字节数 */
+    uint32_t used;          /* 当前已用字节数（含对齐填充） */
+    uint32_t peak;          /* 自上次复位以来的最大已用字节数 */
+    uint32_t high_water;    /* 自初始化以来的最大已用字节数 */
+    uint32_t failures;      /* 空间不足导致分配失败的次数 */
+} AegisScratchArenaStats;
+
+typedef struct {
+    uint8_t* base;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t peak;
+    uint32_t high_water;
+    uint32_t failures;
+    bool_t is_initialized;
+} AegisScratchArena;
+
+/* ==================== 接口 ==================== */
+/*
+ * @brief: 初始化暂存区
+ * @param buffer: 后备缓冲区（由持有者静态分配）
+ * @param capacity: 缓冲区字节数
+ * @return: 错误码
+ * @req: REQ-SCRATCH-001
+ * @design: DES-SCRATCH-001
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_scratch_arena_init(AegisScratchArena* arena, void* buffer, uint32_t capacity);
+
+/*
+ * @brief: 分配临时内存（O(1)，按 SCRATCH_ARENA_ALIGN 对齐）
+ * @param size: 字节数
+ * @return: 内存指针，空间不足或 size 为0时返回 NULL
+ * @req: REQ-SCRATCH-002
+ * @design: DES-SCRATCH-002
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+void* aegis_scratch_arena_alloc(AegisScratchArena* arena, uint32_t size);
+
+/*
+ * @brief: 记录当前位置，之后可用 aegis_scratch_arena_release 回退（嵌套作用域内的临时对象）
+ * @return: 回退标记（arena 为 NULL 时为0）
+ * @req: REQ-SCRATCH-003
+ * @design: DES-SCRATCH-003
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisScratchArenaMark aegis_scratch_arena_mark(const AegisScratchArena* arena);
+
+/*
+ * @brief: 回退到标记处，释放标记之后分配的全部内存
+ * @param mark: aegis_scratch_arena_mark 的返回值
+ * @return: 错误码；标记超出当前已用范围返回 ERR_OUT_OF_RANGE
+ * @req: REQ-SCRATCH-004
+ * @design: DES-SCRATCH-004
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_scratch_arena_release(AegisScratchArena* arena, AegisScratchArenaMark mark);
+
+/*
+ * @brief: 整体复位（释放全部分配，清零本轮峰值；high_water 保留）
+ * @return: 错误码
+ * @req: REQ-SCRATCH-005
+ * @design: DES-SCRATCH-005
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_scratch_arena_reset(AegisScratchArena* arena);
+
+/*
+ * @brief: 获取使用统计
+ * @return: 错误码
+ * @req: REQ-SCRATCH-006
+ * @design: DES-SCRATCH-006
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_scratch_arena_get_stats(const AegisScratchArena* arena, AegisScratchArenaStats* stats);
+
+/* 按类型分配单个临时对象 */
+#define SCRATCH_NEW(arena, Type)  ((Type*)aegis_scratch_arena_alloc((arena), (uint32_t)sizeof(Type)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCRATCH_ARENA_H */
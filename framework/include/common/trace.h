@@ -39,6 +39,7 @@ typedef enum {
     TRACE_EVENT_DOMAIN_ERR  = 6,    /* 领域错误 */
     TRACE_EVENT_APP_ERROR   = 7,    /* 应用错误 */
     TRACE_EVENT_SYSTEM_ERROR= 8,    /* 系统错误 */
+    TRACE_EVENT_MEM_CORRUPT = 9,    /* 内存块魔法数损坏（trace_id=分配文件，param1=分配行号） */
     TRACE_EVENT_MAX         = 255
 } AegisTraceEventType;
 
@@ -66,7 +67,7 @@ typedef struct {
 
 typedef struct {
     AegisRingBuffer ring;
-    uint8_t buffer[TRACE_LOG_SIZE * sizeof(AegisTraceEvent)];
+    uint8_t buffer[RING_BUFFER_STORAGE_SIZE(TRACE_LOG_SIZE * sizeof(AegisTraceEvent))];
     AegisTraceClock clock;
     uint32_t fallback_tick;
     bool_t is_initialized;
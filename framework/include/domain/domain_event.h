@@ -14,6 +14,8 @@
 #include "error_codes.h"
 #include "domain_entity.h"
 #include "trace.h"
+#include "dispatch_index.h"
+#include "object_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +38,14 @@ extern "C" {
 #define MAX_EVENT_RECURSION_DEPTH   3       /* 最大事件递归深度（防止死循环） */
 #endif
 
+#ifndef DOMAIN_EVENT_INFLIGHT_MAX
+#define DOMAIN_EVENT_INFLIGHT_MAX   (MAX_EVENT_RECURSION_DEPTH + 2)  /* 同时处于 reserve~commit 之间的事件数（嵌套发布 + ISR） */
+#endif
+
+/* 事件槽位总数：异步队列与历史记录引用同一批槽位，槽位在两者都不再引用时回收 */
+#define DOMAIN_EVENT_SLOT_COUNT \
+    (DOMAIN_EVENT_QUEUE_SIZE + DOMAIN_EVENT_HISTORY_SIZE + DOMAIN_EVENT_INFLIGHT_MAX)
+
 /* ==================== 事件ID和类型 ==================== */
 typedef uint16_t AegisDomainEventId;
 
@@ -74,6 +84,18 @@ typedef struct {
     } data;
 } AegisDomainEvent;
 
+/*
+ * 领域事件对象池：需要在队列之外暂存事件（延迟发布、重试、跨上下文转交）时使用，
+ * 每槽位恰好一个 AegisDomainEvent。生成 aegis_domain_event_pool_init/alloc/free/get_stats。
+ * 事件队列本身不经过本池；只有业务侧定义了池实例才占用 RAM。
+ * @req: REQ-EVENT-014
+ * @isr_safe
+ */
+#ifndef DOMAIN_EVENT_POOL_SIZE
+#define DOMAIN_EVENT_POOL_SIZE  8U
+#endif
+AEGIS_OBJECT_POOL_DECLARE(AegisDomainEventPool, aegis_domain_event_pool, AegisDomainEvent, DOMAIN_EVENT_POOL_SIZE)
+
 /* ==================== 事件处理器 ==================== */
 /* 事件处理结果 */
 typedef enum {
@@ -94,9 +116,18 @@ typedef struct {
     uint8_t priority;               /* 优先级（0-255，数字越小优先级越高） */
 } AegisEventSubscription;
 
+/* 订阅者列表：sub_order[start .. start+count) 为同一 (事件类型, 同步/异步) 的订阅下标，按优先级升序 */
+typedef struct {
+    uint8_t start;
+    uint8_t count;
+} AegisEventSubscriberList;
+
+/* 事件类型 -> 订阅者列表 的索引桶数 */
+#define DOMAIN_EVENT_INDEX_SIZE  DISPATCH_INDEX_SIZE(MAX_EVENT_SUBSCRIPTIONS)
+
 /* ==================== 事件总线实例（严格依赖注入） ==================== */
 typedef struct {
-    AegisDomainEvent history[DOMAIN_EVENT_HISTORY_SIZE];
+    uint8_t slot[DOMAIN_EVENT_HISTORY_SIZE];    /* 历史事件所在槽位（不拷贝事件） */
     uint8_t head;
     uint8_t count;
 } AegisDomainEventHistory;
@@ -105,8 +136,25 @@ typedef struct {
     const AegisEventSubscription* subscriptions;
     uint8_t subscription_count;
 
-    AegisRingBuffer async_queue;
-    uint8_t async_queue_buffer[DOMAIN_EVENT_QUEUE_SIZE * sizeof(AegisDomainEvent)];
+    /* 订阅索引（init 时构建；下标 0=异步，1=同步）：发布只遍历匹配的订阅者 */
+    uint8_t sub_order[MAX_EVENT_SUBSCRIPTIONS];
+    AegisEventSubscriberList lists[MAX_EVENT_SUBSCRIPTIONS];
+    AegisEventSubscriberList wildcard[2];           /* event_type==0 的订阅者 */
+    uint16_t index_keys[2][DOMAIN_EVENT_INDEX_SIZE];
+    uint8_t index_slots[2][DOMAIN_EVENT_INDEX_SIZE];
+
+    /*
+     * 事件槽位：发布方 reserve 后原地构造，commit 后由历史记录与异步队列按下标引用，
+     * 异步处理器直接拿到槽位指针；两者都不再引用时槽位归还空闲栈。
+     */
+    AegisDomainEvent slots[DOMAIN_EVENT_SLOT_COUNT];
+    uint8_t slot_flags[DOMAIN_EVENT_SLOT_COUNT];
+    uint8_t free_slots[DOMAIN_EVENT_SLOT_COUNT];
+    uint8_t free_count;
+
+    uint8_t async_queue[DOMAIN_EVENT_QUEUE_SIZE];   /* 待异步处理的槽位（FIFO） */
+    uint8_t async_head;
+    uint8_t async_count;
 
     AegisDomainEventHistory history;
 
@@ -125,12 +173,13 @@ typedef struct {
 
 /* ==================== 事件总线接口 ==================== */
 /*
- * @brief: 初始化领域事件总线
+ * @brief: 初始化领域事件总线（按事件类型建立订阅索引，各类型订阅者按 priority 排序）
  * @param bus: 事件总线实例
  * @param trace: 追溯日志（可为NULL）
- * @param subscriptions: 事件订阅表（静态数组）
+ * @param subscriptions: 事件订阅表（静态数组，初始化后不得修改）
  * @param count: 订阅数量
  * @return: 错误码
+ * @note: 同一事件的订阅者按 priority 升序调用（通配订阅者参与排序），优先级相同时按订阅表顺序
  * @req: REQ-EVENT-001
  * @design: DES-EVENT-001
  * @asil: ASIL-B
@@ -146,7 +195,7 @@ AegisErrorCode aegis_domain_event_bus_init(AegisDomainEventBus* bus,
  * @param bus: 事件总线实例
  * @param event: 事件指针
  * @return: 错误码
- * @note: 同步订阅者会立即执行，异步订阅者会将事件入队
+ * @note: 同步订阅者会立即执行，异步订阅者会将事件入队（内部为 reserve + 拷贝 + commit）
  * @req: REQ-EVENT-002
  * @design: DES-EVENT-002
  * @asil: ASIL-B
@@ -154,11 +203,49 @@ AegisErrorCode aegis_domain_event_bus_init(AegisDomainEventBus* bus,
  */
 AegisErrorCode aegis_domain_event_publish(AegisDomainEventBus* bus, const AegisDomainEvent* event);
 
+/* ==================== 零拷贝发布接口 ==================== */
+/*
+ * @brief: 预留一个事件槽位（ISR安全；调用方原地填写后必须 commit 或 cancel）
+ * @param bus: 事件总线实例
+ * @param event: 输出槽位指针（事件头部已复位，custom_data 内容未定义）
+ * @return: 错误码，无空闲槽位返回 ERR_OUT_OF_RANGE
+ * @req: REQ-EVENT-011
+ * @design: DES-EVENT-011
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_domain_event_reserve(AegisDomainEventBus* bus, AegisDomainEvent** event);
+
+/*
+ * @brief: 提交预留的事件（ISR安全；分配事件ID、记入历史、同步分发并入异步队列）
+ * @param bus: 事件总线实例
+ * @param event: reserve 返回的槽位指针
+ * @return: 错误码，异步队列满时事件仅不入队，仍返回 ERR_OK（同 publish）
+ * @req: REQ-EVENT-012
+ * @design: DES-EVENT-012
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_domain_event_commit(AegisDomainEventBus* bus, AegisDomainEvent* event);
+
+/*
+ * @brief: 放弃预留的事件槽位（ISR安全）
+ * @param bus: 事件总线实例
+ * @param event: reserve 返回的槽位指针
+ * @return: 错误码
+ * @req: REQ-EVENT-013
+ * @design: DES-EVENT-013
+ * @asil: ASIL-B
+ * @isr_safe
+ */
+AegisErrorCode aegis_domain_event_cancel(AegisDomainEventBus* bus, AegisDomainEvent* event);
+
 /*
  * @brief: 处理异步事件队列（主循环调用）
  * @param bus: 事件总线实例
  * @param max_events: 本次最多处理的事件数量（0=处理所有）
  * @return: 实际处理的事件数量
+ * @note: 异步处理器收到的是槽位指针，处理期间槽位保持有效
  * @req: REQ-EVENT-003
  * @design: DES-EVENT-003
  * @asil: ASIL-B
@@ -185,7 +272,7 @@ AegisErrorCode aegis_domain_event_get_stats(const AegisDomainEventBus* bus,
  * @brief: 获取事件历史记录（用于事件溯源）
  * @param bus: 事件总线实例
  * @param index: 事件索引（0=最新，1=次新，...）
- * @return: 事件指针，失败返回 NULL
+ * @return: 事件指针（指向事件槽位，槽位被回收复用后内容会变化），失败返回 NULL
  * @req: REQ-EVENT-005
  * @design: DES-EVENT-005
  * @asil: ASIL-B
@@ -26,6 +26,11 @@ typedef struct AegisDomainRepositoryReadInterface AegisDomainRepositoryReadInter
 
 struct AegisDomainRepositoryReadInterface {
     void* ctx;
+
+    /*
+     * 返回仓储内部存储的指针，只读：直接改写会绕过 snapshot 的版本校验与持久化日志。
+     * 修改实体须先拷贝（snapshot），在副本上修改后经写接口 update/update_payload 写回。
+     */
     AegisErrorCode (*get)(const AegisDomainRepositoryReadInterface* self,
                      AegisEntityId entity_id,
                      AegisDomainEntity** entity);
@@ -37,6 +42,15 @@ struct AegisDomainRepositoryReadInterface {
     AegisErrorCode (*count_by_type)(const AegisDomainRepositoryReadInterface* self,
                                AegisEntityType entity_type,
                                uint8_t* count);
+
+    /*
+     * 可选（可为NULL）：把实体拷贝到调用方缓冲区（版本校验的乐观读，不关中断）。
+     * 与 get 返回的指针不同，拷贝结果不受之后的 update/delete/compact 影响；
+     * 连续遇到并发写入超过实现的重试上限时返回 ERR_BUSY。
+     */
+    AegisErrorCode (*snapshot)(const AegisDomainRepositoryReadInterface* self,
+                               AegisEntityId entity_id,
+                               AegisDomainEntity* out);
 };
 
 #ifdef __cplusplus
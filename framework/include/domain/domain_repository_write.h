@@ -16,6 +16,20 @@
 extern "C" {
 #endif
 
+/* 批量写操作类型 */
+typedef enum {
+    DOMAIN_REPOSITORY_OP_CREATE = 0,
+    DOMAIN_REPOSITORY_OP_UPDATE = 1,
+    DOMAIN_REPOSITORY_OP_DELETE = 2
+} AegisDomainRepositoryOpKind;
+
+/* 批量写操作项：create/update 使用 entity（成功后回写ID与时间戳），delete 使用 entity_id */
+typedef struct {
+    AegisDomainRepositoryOpKind kind;
+    AegisDomainEntity* entity;
+    AegisEntityId entity_id;
+} AegisDomainRepositoryOp;
+
 /*
  * @brief: 写仓储接口（包含读接口 + 写操作）
  * @note: AegisCommand 侧依赖此接口；严格DDD下事件由领域层产生并发布，仓储只负责持久化。
@@ -29,6 +43,33 @@ struct AegisDomainRepositoryWriteInterface {
     AegisErrorCode (*create)(const AegisDomainRepositoryWriteInterface* self, AegisDomainEntity* entity);
     AegisErrorCode (*update)(const AegisDomainRepositoryWriteInterface* self, AegisDomainEntity* entity);
     AegisErrorCode (*delete_entity)(const AegisDomainRepositoryWriteInterface* self, AegisEntityId entity_id);
+
+    /*
+     * 可选（可为NULL）：增量压缩删除留下的空洞，每次最多处理 budget 步；
+     * remaining 输出剩余空洞数。压缩可能移动实体，调用时不得持有 get/find_by_type 返回的指针。
+     */
+    AegisErrorCode (*compact)(const AegisDomainRepositoryWriteInterface* self, uint16_t budget, uint16_t* remaining);
+
+    /*
+     * 可选（可为NULL）：按顺序执行一批写操作，全部成功或全部不生效。
+     * 整批共用一个时间戳与一次临界区；同一实体ID在一批中最多出现一次。
+     * 失败时 failed_index（可为NULL）输出首个不合法操作的下标。
+     */
+    AegisErrorCode (*apply_batch)(const AegisDomainRepositoryWriteInterface* self,
+                                  AegisDomainRepositoryOp* ops,
+                                  uint8_t count,
+                                  uint8_t* failed_index);
+
+    /*
+     * 可选（可为NULL）：只覆盖 payload 的 [offset, offset + len) 区间并刷新 updated_at，
+     * 不拷贝整个实体；写入超出当前 payload_size 时扩展 payload_size，
+     * offset 越过当前 payload_size 时其间的字节清零。
+     */
+    AegisErrorCode (*update_payload)(const AegisDomainRepositoryWriteInterface* self,
+                                     AegisEntityId entity_id,
+                                     uint16_t offset,
+                                     const void* data,
+                                     uint16_t len);
 };
 
 #ifdef __cplusplus
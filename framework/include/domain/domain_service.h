@@ -12,6 +12,7 @@
 
 #include "types.h"
 #include "error_codes.h"
+#include "dispatch_index.h"
 #include "domain_entity.h"
 
 #ifdef __cplusplus
@@ -57,9 +58,14 @@ typedef struct {
     void* ctx;
 } AegisDomainServiceHandlerEntry;
 
+#define DOMAIN_SERVICE_INDEX_SIZE  DISPATCH_INDEX_SIZE(DOMAIN_SERVICE_MAX_HANDLERS)
+
 typedef struct {
     AegisDomainServiceHandlerEntry handlers[DOMAIN_SERVICE_MAX_HANDLERS];
+    uint16_t index_keys[DOMAIN_SERVICE_INDEX_SIZE];
+    uint8_t index_slots[DOMAIN_SERVICE_INDEX_SIZE];
     uint8_t handler_count;
+    bool_t is_sealed;
 } AegisDomainService;
 
 /*
@@ -72,6 +78,16 @@ typedef struct {
  */
 AegisErrorCode aegis_domain_service_init(AegisDomainService* service);
 
+/*
+ * @brief: 封存领域服务注册表（之后注册返回 ERR_INVALID_STATE，分发查找不再进入临界区）
+ * @return: 错误码
+ * @req: REQ-DOMAIN-084
+ * @design: DES-DOMAIN-084
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_domain_service_seal(AegisDomainService* service);
+
 /*
  * @brief: 注册领域服务处理器
  * @param op: 操作类型
@@ -31,7 +31,8 @@ extern "C" {
 AegisErrorCode aegis_entry_main_loop(AegisEntryRuntime* runtime);
 
 /*
- * @brief: 主循环单次迭代（用于单元测试）
+ * @brief: 主循环单次迭代（按 runtime->budget 批量处理，统计写入 runtime->last_stats；结束时整体复位 runtime->scratch，
+ *         预算未耗尽时增量巡检一批内存池块）
  * @param runtime: 入口运行时实例
  * @return: 错误码
  * @req: REQ-ENTRY-012
@@ -41,6 +42,21 @@ AegisErrorCode aegis_entry_main_loop(AegisEntryRuntime* runtime);
  */
 AegisErrorCode aegis_entry_main_loop_once(AegisEntryRuntime* runtime);
 
+/*
+ * @brief: 按预算批量处理命令与异步事件（命令/事件配比随两个队列的积压深度自适应）
+ * @param runtime: 入口运行时实例
+ * @param budget: 本次迭代预算（NULL=使用 runtime->budget）
+ * @param stats: 输出本次迭代统计（可为NULL）
+ * @return: 错误码
+ * @req: REQ-ENTRY-013
+ * @design: DES-ENTRY-013
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_entry_main_loop_step(AegisEntryRuntime* runtime,
+                                          const AegisEntryBudget* budget,
+                                          AegisEntryLoopStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
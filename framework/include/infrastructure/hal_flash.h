@@ -0,0 +1,108 @@
+/*
+ * @file: aegis_hal_flash.h
+ * @brief: Flash 存储硬件抽象层接口（按页擦除的 NOR Flash）
+ * @author: jack liu
+ * @req: REQ-HAL-020
+ * @design: DES-HAL-020
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 语义按片上 NOR Flash 约定：擦除以页为单位，擦除后每字节为 HAL_FLASH_ERASED_BYTE；
+ *   编程只能把位从1写为0，且地址/长度须按 program_unit 对齐。
+ * - 地址为 Flash 区域内的偏移（0 ~ page_size * page_count - 1），与物理地址无关。
+ * - 与 GPIO/定时器不同，Flash 以设备句柄（函数表 + ctx）交给使用方，便于持久化仓储等模块依赖注入，
+ *   也便于测试替换；句柄由各平台 port 的 aegis_hal_flash_init() 填充。
+ * - x86_sim：以内存映射的文件模拟（文件不存在时创建并填充为已擦除状态），编程时按位与写入，
+ *   并可注入掉电点（aegis_hal_flash_sim_set_power_cut）；
+ *   stm32f030：寄存器级半字编程（调用期间 CPU 取指停顿，不可在 ISR 中调用）。
+ */
+
+#ifndef HAL_FLASH_H
+#define HAL_FLASH_H
+
+#include "types.h"
+#include "error_codes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_FLASH_ERASED_BYTE  0xFFU
+
+/* ==================== Flash 设备句柄 ==================== */
+typedef struct AegisHalFlash AegisHalFlash;
+
+struct AegisHalFlash {
+    void* ctx;                      /* 平台私有（x86_sim：映射基址；MCU：区域起始地址） */
+    uint32_t page_size;             /* 页大小（字节，擦除单位） */
+    uint16_t page_count;            /* 页数 */
+    uint8_t program_unit;           /* 最小编程单位（字节） */
+
+    AegisErrorCode (*read)(const AegisHalFlash* self, uint32_t addr, void* buf, uint32_t len);
+    AegisErrorCode (*program)(const AegisHalFlash* self, uint32_t addr, const void* data, uint32_t len);
+    AegisErrorCode (*erase_page)(const AegisHalFlash* self, uint16_t page);
+};
+
+/* ==================== Flash 配置 ==================== */
+typedef struct {
+    const char* backing_path;       /* x86_sim：后备文件路径；MCU 忽略 */
+    uint32_t base_addr;             /* MCU：区域起始物理地址（页对齐）；x86_sim 忽略 */
+    uint32_t page_size;             /* 页大小（MCU 须与芯片页大小一致） */
+    uint16_t page_count;            /* 页数 */
+} AegisHalFlashConfig;
+
+/* ==================== Flash 接口 ==================== */
+/*
+ * @brief: 打开 Flash 区域并填充设备句柄
+ * @param flash: 输出设备句柄
+ * @param config: 区域配置
+ * @return: 错误码（配置非法返回 ERR_INVALID_PARAM，后备存储不可用返回 ERR_HAL_ERROR）
+ * @req: REQ-HAL-021
+ * @design: DES-HAL-021
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_hal_flash_init(AegisHalFlash* flash, const AegisHalFlashConfig* config);
+
+/*
+ * @brief: 关闭 Flash 区域（x86_sim 同步并解除文件映射；MCU 重新上锁）
+ * @param flash: 设备句柄
+ * @return: 错误码
+ * @req: REQ-HAL-022
+ * @design: DES-HAL-022
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_hal_flash_deinit(AegisHalFlash* flash);
+
+/* ==================== x86_sim 掉电注入（仅仿真平台实现） ==================== */
+#define HAL_FLASH_SIM_POWER_CUT_OFF  0xFFFFFFFFU
+
+/*
+ * @brief: 设置掉电点：再写入 after_bytes 字节（编程按字节、擦除按整页计）后模拟掉电
+ * @param after_bytes: 掉电前允许写入的字节数（HAL_FLASH_SIM_POWER_CUT_OFF=关闭注入并恢复供电）
+ * @note: 掉电时正在进行的编程/擦除只完成前一部分字节并返回 ERR_HAL_ERROR；
+ *        之后所有编程/擦除均返回 ERR_HAL_ERROR（读取不受影响），直到再次调用本函数。
+ *        用于验证任意写入位置掉电后的恢复，MCU 平台不提供。
+ * @req: REQ-HAL-023
+ * @design: DES-HAL-023
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+void aegis_hal_flash_sim_set_power_cut(uint32_t after_bytes);
+
+/*
+ * @brief: 查询上次设置掉电点以来是否已发生模拟掉电
+ * @return: TRUE=已掉电
+ * @req: REQ-HAL-024
+ * @design: DES-HAL-024
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+bool_t aegis_hal_flash_sim_power_lost(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_FLASH_H */
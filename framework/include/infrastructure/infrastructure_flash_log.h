@@ -0,0 +1,253 @@
+/*
+ * @file: infrastructure_flash_log.h
+ * @brief: Infrastructure 层 - Flash 追加日志（页轮转 + CRC 记录 + 检查点）
+ * @author: jack liu
+ * @req: REQ-INFRA-020
+ * @design: DES-INFRA-020
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - Flash 区域按页组成环：每页以页头开始（魔数、页序号、写入时的尾指针、布局版本、CRC），
+ *   其后顺序追加记录；记录不跨页，放不下时打开下一页（擦除后写页头）。
+ * - 记录 = 8 字节记录头（类型、标志、长度、CRC-32）+ 数据，按 FLASH_LOG_ALIGN 对齐；
+ *   CRC 覆盖类型/标志/长度/数据，掉电写了一半的记录校验失败，挂载时视为日志结尾。
+ * - 尾指针（tail）之前的页可回收：检查点提交（CKPT_END 记录）后尾指针前移到检查点起点；
+ *   挂载时从最新页头记录的尾指针开始扫描，遇到更新的 CKPT_END 即前移尾指针，扫描长度不超过整个区域。
+ * - 记录组：带 FLASH_LOG_FLAG_GROUP 的连续记录以 COMMIT 记录结束时才算生效；
+ *   挂载时若日志以未结束的组收尾（掉电），自动追加 ABORT，重放方据此整组丢弃。
+ * - 挂载发现结尾之后的区域不是已擦除状态（写入中掉电）时，下一条记录改写到新页，不在脏区域上编程。
+ * - 预擦除：aegis_infrastructure_flash_log_erase_ahead() 在主循环空闲时擦除写入页之后的空闲页，
+ *   追加记录换页时只写页头；预擦除不足时才在追加路径上同步擦除（计入 erases_inline）。
+ * - 磨损均衡：页严格按环形顺序重用，各页擦除次数之差不超过1，无需额外的映射表。
+ * - 本模块不加锁，只能在主循环上下文使用（擦除/编程期间 MCU 取指停顿）。
+ */
+
+#ifndef INFRASTRUCTURE_FLASH_LOG_H
+#define INFRASTRUCTURE_FLASH_LOG_H
+
+#include "types.h"
+#include "error_codes.h"
+#include "hal_flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_LOG_ALIGN          8U     /* 记录对齐（Flash 编程单位须整除该值） */
+#define FLASH_LOG_PAGE_HEADER    24U    /* 页头字节数 */
+#define FLASH_LOG_RECORD_HEADER  8U     /* 记录头字节数 */
+
+#ifndef FLASH_LOG_DATA_MAX
+#define FLASH_LOG_DATA_MAX       120U   /* 单条记录数据上限（字节，记录缓冲区在栈上） */
+#endif
+
+/* 数据长度为 len 的记录在 Flash 中占用的字节数 */
+#define FLASH_LOG_RECORD_SPAN(len) \
+    ((FLASH_LOG_RECORD_HEADER + (uint32_t)(len) + FLASH_LOG_ALIGN - 1U) & ~(uint32_t)(FLASH_LOG_ALIGN - 1U))
+
+/* 保留记录类型（使用方记录类型取 0x01 ~ 0xEF；0xFF 为已擦除） */
+#define FLASH_LOG_KIND_COMMIT      0xF0U   /* 结束并提交前面的记录组 */
+#define FLASH_LOG_KIND_ABORT       0xF1U   /* 结束并丢弃前面的记录组 */
+#define FLASH_LOG_KIND_CKPT_BEGIN  0xF2U   /* 检查点起点（数据由使用方定义） */
+#define FLASH_LOG_KIND_CKPT_END    0xF3U   /* 检查点结束（数据为起点位置，提交后尾指针前移） */
+
+#define FLASH_LOG_FLAG_GROUP       0x01U   /* 记录属于未结束的记录组 */
+
+#ifndef FLASH_LOG_ERASE_AHEAD
+#define FLASH_LOG_ERASE_AHEAD      2U      /* 预擦除目标页数（写入页之后保持已擦除的空闲页） */
+#endif
+
+/* 日志位置 */
+typedef struct {
+    uint32_t seq;       /* 页序号（单调递增，页被重用时取新值） */
+    uint32_t offset;    /* 页内偏移 */
+    uint16_t page;      /* 物理页号 */
+} AegisInfrastructureFlashLogPos;
+
+/* 读出的记录 */
+typedef struct {
+    uint8_t kind;
+    uint8_t flags;
+    uint16_t len;
+} AegisInfrastructureFlashLogRecord;
+
+/* 运行统计（挂载/格式化后累计） */
+typedef struct {
+    uint32_t records;                       /* 追加的记录数 */
+    uint32_t bytes;                         /* 编程的字节数（含记录头、对齐填充与页头） */
+    uint32_t pages_opened;                  /* 打开的新页数 */
+    uint32_t erases;                        /* 页擦除次数（含预擦除与格式化） */
+    uint32_t erases_inline;                 /* 在追加路径上同步完成的擦除次数 */
+} AegisInfrastructureFlashLogStats;
+
+typedef struct {
+    const AegisHalFlash* flash;
+    uint16_t layout;                        /* 使用方记录布局版本（写入页头，挂载时校验） */
+
+    AegisInfrastructureFlashLogPos tail;    /* 最旧的有效记录 */
+    AegisInfrastructureFlashLogPos head;    /* 下一条记录的写入位置（offset == page_size 表示须换页） */
+    AegisInfrastructureFlashLogPos ckpt;    /* 进行中的检查点起点 */
+
+    uint16_t erased_ahead;                  /* 写入页之后已预擦除的页数 */
+    AegisInfrastructureFlashLogStats stats;
+
+    bool_t ckpt_open;
+    bool_t is_mounted;
+} AegisInfrastructureFlashLog;
+
+/*
+ * @brief: 绑定 Flash 设备（不访问 Flash）
+ * @param log: 日志实例
+ * @param flash: Flash 设备句柄（生命周期须覆盖日志实例）
+ * @param layout: 使用方记录布局版本（布局变化时须修改，以免误读旧数据）
+ * @return: 错误码（页数 < 2、页放不下最大记录或编程单位不整除 FLASH_LOG_ALIGN 时返回 ERR_INVALID_PARAM）
+ * @req: REQ-INFRA-020
+ * @design: DES-INFRA-020
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_init(AegisInfrastructureFlashLog* log,
+                                                   const AegisHalFlash* flash,
+                                                   uint16_t layout);
+
+/*
+ * @brief: 挂载：定位最新页、恢复尾指针与写入位置，必要时补写 ABORT；空白 Flash 自动格式化
+ * @param log: 日志实例
+ * @return: 错误码（布局版本不符或页链不连续返回 ERR_INVALID_STATE，此时可调用 format 清空）
+ * @req: REQ-INFRA-021
+ * @design: DES-INFRA-021
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_mount(AegisInfrastructureFlashLog* log);
+
+/*
+ * @brief: 格式化：擦除整个区域并写入第一页页头
+ * @param log: 日志实例
+ * @return: 错误码
+ * @req: REQ-INFRA-021
+ * @design: DES-INFRA-021
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_format(AegisInfrastructureFlashLog* log);
+
+/*
+ * @brief: 追加一条记录
+ * @param log: 日志实例
+ * @param kind: 记录类型
+ * @param flags: 记录标志（FLASH_LOG_FLAG_*）
+ * @param data: 数据（len 为 0 时可为 NULL）
+ * @param len: 数据长度（<= FLASH_LOG_DATA_MAX）
+ * @return: 错误码（所有页都在尾指针之后时返回 ERR_DOMAIN_FULL）
+ * @req: REQ-INFRA-022
+ * @design: DES-INFRA-022
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_append(AegisInfrastructureFlashLog* log,
+                                                     uint8_t kind,
+                                                     uint8_t flags,
+                                                     const void* data,
+                                                     uint16_t len);
+
+/*
+ * @brief: 取得从尾指针开始的遍历游标
+ * @param log: 日志实例
+ * @param cursor: 输出游标
+ * @return: 错误码
+ * @req: REQ-INFRA-023
+ * @design: DES-INFRA-023
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_cursor(const AegisInfrastructureFlashLog* log,
+                                                     AegisInfrastructureFlashLogPos* cursor);
+
+/*
+ * @brief: 读取游标处的记录并推进游标
+ * @param log: 日志实例
+ * @param cursor: 遍历游标
+ * @param record: 输出记录类型/标志/长度
+ * @param buf: 输出记录数据
+ * @param buf_size: 缓冲区大小（须 >= FLASH_LOG_DATA_MAX）
+ * @return: ERR_OK=读到一条记录，ERR_EMPTY=已到日志结尾
+ * @req: REQ-INFRA-023
+ * @design: DES-INFRA-023
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_read(const AegisInfrastructureFlashLog* log,
+                                                   AegisInfrastructureFlashLogPos* cursor,
+                                                   AegisInfrastructureFlashLogRecord* record,
+                                                   void* buf,
+                                                   uint16_t buf_size);
+
+/*
+ * @brief: 开始检查点：追加 CKPT_BEGIN 并记住其位置（未提交的检查点可直接重新开始）
+ * @param log: 日志实例
+ * @param data: CKPT_BEGIN 记录数据
+ * @param len: 数据长度
+ * @return: 错误码
+ * @req: REQ-INFRA-024
+ * @design: DES-INFRA-024
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_checkpoint_begin(AegisInfrastructureFlashLog* log,
+                                                               const void* data,
+                                                               uint16_t len);
+
+/*
+ * @brief: 提交检查点：追加 CKPT_END，尾指针前移到检查点起点，之前的页可被回收
+ * @param log: 日志实例
+ * @return: 错误码（没有进行中的检查点返回 ERR_INVALID_STATE）
+ * @req: REQ-INFRA-024
+ * @design: DES-INFRA-024
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_checkpoint_commit(AegisInfrastructureFlashLog* log);
+
+/*
+ * @brief: 查询可写入的空闲页数（不含当前写入页）
+ * @param log: 日志实例
+ * @return: 空闲页数（未挂载时为0）
+ * @req: REQ-INFRA-025
+ * @design: DES-INFRA-025
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+uint16_t aegis_infrastructure_flash_log_free_pages(const AegisInfrastructureFlashLog* log);
+
+/*
+ * @brief: 预擦除写入页之后的空闲页，直到已擦除页数达到 FLASH_LOG_ERASE_AHEAD 或遇到尾指针
+ * @param log: 日志实例
+ * @param max_pages: 本次最多擦除的页数（0=不限）
+ * @return: 错误码
+ * @note: 在主循环命令处理之间调用，使擦除不落在命令路径上；重新挂载后预擦除状态清零。
+ * @req: REQ-INFRA-026
+ * @design: DES-INFRA-026
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_erase_ahead(AegisInfrastructureFlashLog* log, uint16_t max_pages);
+
+/*
+ * @brief: 读取运行统计
+ * @param log: 日志实例
+ * @param stats: 输出统计
+ * @return: 错误码
+ * @req: REQ-INFRA-027
+ * @design: DES-INFRA-027
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_flash_log_get_stats(const AegisInfrastructureFlashLog* log,
+                                                        AegisInfrastructureFlashLogStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INFRASTRUCTURE_FLASH_LOG_H */
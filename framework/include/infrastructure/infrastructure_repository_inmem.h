@@ -19,6 +19,7 @@
 #include "domain_entity.h"
 #include "domain_repository_read.h"
 #include "domain_repository_write.h"
+#include "dispatch_index.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,12 +28,104 @@ extern "C" {
 typedef uint32_t (*InfrastructureNowMsFn)(void* ctx);
 
 #ifndef REPOSITORY_MAX_ENTITIES
-#define REPOSITORY_MAX_ENTITIES 32U
+#define REPOSITORY_MAX_ENTITIES 32U     /* 实体容量（上限 65534；x86_sim 网关可配置到数千） */
 #endif
 
+/*
+ * 槽位下标宽度：容量 <= 254 时默认 uint8_t（MCU 省 RAM），否则 uint16_t。
+ * 也可定义 REPOSITORY_SLOT_INDEX_16 强制使用 16 位下标。
+ */
+#if defined(REPOSITORY_SLOT_INDEX_16) || ((REPOSITORY_MAX_ENTITIES) > 254)
+typedef uint16_t AegisInfrastructureRepositorySlot;
+#define REPOSITORY_SLOT_NONE  ((AegisInfrastructureRepositorySlot)0xFFFFU)
+#else
+typedef uint8_t AegisInfrastructureRepositorySlot;
+#define REPOSITORY_SLOT_NONE  ((AegisInfrastructureRepositorySlot)0xFFU)
+#endif
+
+/* 实体ID -> 槽位 的开放寻址索引桶数（2的幂，>= 2 倍容量） */
+#define REPOSITORY_INDEX_SIZE  DISPATCH_INDEX_SIZE(REPOSITORY_MAX_ENTITIES)
+
+/*
+ * 存储布局：
+ * - 0（默认）：按类型维护侵入式链表，count_by_type O(1)、find_by_type O(k)，类型数受 REPOSITORY_MAX_TYPES 限制；
+ * - 1（SoA）：实体类型另存一份稠密数组 hot_type（空闲槽位为 ENTITY_TYPE_INVALID），
+ *   按类型查询由 key_filter 过滤核逐块（32个）比较该数组（每实体2字节，x86 上为 SSE2/AVX2），
+ *   只有命中时才访问实体槽位；类型数不受限，适合 x86_sim/网关等大容量构建。
+ * 两种布局下 get/find_by_type 返回的均为实体槽位指针（接口要求头部与 payload 连续）。
+ */
+#ifndef REPOSITORY_LAYOUT_SOA
+#define REPOSITORY_LAYOUT_SOA  0
+#endif
+
+#ifndef REPOSITORY_MAX_TYPES
+#define REPOSITORY_MAX_TYPES   16U      /* 可同时存在的实体类型数（上限 254；SoA 布局不使用） */
+#endif
+
+#define REPOSITORY_TYPE_INDEX_SIZE  DISPATCH_INDEX_SIZE(REPOSITORY_MAX_TYPES)
+
+#ifndef REPOSITORY_BATCH_MAX
+#define REPOSITORY_BATCH_MAX  32U   /* apply_batch 单批最多操作数（校验状态在栈上，关中断时间随批大小线性增长） */
+#endif
+
+/*
+ * 每实体脏位图（uint16_t）：payload 按 REPOSITORY_DIRTY_CHUNK 字节分块，第 i 位表示第 i 块被修改；
+ * REPOSITORY_DIRTY_HEADER 表示整体写入（create/update，含类型/状态等头部字段）。
+ * 持久化/变更捕获（CDC）消费者通过 aegis_infrastructure_repository_inmem_take_dirty() 只处理修改过的区间。
+ */
+#define REPOSITORY_DIRTY_CHUNK   8U
+#define REPOSITORY_DIRTY_HEADER  ((uint16_t)0x8000U)
+#define REPOSITORY_DIRTY_ALL     ((uint16_t)0xFFFFU)
+
+#ifndef REPOSITORY_SNAPSHOT_RETRY_MAX
+#define REPOSITORY_SNAPSHOT_RETRY_MAX  8U   /* snapshot 遇到并发写入时的最大重试次数（保证读端耗时有界） */
+#endif
+
+/* 按类型的实体链表（侵入式双向链表，节点为 type_next/type_prev） */
+typedef struct {
+    AegisEntityType type;
+    AegisInfrastructureRepositorySlot head;
+    AegisInfrastructureRepositorySlot tail;
+    AegisInfrastructureRepositorySlot count;
+    uint8_t pending;            /* 已登记（prepare）尚未链接的次数：批量校验期间不可被复用 */
+} AegisInfrastructureRepositoryTypeList;
+
 typedef struct {
     AegisDomainEntity entity_pool[REPOSITORY_MAX_ENTITIES];
-    uint8_t entity_count;
+    AegisInfrastructureRepositorySlot entity_count;   /* 已使用槽位区间 [0, entity_count)，含待压缩的空洞 */
+
+    /* 空闲槽位栈：删除时入栈、创建时优先复用；free_pos 记录槽位在栈中的位置，供压缩 O(1) 摘除 */
+    AegisInfrastructureRepositorySlot free_slots[REPOSITORY_MAX_ENTITIES];
+    AegisInfrastructureRepositorySlot free_pos[REPOSITORY_MAX_ENTITIES];
+    AegisInfrastructureRepositorySlot free_count;
+
+    /* 实体ID索引（线性探测，删除时回移，无墓碑）：get/update/delete 为 O(1) */
+    AegisEntityId index_ids[REPOSITORY_INDEX_SIZE];
+    AegisInfrastructureRepositorySlot index_slots[REPOSITORY_INDEX_SIZE];
+
+    /*
+     * 顺序锁版本号（奇数=写入中）：写端在临界区内修改前后各加1，读端 snapshot 乐观拷贝后校验版本，
+     * 冲突时重试，不关中断、也不阻塞写端。slot_seq 保护对应槽位，index_seq 保护实体ID索引。
+     */
+    volatile uint32_t slot_seq[REPOSITORY_MAX_ENTITIES];
+    volatile uint32_t index_seq;
+
+    /* 每槽位脏位图（见 REPOSITORY_DIRTY_*），take_dirty 读取后清零 */
+    uint16_t dirty[REPOSITORY_MAX_ENTITIES];
+
+#if REPOSITORY_LAYOUT_SOA
+    /* 热字段稠密数组：按类型扫描时只读此数组 */
+    AegisEntityType hot_type[REPOSITORY_MAX_ENTITIES];
+#else
+    /* 类型二级索引：count_by_type 为 O(1)，find_by_type 为 O(k)；类型表满时复用已排空的表项 */
+    AegisInfrastructureRepositoryTypeList type_lists[REPOSITORY_MAX_TYPES];
+    uint8_t type_count;
+    uint16_t type_index_keys[REPOSITORY_TYPE_INDEX_SIZE];
+    uint8_t type_index_slots[REPOSITORY_TYPE_INDEX_SIZE];
+    AegisInfrastructureRepositorySlot type_next[REPOSITORY_MAX_ENTITIES];
+    AegisInfrastructureRepositorySlot type_prev[REPOSITORY_MAX_ENTITIES];
+#endif
+
     AegisEntityId next_entity_id;
     bool_t is_initialized;
 
@@ -77,6 +170,55 @@ const AegisDomainRepositoryReadInterface* aegis_infrastructure_repository_inmem_
  */
 const AegisDomainRepositoryWriteInterface* aegis_infrastructure_repository_inmem_write(AegisInfrastructureRepositoryInmem* repo);
 
+/*
+ * @brief: 增量压缩：把尾部实体移入空洞并收缩已使用区间，使扫描不再遍历已删除槽位
+ * @param repo: 仓储实例
+ * @param budget: 本次最多处理的步数（每步一次实体搬移或尾部收缩，0=处理全部）
+ * @param remaining: 输出剩余空洞数（可为NULL）
+ * @return: 错误码
+ * @note: 每步单独进入临界区；压缩会移动实体，调用时不得持有 get/find_by_type 返回的指针
+ *        （在主循环命令/事件处理之间调用）。
+ * @req: REQ-INFRA-013
+ * @design: DES-INFRA-013
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_repository_inmem_compact(AegisInfrastructureRepositoryInmem* repo,
+                                                             uint16_t budget,
+                                                             uint16_t* remaining);
+
+/*
+ * @brief: 按槽位顺序取出下一个有修改的实体及其脏位图，并清零该位图
+ * @param repo: 仓储实例
+ * @param cursor: 遍历游标（从0开始，由本函数推进）
+ * @param entity_id: 输出实体ID
+ * @param mask: 输出脏位图（REPOSITORY_DIRTY_*）
+ * @return: ERR_OK=取到一个实体，ERR_NOT_FOUND=本轮遍历结束
+ * @note: 每个槽位单独进入临界区；遍历期间被压缩搬到游标之前的实体留到下一轮。
+ * @req: REQ-INFRA-014
+ * @design: DES-INFRA-014
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_repository_inmem_take_dirty(AegisInfrastructureRepositoryInmem* repo,
+                                                                uint16_t* cursor,
+                                                                AegisEntityId* entity_id,
+                                                                uint16_t* mask);
+
+/*
+ * @brief: 按原样写入实体（不存在则创建，存在则覆盖），用于从持久化副本恢复
+ * @param repo: 仓储实例
+ * @param entity: 实体（ID 须有效；created_at/updated_at 保持不变，不调用时间戳回调）
+ * @return: 错误码
+ * @note: 恢复后的实体不计入脏位图；next_entity_id 推进到该ID之后，避免之后自动分配时冲突。
+ * @req: REQ-INFRA-015
+ * @design: DES-INFRA-015
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_repository_inmem_restore(AegisInfrastructureRepositoryInmem* repo,
+                                                             const AegisDomainEntity* entity);
+
 #ifdef __cplusplus
 }
 #endif
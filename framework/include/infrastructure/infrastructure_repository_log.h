@@ -0,0 +1,120 @@
+/*
+ * @file: infrastructure_repository_log.h
+ * @brief: Infrastructure 层 - 持久化仓储（Flash 追加日志 + 周期检查点）
+ * @author: jack liu
+ * @req: REQ-INFRA-030
+ * @design: DES-INFRA-030
+ * @asil: ASIL-B
+ *
+ * @note:
+ * - 内存中的实体状态与查询完全复用内存仓储（mem 成员）；每次写操作先更新内存，再向 Flash 日志追加一条记录：
+ *   create/update 追加整实体（PUT），delete 追加实体ID（DEL），update_payload 只追加修改的区间（PATCH），
+ *   apply_batch 追加一组记录并以 COMMIT 结束，掉电时未结束的组在重放时整组丢弃。
+ * - 检查点：把当前全部实体写成一段快照（CKPT_BEGIN ... CKPT_END），提交后日志尾指针前移到快照起点，
+ *   旧页可回收。上次检查点之后的记录数达到 REPOSITORY_LOG_REPLAY_MAX / 2 时由 compact 钩子
+ *   （主循环空闲时）完成检查点并预擦除下一页，达到 REPOSITORY_LOG_REPLAY_MAX 或日志剩余空间不足时在写操作中同步完成。
+ * - 写接口的 init 即"挂载 + 重放"（app_init 在启动时调用）：从尾指针的快照开始重放，
+ *   重放记录数上界约为 实体容量 + REPOSITORY_LOG_REPLAY_MAX + REPOSITORY_BATCH_MAX，与运行时长无关。
+ * - 日志追加失败时从日志重新载入本次写操作涉及的实体（整批重新载入），写操作返回错误后读到的是最后一次
+ *   持久化的状态，与重启后一致；修改前的状态不取自内存，经 get() 指针直接改过的实体同样恢复
+ *   （记录已完整写入、只差对齐填充时掉电，该次修改已持久化：写操作返回错误，内存与重启后都包含该修改）。
+ * - Flash 写入失败后仓储进入故障态，拒绝后续写操作；再次 init 把内存状态恢复为最后一次持久化的状态。
+ * - 写操作与检查点会擦除/编程 Flash，只能在主循环上下文调用；读接口与内存仓储相同。
+ */
+
+#ifndef INFRASTRUCTURE_REPOSITORY_LOG_H
+#define INFRASTRUCTURE_REPOSITORY_LOG_H
+
+#include "types.h"
+#include "error_codes.h"
+#include "hal_flash.h"
+#include "infrastructure_flash_log.h"
+#include "infrastructure_repository_inmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef REPOSITORY_LOG_REPLAY_MAX
+#define REPOSITORY_LOG_REPLAY_MAX  256U     /* 两次检查点之间最多累积的记录数（限制上电重放时间） */
+#endif
+
+typedef struct {
+    AegisInfrastructureRepositoryInmem mem;     /* 必须为首个成员：读接口 ctx 即本实例地址 */
+    AegisInfrastructureFlashLog log;
+
+    uint16_t checkpoint_pages;                  /* 一次检查点最多占用的页数 */
+    uint16_t reserve_pages;                     /* 写操作前须保留的空闲页数（检查点 + 一个最大批次） */
+    uint16_t records_since_checkpoint;          /* 上次检查点之后追加的记录数 */
+    uint16_t replayed_records;                  /* 最近一次 init 重放的记录数 */
+
+    bool_t is_mounted;
+    bool_t is_faulted;
+
+    AegisDomainRepositoryWriteInterface write_if;
+} AegisInfrastructureRepositoryLog;
+
+/*
+ * @brief: 初始化持久化仓储实例（绑定 Flash，不访问 Flash；挂载与重放在写接口 init 中进行）
+ * @param repo: 仓储实例
+ * @param flash: Flash 设备句柄（生命周期须覆盖仓储实例）
+ * @param now_ms_fn: 时间戳回调（可为NULL，则使用0）
+ * @param now_ms_ctx: 时间戳回调上下文
+ * @return: 错误码（Flash 容量不足以容纳检查点与一个最大批次时返回 ERR_INVALID_PARAM）
+ * @req: REQ-INFRA-030
+ * @design: DES-INFRA-030
+ * @asil: ASIL-B
+ */
+AegisErrorCode aegis_infrastructure_repository_log_init(AegisInfrastructureRepositoryLog* repo,
+                                                        const AegisHalFlash* flash,
+                                                        InfrastructureNowMsFn now_ms_fn,
+                                                        void* now_ms_ctx);
+
+/*
+ * @brief: 获取读仓储接口（绑定到实例）
+ * @param repo: 仓储实例
+ * @return: 读仓储接口指针
+ * @req: REQ-INFRA-031
+ * @design: DES-INFRA-031
+ * @asil: ASIL-B
+ */
+const AegisDomainRepositoryReadInterface* aegis_infrastructure_repository_log_read(AegisInfrastructureRepositoryLog* repo);
+
+/*
+ * @brief: 获取写仓储接口（绑定到实例）
+ * @param repo: 仓储实例
+ * @return: 写仓储接口指针
+ * @req: REQ-INFRA-032
+ * @design: DES-INFRA-032
+ * @asil: ASIL-B
+ */
+const AegisDomainRepositoryWriteInterface* aegis_infrastructure_repository_log_write(AegisInfrastructureRepositoryLog* repo);
+
+/*
+ * @brief: 立即写检查点（快照全部实体并回收旧日志页）
+ * @param repo: 仓储实例
+ * @return: 错误码
+ * @req: REQ-INFRA-033
+ * @design: DES-INFRA-033
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_repository_log_checkpoint(AegisInfrastructureRepositoryLog* repo);
+
+/*
+ * @brief: 清空持久化数据（擦除日志区并清空内存状态），之后仓储可直接使用
+ * @param repo: 仓储实例
+ * @return: 错误码
+ * @note: 用于出厂初始化，或 init 因布局版本不符返回 ERR_INVALID_STATE 后放弃旧数据。
+ * @req: REQ-INFRA-034
+ * @design: DES-INFRA-034
+ * @asil: ASIL-B
+ * @isr_unsafe
+ */
+AegisErrorCode aegis_infrastructure_repository_log_format(AegisInfrastructureRepositoryLog* repo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INFRASTRUCTURE_REPOSITORY_LOG_H */
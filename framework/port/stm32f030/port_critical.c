@@ -63,3 +63,8 @@ void aegis_critical_exit(void) {
     }
 }
 
+void aegis_critical_barrier(void) {
+#if defined(__arm__) || defined(__thumb__)
+    __asm volatile("dmb" ::: "memory");
+#endif
+}
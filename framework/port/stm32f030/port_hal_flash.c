@@ -0,0 +1,226 @@
+/*
+ * @file: port_hal_flash.c
+ * @brief: STM32F030 片上 Flash 寄存器级移植示例
+ * @author: jack liu
+ *
+ * @note:
+ * - 区域须位于程序映像之外（由链接脚本预留），base_addr 与页大小对齐（F030x4/6/8 为 1KB，F030xC 为 2KB）。
+ * - 编程单位为半字（16位）；擦除/编程期间访问 Flash 的取指会停顿，调用方不得在 ISR 中使用。
+ * - 每次操作后检查 EOP/PGERR/WRPRTERR，并在结束时重新上锁，避免误写。
+ */
+
+#include "hal_flash.h"
+#include "critical.h"
+
+/* ==================== STM32F0 寄存器定义（最小子集） ==================== */
+typedef struct {
+    volatile uint32_t ACR;
+    volatile uint32_t KEYR;
+    volatile uint32_t OPTKEYR;
+    volatile uint32_t SR;
+    volatile uint32_t CR;
+    volatile uint32_t AR;
+    volatile uint32_t RESERVED;
+    volatile uint32_t OBR;
+    volatile uint32_t WRPR;
+} Stm32FlashRegs;
+
+#define STM32_FLASH_R_BASE  (0x40022000UL)
+#define STM32_FLASH_START   (0x08000000UL)
+#define STM32_FLASH_END     (0x08040000UL)    /* F030xC 最大 256KB */
+
+#define FLASH_REGS ((Stm32FlashRegs*)STM32_FLASH_R_BASE)
+
+#define FLASH_KEY1          (0x45670123UL)
+#define FLASH_KEY2          (0xCDEF89ABUL)
+
+#define FLASH_SR_BSY        (1UL << 0)
+#define FLASH_SR_PGERR      (1UL << 2)
+#define FLASH_SR_WRPRTERR   (1UL << 4)
+#define FLASH_SR_EOP        (1UL << 5)
+
+#define FLASH_CR_PG         (1UL << 0)
+#define FLASH_CR_PER        (1UL << 1)
+#define FLASH_CR_STRT       (1UL << 6)
+#define FLASH_CR_LOCK       (1UL << 7)
+
+/* 忙等待上限（按 48MHz 下页擦除最长约 40ms 估算） */
+#define FLASH_BUSY_SPIN_MAX (2000000UL)
+
+/* ==================== 内部辅助函数 ==================== */
+static uint32_t flash_base(const AegisHalFlash* self) {
+    return (uint32_t)(ulong_t)self->ctx;
+}
+
+static uint32_t flash_size(const AegisHalFlash* self) {
+    return self->page_size * (uint32_t)self->page_count;
+}
+
+static void flash_unlock(void) {
+    if ((FLASH_REGS->CR & FLASH_CR_LOCK) != 0UL) {
+        FLASH_REGS->KEYR = FLASH_KEY1;
+        FLASH_REGS->KEYR = FLASH_KEY2;
+    }
+}
+
+static void flash_lock(void) {
+    FLASH_REGS->CR |= FLASH_CR_LOCK;
+}
+
+/* 等待操作结束并检查状态（写1清除 EOP/错误位） */
+static AegisErrorCode flash_wait_done(void) {
+    ulong_t spin = 0UL;
+    uint32_t sr;
+
+    while ((FLASH_REGS->SR & FLASH_SR_BSY) != 0UL) {
+        spin++;
+        if (spin >= FLASH_BUSY_SPIN_MAX) {
+            return ERR_HAL_TIMEOUT;
+        }
+    }
+
+    sr = FLASH_REGS->SR;
+    FLASH_REGS->SR = FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR;
+
+    if ((sr & (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)) != 0UL) {
+        return ERR_HAL_ERROR;
+    }
+    return ERR_OK;
+}
+
+static AegisErrorCode flash_check_range(const AegisHalFlash* self, uint32_t addr, uint32_t len) {
+    if (self == NULL || self->ctx == NULL) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (addr > flash_size(self) || len > flash_size(self) - addr) {
+        return ERR_OUT_OF_RANGE;
+    }
+    return ERR_OK;
+}
+
+static AegisErrorCode flash_read(const AegisHalFlash* self, uint32_t addr, void* buf, uint32_t len) {
+    const volatile uint8_t* src;
+    uint8_t* dst = (uint8_t*)buf;
+    uint32_t i;
+    AegisErrorCode ret;
+
+    if (buf == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = flash_check_range(self, addr, len);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    src = (const volatile uint8_t*)(ulong_t)(flash_base(self) + addr);
+    for (i = 0; i < len; i++) {
+        dst[i] = src[i];
+    }
+    return ERR_OK;
+}
+
+static AegisErrorCode flash_program(const AegisHalFlash* self, uint32_t addr, const void* data, uint32_t len) {
+    const uint8_t* src = (const uint8_t*)data;
+    volatile uint16_t* dst;
+    uint32_t i;
+    AegisErrorCode ret;
+
+    if (data == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = flash_check_range(self, addr, len);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if ((addr & 1U) != 0U || (len & 1U) != 0U) {
+        return ERR_INVALID_PARAM;
+    }
+
+    dst = (volatile uint16_t*)(ulong_t)(flash_base(self) + addr);
+
+    flash_unlock();
+    FLASH_REGS->CR |= FLASH_CR_PG;
+    for (i = 0; i < len; i += 2U) {
+        /* 小端：低地址字节在低8位 */
+        dst[i / 2U] = (uint16_t)((uint16_t)src[i] | (uint16_t)((uint16_t)src[i + 1U] << 8));
+        ret = flash_wait_done();
+        if (ret != ERR_OK) {
+            break;
+        }
+    }
+    FLASH_REGS->CR &= (uint32_t)~FLASH_CR_PG;
+    flash_lock();
+
+    return ret;
+}
+
+static AegisErrorCode flash_erase_page(const AegisHalFlash* self, uint16_t page) {
+    AegisErrorCode ret;
+
+    if (self == NULL || self->ctx == NULL) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (page >= self->page_count) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    flash_unlock();
+    FLASH_REGS->CR |= FLASH_CR_PER;
+    FLASH_REGS->AR = flash_base(self) + (uint32_t)page * self->page_size;
+    FLASH_REGS->CR |= FLASH_CR_STRT;
+    ret = flash_wait_done();
+    FLASH_REGS->CR &= (uint32_t)~FLASH_CR_PER;
+    flash_lock();
+
+    return ret;
+}
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_hal_flash_init(AegisHalFlash* flash, const AegisHalFlashConfig* config) {
+    uint32_t size;
+
+    if (flash == NULL || config == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (config->page_size == 0U || config->page_count == 0U ||
+        (config->base_addr % config->page_size) != 0U ||
+        config->base_addr < STM32_FLASH_START) {
+        return ERR_INVALID_PARAM;
+    }
+
+    size = config->page_size * (uint32_t)config->page_count;
+    if (size > STM32_FLASH_END - config->base_addr) {
+        return ERR_INVALID_PARAM;
+    }
+
+    flash->ctx = (void*)(ulong_t)config->base_addr;
+    flash->page_size = config->page_size;
+    flash->page_count = config->page_count;
+    flash->program_unit = 2U;
+    flash->read = flash_read;
+    flash->program = flash_program;
+    flash->erase_page = flash_erase_page;
+
+    ENTER_CRITICAL();
+    flash_lock();
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_hal_flash_deinit(AegisHalFlash* flash) {
+    if (flash == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (flash->ctx == NULL) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    flash_lock();
+    flash->ctx = NULL;
+    return ERR_OK;
+}
@@ -1,20 +1,50 @@
 /*
  * @file: port_critical.c
- * @brief: x86 模拟平台临界区实现（空操作）
+ * @brief: x86 模拟平台临界区实现（进程内自旋锁 + 按线程嵌套计数）
  * @author: jack liu
  */
 
+#include "types.h"
 #include "critical.h"
 
 /*
- * x86 模拟平台下，临界区操作为空
- * 实际 MCU 平台需要实现关中断/开中断操作
+ * x86 模拟平台没有中断可关：临界区用一把全局自旋锁代替，
+ * 使主循环与多个工作线程（各自模拟一个执行上下文）可以共享同一个内存池/仓储。
+ * 嵌套计数按线程保存，同一线程重复进入不会自锁。
  */
+#if defined(__GNUC__)
+static volatile uint32_t g_lock = 0U;
+static __thread uint32_t g_nest = 0U;
+#endif
 
 void aegis_critical_enter(void) {
-    /* x86 模拟环境：单线程，无需关中断 */
+#if defined(__GNUC__)
+    if (g_nest == 0U) {
+        while (__atomic_exchange_n(&g_lock, 1U, __ATOMIC_ACQUIRE) != 0U) {
+            while (__atomic_load_n(&g_lock, __ATOMIC_RELAXED) != 0U) {
+            }
+        }
+    }
+    g_nest++;
+#endif
 }
 
 void aegis_critical_exit(void) {
-    /* x86 模拟环境：单线程，无需开中断 */
+#if defined(__GNUC__)
+    if (g_nest == 0U) {
+        return;
+    }
+
+    g_nest--;
+    if (g_nest == 0U) {
+        __atomic_store_n(&g_lock, 0U, __ATOMIC_RELEASE);
+    }
+#endif
+}
+
+void aegis_critical_barrier(void) {
+#if defined(__GNUC__)
+    /* 测试/仿真中生产者与消费者可能位于不同线程 */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
 }
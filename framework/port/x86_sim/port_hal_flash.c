@@ -0,0 +1,207 @@
+/*
+ * @file: port_hal_flash.c
+ * @brief: x86_sim平台 Flash 模拟实现（内存映射文件）
+ * @author: jack liu
+ *
+ * @note:
+ * - 后备文件大小固定为 page_size * page_count；新建或长度不符时重建并填充为已擦除状态（0xFF）。
+ * - 编程按位与写入（只能 1->0），与 NOR Flash 一致，因此"未擦除即编程"的缺陷在仿真中同样暴露。
+ * - 映射为 MAP_SHARED，进程退出或异常终止后内容仍保留在文件中，可用于掉电/重启测试。
+ * - 掉电注入：写入字节预算耗尽时，当前编程/擦除只完成前一部分字节（擦除按字节顺序回到 0xFF），
+ *   之后的写操作全部失败，模拟断电后残留的撕裂记录/半擦除页。
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string.h>
+#include "hal_flash.h"
+
+/* ==================== 掉电注入状态（仿真平台全局，跨所有 Flash 句柄） ==================== */
+static uint32_t g_power_budget = HAL_FLASH_SIM_POWER_CUT_OFF;
+static bool_t g_power_lost = FALSE;
+
+/* ==================== 内部辅助函数 ==================== */
+static uint32_t flash_size(const AegisHalFlash* self) {
+    return self->page_size * (uint32_t)self->page_count;
+}
+
+static AegisErrorCode flash_check_range(const AegisHalFlash* self, uint32_t addr, uint32_t len) {
+    if (self == NULL || self->ctx == NULL) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (addr > flash_size(self) || len > flash_size(self) - addr) {
+        return ERR_OUT_OF_RANGE;
+    }
+    return ERR_OK;
+}
+
+/* 从写入预算中扣除 len 字节，返回实际可写入的字节数（不足 len 时即在此掉电） */
+static uint32_t flash_power_take(uint32_t len) {
+    uint32_t done;
+
+    if (g_power_lost) {
+        return 0U;
+    }
+    if (g_power_budget == HAL_FLASH_SIM_POWER_CUT_OFF) {
+        return len;
+    }
+
+    if (len <= g_power_budget) {
+        g_power_budget -= len;
+        return len;
+    }
+
+    done = g_power_budget;
+    g_power_budget = 0U;
+    g_power_lost = TRUE;
+    return done;
+}
+
+static AegisErrorCode flash_read(const AegisHalFlash* self, uint32_t addr, void* buf, uint32_t len) {
+    AegisErrorCode ret;
+
+    if (buf == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = flash_check_range(self, addr, len);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    memcpy(buf, (const uint8_t*)self->ctx + addr, (size_t)len);
+    return ERR_OK;
+}
+
+static AegisErrorCode flash_program(const AegisHalFlash* self, uint32_t addr, const void* data, uint32_t len) {
+    const uint8_t* src = (const uint8_t*)data;
+    uint8_t* dst;
+    uint32_t done;
+    uint32_t i;
+    AegisErrorCode ret;
+
+    if (data == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = flash_check_range(self, addr, len);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if ((addr % self->program_unit) != 0U || (len % self->program_unit) != 0U) {
+        return ERR_INVALID_PARAM;
+    }
+
+    done = flash_power_take(len);
+    dst = (uint8_t*)self->ctx + addr;
+    for (i = 0; i < done; i++) {
+        dst[i] = (uint8_t)(dst[i] & src[i]);
+    }
+
+    return (done == len) ? ERR_OK : ERR_HAL_ERROR;
+}
+
+static AegisErrorCode flash_erase_page(const AegisHalFlash* self, uint16_t page) {
+    uint32_t done;
+
+    if (self == NULL || self->ctx == NULL) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (page >= self->page_count) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    done = flash_power_take(self->page_size);
+    memset((uint8_t*)self->ctx + (uint32_t)page * self->page_size, (int)HAL_FLASH_ERASED_BYTE, (size_t)done);
+    return (done == self->page_size) ? ERR_OK : ERR_HAL_ERROR;
+}
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_hal_flash_init(AegisHalFlash* flash, const AegisHalFlashConfig* config) {
+    struct stat st;
+    void* base;
+    size_t size;
+    int fd;
+
+    if (flash == NULL || config == NULL || config->backing_path == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (config->page_size == 0U || (config->page_size % 8U) != 0U || config->page_count == 0U) {
+        return ERR_INVALID_PARAM;
+    }
+
+    memset(flash, 0, sizeof(*flash));
+    size = (size_t)config->page_size * (size_t)config->page_count;
+
+    fd = open(config->backing_path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return ERR_HAL_ERROR;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        (void)close(fd);
+        return ERR_HAL_ERROR;
+    }
+
+    /* 新建或几何参数变化：重建为全擦除 */
+    if ((size_t)st.st_size != size) {
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)size) != 0) {
+            (void)close(fd);
+            return ERR_HAL_ERROR;
+        }
+        st.st_size = 0;
+    }
+
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (base == MAP_FAILED) {
+        return ERR_HAL_ERROR;
+    }
+
+    if (st.st_size == 0) {
+        memset(base, (int)HAL_FLASH_ERASED_BYTE, size);
+    }
+
+    flash->ctx = base;
+    flash->page_size = config->page_size;
+    flash->page_count = config->page_count;
+    flash->program_unit = 8U;
+    flash->read = flash_read;
+    flash->program = flash_program;
+    flash->erase_page = flash_erase_page;
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_hal_flash_deinit(AegisHalFlash* flash) {
+    size_t size;
+
+    if (flash == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (flash->ctx == NULL) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    size = (size_t)flash_size(flash);
+    (void)msync(flash->ctx, size, MS_SYNC);
+    (void)munmap(flash->ctx, size);
+    flash->ctx = NULL;
+
+    return ERR_OK;
+}
+
+void aegis_hal_flash_sim_set_power_cut(uint32_t after_bytes) {
+    g_power_budget = after_bytes;
+    g_power_lost = FALSE;
+}
+
+bool_t aegis_hal_flash_sim_power_lost(void) {
+    return g_power_lost;
+}
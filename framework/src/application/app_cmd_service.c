@@ -9,6 +9,38 @@
 
 #include "app_cmd_service.h"
 #include "critical.h"
+#include "compile_time.h"
+
+FW_STATIC_ASSERT(APP_CMD_SERVICE_MAX_HANDLERS < DISPATCH_INDEX_EMPTY, cmd_service_max_handlers);
+FW_STATIC_ASSERT(APP_CMD_SERVICE_MAX_TABLES <= 255U, cmd_service_max_tables);
+
+/*
+ * @brief: 在已绑定的静态表中直接按下标查找处理器
+ * @return: TRUE 表示命中（handler/ctx 已输出）
+ */
+static bool_t static_table_lookup(const AegisAppCmdService* service,
+                                  AegisCommandType type,
+                                  AppCmdHandler* handler,
+                                  void** ctx) {
+    uint8_t i;
+    const AegisAppCmdStaticTable* table;
+    uint16_t offset;
+
+    for (i = 0; i < service->table_count; i++) {
+        table = service->tables[i].table;
+        if (type < table->first_type) {
+            continue;
+        }
+        offset = (uint16_t)(type - table->first_type);
+        if (offset < table->count && table->handlers[offset] != NULL) {
+            *handler = table->handlers[offset];
+            *ctx = service->tables[i].ctx;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
 
 AegisErrorCode aegis_app_cmd_service_init(AegisAppCmdService* service) {
     uint8_t i;
@@ -24,6 +56,25 @@ AegisErrorCode aegis_app_cmd_service_init(AegisAppCmdService* service) {
         service->handlers[i].ctx = NULL;
     }
     service->handler_count = 0;
+    for (i = 0; i < (uint8_t)APP_CMD_SERVICE_MAX_TABLES; i++) {
+        service->tables[i].table = NULL;
+        service->tables[i].ctx = NULL;
+    }
+    service->table_count = 0;
+    aegis_dispatch_index_clear(service->index_slots, (uint16_t)APP_CMD_SERVICE_INDEX_SIZE);
+    service->is_sealed = FALSE;
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_app_cmd_service_seal(AegisAppCmdService* service) {
+    if (service == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ENTER_CRITICAL();
+    service->is_sealed = TRUE;
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -45,14 +96,19 @@ AegisErrorCode aegis_app_cmd_service_register_handler(AegisAppCmdService* servic
 
     ENTER_CRITICAL();
 
+    if (service->is_sealed) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
     /* 更新已存在的注册 */
-    for (i = 0; i < service->handler_count; i++) {
-        if (service->handlers[i].type == type) {
-            service->handlers[i].handler = handler;
-            service->handlers[i].ctx = ctx;
-            EXIT_CRITICAL();
-            return ERR_OK;
-        }
+    i = aegis_dispatch_index_find(service->index_keys, service->index_slots,
+                                  (uint16_t)APP_CMD_SERVICE_INDEX_SIZE, type);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        service->handlers[i].handler = handler;
+        service->handlers[i].ctx = ctx;
+        EXIT_CRITICAL();
+        return ERR_OK;
     }
 
     if (service->handler_count >= (uint8_t)APP_CMD_SERVICE_MAX_HANDLERS) {
@@ -63,6 +119,8 @@ AegisErrorCode aegis_app_cmd_service_register_handler(AegisAppCmdService* servic
     service->handlers[service->handler_count].type = type;
     service->handlers[service->handler_count].handler = handler;
     service->handlers[service->handler_count].ctx = ctx;
+    (void)aegis_dispatch_index_insert(service->index_keys, service->index_slots,
+                                      (uint16_t)APP_CMD_SERVICE_INDEX_SIZE, type, service->handler_count);
     service->handler_count++;
 
     EXIT_CRITICAL();
@@ -94,12 +152,68 @@ AegisErrorCode aegis_app_cmd_service_register_handlers(AegisAppCmdService* servi
     return ERR_OK;
 }
 
+AegisErrorCode aegis_app_cmd_service_bind_table(AegisAppCmdService* service,
+                                                const AegisAppCmdStaticTable* table,
+                                                void* ctx) {
+    uint8_t i;
+    uint32_t first;
+    uint32_t last;
+    const AegisAppCmdStaticTable* bound;
+
+    if (service == NULL || table == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (table->handlers == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    /* 区间不得为空，也不得覆盖 CMD_TYPE_INVALID */
+    first = (uint32_t)table->first_type;
+    last = first + (uint32_t)table->count;
+    if (table->count == 0U || last > (uint32_t)CMD_TYPE_INVALID) {
+        return ERR_INVALID_PARAM;
+    }
+
+    ENTER_CRITICAL();
+
+    if (service->is_sealed) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    for (i = 0; i < service->table_count; i++) {
+        bound = service->tables[i].table;
+        if (first < (uint32_t)bound->first_type + (uint32_t)bound->count &&
+            (uint32_t)bound->first_type < last) {
+            EXIT_CRITICAL();
+            return ERR_INVALID_PARAM;
+        }
+    }
+
+    if (service->table_count >= (uint8_t)APP_CMD_SERVICE_MAX_TABLES) {
+        EXIT_CRITICAL();
+        return ERR_OUT_OF_RANGE;
+    }
+
+    service->tables[service->table_count].table = table;
+    service->tables[service->table_count].ctx = ctx;
+    service->table_count++;
+
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
 AegisErrorCode aegis_app_cmd_service_execute(const AegisAppCmdService* service,
                                   const AegisCommand* cmd,
                                   AegisCommandResult* result) {
     uint8_t i;
+    AegisAppCmdServiceHandlerEntry entry;
     AppCmdHandler handler;
     void* ctx;
+    bool_t locked;
+    bool_t found;
 
     if (service == NULL || cmd == NULL || result == NULL) {
         return ERR_NULL_PTR;
@@ -112,15 +226,20 @@ AegisErrorCode aegis_app_cmd_service_execute(const AegisAppCmdService* service,
     handler = NULL;
     ctx = NULL;
 
-    ENTER_CRITICAL();
-    for (i = 0; i < service->handler_count; i++) {
-        if (service->handlers[i].type == cmd->type) {
-            handler = service->handlers[i].handler;
-            ctx = service->handlers[i].ctx;
-            break;
+    /* 静态分发表优先 */
+    locked = aegis_dispatch_index_lock(service->is_sealed);
+    found = static_table_lookup(service, cmd->type, &handler, &ctx);
+    aegis_dispatch_index_unlock(locked);
+
+    if (!found) {
+        i = aegis_dispatch_index_find_sealed(service->index_keys, service->index_slots,
+                                             (uint16_t)APP_CMD_SERVICE_INDEX_SIZE, cmd->type, service->is_sealed,
+                                             service->handlers, (uint16_t)sizeof(entry), &entry);
+        if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+            handler = entry.handler;
+            ctx = entry.ctx;
         }
     }
-    EXIT_CRITICAL();
 
     if (handler == NULL) {
         result->result = ERR_NOT_FOUND;
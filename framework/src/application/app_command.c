@@ -1,13 +1,112 @@
 /*
  * @file: aegis_app_command.c
- * @brief: CQRS命令系统实现（基于ring_buffer）
+ * @brief: CQRS命令系统实现（变长记录队列，支持原地构造/原地执行）
  * @author: jack liu
  */
 
 #include "app_command.h"
 #include "critical.h"
+#include "compile_time.h"
+#include <stddef.h>
 #include <string.h>
 
+/* ==================== 命令对象池 ==================== */
+AEGIS_OBJECT_POOL_DEFINE(AegisCommandPool, aegis_app_cmd_pool, AegisCommand, APP_CMD_POOL_SIZE)
+
+/* ==================== 记录格式 ==================== */
+/*
+ * 记录头：len 为整条记录字节数（含记录头，4字节对齐），state 为记录状态。
+ * 记录头之后紧跟 AegisCommand 的头部字段与实际使用的payload。
+ */
+typedef struct {
+    uint16_t len;
+    volatile uint8_t state;
+    uint8_t reserved;
+} AegisAppCmdRecord;
+
+/* 记录状态 */
+#define CMD_REC_RESERVED    1U      /* 生产者填写中 */
+#define CMD_REC_READY       2U      /* 已提交，待消费 */
+#define CMD_REC_CANCELLED   3U      /* 已作废，消费者跳过 */
+#define CMD_REC_PAD         4U      /* 回绕填充，消费者跳过 */
+
+/* 命令头部长度（payload 之前的字段） */
+#define CMD_HEADER_SIZE     ((uint16_t)offsetof(AegisCommand, payload))
+
+#define CMD_RECORD_HDR_SIZE ((uint16_t)sizeof(AegisAppCmdRecord))
+#define CMD_ARENA_CAP       ((uint16_t)APP_CMD_ARENA_CAPACITY)
+
+/* 携带 payload_size 字节payload的记录长度 */
+#define CMD_RECORD_LEN(payload_size) \
+    ((uint16_t)(((uint32_t)CMD_RECORD_HDR_SIZE + (uint32_t)CMD_HEADER_SIZE + (uint32_t)(payload_size) + 3U) & ~(uint32_t)3U))
+
+#define CMD_RECORD_AT(queue, off) \
+    ((AegisAppCmdRecord*)(void*)((uint8_t*)(queue)->arena + (off)))
+
+#define CMD_RECORD_VIEW(rec)    ((AegisCommand*)(void*)((rec) + 1))
+
+/* ==================== 编译期约束 ==================== */
+FW_STATIC_ASSERT(CMD_QUEUE_SIZE > 0 && CMD_QUEUE_SIZE <= 255, cmd_queue_size_range);
+FW_STATIC_ASSERT(sizeof(AegisAppCmdRecord) == 4U, cmd_record_header_size);
+FW_STATIC_ASSERT(APP_CMD_ARENA_CAPACITY <= 0xFFFCU, cmd_arena_capacity_16bit);
+FW_STATIC_ASSERT(APP_CMD_ARENA_CAPACITY >= CMD_RECORD_LEN(APP_CMD_PAYLOAD_MAX), cmd_arena_fits_max_command);
+/* 尾部余量：最靠后的记录按完整 AegisCommand 访问时仍在 arena 内 */
+FW_STATIC_ASSERT(APP_CMD_ARENA_WORDS * 4U - APP_CMD_ARENA_CAPACITY + CMD_RECORD_LEN(0U) >=
+                 CMD_RECORD_HDR_SIZE + sizeof(AegisCommand), cmd_arena_view_slack);
+
+/* ==================== 内部辅助函数 ==================== */
+/*
+ * @brief: 命令指针 -> 记录偏移（非本队列记录返回 -1）
+ */
+static int32_t record_offset_of(const AegisAppCmdQueue* queue, const AegisCommand* cmd) {
+    const uint8_t* base = (const uint8_t*)queue->arena;
+    const uint8_t* p = (const uint8_t*)cmd;
+    ptrdiff_t off;
+
+    if (p < base + CMD_RECORD_HDR_SIZE || p >= base + CMD_ARENA_CAP) {
+        return -1;
+    }
+
+    off = (p - base) - (ptrdiff_t)CMD_RECORD_HDR_SIZE;
+    if ((off & 3) != 0) {
+        return -1;
+    }
+
+    return (int32_t)off;
+}
+
+/*
+ * @brief: 释放 tail 处的记录（调用方持有临界区）
+ */
+static void advance_tail(AegisAppCmdQueue* queue, uint16_t len) {
+    queue->tail = (uint16_t)(queue->tail + len);
+    queue->used = (uint16_t)(queue->used - len);
+    if (queue->tail >= CMD_ARENA_CAP) {
+        queue->tail = 0U;
+    }
+
+    /* 队列排空时回到起点，减少回绕填充 */
+    if (queue->used == 0U) {
+        queue->head = 0U;
+        queue->tail = 0U;
+    }
+}
+
+/*
+ * @brief: 回收 tail 处连续的作废/填充记录（调用方持有临界区）
+ */
+static void reclaim_cancelled(AegisAppCmdQueue* queue) {
+    AegisAppCmdRecord* rec;
+
+    while (queue->used > 0U && !queue->peeked) {
+        rec = CMD_RECORD_AT(queue, queue->tail);
+        if (rec->state != CMD_REC_CANCELLED && rec->state != CMD_REC_PAD) {
+            break;
+        }
+        advance_tail(queue, rec->len);
+    }
+}
+
 /* ==================== 公共接口实现 ==================== */
 AegisErrorCode aegis_app_cmd_init(AegisAppCmdQueue* queue, AegisTraceLog* trace) {
     if (queue == NULL) {
@@ -16,13 +115,14 @@ AegisErrorCode aegis_app_cmd_init(AegisAppCmdQueue* queue, AegisTraceLog* trace)
 
     ENTER_CRITICAL();
 
-    memset(queue, 0, sizeof(AegisAppCmdQueue));
+    /* 记录区无需清零，只重置偏移 */
+    queue->head = 0U;
+    queue->tail = 0U;
+    queue->used = 0U;
+    queue->ready = 0U;
+    queue->reserving = 0U;
+    queue->peeked = FALSE;
     queue->trace = trace;
-
-    /* 初始化环形缓冲区 */
-    aegis_ring_buffer_init(&queue->ring, queue->buffer,
-                     (uint16_t)sizeof(queue->buffer));
-
     queue->is_initialized = TRUE;
 
     EXIT_CRITICAL();
@@ -30,11 +130,11 @@ AegisErrorCode aegis_app_cmd_init(AegisAppCmdQueue* queue, AegisTraceLog* trace)
     return ERR_OK;
 }
 
-AegisErrorCode aegis_app_cmd_enqueue(AegisAppCmdQueue* queue, const AegisCommand* cmd) {
-    AegisCommand cmd_copy;
-    uint32_t timestamp;
-    uint16_t written;
-    uint16_t free_space;
+AegisErrorCode aegis_app_cmd_reserve_sized(AegisAppCmdQueue* queue, uint16_t payload_capacity, AegisCommand** cmd) {
+    AegisAppCmdRecord* rec;
+    uint16_t len;
+    uint16_t off;
+    uint16_t pad;
 
     if (queue == NULL || cmd == NULL) {
         return ERR_NULL_PTR;
@@ -44,28 +144,115 @@ AegisErrorCode aegis_app_cmd_enqueue(AegisAppCmdQueue* queue, const AegisCommand
         return ERR_NOT_INITIALIZED;
     }
 
-    if (cmd->type == CMD_TYPE_INVALID) {
+    if (payload_capacity > (uint16_t)APP_CMD_PAYLOAD_MAX) {
         return ERR_INVALID_PARAM;
     }
 
-    /* 检查队列是否已满 */
-    free_space = aegis_ring_buffer_get_free(&queue->ring);
-    if (free_space < sizeof(AegisCommand)) {
+    len = CMD_RECORD_LEN(payload_capacity);
+    pad = 0U;
+
+    ENTER_CRITICAL();
+
+    if ((uint32_t)queue->used + (uint32_t)len > (uint32_t)CMD_ARENA_CAP) {
+        EXIT_CRITICAL();
+        return ERR_OUT_OF_RANGE;
+    }
+
+    /* 记录必须物理连续：未回绕时优先用尾部空间，不够则填充尾部后回绕到起点 */
+    off = queue->head;
+    if (queue->head >= queue->tail) {
+        if ((uint16_t)(CMD_ARENA_CAP - queue->head) < len) {
+            if (queue->tail < len) {
+                EXIT_CRITICAL();
+                return ERR_OUT_OF_RANGE;
+            }
+            pad = (uint16_t)(CMD_ARENA_CAP - queue->head);
+            off = 0U;
+        }
+    } else if ((uint16_t)(queue->tail - queue->head) < len) {
+        EXIT_CRITICAL();
         return ERR_OUT_OF_RANGE;
     }
 
-    /* 复制命令并设置时间戳 */
-    memcpy(&cmd_copy, cmd, sizeof(AegisCommand));
+    if (pad > 0U) {
+        rec = CMD_RECORD_AT(queue, queue->head);
+        rec->len = pad;
+        rec->state = CMD_REC_PAD;
+    }
+
+    rec = CMD_RECORD_AT(queue, off);
+    rec->len = len;
+    rec->state = CMD_REC_RESERVED;
+    queue->head = (uint16_t)(off + len);
+    queue->used = (uint16_t)(queue->used + pad + len);
+    queue->reserving++;
+
+    EXIT_CRITICAL();
+
+    *cmd = CMD_RECORD_VIEW(rec);
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_app_cmd_reserve(AegisAppCmdQueue* queue, AegisCommand** cmd) {
+    return aegis_app_cmd_reserve_sized(queue, (uint16_t)APP_CMD_PAYLOAD_MAX, cmd);
+}
+
+AegisErrorCode aegis_app_cmd_commit(AegisAppCmdQueue* queue, AegisCommand* cmd) {
+    int32_t off;
+    AegisAppCmdRecord* rec;
+    uint16_t capacity;
+    uint16_t len;
+    uint32_t timestamp;
+    bool_t valid;
+
+    if (queue == NULL || cmd == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!queue->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    off = record_offset_of(queue, cmd);
+    if (off < 0) {
+        return ERR_INVALID_STATE;
+    }
+
+    rec = CMD_RECORD_AT(queue, off);
+    if (rec->state != CMD_REC_RESERVED) {
+        return ERR_INVALID_STATE;
+    }
+
+    capacity = (uint16_t)(rec->len - CMD_RECORD_HDR_SIZE - CMD_HEADER_SIZE);
+    valid = (cmd->type != CMD_TYPE_INVALID &&
+             cmd->payload_size <= capacity &&
+             cmd->payload_size <= (uint16_t)APP_CMD_PAYLOAD_MAX) ? TRUE : FALSE;
+
+    /* 时间戳在临界区外获取（回调可能较慢） */
     timestamp = (queue->trace != NULL) ? aegis_trace_get_timestamp(queue->trace) : 0U;
-    cmd_copy.timestamp = timestamp;
+    cmd->timestamp = timestamp;
 
-    /* 写入环形缓冲区 */
     ENTER_CRITICAL();
-    written = aegis_ring_buffer_write(&queue->ring, (const uint8_t*)&cmd_copy, sizeof(AegisCommand));
+    queue->reserving--;
+    if (valid) {
+        /* 最新的预留记录按实际payload收缩，归还多余空间 */
+        len = CMD_RECORD_LEN(cmd->payload_size);
+        if (len < rec->len && (uint32_t)off + (uint32_t)rec->len == (uint32_t)queue->head) {
+            queue->head = (uint16_t)(queue->head - (uint16_t)(rec->len - len));
+            queue->used = (uint16_t)(queue->used - (uint16_t)(rec->len - len));
+            rec->len = len;
+        }
+        rec->state = CMD_REC_READY;
+        queue->ready++;
+    } else {
+        rec->state = CMD_REC_CANCELLED;
+        reclaim_cancelled(queue);
+    }
     EXIT_CRITICAL();
 
-    if (written != sizeof(AegisCommand)) {
-        return ERR_OUT_OF_RANGE;
+    if (!valid) {
+        return ERR_INVALID_PARAM;
     }
 
     /* 记录入队事件 */
@@ -76,9 +263,9 @@ AegisErrorCode aegis_app_cmd_enqueue(AegisAppCmdQueue* queue, const AegisCommand
     return ERR_OK;
 }
 
-AegisErrorCode aegis_app_cmd_dequeue(AegisAppCmdQueue* queue, AegisCommand* cmd) {
-    uint16_t read_len;
-    uint16_t count;
+AegisErrorCode aegis_app_cmd_cancel(AegisAppCmdQueue* queue, AegisCommand* cmd) {
+    int32_t off;
+    AegisAppCmdRecord* rec;
 
     if (queue == NULL || cmd == NULL) {
         return ERR_NULL_PTR;
@@ -88,28 +275,91 @@ AegisErrorCode aegis_app_cmd_dequeue(AegisAppCmdQueue* queue, AegisCommand* cmd)
         return ERR_NOT_INITIALIZED;
     }
 
-    /* 检查队列是否为空 */
-    count = aegis_ring_buffer_get_count(&queue->ring);
-    if (count < sizeof(AegisCommand)) {
-        return ERR_EMPTY;
+    off = record_offset_of(queue, cmd);
+    if (off < 0) {
+        return ERR_INVALID_PARAM;
     }
 
-    /* 从环形缓冲区读取命令 */
+    rec = CMD_RECORD_AT(queue, off);
+
     ENTER_CRITICAL();
-    read_len = aegis_ring_buffer_read(&queue->ring, (uint8_t*)cmd, sizeof(AegisCommand));
+
+    if (rec->state != CMD_REC_RESERVED) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    rec->state = CMD_REC_CANCELLED;
+    queue->reserving--;
+    reclaim_cancelled(queue);
+
     EXIT_CRITICAL();
 
-    if (read_len != sizeof(AegisCommand)) {
-        return ERR_EMPTY;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_app_cmd_peek(AegisAppCmdQueue* queue, const AegisCommand** cmd) {
+    AegisErrorCode ret = ERR_EMPTY;
+    AegisAppCmdRecord* rec;
+
+    if (queue == NULL || cmd == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!queue->is_initialized) {
+        return ERR_NOT_INITIALIZED;
     }
+
+    ENTER_CRITICAL();
+
+    reclaim_cancelled(queue);
+
+    /* 只消费 tail 记录：较早的预留尚未提交时，后续已提交命令继续等待（保持FIFO） */
+    if (queue->used > 0U) {
+        rec = CMD_RECORD_AT(queue, queue->tail);
+        if (rec->state == CMD_REC_READY) {
+            queue->peeked = TRUE;
+            *cmd = CMD_RECORD_VIEW(rec);
+            ret = ERR_OK;
+        }
+    }
+
+    EXIT_CRITICAL();
+
+    return ret;
+}
+
+AegisErrorCode aegis_app_cmd_release(AegisAppCmdQueue* queue) {
+    if (queue == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!queue->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    ENTER_CRITICAL();
+
+    if (!queue->peeked) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    advance_tail(queue, CMD_RECORD_AT(queue, queue->tail)->len);
+    queue->ready--;
+    queue->peeked = FALSE;
+    reclaim_cancelled(queue);
+
+    EXIT_CRITICAL();
+
     return ERR_OK;
 }
 
-AegisErrorCode aegis_app_cmd_get_count(const AegisAppCmdQueue* queue, uint8_t* count) {
-    uint16_t byte_count;
-    uint8_t cmd_count;
+AegisErrorCode aegis_app_cmd_enqueue(AegisAppCmdQueue* queue, const AegisCommand* cmd) {
+    AegisCommand* view;
+    AegisErrorCode ret;
 
-    if (queue == NULL || count == NULL) {
+    if (queue == NULL || cmd == NULL) {
         return ERR_NULL_PTR;
     }
 
@@ -117,10 +367,50 @@ AegisErrorCode aegis_app_cmd_get_count(const AegisAppCmdQueue* queue, uint8_t* c
         return ERR_NOT_INITIALIZED;
     }
 
-    byte_count = aegis_ring_buffer_get_count(&queue->ring);
-    cmd_count = (uint8_t)(byte_count / sizeof(AegisCommand));
+    if (cmd->type == CMD_TYPE_INVALID || cmd->payload_size > (uint16_t)APP_CMD_PAYLOAD_MAX) {
+        return ERR_INVALID_PARAM;
+    }
+
+    /* 只按有效payload预留记录 */
+    ret = aegis_app_cmd_reserve_sized(queue, cmd->payload_size, &view);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    /* 仅拷贝头部与有效payload */
+    memcpy(view, cmd, (size_t)CMD_HEADER_SIZE + (size_t)cmd->payload_size);
+
+    return aegis_app_cmd_commit(queue, view);
+}
+
+AegisErrorCode aegis_app_cmd_dequeue(AegisAppCmdQueue* queue, AegisCommand* cmd) {
+    const AegisCommand* view;
+    AegisErrorCode ret;
+
+    if (queue == NULL || cmd == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = aegis_app_cmd_peek(queue, &view);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    memcpy(cmd, view, (size_t)CMD_HEADER_SIZE + (size_t)view->payload_size);
+
+    return aegis_app_cmd_release(queue);
+}
 
-    *count = cmd_count;
+AegisErrorCode aegis_app_cmd_get_count(const AegisAppCmdQueue* queue, uint8_t* count) {
+    if (queue == NULL || count == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!queue->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    *count = (queue->ready > 255U) ? (uint8_t)255U : (uint8_t)queue->ready;
 
     return ERR_OK;
 }
@@ -134,7 +424,18 @@ AegisErrorCode aegis_app_cmd_clear(AegisAppCmdQueue* queue) {
         return ERR_NOT_INITIALIZED;
     }
 
-    aegis_ring_buffer_clear(&queue->ring);
+    ENTER_CRITICAL();
+    /* 记录区不清零：在途预留的记录头仍为 RESERVED，此时清空会让其 commit/cancel 落到队列之外 */
+    if (queue->reserving > 0U) {
+        EXIT_CRITICAL();
+        return ERR_BUSY;
+    }
+    queue->head = 0U;
+    queue->tail = 0U;
+    queue->used = 0U;
+    queue->ready = 0U;
+    queue->peeked = FALSE;
+    EXIT_CRITICAL();
 
     if (queue->trace != NULL) {
         aegis_trace_log_event(queue->trace, TRACE_EVENT_CMD_EXEC, "CMD-CLEAR", 0, 0);
@@ -9,6 +9,9 @@
 
 #include "app_domain_assembler.h"
 #include "critical.h"
+#include "compile_time.h"
+
+FW_STATIC_ASSERT(APP_ASSEMBLER_MAX < DISPATCH_INDEX_EMPTY, assembler_max);
 
 AegisErrorCode aegis_app_asm_init(AegisAppAssembler* assembler) {
     uint8_t i;
@@ -24,6 +27,20 @@ AegisErrorCode aegis_app_asm_init(AegisAppAssembler* assembler) {
         assembler->entries[i].ctx = NULL;
     }
     assembler->aegis_entry_count = 0;
+    aegis_dispatch_index_clear(assembler->index_slots, (uint16_t)APP_ASSEMBLER_INDEX_SIZE);
+    assembler->is_sealed = FALSE;
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_app_asm_seal(AegisAppAssembler* assembler) {
+    if (assembler == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ENTER_CRITICAL();
+    assembler->is_sealed = TRUE;
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -45,13 +62,19 @@ AegisErrorCode aegis_app_asm_register(AegisAppAssembler* assembler,
 
     ENTER_CRITICAL();
 
-    for (i = 0; i < assembler->aegis_entry_count; i++) {
-        if (assembler->entries[i].dto_type == dto_type) {
-            assembler->entries[i].assembler = fn;
-            assembler->entries[i].ctx = ctx;
-            EXIT_CRITICAL();
-            return ERR_OK;
-        }
+    if (assembler->is_sealed) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    /* 更新已存在的注册 */
+    i = aegis_dispatch_index_find(assembler->index_keys, assembler->index_slots,
+                                  (uint16_t)APP_ASSEMBLER_INDEX_SIZE, dto_type);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        assembler->entries[i].assembler = fn;
+        assembler->entries[i].ctx = ctx;
+        EXIT_CRITICAL();
+        return ERR_OK;
     }
 
     if (assembler->aegis_entry_count >= (uint8_t)APP_ASSEMBLER_MAX) {
@@ -62,6 +85,8 @@ AegisErrorCode aegis_app_asm_register(AegisAppAssembler* assembler,
     assembler->entries[assembler->aegis_entry_count].dto_type = dto_type;
     assembler->entries[assembler->aegis_entry_count].assembler = fn;
     assembler->entries[assembler->aegis_entry_count].ctx = ctx;
+    (void)aegis_dispatch_index_insert(assembler->index_keys, assembler->index_slots,
+                                      (uint16_t)APP_ASSEMBLER_INDEX_SIZE, dto_type, assembler->aegis_entry_count);
     assembler->aegis_entry_count++;
 
     EXIT_CRITICAL();
@@ -74,6 +99,7 @@ AegisErrorCode aegis_app_asm_to_dto(const AegisAppAssembler* registry,
                          const AegisDomainEntity* entity,
                          AegisAppDto* dto) {
     uint8_t i;
+    AegisAppAssemblerEntry entry;
     AppDomainAssembler assembler_fn;
     void* ctx;
 
@@ -84,15 +110,13 @@ AegisErrorCode aegis_app_asm_to_dto(const AegisAppAssembler* registry,
     assembler_fn = NULL;
     ctx = NULL;
 
-    ENTER_CRITICAL();
-    for (i = 0; i < registry->aegis_entry_count; i++) {
-        if (registry->entries[i].dto_type == dto_type) {
-            assembler_fn = registry->entries[i].assembler;
-            ctx = registry->entries[i].ctx;
-            break;
-        }
+    i = aegis_dispatch_index_find_sealed(registry->index_keys, registry->index_slots,
+                                         (uint16_t)APP_ASSEMBLER_INDEX_SIZE, dto_type, registry->is_sealed,
+                                         registry->entries, (uint16_t)sizeof(entry), &entry);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        assembler_fn = entry.assembler;
+        ctx = entry.ctx;
     }
-    EXIT_CRITICAL();
 
     if (assembler_fn == NULL) {
         return ERR_NOT_FOUND;
@@ -9,6 +9,9 @@
 
 #include "app_domain_converter.h"
 #include "critical.h"
+#include "compile_time.h"
+
+FW_STATIC_ASSERT(APP_CONVERTER_MAX < DISPATCH_INDEX_EMPTY, converter_max);
 
 AegisErrorCode aegis_app_conv_init(AegisAppConverter* converter) {
     uint8_t i;
@@ -24,6 +27,20 @@ AegisErrorCode aegis_app_conv_init(AegisAppConverter* converter) {
         converter->entries[i].ctx = NULL;
     }
     converter->aegis_entry_count = 0;
+    aegis_dispatch_index_clear(converter->index_slots, (uint16_t)APP_CONVERTER_INDEX_SIZE);
+    converter->is_sealed = FALSE;
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_app_conv_seal(AegisAppConverter* converter) {
+    if (converter == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ENTER_CRITICAL();
+    converter->is_sealed = TRUE;
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -45,13 +62,19 @@ AegisErrorCode aegis_app_conv_register(AegisAppConverter* converter,
 
     ENTER_CRITICAL();
 
-    for (i = 0; i < converter->aegis_entry_count; i++) {
-        if (converter->entries[i].dto_type == dto_type) {
-            converter->entries[i].converter = fn;
-            converter->entries[i].ctx = ctx;
-            EXIT_CRITICAL();
-            return ERR_OK;
-        }
+    if (converter->is_sealed) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    /* 更新已存在的注册 */
+    i = aegis_dispatch_index_find(converter->index_keys, converter->index_slots,
+                                  (uint16_t)APP_CONVERTER_INDEX_SIZE, dto_type);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        converter->entries[i].converter = fn;
+        converter->entries[i].ctx = ctx;
+        EXIT_CRITICAL();
+        return ERR_OK;
     }
 
     if (converter->aegis_entry_count >= (uint8_t)APP_CONVERTER_MAX) {
@@ -62,6 +85,8 @@ AegisErrorCode aegis_app_conv_register(AegisAppConverter* converter,
     converter->entries[converter->aegis_entry_count].dto_type = dto_type;
     converter->entries[converter->aegis_entry_count].converter = fn;
     converter->entries[converter->aegis_entry_count].ctx = ctx;
+    (void)aegis_dispatch_index_insert(converter->index_keys, converter->index_slots,
+                                      (uint16_t)APP_CONVERTER_INDEX_SIZE, dto_type, converter->aegis_entry_count);
     converter->aegis_entry_count++;
 
     EXIT_CRITICAL();
@@ -74,6 +99,7 @@ AegisErrorCode aegis_app_conv_from_dto(const AegisAppConverter* registry,
                             const AegisAppDto* dto,
                             AegisDomainEntity* entity) {
     uint8_t i;
+    AegisAppConverterEntry entry;
     AppDomainConverter converter_fn;
     void* ctx;
 
@@ -84,15 +110,13 @@ AegisErrorCode aegis_app_conv_from_dto(const AegisAppConverter* registry,
     converter_fn = NULL;
     ctx = NULL;
 
-    ENTER_CRITICAL();
-    for (i = 0; i < registry->aegis_entry_count; i++) {
-        if (registry->entries[i].dto_type == dto_type) {
-            converter_fn = registry->entries[i].converter;
-            ctx = registry->entries[i].ctx;
-            break;
-        }
+    i = aegis_dispatch_index_find_sealed(registry->index_keys, registry->index_slots,
+                                         (uint16_t)APP_CONVERTER_INDEX_SIZE, dto_type, registry->is_sealed,
+                                         registry->entries, (uint16_t)sizeof(entry), &entry);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        converter_fn = entry.converter;
+        ctx = entry.ctx;
     }
-    EXIT_CRITICAL();
 
     if (converter_fn == NULL) {
         return ERR_NOT_FOUND;
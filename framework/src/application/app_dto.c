@@ -10,6 +10,9 @@
 #include "app_dto.h"
 #include <string.h>
 
+/* ==================== DTO 对象池 ==================== */
+AEGIS_OBJECT_POOL_DEFINE(AegisAppDtoPool, aegis_app_dto_pool, AegisAppDto, APP_DTO_POOL_SIZE)
+
 AegisErrorCode aegis_app_dto_payload_write(AegisAppDto* dto, const void* payload, uint16_t size) {
     uint16_t i;
 
@@ -91,3 +91,32 @@ uint8_t aegis_app_init_process_domain_events(AegisAppRuntime* runtime, uint8_t m
     return aegis_domain_event_process(&runtime->event_bus, max_events);
 }
 
+AegisErrorCode aegis_app_init_seal(AegisAppRuntime* runtime) {
+    AegisErrorCode ret;
+
+    if (runtime == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!runtime->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    ret = aegis_app_cmd_service_seal(&runtime->cmd_service);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = aegis_app_query_seal(&runtime->query);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = aegis_app_asm_seal(&runtime->assembler);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    return aegis_app_conv_seal(&runtime->converter);
+}
+
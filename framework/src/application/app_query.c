@@ -6,6 +6,9 @@
 
 #include "app_query.h"
 #include "critical.h"
+#include "compile_time.h"
+
+FW_STATIC_ASSERT(APP_QUERY_MAX_HANDLERS < DISPATCH_INDEX_EMPTY, query_max_handlers);
 #include <string.h>
 
 AegisErrorCode aegis_app_query_init(AegisAppQueryDispatcher* dispatcher) {
@@ -22,6 +25,20 @@ AegisErrorCode aegis_app_query_init(AegisAppQueryDispatcher* dispatcher) {
         dispatcher->handlers[i].ctx = NULL;
     }
     dispatcher->handler_count = 0;
+    aegis_dispatch_index_clear(dispatcher->index_slots, (uint16_t)APP_QUERY_INDEX_SIZE);
+    dispatcher->is_sealed = FALSE;
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_app_query_seal(AegisAppQueryDispatcher* dispatcher) {
+    if (dispatcher == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ENTER_CRITICAL();
+    dispatcher->is_sealed = TRUE;
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -43,13 +60,19 @@ AegisErrorCode aegis_app_query_register_handler(AegisAppQueryDispatcher* dispatc
 
     ENTER_CRITICAL();
 
-    for (i = 0; i < dispatcher->handler_count; i++) {
-        if (dispatcher->handlers[i].type == type) {
-            dispatcher->handlers[i].handler = handler;
-            dispatcher->handlers[i].ctx = ctx;
-            EXIT_CRITICAL();
-            return ERR_OK;
-        }
+    if (dispatcher->is_sealed) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    /* 更新已存在的注册 */
+    i = aegis_dispatch_index_find(dispatcher->index_keys, dispatcher->index_slots,
+                                  (uint16_t)APP_QUERY_INDEX_SIZE, type);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        dispatcher->handlers[i].handler = handler;
+        dispatcher->handlers[i].ctx = ctx;
+        EXIT_CRITICAL();
+        return ERR_OK;
     }
 
     if (dispatcher->handler_count >= (uint8_t)APP_QUERY_MAX_HANDLERS) {
@@ -60,6 +83,8 @@ AegisErrorCode aegis_app_query_register_handler(AegisAppQueryDispatcher* dispatc
     dispatcher->handlers[dispatcher->handler_count].type = type;
     dispatcher->handlers[dispatcher->handler_count].handler = handler;
     dispatcher->handlers[dispatcher->handler_count].ctx = ctx;
+    (void)aegis_dispatch_index_insert(dispatcher->index_keys, dispatcher->index_slots,
+                                      (uint16_t)APP_QUERY_INDEX_SIZE, type, dispatcher->handler_count);
     dispatcher->handler_count++;
 
     EXIT_CRITICAL();
@@ -95,6 +120,7 @@ AegisErrorCode aegis_app_query_execute(const AegisAppQueryDispatcher* dispatcher
                             const AegisQueryRequest* req,
                             AegisQueryResponse* resp) {
     uint8_t i;
+    AegisAppQueryHandlerEntry entry;
     AppQueryHandler handler;
     void* ctx;
 
@@ -111,15 +137,13 @@ AegisErrorCode aegis_app_query_execute(const AegisAppQueryDispatcher* dispatcher
     handler = NULL;
     ctx = NULL;
 
-    ENTER_CRITICAL();
-    for (i = 0; i < dispatcher->handler_count; i++) {
-        if (dispatcher->handlers[i].type == req->type) {
-            handler = dispatcher->handlers[i].handler;
-            ctx = dispatcher->handlers[i].ctx;
-            break;
-        }
+    i = aegis_dispatch_index_find_sealed(dispatcher->index_keys, dispatcher->index_slots,
+                                         (uint16_t)APP_QUERY_INDEX_SIZE, req->type, dispatcher->is_sealed,
+                                         dispatcher->handlers, (uint16_t)sizeof(entry), &entry);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        handler = entry.handler;
+        ctx = entry.ctx;
     }
-    EXIT_CRITICAL();
 
     if (handler == NULL) {
         resp->result = ERR_NOT_FOUND;
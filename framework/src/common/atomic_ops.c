@@ -0,0 +1,22 @@
+/*
+ * @file: atomic_ops.c
+ * @brief: 屏障后端的 acquire/release 访问实现
+ * @author: jack liu
+ */
+
+#include "atomic_ops.h"
+
+/* ==================== 公共接口实现 ==================== */
+uint32_t aegis_atomic_load_acquire_u32(const volatile uint32_t* p) {
+    uint32_t v;
+
+    v = *p;
+    aegis_critical_barrier();
+
+    return v;
+}
+
+void aegis_atomic_store_release_u32(volatile uint32_t* p, uint32_t v) {
+    aegis_critical_barrier();
+    *p = v;
+}
@@ -0,0 +1,32 @@
+/*
+ * @file: crc32.c
+ * @brief: CRC-32 半字节查表实现
+ * @author: jack liu
+ */
+
+#include "crc32.h"
+
+static const uint32_t g_crc32_nibble[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+uint32_t aegis_crc32_update(uint32_t crc, const void* data, uint32_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    uint32_t i;
+
+    if (p == NULL) {
+        return crc;
+    }
+
+    crc = ~crc;
+    for (i = 0; i < len; i++) {
+        crc ^= (uint32_t)p[i];
+        crc = (crc >> 4) ^ g_crc32_nibble[crc & 0x0FU];
+        crc = (crc >> 4) ^ g_crc32_nibble[crc & 0x0FU];
+    }
+
+    return ~crc;
+}
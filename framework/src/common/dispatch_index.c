@@ -0,0 +1,116 @@
+/*
+ * @file: dispatch_index.c
+ * @brief: 处理器分发索引实现（开放寻址 + 线性探测）
+ * @author: jack liu
+ */
+
+#include "dispatch_index.h"
+#include "critical.h"
+#include <string.h>
+
+/* 乘法散列：连续类型值（最常见的注册方式）也能均匀分布到各桶 */
+#define DISPATCH_INDEX_HASH(key) \
+    ((uint16_t)(((uint32_t)(key) * 0x9E3779B1UL) >> 16))
+
+void aegis_dispatch_index_clear(uint8_t* slots, uint16_t size) {
+    uint16_t i;
+
+    if (slots == NULL) {
+        return;
+    }
+
+    for (i = 0; i < size; i++) {
+        slots[i] = (uint8_t)DISPATCH_INDEX_EMPTY;
+    }
+}
+
+AegisErrorCode aegis_dispatch_index_insert(uint16_t* keys, uint8_t* slots, uint16_t size,
+                                           uint16_t key, uint8_t slot) {
+    uint16_t mask;
+    uint16_t pos;
+    uint16_t probes;
+
+    if (keys == NULL || slots == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (size == 0U || (size & (uint16_t)(size - 1U)) != 0U || slot == (uint8_t)DISPATCH_INDEX_EMPTY) {
+        return ERR_INVALID_PARAM;
+    }
+
+    mask = (uint16_t)(size - 1U);
+    pos = (uint16_t)(DISPATCH_INDEX_HASH(key) & mask);
+
+    for (probes = 0; probes < size; probes++) {
+        if (slots[pos] == (uint8_t)DISPATCH_INDEX_EMPTY) {
+            keys[pos] = key;
+            slots[pos] = slot;
+            return ERR_OK;
+        }
+        pos = (uint16_t)((pos + 1U) & mask);
+    }
+
+    return ERR_OUT_OF_RANGE;
+}
+
+uint8_t aegis_dispatch_index_find(const uint16_t* keys, const uint8_t* slots, uint16_t size,
+                                  uint16_t key) {
+    uint16_t mask;
+    uint16_t pos;
+    uint16_t probes;
+
+    if (keys == NULL || slots == NULL || size == 0U) {
+        return (uint8_t)DISPATCH_INDEX_EMPTY;
+    }
+
+    mask = (uint16_t)(size - 1U);
+    pos = (uint16_t)(DISPATCH_INDEX_HASH(key) & mask);
+
+    /* 负载因子 <= 0.5，遇到空桶即可判定未注册 */
+    for (probes = 0; probes < size; probes++) {
+        if (slots[pos] == (uint8_t)DISPATCH_INDEX_EMPTY) {
+            break;
+        }
+        if (keys[pos] == key) {
+            return slots[pos];
+        }
+        pos = (uint16_t)((pos + 1U) & mask);
+    }
+
+    return (uint8_t)DISPATCH_INDEX_EMPTY;
+}
+
+bool_t aegis_dispatch_index_lock(bool_t sealed) {
+    if (sealed) {
+        return FALSE;
+    }
+
+    ENTER_CRITICAL();
+    return TRUE;
+}
+
+void aegis_dispatch_index_unlock(bool_t locked) {
+    if (locked) {
+        EXIT_CRITICAL();
+    }
+}
+
+uint8_t aegis_dispatch_index_find_sealed(const uint16_t* keys, const uint8_t* slots, uint16_t size,
+                                         uint16_t key, bool_t sealed,
+                                         const void* entries, uint16_t entry_size, void* out) {
+    uint8_t slot;
+    bool_t locked;
+
+    if (entries == NULL || out == NULL) {
+        return (uint8_t)DISPATCH_INDEX_EMPTY;
+    }
+
+    locked = aegis_dispatch_index_lock(sealed);
+    slot = aegis_dispatch_index_find(keys, slots, size, key);
+    if (slot != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        memcpy(out, (const uint8_t*)entries + (size_t)slot * (size_t)entry_size, (size_t)entry_size);
+    }
+    aegis_dispatch_index_unlock(locked);
+
+    return slot;
+}
@@ -0,0 +1,173 @@
+/*
+ * @file: key_filter.c
+ * @brief: 16位键过滤核实现（AVX2 / SSE2 / 标量）
+ * @author: jack liu
+ */
+
+#include "key_filter.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define KEY_FILTER_SIMD_LANES  16U
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define KEY_FILTER_SIMD_LANES  8U
+#else
+#define KEY_FILTER_SIMD_LANES  0U
+#endif
+
+/* ==================== 内部辅助函数 ==================== */
+static uint32_t key_filter_popcount(uint32_t v) {
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_popcount(v);
+#else
+    v = v - ((v >> 1) & 0x55555555UL);
+    v = (v & 0x33333333UL) + ((v >> 2) & 0x33333333UL);
+    v = (v + (v >> 4)) & 0x0F0F0F0FUL;
+    return (uint32_t)((v * 0x01010101UL) >> 24);
+#endif
+}
+
+static uint32_t key_filter_scalar(const uint16_t* keys, uint8_t count, uint16_t key) {
+    uint32_t mask = 0U;
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        if (keys[i] == key) {
+            mask |= (uint32_t)1U << i;
+        }
+    }
+    return mask;
+}
+
+#if defined(__AVX2__)
+/*
+ * @brief: 比较32个键（两次 16 路比较，打包后一次 movemask）
+ */
+static uint32_t key_filter_block32(const uint16_t* keys, uint16_t key) {
+    __m256i k = _mm256_set1_epi16((short)key);
+    __m256i a = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(const void*)keys), k);
+    __m256i b = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(const void*)(keys + 16)), k);
+
+    /* packs 按 128 位通道交织，permute 恢复键顺序 */
+    return (uint32_t)_mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0xD8));
+}
+
+/*
+ * @brief: 比较16个键
+ */
+static uint32_t key_filter_block16(const uint16_t* keys, uint16_t key) {
+    __m256i eq = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)(const void*)keys),
+                                    _mm256_set1_epi16((short)key));
+    __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(eq), _mm256_extracti128_si256(eq, 1));
+
+    return (uint32_t)_mm_movemask_epi8(packed) & 0xFFFFU;
+}
+#elif defined(__SSE2__)
+/*
+ * @brief: 比较16个键（两次 8 路比较，打包后一次 movemask）
+ */
+static uint32_t key_filter_block16(const uint16_t* keys, uint16_t key) {
+    __m128i k = _mm_set1_epi16((short)key);
+    __m128i a = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(const void*)keys), k);
+    __m128i b = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(const void*)(keys + 8)), k);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(a, b)) & 0xFFFFU;
+}
+
+/*
+ * @brief: 比较32个键
+ */
+static uint32_t key_filter_block32(const uint16_t* keys, uint16_t key) {
+    return key_filter_block16(keys, key) | (key_filter_block16(keys + 16, key) << 16);
+}
+#endif
+
+/* ==================== 公共接口实现 ==================== */
+uint32_t aegis_key_filter_mask(const uint16_t* keys, uint8_t count, uint16_t key) {
+#if KEY_FILTER_SIMD_LANES > 0U
+    uint32_t mask;
+#endif
+
+    if (keys == NULL) {
+        return 0U;
+    }
+
+    if (count > (uint8_t)KEY_FILTER_BLOCK) {
+        count = (uint8_t)KEY_FILTER_BLOCK;
+    }
+
+#if KEY_FILTER_SIMD_LANES > 0U
+    if (count == (uint8_t)KEY_FILTER_BLOCK) {
+        return key_filter_block32(keys, key);
+    }
+
+    /* 不足一块：整16个用向量比较，剩余逐个比较（不越界读取） */
+    if (count >= 16U) {
+        mask = key_filter_block16(keys, key);
+        mask |= key_filter_scalar(keys + 16, (uint8_t)(count - 16U), key) << 16;
+        return mask;
+    }
+    return key_filter_scalar(keys, count, key);
+#else
+    return key_filter_scalar(keys, count, key);
+#endif
+}
+
+uint32_t aegis_key_filter_count(const uint16_t* keys, uint32_t count, uint16_t key) {
+    uint32_t total = 0U;
+    uint32_t i = 0U;
+
+    if (keys == NULL) {
+        return 0U;
+    }
+
+#if KEY_FILTER_SIMD_LANES > 0U
+    for (; i + KEY_FILTER_BLOCK <= count; i += KEY_FILTER_BLOCK) {
+        total += key_filter_popcount(key_filter_block32(keys + i, key));
+    }
+#endif
+
+    for (; i < count; i += KEY_FILTER_BLOCK) {
+        uint32_t n = count - i;
+        total += key_filter_popcount(aegis_key_filter_mask(keys + i,
+                                                           (uint8_t)((n > KEY_FILTER_BLOCK) ? KEY_FILTER_BLOCK : n),
+                                                           key));
+    }
+
+    return total;
+}
+
+uint8_t aegis_key_filter_pop(uint32_t* mask) {
+    uint32_t m;
+    uint8_t index;
+
+    if (mask == NULL || *mask == 0U) {
+        return (uint8_t)KEY_FILTER_BLOCK;
+    }
+
+    m = *mask;
+#if defined(__GNUC__)
+    index = (uint8_t)__builtin_ctz(m);
+#else
+    index = 0U;
+    while ((m & 1U) == 0U) {
+        m >>= 1;
+        index++;
+    }
+    m = *mask;
+#endif
+    *mask = m & (m - 1U);
+
+    return index;
+}
+
+const char* aegis_key_filter_kernel(void) {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -1,11 +1,12 @@
 /*
  * @file: mem_pool.c
- * @brief: 统一内存块静态内存池实现（单一内存块+多区域划分+魔法数保护）
+ * @brief: 统一内存块静态内存池实现（单一内存块+按尺寸类表划分区域+魔法数保护）
  * @author: jack liu
  */
 
 #include "mem_pool.h"
 #include "critical.h"
+#include "compile_time.h"
 #include <string.h>
 
 /* ==================== 魔法数定义 ==================== */
@@ -13,8 +14,41 @@
 #define MEM_MAGIC_TAIL      0xBEEFU         /* 尾部魔法数（16位） */
 #define MEM_MAGIC_SIZE      2               /* 魔法数占用字节 */
 
-/* 空闲链表结束标记 */
-#define FREE_LIST_END   0xFF
+/* 无可用尺寸类 */
+#define MEM_POOL_CLASS_NONE  0xFFU
+
+/* ==================== 编译期约束 ==================== */
+#define MEM_POOL_IS_POW2(x)  (((x) != 0) && (((x) & ((x) - 1)) == 0))
+
+/* 每个尺寸类：块数 >= 1，块大小在 [MIN, MAX] 内且能容纳头尾魔法数与至少1字节数据 */
+#define MEM_POOL_X_VALID(size, count) \
+    && ((count) > 0) && ((size) > (int)MEM_POOL_GUARD_SIZE) && ((size) <= 0xFFFF) && \
+    ((size) >= MEM_POOL_CLASS_MIN_SIZE) && ((size) <= MEM_POOL_CLASS_MAX_SIZE)
+
+FW_STATIC_ASSERT(2 * MEM_MAGIC_SIZE == (int)MEM_POOL_GUARD_SIZE, mem_pool_guard_size_mismatch);
+FW_STATIC_ASSERT(1 MEM_POOL_CLASS_LIST(MEM_POOL_X_VALID), mem_pool_class_invalid);
+FW_STATIC_ASSERT(MEM_POOL_CLASS_COUNT >= 1 && MEM_POOL_CLASS_COUNT <= 254, mem_pool_class_count_out_of_range);
+FW_STATIC_ASSERT((unsigned long)MEM_POOL_TOTAL_BLOCKS < (unsigned long)MEM_POOL_INDEX_NONE, mem_pool_too_many_blocks);
+
+FW_STATIC_ASSERT(MEM_POOL_CACHE_DEPTH >= 1U && MEM_POOL_CACHE_DEPTH <= 255U, mem_pool_cache_depth_out_of_range);
+FW_STATIC_ASSERT(MEM_POOL_CACHE_BATCH >= 1U && MEM_POOL_CACHE_BATCH <= MEM_POOL_CACHE_DEPTH, mem_pool_cache_batch_out_of_range);
+
+#if MEM_POOL_POW2_BLOCKS
+#define MEM_POOL_X_POW2(size, count)  && MEM_POOL_IS_POW2(size)
+FW_STATIC_ASSERT(1 MEM_POOL_CLASS_LIST(MEM_POOL_X_POW2), mem_pool_sizes_not_pow2);
+#endif
+
+/* ==================== 尺寸类表（由 MEM_POOL_CLASS_LIST 编译期生成） ==================== */
+#define MEM_POOL_X_SIZE_ITEM(size, count)   (uint16_t)(size),
+#define MEM_POOL_X_COUNT_ITEM(size, count)  (AegisMemPoolIndex)(count),
+
+static const uint16_t g_mem_pool_class_size[MEM_POOL_CLASS_COUNT] = {
+    MEM_POOL_CLASS_LIST(MEM_POOL_X_SIZE_ITEM)
+};
+
+static const AegisMemPoolIndex g_mem_pool_class_count[MEM_POOL_CLASS_COUNT] = {
+    MEM_POOL_CLASS_LIST(MEM_POOL_X_COUNT_ITEM)
+};
 
 /* ==================== 内部辅助函数 ==================== */
 /*
@@ -56,104 +90,270 @@ static bool_t check_magic_numbers(const uint8_t* block_start, uint16_t block_siz
 }
 
 /*
- * @brief: 获取指针所属的区域和块索引
+ * @brief: 计算 log2(size)，非2的幂返回0
+ */
+static uint8_t calc_block_shift(uint16_t size) {
+    uint8_t shift = 0;
+
+    if (size == 0U || (size & (uint16_t)(size - 1U)) != 0U) {
+        return 0;
+    }
+
+    while ((uint16_t)(1U << shift) != size) {
+        shift++;
+    }
+
+    return shift;
+}
+
+/*
+ * @brief: 最低置位的位号（v != 0）
+ */
+static uint8_t lowest_bit(uint32_t v) {
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctz(v);
+#else
+    uint8_t index = 0U;
+
+    while ((v & 1U) == 0U) {
+        v >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/*
+ * @brief: 尺寸类表约束：首/末块大小与配置一致，相邻块大小递增且差值不小于分桶粒度
+ */
+static bool_t class_table_valid(void) {
+    uint32_t c;
+
+    if (g_mem_pool_class_size[0] != (uint16_t)MEM_POOL_CLASS_MIN_SIZE ||
+        g_mem_pool_class_size[MEM_POOL_CLASS_COUNT - 1] != (uint16_t)MEM_POOL_CLASS_MAX_SIZE) {
+        return FALSE;
+    }
+
+    for (c = 1U; c < (uint32_t)MEM_POOL_CLASS_COUNT; c++) {
+        if ((uint32_t)g_mem_pool_class_size[c] < (uint32_t)g_mem_pool_class_size[c - 1U] + MEM_POOL_CLASS_GRANULE) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/*
+ * @brief: 块起始地址
+ */
+static uint8_t* block_addr(const AegisMemPoolRegion* region, AegisMemPoolIndex block_idx) {
+    return region->start_addr + (uint32_t)block_idx * (uint32_t)region->block_size;
+}
+
+/*
+ * @brief: 请求大小 -> 最小可容纳的尺寸类（O(1)：查表 + 至多一次比较）
+ * @param size: 1 ~ MEM_POOL_MAX_ALLOC
+ */
+static uint8_t size_to_class(const AegisMemPool* pool, uint32_t size) {
+    uint8_t c = pool->size_class[(size - 1U) >> MEM_POOL_CLASS_GRANULE_SHIFT];
+
+    /* 桶内跨过一个尺寸类边界（相邻尺寸类之差 >= 分桶粒度，最多跨一个） */
+    if (size > (uint32_t)pool->regions[c].block_size - MEM_POOL_GUARD_SIZE) {
+        c++;
+    }
+    return c;
+}
+
+/*
+ * @brief: 从尺寸类 from 起查找第一个有空闲块的尺寸类
+ * @return: 尺寸类，MEM_POOL_CLASS_NONE 表示全部耗尽
+ */
+static uint8_t find_available_class(const AegisMemPool* pool, uint8_t from) {
+    uint32_t word = (uint32_t)from >> 5;
+    uint32_t bits = pool->class_avail[word] & (0xFFFFFFFFU << ((uint32_t)from & 31U));
+
+    while (bits == 0U) {
+        word++;
+        if (word >= (uint32_t)MEM_POOL_CLASS_WORDS) {
+            return MEM_POOL_CLASS_NONE;
+        }
+        bits = pool->class_avail[word];
+    }
+
+    return (uint8_t)((word << 5) + lowest_bit(bits));
+}
+
+static void set_class_avail(AegisMemPool* pool, uint8_t c, bool_t avail) {
+    uint32_t bit = 1UL << ((uint32_t)c & 31U);
+
+    if (avail) {
+        pool->class_avail[c >> 5] |= bit;
+    } else {
+        pool->class_avail[c >> 5] &= ~bit;
+    }
+}
+
+/*
+ * @brief: 获取指针所属的区域和块索引（2的幂模式查表；否则按区域结束偏移二分，4个尺寸类时2次比较）
  * @return: 区域索引，-1表示无效指针
  */
-static int8_t find_block_region(const AegisMemPool* pool, const void* ptr, uint8_t* block_idx) {
-    uint8_t r;
+static int16_t find_block_region(const AegisMemPool* pool, const void* ptr, AegisMemPoolIndex* block_idx) {
     const uint8_t* p = (const uint8_t*)ptr;
+    const AegisMemPoolRegion* region;
+    uint32_t offset;
+    uint32_t r;
+#if !MEM_POOL_POW2_BLOCKS
+    uint32_t hi;
+    uint32_t mid;
+#endif
 
     if (pool == NULL) {
         return -1;
     }
 
-    for (r = 0; r < 4; r++) {
-        const uint8_t* region_start = pool->regions[r].start_addr;
-        uint32_t region_size = (uint32_t)pool->regions[r].block_size *
-                               (uint32_t)pool->regions[r].block_count;
-        const uint8_t* region_end = region_start + region_size;
+    if (p < pool->buffer || p >= pool->buffer + MEM_POOL_TOTAL_SIZE) {
+        return -1;  /* 无效指针 */
+    }
 
-        if (p >= region_start && p < region_end) {
-            /* 计算块索引 */
-            uint32_t offset = (uint32_t)(p - region_start);
-            *block_idx = (uint8_t)(offset / (uint32_t)pool->regions[r].block_size);
-            return (int8_t)r;
+    offset = (uint32_t)(p - pool->buffer);
+
+#if MEM_POOL_POW2_BLOCKS
+    r = pool->region_map[offset / (uint32_t)MEM_POOL_CLASS_MIN_SIZE];
+#else
+    /* 区域按偏移递增：找第一个 end_offset > offset 的区域 */
+    r = 0U;
+    hi = (uint32_t)MEM_POOL_CLASS_COUNT - 1U;
+    while (r < hi) {
+        mid = (r + hi) >> 1;
+        if (offset < pool->regions[mid].end_offset) {
+            hi = mid;
+        } else {
+            r = mid + 1U;
         }
     }
+#endif
+
+    region = &pool->regions[r];
+    offset -= region->start_offset;
+
+#if MEM_POOL_POW2_BLOCKS
+    *block_idx = (AegisMemPoolIndex)(offset >> region->block_shift);
+#else
+    if (region->block_shift != 0U) {
+        *block_idx = (AegisMemPoolIndex)(offset >> region->block_shift);
+    } else {
+        *block_idx = (AegisMemPoolIndex)(offset / (uint32_t)region->block_size);
+    }
+#endif
 
-    return -1;  /* 无效指针 */
+    return (int16_t)r;
 }
 
 /*
- * @brief: 获取元数据的全局索引
+ * @brief: 获取元数据的全局索引（init 时预计算各区域基址）
  */
-static uint8_t get_meta_index(const AegisMemPool* pool, uint8_t region, uint8_t block_idx) {
-    uint8_t meta_idx = 0;
-    uint8_t r;
-
+static AegisMemPoolIndex get_meta_index(const AegisMemPool* pool, uint8_t region, AegisMemPoolIndex block_idx) {
     if (pool == NULL) {
         return 0;
     }
 
-    /* 累加前面区域的块数 */
-    for (r = 0; r < region; r++) {
-        meta_idx += pool->regions[r].block_count;
+    return (AegisMemPoolIndex)(pool->regions[region].meta_base + block_idx);
+}
+
+/*
+ * @brief: 按尺寸类表划分区域，并预计算查找参数（元数据基址/移位/偏移范围）
+ */
+static void init_region_lookup(AegisMemPool* pool) {
+    uint8_t* current_addr = pool->buffer;
+    AegisMemPoolIndex meta_base = 0;
+    uint8_t r;
+
+    for (r = 0; r < (uint8_t)MEM_POOL_CLASS_COUNT; r++) {
+        AegisMemPoolRegion* region = &pool->regions[r];
+
+        region->start_addr = current_addr;
+        region->block_size = g_mem_pool_class_size[r];
+        region->block_count = g_mem_pool_class_count[r];
+        region->meta_base = meta_base;
+        region->block_shift = calc_block_shift(region->block_size);
+        region->start_offset = (uint32_t)(region->start_addr - pool->buffer);
+        region->end_offset = region->start_offset +
+                             (uint32_t)region->block_size * (uint32_t)region->block_count;
+        meta_base = (AegisMemPoolIndex)(meta_base + region->block_count);
+        current_addr += (uint32_t)region->block_size * (uint32_t)region->block_count;
+
+#if MEM_POOL_POW2_BLOCKS
+        {
+            uint32_t i;
+            for (i = region->start_offset / (uint32_t)MEM_POOL_CLASS_MIN_SIZE;
+                 i < region->end_offset / (uint32_t)MEM_POOL_CLASS_MIN_SIZE; i++) {
+                pool->region_map[i] = r;
+            }
+        }
+#endif
     }
+}
 
-    meta_idx += block_idx;
-    return meta_idx;
+/*
+ * @brief: 构建 请求大小 -> 尺寸类 查找表：每桶记录可容纳该桶最小请求的尺寸类
+ */
+static void init_size_map(AegisMemPool* pool) {
+    uint32_t bucket;
+    uint8_t c = 0;
+
+    for (bucket = 0; bucket < (uint32_t)MEM_POOL_SIZE_MAP_SIZE; bucket++) {
+        while ((uint32_t)pool->regions[c].block_size - MEM_POOL_GUARD_SIZE <
+               (bucket << MEM_POOL_CLASS_GRANULE_SHIFT) + 1U) {
+            c++;
+        }
+        pool->size_class[bucket] = c;
+    }
 }
 
 /*
- * @brief: 初始化区域的空闲链表
+ * @brief: 初始化区域的空闲链表（链接存放在空闲块开头，宽度为 AegisMemPoolIndex）
  */
 static void init_free_list(AegisMemPool* pool, uint8_t region) {
-    uint8_t i;
-    uint8_t* block_addr;
+    AegisMemPoolIndex i;
+    AegisMemPoolIndex next;
 
     if (pool == NULL) {
         return;
     }
 
-    /* 构建空闲链表：block[0]->block[1]->...->0xFF */
+    /* 构建空闲链表：block[0]->block[1]->...->MEM_POOL_INDEX_NONE */
     for (i = 0; i < pool->regions[region].block_count; i++) {
-        block_addr = pool->regions[region].start_addr +
-                     (uint32_t)i * (uint32_t)pool->regions[region].block_size;
-
-        if (i < pool->regions[region].block_count - 1) {
-            /* 前2字节存储下一个块的索引 */
-            block_addr[0] = (uint8_t)(i + 1);
-        } else {
-            /* 最后一个块指向结束标记 */
-            block_addr[0] = FREE_LIST_END;
-        }
+        next = (i + 1U < (uint32_t)pool->regions[region].block_count) ? (AegisMemPoolIndex)(i + 1U)
+                                                                       : MEM_POOL_INDEX_NONE;
+        memcpy(block_addr(&pool->regions[region], i), &next, sizeof(next));
     }
 
     /* 链表头指向第0块 */
     pool->regions[region].free_list_head = 0;
+    set_class_avail(pool, region, TRUE);
 }
 
 /*
  * @brief: 从空闲链表分配一块
- * @return: 块索引，FREE_LIST_END表示无空闲块
+ * @return: 块索引，MEM_POOL_INDEX_NONE表示无空闲块
  */
-static uint8_t alloc_from_free_list(AegisMemPool* pool, uint8_t region) {
-    uint8_t block_idx;
-    uint8_t* block_addr;
+static AegisMemPoolIndex alloc_from_free_list(AegisMemPool* pool, uint8_t region) {
+    AegisMemPoolRegion* r;
+    AegisMemPoolIndex block_idx;
 
     if (pool == NULL) {
-        return FREE_LIST_END;
+        return MEM_POOL_INDEX_NONE;
     }
 
-    block_idx = pool->regions[region].free_list_head;
-
-    if (block_idx != FREE_LIST_END) {
-        /* 取出链表头 */
-        block_addr = pool->regions[region].start_addr +
-                     (uint32_t)block_idx * (uint32_t)pool->regions[region].block_size;
+    r = &pool->regions[region];
+    block_idx = r->free_list_head;
 
+    if (block_idx != MEM_POOL_INDEX_NONE) {
         /* 更新链表头为下一个空闲块 */
-        pool->regions[region].free_list_head = block_addr[0];
+        memcpy(&r->free_list_head, block_addr(r, block_idx), sizeof(r->free_list_head));
+        if (r->free_list_head == MEM_POOL_INDEX_NONE) {
+            set_class_avail(pool, region, FALSE);
+        }
     }
 
     return block_idx;
@@ -162,70 +362,199 @@ static uint8_t alloc_from_free_list(AegisMemPool* pool, uint8_t region) {
 /*
  * @brief: 将块归还到空闲链表
  */
-static void free_to_list(AegisMemPool* pool, uint8_t region, uint8_t block_idx) {
-    uint8_t* block_addr;
+static void free_to_list(AegisMemPool* pool, uint8_t region, AegisMemPoolIndex block_idx) {
+    AegisMemPoolRegion* r;
 
     if (pool == NULL) {
         return;
     }
 
-    block_addr = pool->regions[region].start_addr +
-                 (uint32_t)block_idx * (uint32_t)pool->regions[region].block_size;
-
     /* 插入链表头 */
-    block_addr[0] = pool->regions[region].free_list_head;
-    pool->regions[region].free_list_head = block_idx;
+    r = &pool->regions[region];
+    memcpy(block_addr(r, block_idx), &r->free_list_head, sizeof(r->free_list_head));
+    r->free_list_head = block_idx;
+    set_class_avail(pool, region, TRUE);
+}
+
+/*
+ * @brief: 从区域空闲链表取出一块并计入统计（调用方持有临界区）
+ * @return: 块索引，MEM_POOL_INDEX_NONE表示无空闲块
+ */
+static AegisMemPoolIndex take_block(AegisMemPool* pool, uint8_t region) {
+    AegisMemPoolRegion* r;
+    AegisMemPoolIndex block_idx;
+
+    block_idx = alloc_from_free_list(pool, region);
+    if (block_idx != MEM_POOL_INDEX_NONE) {
+        r = &pool->regions[region];
+        r->used_count++;
+        if (r->used_count > r->peak_usage) {
+            r->peak_usage = r->used_count;
+        }
+
+        pool->used_blocks++;
+        if (pool->used_blocks > pool->peak_usage) {
+            pool->peak_usage = pool->used_blocks;
+        }
+    }
+
+    return block_idx;
+}
+
+/*
+ * @brief: 把一块归还区域空闲链表并扣减统计（调用方持有临界区）
+ */
+static void return_block(AegisMemPool* pool, uint8_t region, AegisMemPoolIndex block_idx) {
+    free_to_list(pool, region, block_idx);
+    pool->regions[region].used_count--;
+    pool->used_blocks--;
+}
+
+/*
+ * @brief: 把已取出的块交给调用方：写魔法数与元数据，返回用户指针
+ * @param fence: 在临界区外调用时为 TRUE：魔法数写完后加内存屏障再置 is_used，
+ *               保证 check_all_magic 不会看到未写完魔法数的已用块
+ */
+static void* claim_block(AegisMemPool* pool, uint8_t region, AegisMemPoolIndex block_idx,
+                         const char* file, uint32_t line, bool_t fence) {
+    AegisMemPoolRegion* r;
+    AegisMemPoolBlockMeta* meta;
+    uint8_t* block_start;
+
+    r = &pool->regions[region];
+    meta = &pool->meta[get_meta_index(pool, region, block_idx)];
+    block_start = block_addr(r, block_idx);
+
+    write_magic_numbers(block_start, r->block_size);
+
+    meta->block_type = region;
+    meta->alloc_file = file;
+    meta->alloc_line = line;
+    if (fence) {
+        aegis_critical_barrier();
+    }
+    meta->is_used = TRUE;
+
+    /* 返回用户可用指针（跳过头部魔法数） */
+    return (void*)(block_start + MEM_MAGIC_SIZE);
+}
+
+/*
+ * @brief: 把用户指针映射为区域与块索引（只读 init 后不变的查找表，可在临界区外调用）
+ * @return: TRUE=ptr 是某块的用户指针
+ */
+static bool_t resolve_user_ptr(const AegisMemPool* pool, const void* ptr, uint8_t* region,
+                               AegisMemPoolIndex* block_idx) {
+    const uint8_t* block_start;
+    int16_t r;
+
+    if ((ulong_t)ptr < (ulong_t)MEM_MAGIC_SIZE) {
+        return FALSE;
+    }
+
+    block_start = ((const uint8_t*)ptr) - MEM_MAGIC_SIZE;
+    r = find_block_region(pool, block_start, block_idx);
+    if (r < 0 || block_addr(&pool->regions[r], *block_idx) != block_start) {
+        return FALSE;
+    }
+
+    *region = (uint8_t)r;
+    return TRUE;
+}
+
+/*
+ * @brief: 巡检游标越过区域末尾时转到下一区域（跳过空区域）；全部区域扫完即完成一轮
+ */
+static void scrub_advance(AegisMemPool* pool) {
+    while (pool->scrub_block >= pool->regions[pool->scrub_region].block_count) {
+        pool->scrub_block = 0;
+        pool->scrub_region++;
+        if (pool->scrub_region >= (uint8_t)MEM_POOL_CLASS_COUNT) {
+            pool->scrub_region = 0;
+            pool->scrub_last = pool->scrub_found;
+            pool->scrub_found = 0;
+            pool->scrub_sweeps++;
+        }
+    }
+}
+
+/*
+ * @brief: 从共享空闲链表为缓存取回一批块（一次临界区）
+ */
+static void cache_refill(AegisMemPoolCache* cache, uint8_t region) {
+    AegisMemPool* pool = cache->pool;
+    AegisMemPoolIndex block_idx;
+    uint8_t n = cache->count[region];
+
+    ENTER_CRITICAL();
+    while (n < (uint8_t)MEM_POOL_CACHE_BATCH) {
+        block_idx = take_block(pool, region);
+        if (block_idx == MEM_POOL_INDEX_NONE) {
+            break;
+        }
+        cache->blocks[region][n] = block_idx;
+        n++;
+    }
+    EXIT_CRITICAL();
+
+    if (n != cache->count[region]) {
+        cache->count[region] = n;
+        cache->refills++;
+    }
+}
+
+/*
+ * @brief: 把缓存中最早放入的 n 块归还共享空闲链表（一次临界区），其余块下移
+ */
+static void cache_flush_class(AegisMemPoolCache* cache, uint8_t region, uint8_t n) {
+    AegisMemPool* pool = cache->pool;
+    uint8_t i;
+
+    if (n > cache->count[region]) {
+        n = cache->count[region];
+    }
+    if (n == 0U) {
+        return;
+    }
+
+    ENTER_CRITICAL();
+    for (i = 0; i < n; i++) {
+        return_block(pool, region, cache->blocks[region][i]);
+    }
+    EXIT_CRITICAL();
+
+    /* 栈顶是最近释放的块（更可能仍在 CPU 缓存中），保留在本上下文 */
+    for (i = n; i < cache->count[region]; i++) {
+        cache->blocks[region][i - n] = cache->blocks[region][i];
+    }
+    cache->count[region] = (uint8_t)(cache->count[region] - n);
+    cache->flushes++;
 }
 
 /* ==================== 公共接口实现 ==================== */
 AegisErrorCode aegis_mem_pool_init(AegisMemPool* pool, AegisTraceLog* trace) {
-    uint8_t i;
-    uint8_t* current_addr;
+    uint32_t i;
 
     if (pool == NULL) {
         return ERR_NULL_PTR;
     }
 
+    if (!class_table_valid()) {
+        return ERR_INVALID_PARAM;
+    }
+
     ENTER_CRITICAL();
 
     /* 初始化区域描述表 */
     memset(pool, 0, sizeof(AegisMemPool));
     pool->trace = trace;
-    current_addr = pool->buffer;
-
-    /* 区域0：小块 */
-    pool->regions[0].start_addr = current_addr;
-    pool->regions[0].block_size = MEM_POOL_SMALL_SIZE;
-    pool->regions[0].block_count = MEM_POOL_SMALL_COUNT;
-    pool->regions[0].used_count = 0;
-    pool->regions[0].peak_usage = 0;
-    current_addr += (uint32_t)MEM_POOL_SMALL_SIZE * (uint32_t)MEM_POOL_SMALL_COUNT;
-
-    /* 区域1：中块 */
-    pool->regions[1].start_addr = current_addr;
-    pool->regions[1].block_size = MEM_POOL_MEDIUM_SIZE;
-    pool->regions[1].block_count = MEM_POOL_MEDIUM_COUNT;
-    pool->regions[1].used_count = 0;
-    pool->regions[1].peak_usage = 0;
-    current_addr += (uint32_t)MEM_POOL_MEDIUM_SIZE * (uint32_t)MEM_POOL_MEDIUM_COUNT;
-
-    /* 区域2：大块 */
-    pool->regions[2].start_addr = current_addr;
-    pool->regions[2].block_size = MEM_POOL_LARGE_SIZE;
-    pool->regions[2].block_count = MEM_POOL_LARGE_COUNT;
-    pool->regions[2].used_count = 0;
-    pool->regions[2].peak_usage = 0;
-    current_addr += (uint32_t)MEM_POOL_LARGE_SIZE * (uint32_t)MEM_POOL_LARGE_COUNT;
-
-    /* 区域3：超大块 */
-    pool->regions[3].start_addr = current_addr;
-    pool->regions[3].block_size = MEM_POOL_XLARGE_SIZE;
-    pool->regions[3].block_count = MEM_POOL_XLARGE_COUNT;
-    pool->regions[3].used_count = 0;
-    pool->regions[3].peak_usage = 0;
+
+    /* 按尺寸类表划分区域，预计算 指针->块 与 大小->尺寸类 的查找参数 */
+    init_region_lookup(pool);
+    init_size_map(pool);
 
     /* 初始化所有元数据 */
-    for (i = 0; i < MEM_POOL_TOTAL_BLOCKS; i++) {
+    for (i = 0; i < (uint32_t)MEM_POOL_TOTAL_BLOCKS; i++) {
         pool->meta[i].is_used = FALSE;
         pool->meta[i].block_type = 0;
         pool->meta[i].alloc_file = NULL;
@@ -233,10 +562,11 @@ AegisErrorCode aegis_mem_pool_init(AegisMemPool* pool, AegisTraceLog* trace) {
     }
 
     /* 初始化所有区域的空闲链表 */
-    for (i = 0; i < 4; i++) {
-        init_free_list(pool, i);
+    for (i = 0; i < (uint32_t)MEM_POOL_CLASS_COUNT; i++) {
+        init_free_list(pool, (uint8_t)i);
     }
 
+    pool->used_blocks = 0;
     pool->peak_usage = 0;
     pool->is_initialized = TRUE;
 
@@ -246,67 +576,31 @@ AegisErrorCode aegis_mem_pool_init(AegisMemPool* pool, AegisTraceLog* trace) {
 }
 
 void* aegis_mem_pool_alloc(AegisMemPool* pool, uint32_t size, const char* file, uint32_t line) {
-    uint8_t* block_start;
     void* user_ptr;
     uint8_t region;
-    uint8_t block_idx;
-    uint8_t meta_idx;
-    uint8_t total_used;
+    AegisMemPoolIndex block_idx;
 
     if (pool == NULL || !pool->is_initialized) {
         return NULL;
     }
 
-    if (size == 0) {
+    /* 预留头尾魔法数字节 */
+    if (size == 0 || size > MEM_POOL_MAX_ALLOC) {
         return NULL;
     }
 
-    block_start = NULL;
     user_ptr = NULL;
 
-    ENTER_CRITICAL();
-
-    /* 选择合适的区域（从小到大尝试） */
-    for (region = 0; region < 4; region++) {
-        /* 预留头尾魔法数字节 */
-        if (size <= ((uint32_t)pool->regions[region].block_size - (uint32_t)(2U * MEM_MAGIC_SIZE))) {
-            /* 从空闲链表分配 - O(1) */
-            block_idx = alloc_from_free_list(pool, region);
-
-            if (block_idx != FREE_LIST_END) {
-                /* 找到空闲块 */
-                meta_idx = get_meta_index(pool, region, block_idx);
-
-                pool->meta[meta_idx].is_used = TRUE;
-                pool->meta[meta_idx].block_type = region;
-                pool->meta[meta_idx].alloc_file = file;
-                pool->meta[meta_idx].alloc_line = line;
-
-                block_start = (pool->regions[region].start_addr +
-                               (uint32_t)block_idx * (uint32_t)pool->regions[region].block_size);
-
-                /* 写入魔法数保护 */
-                write_magic_numbers(block_start, pool->regions[region].block_size);
+    /* 查找表在 init 后只读，可在临界区外查询 */
+    region = size_to_class(pool, size);
 
-                /* 返回用户可用指针（跳过头部魔法数） */
-                user_ptr = (void*)(block_start + MEM_MAGIC_SIZE);
-
-                /* 更新统计 */
-                pool->regions[region].used_count++;
-                if (pool->regions[region].used_count > pool->regions[region].peak_usage) {
-                    pool->regions[region].peak_usage = pool->regions[region].used_count;
-                }
-
-                /* 更新全局峰值 */
-                total_used = (uint8_t)(pool->regions[0].used_count + pool->regions[1].used_count +
-                             pool->regions[2].used_count + pool->regions[3].used_count);
-                if (total_used > pool->peak_usage) {
-                    pool->peak_usage = total_used;
-                }
+    ENTER_CRITICAL();
 
-                break;  /* 已找到 */
-            }
-        }
+    /* 最佳尺寸类耗尽时使用下一个有空闲块的更大尺寸类；从空闲链表分配 - O(1) */
+    region = find_available_class(pool, region);
+    if (region != MEM_POOL_CLASS_NONE) {
+        block_idx = take_block(pool, region);
+        user_ptr = claim_block(pool, region, block_idx, file, line, FALSE);
     }
 
     EXIT_CRITICAL();
@@ -323,9 +617,9 @@ void* aegis_mem_pool_alloc(AegisMemPool* pool, uint32_t size, const char* file,
 
 AegisErrorCode aegis_mem_pool_free(AegisMemPool* pool, void* ptr) {
     AegisErrorCode ret = ERR_MEM_POOL_INVALID;
-    int8_t region;
-    uint8_t block_idx;
-    uint8_t meta_idx;
+    int16_t region;
+    AegisMemPoolIndex block_idx;
+    AegisMemPoolIndex meta_idx;
     uint8_t* block_start;
     void* expected_user_ptr;
 
@@ -352,9 +646,7 @@ AegisErrorCode aegis_mem_pool_free(AegisMemPool* pool, void* ptr) {
     /* 查找指针所属区域 */
     region = find_block_region(pool, block_start, &block_idx);
     if (region >= 0) {
-        expected_user_ptr = (void*)(pool->regions[region].start_addr +
-                                    (uint32_t)block_idx * (uint32_t)pool->regions[region].block_size +
-                                    (uint32_t)MEM_MAGIC_SIZE);
+        expected_user_ptr = (void*)(block_addr(&pool->regions[region], block_idx) + MEM_MAGIC_SIZE);
         if (ptr != expected_user_ptr) {
             EXIT_CRITICAL();
             return ERR_MEM_POOL_INVALID;
@@ -379,11 +671,8 @@ AegisErrorCode aegis_mem_pool_free(AegisMemPool* pool, void* ptr) {
             pool->meta[meta_idx].alloc_file = NULL;
             pool->meta[meta_idx].alloc_line = 0;
 
-            /* 归还到空闲链表 - O(1) */
-            free_to_list(pool, (uint8_t)region, block_idx);
-
-            /* 更新统计 */
-            pool->regions[region].used_count--;
+            /* 归还到空闲链表并更新统计 - O(1) */
+            return_block(pool, (uint8_t)region, block_idx);
 
             ret = ERR_OK;
         } else {
@@ -404,7 +693,10 @@ AegisErrorCode aegis_mem_pool_free(AegisMemPool* pool, void* ptr) {
 }
 
 AegisErrorCode aegis_mem_pool_get_stats(const AegisMemPool* pool, AegisMemPoolStats* stats) {
-    uint8_t total_used;
+    const AegisMemPoolCache* cache;
+    AegisMemPoolIndex cached;
+    AegisMemPoolIndex total_cached;
+    uint32_t c;
 
     if (pool == NULL) {
         return ERR_NULL_PTR;
@@ -420,18 +712,30 @@ AegisErrorCode aegis_mem_pool_get_stats(const AegisMemPool* pool, AegisMemPoolSt
 
     ENTER_CRITICAL();
 
-    total_used = (uint8_t)(pool->regions[0].used_count + pool->regions[1].used_count +
-                 pool->regions[2].used_count + pool->regions[3].used_count);
+    /*
+     * 缓存计数由各上下文无锁修改，这里读到的是近似快照；
+     * 每个计数都不超过对应区域已取出的块数，扣减不会下溢
+     */
+    total_cached = 0;
+    for (c = 0; c < (uint32_t)MEM_POOL_CLASS_COUNT; c++) {
+        cached = 0;
+        for (cache = pool->caches; cache != NULL; cache = cache->next) {
+            cached = (AegisMemPoolIndex)(cached + cache->count[c]);
+        }
+        if (cached > pool->regions[c].used_count) {
+            cached = pool->regions[c].used_count;
+        }
+        stats->class_used[c] = (AegisMemPoolIndex)(pool->regions[c].used_count - cached);
+        total_cached = (AegisMemPoolIndex)(total_cached + cached);
+    }
 
-    stats->total_blocks = MEM_POOL_TOTAL_BLOCKS;
-    stats->used_blocks = total_used;
-    stats->free_blocks = stats->total_blocks - total_used;
+    stats->total_blocks = (AegisMemPoolIndex)MEM_POOL_TOTAL_BLOCKS;
+    stats->used_blocks = (AegisMemPoolIndex)(pool->used_blocks - total_cached);
+    stats->cached_blocks = total_cached;
+    stats->free_blocks = (AegisMemPoolIndex)(stats->total_blocks - pool->used_blocks);
     stats->peak_usage = pool->peak_usage;
-
-    stats->small_used = pool->regions[0].used_count;
-    stats->medium_used = pool->regions[1].used_count;
-    stats->large_used = pool->regions[2].used_count;
-    stats->xlarge_used = pool->regions[3].used_count;
+    stats->scrub_corrupted = pool->scrub_last;
+    stats->scrub_sweeps = pool->scrub_sweeps;
 
     EXIT_CRITICAL();
 
@@ -450,8 +754,8 @@ uint32_t aegis_mem_pool_get_total_size(void) {
 }
 
 AegisErrorCode aegis_mem_pool_check_magic(const AegisMemPool* pool, const void* ptr) {
-    int8_t region;
-    uint8_t block_idx;
+    int16_t region;
+    AegisMemPoolIndex block_idx;
     const uint8_t* block_start;
     const void* expected_user_ptr;
 
@@ -478,9 +782,7 @@ AegisErrorCode aegis_mem_pool_check_magic(const AegisMemPool* pool, const void*
 
     region = find_block_region(pool, block_start, &block_idx);
     if (region >= 0) {
-        expected_user_ptr = (const void*)(pool->regions[region].start_addr +
-                                          (uint32_t)block_idx * (uint32_t)pool->regions[region].block_size +
-                                          (uint32_t)MEM_MAGIC_SIZE);
+        expected_user_ptr = (const void*)(block_addr(&pool->regions[region], block_idx) + MEM_MAGIC_SIZE);
         if (ptr != expected_user_ptr) {
             EXIT_CRITICAL();
             return ERR_MEM_POOL_INVALID;
@@ -496,11 +798,11 @@ AegisErrorCode aegis_mem_pool_check_magic(const AegisMemPool* pool, const void*
     return ERR_MEM_POOL_INVALID;
 }
 
-AegisErrorCode aegis_mem_pool_check_all_magic(const AegisMemPool* pool, uint8_t* corrupted_count) {
+AegisErrorCode aegis_mem_pool_check_all_magic(const AegisMemPool* pool, AegisMemPoolIndex* corrupted_count) {
     uint8_t region;
-    uint8_t i;
-    uint8_t meta_idx;
-    uint8_t corrupted = 0;
+    AegisMemPoolIndex i;
+    AegisMemPoolIndex meta_idx;
+    AegisMemPoolIndex corrupted = 0;
 
     if (pool == NULL) {
         return ERR_NULL_PTR;
@@ -516,14 +818,12 @@ AegisErrorCode aegis_mem_pool_check_all_magic(const AegisMemPool* pool, uint8_t*
 
     ENTER_CRITICAL();
 
-    for (region = 0; region < 4; region++) {
+    for (region = 0; region < (uint8_t)MEM_POOL_CLASS_COUNT; region++) {
         for (i = 0; i < pool->regions[region].block_count; i++) {
             meta_idx = get_meta_index(pool, region, i);
 
             if (pool->meta[meta_idx].is_used) {
-                uint8_t* block_addr = pool->regions[region].start_addr +
-                                      (uint32_t)i * (uint32_t)pool->regions[region].block_size;
-                if (!check_magic_numbers(block_addr, pool->regions[region].block_size)) {
+                if (!check_magic_numbers(block_addr(&pool->regions[region], i), pool->regions[region].block_size)) {
                     corrupted++;
                 }
             }
@@ -536,3 +836,218 @@ AegisErrorCode aegis_mem_pool_check_all_magic(const AegisMemPool* pool, uint8_t*
 
     return (corrupted > 0) ? ERR_MEM_POOL_INVALID : ERR_OK;
 }
+
+AegisErrorCode aegis_mem_pool_scrub_step(AegisMemPool* pool, AegisMemPoolIndex* corrupted_count) {
+    const AegisMemPoolBlockMeta* meta;
+    const AegisMemPoolRegion* r;
+    const char* file;
+    uint32_t line;
+    uint32_t n;
+    bool_t bad;
+    uint8_t* block_start;
+    AegisMemPoolIndex corrupted = 0;
+
+    if (pool == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    for (n = 0; n < (uint32_t)MEM_POOL_SCRUB_BATCH; n++) {
+        scrub_advance(pool);
+        r = &pool->regions[pool->scrub_region];
+        block_start = block_addr(r, pool->scrub_block);
+        file = NULL;
+        line = 0U;
+
+        /* 每块单独一次临界区：与 check_all_magic 相同的可见性，但关中断时间与池大小无关 */
+        ENTER_CRITICAL();
+        meta = &pool->meta[get_meta_index(pool, pool->scrub_region, pool->scrub_block)];
+        bad = (meta->is_used && !check_magic_numbers(block_start, r->block_size)) ? TRUE : FALSE;
+        if (bad) {
+            file = meta->alloc_file;
+            line = meta->alloc_line;
+        }
+        EXIT_CRITICAL();
+
+        if (bad) {
+            corrupted++;
+            pool->scrub_found++;
+            if (pool->trace != NULL) {
+                aegis_trace_log_event(pool->trace, TRACE_EVENT_MEM_CORRUPT,
+                                      (file != NULL) ? file : "MEM-CORRUPT", line,
+                                      (uint32_t)((ulong_t)(block_start + MEM_MAGIC_SIZE) & 0xFFFFFFFFUL));
+            }
+        }
+
+        pool->scrub_block++;
+        scrub_advance(pool);
+    }
+
+    if (corrupted_count != NULL) {
+        *corrupted_count = corrupted;
+    }
+
+    return (corrupted > 0U) ? ERR_MEM_POOL_INVALID : ERR_OK;
+}
+
+AegisErrorCode aegis_mem_pool_cache_init(AegisMemPoolCache* cache, AegisMemPool* pool) {
+    AegisMemPoolCache* it;
+    uint8_t c;
+    uint8_t i;
+
+    if (cache == NULL || pool == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    ENTER_CRITICAL();
+
+    for (it = pool->caches; it != NULL && it != cache; it = it->next) {
+    }
+
+    if (it == NULL) {
+        memset(cache, 0, sizeof(AegisMemPoolCache));
+        cache->pool = pool;
+        cache->next = pool->caches;
+        pool->caches = cache;
+    } else {
+        /* 重复初始化：先归还仍缓存的块，保留链表位置 */
+        for (c = 0; c < (uint8_t)MEM_POOL_CLASS_COUNT; c++) {
+            for (i = 0; i < cache->count[c]; i++) {
+                return_block(pool, c, cache->blocks[c][i]);
+            }
+            cache->count[c] = 0;
+        }
+        cache->hits = 0;
+        cache->refills = 0;
+        cache->flushes = 0;
+    }
+
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+void* aegis_mem_pool_cache_alloc(AegisMemPoolCache* cache, uint32_t size, const char* file, uint32_t line) {
+    AegisMemPool* pool;
+    uint8_t region;
+    uint8_t c;
+    AegisMemPoolIndex block_idx;
+
+    if (cache == NULL || cache->pool == NULL || !cache->pool->is_initialized) {
+        return NULL;
+    }
+
+    if (size == 0 || size > MEM_POOL_MAX_ALLOC) {
+        return NULL;
+    }
+
+    pool = cache->pool;
+    region = size_to_class(pool, size);
+
+    if (cache->count[region] > 0U) {
+        cache->hits++;
+    } else {
+        cache_refill(cache, region);
+
+        /* 最佳尺寸类在共享链表中也已耗尽：先用本缓存中更大尺寸类的块 */
+        for (c = region; c < (uint8_t)MEM_POOL_CLASS_COUNT && cache->count[c] == 0U; c++) {
+        }
+        if (c >= (uint8_t)MEM_POOL_CLASS_COUNT) {
+            /* 再从共享池向上借用一块（不进缓存） */
+            block_idx = MEM_POOL_INDEX_NONE;
+            ENTER_CRITICAL();
+            region = find_available_class(pool, region);
+            if (region != MEM_POOL_CLASS_NONE) {
+                block_idx = take_block(pool, region);
+            }
+            EXIT_CRITICAL();
+
+            if (block_idx == MEM_POOL_INDEX_NONE) {
+                return NULL;
+            }
+            return claim_block(pool, region, block_idx, file, line, TRUE);
+        }
+        region = c;
+    }
+
+    cache->count[region]--;
+    return claim_block(pool, region, cache->blocks[region][cache->count[region]], file, line, TRUE);
+}
+
+AegisErrorCode aegis_mem_pool_cache_free(AegisMemPoolCache* cache, void* ptr) {
+    AegisMemPool* pool;
+    AegisMemPoolBlockMeta* meta;
+    uint8_t region;
+    AegisMemPoolIndex block_idx;
+
+    if (cache == NULL || ptr == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    pool = cache->pool;
+    if (pool == NULL || !pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    if (!resolve_user_ptr(pool, ptr, &region, &block_idx)) {
+        return ERR_MEM_POOL_INVALID;
+    }
+
+    meta = &pool->meta[get_meta_index(pool, region, block_idx)];
+
+    /* 检查并清除 is_used 须在同一临界区内：否则两个上下文同时释放同一指针都能通过检查，
+     * 该块进入两个缓存后被重复分配；巡检也不会看到半更新的元数据 */
+    ENTER_CRITICAL();
+    if (!meta->is_used) {
+        EXIT_CRITICAL();
+        return ERR_MEM_POOL_DOUBLE_FREE;
+    }
+
+    /* 释放前检查魔法数 */
+    if (!check_magic_numbers(((uint8_t*)ptr) - MEM_MAGIC_SIZE, pool->regions[region].block_size)) {
+        EXIT_CRITICAL();
+        return ERR_MEM_POOL_INVALID;
+    }
+
+    meta->is_used = FALSE;
+    meta->alloc_file = NULL;
+    meta->alloc_line = 0;
+    EXIT_CRITICAL();
+
+    /* 缓存已满时先归还一批，再放入本块 */
+    if (cache->count[region] >= (uint8_t)MEM_POOL_CACHE_DEPTH) {
+        cache_flush_class(cache, region, (uint8_t)MEM_POOL_CACHE_BATCH);
+    } else {
+        cache->hits++;
+    }
+
+    cache->blocks[region][cache->count[region]] = block_idx;
+    cache->count[region]++;
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_mem_pool_cache_flush(AegisMemPoolCache* cache) {
+    uint8_t c;
+
+    if (cache == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (cache->pool == NULL || !cache->pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    for (c = 0; c < (uint8_t)MEM_POOL_CLASS_COUNT; c++) {
+        cache_flush_class(cache, c, cache->count[c]);
+    }
+
+    return ERR_OK;
+}
@@ -0,0 +1,202 @@
+/*
+ * @file: object_pool.c
+ * @brief: 定长对象池核心实现（侵入式空闲链表 + 已分配位图 + 可选保护字）
+ * @author: jack liu
+ */
+
+#include "object_pool.h"
+#include "critical.h"
+#include <string.h>
+
+/* ==================== 内部辅助函数 ==================== */
+/*
+ * @brief: 槽位地址
+ */
+static uint8_t* slot_addr(const AegisObjectPool* pool, AegisObjectPoolIndex index) {
+    return pool->slots + (uint32_t)index * (uint32_t)pool->stride;
+}
+
+/*
+ * @brief: 读取/写入空闲链接（保存在槽位起始处，与对象共用空间）
+ */
+static AegisObjectPoolIndex read_link(const AegisObjectPool* pool, AegisObjectPoolIndex index) {
+    AegisObjectPoolIndex next;
+
+    memcpy(&next, slot_addr(pool, index), sizeof(next));
+    return next;
+}
+
+static void write_link(AegisObjectPool* pool, AegisObjectPoolIndex index, AegisObjectPoolIndex next) {
+    memcpy(slot_addr(pool, index), &next, sizeof(next));
+}
+
+#if OBJECT_POOL_GUARD
+/*
+ * @brief: 校验槽位保护字
+ */
+static bool_t guard_intact(const AegisObjectPool* pool, AegisObjectPoolIndex index) {
+    uint32_t guard;
+
+    memcpy(&guard, slot_addr(pool, index) + pool->guard_offset, sizeof(guard));
+    return (guard == (uint32_t)OBJECT_POOL_GUARD_WORD) ? TRUE : FALSE;
+}
+#endif
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_object_pool_init(AegisObjectPool* pool, void* slots, uint32_t* used_map,
+                                      uint16_t stride, uint16_t guard_offset, AegisObjectPoolIndex capacity) {
+    AegisObjectPoolIndex i;
+#if OBJECT_POOL_GUARD
+    uint32_t guard = (uint32_t)OBJECT_POOL_GUARD_WORD;
+#endif
+
+    if (pool == NULL || slots == NULL || used_map == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (capacity == 0U || capacity == OBJECT_POOL_INDEX_NONE || stride < (uint16_t)sizeof(AegisObjectPoolIndex)) {
+        return ERR_INVALID_PARAM;
+    }
+
+#if OBJECT_POOL_GUARD
+    if ((uint32_t)guard_offset + (uint32_t)sizeof(guard) > (uint32_t)stride) {
+        return ERR_INVALID_PARAM;
+    }
+#endif
+
+    ENTER_CRITICAL();
+
+    pool->slots = (uint8_t*)slots;
+    pool->used_map = used_map;
+    pool->stride = stride;
+    pool->guard_offset = guard_offset;
+    pool->capacity = capacity;
+    pool->used = 0;
+    pool->peak = 0;
+
+    memset(used_map, 0, (size_t)OBJECT_POOL_MAP_WORDS((uint32_t)capacity) * sizeof(uint32_t));
+
+    /* 空闲链表按下标递增串联，首次分配从槽位0开始 */
+    for (i = 0; i < capacity; i++) {
+        write_link(pool, i, (AegisObjectPoolIndex)((i + 1U < capacity) ? (i + 1U) : OBJECT_POOL_INDEX_NONE));
+#if OBJECT_POOL_GUARD
+        memcpy(slot_addr(pool, i) + guard_offset, &guard, sizeof(guard));
+#endif
+    }
+    pool->free_head = 0;
+    pool->is_initialized = TRUE;
+
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisObjectPoolIndex aegis_object_pool_take(AegisObjectPool* pool) {
+    AegisObjectPoolIndex index;
+
+    if (pool == NULL || !pool->is_initialized) {
+        return OBJECT_POOL_INDEX_NONE;
+    }
+
+    ENTER_CRITICAL();
+
+    index = pool->free_head;
+    if (index != OBJECT_POOL_INDEX_NONE) {
+        pool->free_head = read_link(pool, index);
+        pool->used_map[index >> 5] |= (uint32_t)1U << (index & 31U);
+        pool->used++;
+        if (pool->used > pool->peak) {
+            pool->peak = pool->used;
+        }
+    }
+
+    EXIT_CRITICAL();
+
+    return index;
+}
+
+AegisErrorCode aegis_object_pool_release(AegisObjectPool* pool, AegisObjectPoolIndex index) {
+    uint32_t bit;
+    AegisErrorCode ret = ERR_OK;
+
+    if (pool == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    if (index >= pool->capacity) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    bit = (uint32_t)1U << (index & 31U);
+
+    ENTER_CRITICAL();
+
+    if ((pool->used_map[index >> 5] & bit) == 0U) {
+        ret = ERR_MEM_POOL_DOUBLE_FREE;
+#if OBJECT_POOL_GUARD
+    } else if (!guard_intact(pool, index)) {
+        /* 对象越界写：不回收该槽位，避免损坏扩散到空闲链表 */
+        ret = ERR_MEM_POOL_INVALID;
+#endif
+    } else {
+        pool->used_map[index >> 5] &= ~bit;
+        write_link(pool, index, pool->free_head);
+        pool->free_head = index;
+        pool->used--;
+    }
+
+    EXIT_CRITICAL();
+
+    return ret;
+}
+
+AegisErrorCode aegis_object_pool_get_stats(const AegisObjectPool* pool, AegisObjectPoolStats* stats) {
+    if (pool == NULL || stats == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    ENTER_CRITICAL();
+    stats->capacity = pool->capacity;
+    stats->used = pool->used;
+    stats->peak = pool->peak;
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_object_pool_check_guards(const AegisObjectPool* pool, AegisObjectPoolIndex* corrupted) {
+    AegisObjectPoolIndex count = 0;
+#if OBJECT_POOL_GUARD
+    AegisObjectPoolIndex i;
+#endif
+
+    if (pool == NULL || corrupted == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!pool->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+#if OBJECT_POOL_GUARD
+    ENTER_CRITICAL();
+    for (i = 0; i < pool->capacity; i++) {
+        if (!guard_intact(pool, i)) {
+            count++;
+        }
+    }
+    EXIT_CRITICAL();
+#endif
+
+    *corrupted = count;
+
+    return (count > 0U) ? ERR_MEM_POOL_INVALID : ERR_OK;
+}
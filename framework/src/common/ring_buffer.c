@@ -2,6 +2,10 @@
  * @file: ring_buffer.c
  * @brief: DMA友善的环形缓冲区实现
  * @author: jack liu
+ *
+ * @note:
+ * - 2的幂容量：head/tail 为自由递增的16位计数，下标 = 计数 & mask，数据量 = head - tail。
+ * - 其他容量：head/tail 为物理下标，回绕用比较减法（避免 Cortex-M0 软件除法），数据量由 count 维护。
  */
 
 #include "ring_buffer.h"
@@ -11,17 +15,82 @@
 /* ==================== 内部辅助宏 ==================== */
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
+/* 宏实现：C89 无 inline，保证 -O0 下也无额外调用开销 */
+#if RING_BUFFER_POW2_ONLY
+#define RB_IS_POW2(rb)          (1)
+#else
+#define RB_IS_POW2(rb)          ((rb)->is_pow2)
+#endif
+
+/* 当前数据量 */
+#define RB_USED(rb) \
+    ((uint16_t)(RB_IS_POW2(rb) ? (uint16_t)((rb)->head - (rb)->tail) : (rb)->count))
+
+/* 位置 -> 物理下标 */
+#define RB_INDEX(rb, pos) \
+    ((uint16_t)(RB_IS_POW2(rb) ? ((pos) & (rb)->mask) : (pos)))
+
+/* ==================== 内部辅助函数 ==================== */
+/*
+ * @brief: 非2的幂模式下的回绕推进（pos < size 且 len <= size，比较减法代替取模）
+ */
+static uint16_t rb_wrap(const AegisRingBuffer* rb, uint16_t pos, uint16_t len) {
+    uint32_t next = (uint32_t)pos + (uint32_t)len;
+
+    if (next >= (uint32_t)rb->size) {
+        next -= (uint32_t)rb->size;
+    }
+
+    return (uint16_t)next;
+}
+
+/*
+ * @brief: 推进写位置（调用方保证 len <= 剩余空间）
+ */
+static void rb_advance_head(AegisRingBuffer* rb, uint16_t len) {
+    if (RB_IS_POW2(rb)) {
+        rb->head = (uint16_t)(rb->head + len);
+    } else {
+        rb->head = rb_wrap(rb, rb->head, len);
+        rb->count = (uint16_t)(rb->count + len);
+    }
+}
+
+/*
+ * @brief: 推进读位置（调用方保证 len <= 数据量）
+ */
+static void rb_advance_tail(AegisRingBuffer* rb, uint16_t len) {
+    if (RB_IS_POW2(rb)) {
+        rb->tail = (uint16_t)(rb->tail + len);
+    } else {
+        rb->tail = rb_wrap(rb, rb->tail, len);
+        rb->count = (uint16_t)(rb->count - len);
+    }
+}
+
 /* ==================== 公共接口实现 ==================== */
 AegisErrorCode aegis_ring_buffer_init(AegisRingBuffer* rb, uint8_t* buffer, uint16_t size) {
+    bool_t is_pow2;
+
     if (rb == NULL || buffer == NULL || size == 0) {
         return ERR_INVALID_PARAM;
     }
 
+    is_pow2 = ((size & (uint16_t)(size - 1U)) == 0U) ? TRUE : FALSE;
+
+#if RING_BUFFER_POW2_ONLY
+    if (!is_pow2) {
+        return ERR_INVALID_PARAM;
+    }
+#endif
+
     rb->buffer = buffer;
     rb->size = size;
+    rb->mask = (uint16_t)(size - 1U);
     rb->head = 0;
     rb->tail = 0;
     rb->count = 0;
+    rb->is_pow2 = is_pow2;
 
     return ERR_OK;
 }
@@ -34,15 +103,19 @@ AegisErrorCode aegis_ring_buffer_put(AegisRingBuffer* rb, uint8_t data) {
     ENTER_CRITICAL();
 
     /* 检查是否已满 */
-    if (rb->count >= rb->size) {
+    if (RB_USED(rb) >= rb->size) {
         EXIT_CRITICAL();
         return ERR_OUT_OF_RANGE;
     }
 
     /* 写入数据 */
-    rb->buffer[rb->head] = data;
-    rb->head = (uint16_t)((rb->head + 1) % rb->size);
-    rb->count++;
+    rb->buffer[RB_INDEX(rb, rb->head)] = data;
+    if (RB_IS_POW2(rb)) {
+        rb->head++;
+    } else {
+        rb->head = (uint16_t)((rb->head + 1U == rb->size) ? 0U : rb->head + 1U);
+        rb->count++;
+    }
 
     EXIT_CRITICAL();
 
@@ -57,15 +130,19 @@ AegisErrorCode aegis_ring_buffer_get(AegisRingBuffer* rb, uint8_t* data) {
     ENTER_CRITICAL();
 
     /* 检查是否为空 */
-    if (rb->count == 0) {
+    if (RB_USED(rb) == 0) {
         EXIT_CRITICAL();
         return ERR_OUT_OF_RANGE;
     }
 
     /* 读取数据 */
-    *data = rb->buffer[rb->tail];
-    rb->tail = (uint16_t)((rb->tail + 1) % rb->size);
-    rb->count--;
+    *data = rb->buffer[RB_INDEX(rb, rb->tail)];
+    if (RB_IS_POW2(rb)) {
+        rb->tail++;
+    } else {
+        rb->tail = (uint16_t)((rb->tail + 1U == rb->size) ? 0U : rb->tail + 1U);
+        rb->count--;
+    }
 
     EXIT_CRITICAL();
 
@@ -75,6 +152,7 @@ AegisErrorCode aegis_ring_buffer_get(AegisRingBuffer* rb, uint8_t* data) {
 uint16_t aegis_ring_buffer_write(AegisRingBuffer* rb, const uint8_t* data, uint16_t len) {
     uint16_t written = 0;
     uint16_t free_space;
+    uint16_t idx;
     uint16_t to_end;
     uint16_t chunk1;
     uint16_t chunk2;
@@ -86,26 +164,26 @@ uint16_t aegis_ring_buffer_write(AegisRingBuffer* rb, const uint8_t* data, uint1
     ENTER_CRITICAL();
 
     /* 计算可写空间 */
-    free_space = rb->size - rb->count;
+    free_space = (uint16_t)(rb->size - RB_USED(rb));
     written = MIN(len, free_space);
 
     if (written > 0) {
         /* 计算到缓冲区末尾的距离 */
-        to_end = rb->size - rb->head;
+        idx = RB_INDEX(rb, rb->head);
+        to_end = (uint16_t)(rb->size - idx);
 
         if (written <= to_end) {
             /* 一次拷贝完成 */
-            memcpy(&rb->buffer[rb->head], data, written);
+            memcpy(&rb->buffer[idx], data, written);
         } else {
             /* 分两次拷贝：先到末尾，再从头开始 */
             chunk1 = to_end;
-            chunk2 = written - chunk1;
-            memcpy(&rb->buffer[rb->head], data, chunk1);
+            chunk2 = (uint16_t)(written - chunk1);
+            memcpy(&rb->buffer[idx], data, chunk1);
             memcpy(&rb->buffer[0], &data[chunk1], chunk2);
         }
 
-        rb->head = (uint16_t)((rb->head + written) % rb->size);
-        rb->count += written;
+        rb_advance_head(rb, written);
     }
 
     EXIT_CRITICAL();
@@ -115,6 +193,8 @@ uint16_t aegis_ring_buffer_write(AegisRingBuffer* rb, const uint8_t* data, uint1
 
 uint16_t aegis_ring_buffer_read(AegisRingBuffer* rb, uint8_t* data, uint16_t len) {
     uint16_t read_len = 0;
+    uint16_t used;
+    uint16_t idx;
     uint16_t to_end;
     uint16_t chunk1;
     uint16_t chunk2;
@@ -126,25 +206,26 @@ uint16_t aegis_ring_buffer_read(AegisRingBuffer* rb, uint8_t* data, uint16_t len
     ENTER_CRITICAL();
 
     /* 计算可读数据量 */
-    read_len = MIN(len, rb->count);
+    used = RB_USED(rb);
+    read_len = MIN(len, used);
 
     if (read_len > 0) {
         /* 计算到缓冲区末尾的距离 */
-        to_end = rb->size - rb->tail;
+        idx = RB_INDEX(rb, rb->tail);
+        to_end = (uint16_t)(rb->size - idx);
 
         if (read_len <= to_end) {
             /* 一次拷贝完成 */
-            memcpy(data, &rb->buffer[rb->tail], read_len);
+            memcpy(data, &rb->buffer[idx], read_len);
         } else {
             /* 分两次拷贝：先到末尾，再从头开始 */
             chunk1 = to_end;
-            chunk2 = read_len - chunk1;
-            memcpy(data, &rb->buffer[rb->tail], chunk1);
+            chunk2 = (uint16_t)(read_len - chunk1);
+            memcpy(data, &rb->buffer[idx], chunk1);
             memcpy(&data[chunk1], &rb->buffer[0], chunk2);
         }
 
-        rb->tail = (uint16_t)((rb->tail + read_len) % rb->size);
-        rb->count -= read_len;
+        rb_advance_tail(rb, read_len);
     }
 
     EXIT_CRITICAL();
@@ -154,6 +235,7 @@ uint16_t aegis_ring_buffer_read(AegisRingBuffer* rb, uint8_t* data, uint16_t len
 
 uint16_t aegis_ring_buffer_get_write_ptr(AegisRingBuffer* rb, uint8_t** ptr) {
     uint16_t free_space;
+    uint16_t idx;
     uint16_t to_end;
     uint16_t continuous;
 
@@ -164,14 +246,15 @@ uint16_t aegis_ring_buffer_get_write_ptr(AegisRingBuffer* rb, uint8_t** ptr) {
     ENTER_CRITICAL();
 
     /* 计算可写空间 */
-    free_space = rb->size - rb->count;
-    to_end = rb->size - rb->head;
+    free_space = (uint16_t)(rb->size - RB_USED(rb));
+    idx = RB_INDEX(rb, rb->head);
+    to_end = (uint16_t)(rb->size - idx);
 
     /* 连续可写空间 = MIN(剩余空间, 到末尾距离) */
     continuous = MIN(free_space, to_end);
 
     if (continuous > 0) {
-        *ptr = &rb->buffer[rb->head];
+        *ptr = &rb->buffer[idx];
     } else {
         *ptr = NULL;
     }
@@ -186,14 +269,14 @@ AegisErrorCode aegis_ring_buffer_commit_write(AegisRingBuffer* rb, uint16_t len)
         return ERR_NULL_PTR;
     }
 
-    if (len > (rb->size - rb->count)) {
+    ENTER_CRITICAL();
+
+    if (len > (uint16_t)(rb->size - RB_USED(rb))) {
+        EXIT_CRITICAL();
         return ERR_OUT_OF_RANGE;
     }
 
-    ENTER_CRITICAL();
-
-    rb->head = (uint16_t)((rb->head + len) % rb->size);
-    rb->count += len;
+    rb_advance_head(rb, len);
 
     EXIT_CRITICAL();
 
@@ -201,6 +284,8 @@ AegisErrorCode aegis_ring_buffer_commit_write(AegisRingBuffer* rb, uint16_t len)
 }
 
 uint16_t aegis_ring_buffer_get_read_ptr(AegisRingBuffer* rb, uint8_t** ptr) {
+    uint16_t used;
+    uint16_t idx;
     uint16_t to_end;
     uint16_t continuous;
 
@@ -211,13 +296,15 @@ uint16_t aegis_ring_buffer_get_read_ptr(AegisRingBuffer* rb, uint8_t** ptr) {
     ENTER_CRITICAL();
 
     /* 计算到末尾的距离 */
-    to_end = rb->size - rb->tail;
+    idx = RB_INDEX(rb, rb->tail);
+    to_end = (uint16_t)(rb->size - idx);
 
     /* 连续可读空间 = MIN(当前数据量, 到末尾距离) */
-    continuous = MIN(rb->count, to_end);
+    used = RB_USED(rb);
+    continuous = MIN(used, to_end);
 
     if (continuous > 0) {
-        *ptr = &rb->buffer[rb->tail];
+        *ptr = &rb->buffer[idx];
     } else {
         *ptr = NULL;
     }
@@ -232,14 +319,14 @@ AegisErrorCode aegis_ring_buffer_commit_read(AegisRingBuffer* rb, uint16_t len)
         return ERR_NULL_PTR;
     }
 
-    if (len > rb->count) {
+    ENTER_CRITICAL();
+
+    if (len > RB_USED(rb)) {
+        EXIT_CRITICAL();
         return ERR_OUT_OF_RANGE;
     }
 
-    ENTER_CRITICAL();
-
-    rb->tail = (uint16_t)((rb->tail + len) % rb->size);
-    rb->count -= len;
+    rb_advance_tail(rb, len);
 
     EXIT_CRITICAL();
 
@@ -254,7 +341,7 @@ uint16_t aegis_ring_buffer_get_count(const AegisRingBuffer* rb) {
     }
 
     ENTER_CRITICAL();
-    count = rb->count;
+    count = RB_USED(rb);
     EXIT_CRITICAL();
 
     return count;
@@ -268,7 +355,7 @@ uint16_t aegis_ring_buffer_get_free(const AegisRingBuffer* rb) {
     }
 
     ENTER_CRITICAL();
-    free_space = rb->size - rb->count;
+    free_space = (uint16_t)(rb->size - RB_USED(rb));
     EXIT_CRITICAL();
 
     return free_space;
@@ -0,0 +1,269 @@
+/*
+ * @file: ring_buffer_spsc.c
+ * @brief: 无锁单生产者/单消费者环形缓冲区实现
+ * @author: jack liu
+ */
+
+#include "ring_buffer_spsc.h"
+#include "atomic_ops.h"
+#include <string.h>
+
+/* ==================== 内部辅助宏 ==================== */
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* ==================== 内部辅助函数 ==================== */
+/*
+ * @brief: 拷入环形区（处理回绕）
+ */
+static void copy_in(AegisRingBufferSpsc* rb, uint32_t pos, const uint8_t* data, uint16_t len) {
+    uint32_t idx = pos & rb->mask;
+    uint32_t to_end = (uint32_t)rb->size - idx;
+
+    if ((uint32_t)len <= to_end) {
+        memcpy(&rb->buffer[idx], data, len);
+    } else {
+        memcpy(&rb->buffer[idx], data, to_end);
+        memcpy(&rb->buffer[0], &data[to_end], (uint32_t)len - to_end);
+    }
+}
+
+/*
+ * @brief: 从环形区拷出（处理回绕）
+ */
+static void copy_out(const AegisRingBufferSpsc* rb, uint32_t pos, uint8_t* data, uint16_t len) {
+    uint32_t idx = pos & rb->mask;
+    uint32_t to_end = (uint32_t)rb->size - idx;
+
+    if ((uint32_t)len <= to_end) {
+        memcpy(data, &rb->buffer[idx], len);
+    } else {
+        memcpy(data, &rb->buffer[idx], to_end);
+        memcpy(&data[to_end], &rb->buffer[0], (uint32_t)len - to_end);
+    }
+}
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_ring_buffer_spsc_init(AegisRingBufferSpsc* rb, uint8_t* buffer, uint16_t size) {
+    if (rb == NULL || buffer == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    /* 仅支持2的幂：掩码取下标，自由递增计数的差值即为数据量 */
+    if (size == 0U || (size & (uint16_t)(size - 1U)) != 0U) {
+        return ERR_INVALID_PARAM;
+    }
+
+    rb->buffer = buffer;
+    rb->size = size;
+    rb->mask = (uint32_t)size - 1U;
+    rb->head = 0U;
+    rb->tail = 0U;
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_ring_buffer_spsc_put(AegisRingBufferSpsc* rb, uint8_t data) {
+    uint32_t head;
+    uint32_t tail;
+
+    if (rb == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    head = AEGIS_ATOMIC_LOAD_RELAXED(&rb->head);
+    tail = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->tail);
+
+    if ((uint32_t)(head - tail) >= (uint32_t)rb->size) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    rb->buffer[head & rb->mask] = data;
+    AEGIS_ATOMIC_STORE_RELEASE(&rb->head, head + 1U);
+
+    return ERR_OK;
+}
+
+uint16_t aegis_ring_buffer_spsc_write(AegisRingBufferSpsc* rb, const uint8_t* data, uint16_t len) {
+    uint32_t head;
+    uint32_t tail;
+    uint16_t free_space;
+    uint16_t written;
+
+    if (rb == NULL || data == NULL || len == 0U) {
+        return 0;
+    }
+
+    head = AEGIS_ATOMIC_LOAD_RELAXED(&rb->head);
+    tail = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->tail);
+
+    free_space = (uint16_t)((uint32_t)rb->size - (head - tail));
+    written = MIN(len, free_space);
+
+    if (written > 0U) {
+        copy_in(rb, head, data, written);
+        AEGIS_ATOMIC_STORE_RELEASE(&rb->head, head + (uint32_t)written);
+    }
+
+    return written;
+}
+
+uint16_t aegis_ring_buffer_spsc_get_write_ptr(AegisRingBufferSpsc* rb, uint8_t** ptr) {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t idx;
+    uint32_t free_space;
+    uint32_t to_end;
+
+    if (rb == NULL || ptr == NULL) {
+        return 0;
+    }
+
+    head = AEGIS_ATOMIC_LOAD_RELAXED(&rb->head);
+    tail = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->tail);
+
+    idx = head & rb->mask;
+    free_space = (uint32_t)rb->size - (head - tail);
+    to_end = (uint32_t)rb->size - idx;
+
+    *ptr = &rb->buffer[idx];
+    return (uint16_t)MIN(free_space, to_end);
+}
+
+AegisErrorCode aegis_ring_buffer_spsc_commit_write(AegisRingBufferSpsc* rb, uint16_t len) {
+    uint32_t head;
+    uint32_t tail;
+
+    if (rb == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    head = AEGIS_ATOMIC_LOAD_RELAXED(&rb->head);
+    tail = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->tail);
+
+    if ((uint32_t)len > (uint32_t)rb->size - (head - tail)) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    AEGIS_ATOMIC_STORE_RELEASE(&rb->head, head + (uint32_t)len);
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_ring_buffer_spsc_get(AegisRingBufferSpsc* rb, uint8_t* data) {
+    uint32_t head;
+    uint32_t tail;
+
+    if (rb == NULL || data == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    tail = AEGIS_ATOMIC_LOAD_RELAXED(&rb->tail);
+    head = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->head);
+
+    if (head == tail) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    *data = rb->buffer[tail & rb->mask];
+    AEGIS_ATOMIC_STORE_RELEASE(&rb->tail, tail + 1U);
+
+    return ERR_OK;
+}
+
+uint16_t aegis_ring_buffer_spsc_read(AegisRingBufferSpsc* rb, uint8_t* data, uint16_t len) {
+    uint32_t head;
+    uint32_t tail;
+    uint16_t used;
+    uint16_t read_len;
+
+    if (rb == NULL || data == NULL || len == 0U) {
+        return 0;
+    }
+
+    tail = AEGIS_ATOMIC_LOAD_RELAXED(&rb->tail);
+    head = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->head);
+
+    used = (uint16_t)(head - tail);
+    read_len = MIN(len, used);
+
+    if (read_len > 0U) {
+        copy_out(rb, tail, data, read_len);
+        AEGIS_ATOMIC_STORE_RELEASE(&rb->tail, tail + (uint32_t)read_len);
+    }
+
+    return read_len;
+}
+
+uint16_t aegis_ring_buffer_spsc_get_read_ptr(AegisRingBufferSpsc* rb, uint8_t** ptr) {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t idx;
+    uint32_t used;
+    uint32_t to_end;
+
+    if (rb == NULL || ptr == NULL) {
+        return 0;
+    }
+
+    tail = AEGIS_ATOMIC_LOAD_RELAXED(&rb->tail);
+    head = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->head);
+
+    idx = tail & rb->mask;
+    used = head - tail;
+    to_end = (uint32_t)rb->size - idx;
+
+    *ptr = &rb->buffer[idx];
+    return (uint16_t)MIN(used, to_end);
+}
+
+AegisErrorCode aegis_ring_buffer_spsc_commit_read(AegisRingBufferSpsc* rb, uint16_t len) {
+    uint32_t head;
+    uint32_t tail;
+
+    if (rb == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    tail = AEGIS_ATOMIC_LOAD_RELAXED(&rb->tail);
+    head = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->head);
+
+    if ((uint32_t)len > head - tail) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    AEGIS_ATOMIC_STORE_RELEASE(&rb->tail, tail + (uint32_t)len);
+
+    return ERR_OK;
+}
+
+uint16_t aegis_ring_buffer_spsc_get_count(const AegisRingBufferSpsc* rb) {
+    uint32_t head;
+    uint32_t tail;
+
+    if (rb == NULL) {
+        return 0;
+    }
+
+    /* 先读 tail 再读 head：并发下结果可能偏大于真实值，但不会超过 size */
+    tail = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->tail);
+    head = AEGIS_ATOMIC_LOAD_ACQUIRE(&rb->head);
+
+    return (uint16_t)MIN(head - tail, (uint32_t)rb->size);
+}
+
+uint16_t aegis_ring_buffer_spsc_get_free(const AegisRingBufferSpsc* rb) {
+    if (rb == NULL) {
+        return 0;
+    }
+
+    return (uint16_t)(rb->size - aegis_ring_buffer_spsc_get_count(rb));
+}
+
+void aegis_ring_buffer_spsc_clear(AegisRingBufferSpsc* rb) {
+    if (rb == NULL) {
+        return;
+    }
+
+    AEGIS_ATOMIC_STORE_RELEASE(&rb->tail, 0U);
+    AEGIS_ATOMIC_STORE_RELEASE(&rb->head, 0U);
+}
@@ -0,0 +1,114 @@
+/*
+ * @file: scratch_arena.c
+ * @brief: 临时对象暂存区实现
+ * @author: jack liu
+ */
+
+#include "scratch_arena.h"
+#include "compile_time.h"
+
+FW_STATIC_ASSERT(((SCRATCH_ARENA_ALIGN) & ((SCRATCH_ARENA_ALIGN) - 1U)) == 0U, scratch_arena_align_pow2);
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_scratch_arena_init(AegisScratchArena* arena, void* buffer, uint32_t capacity) {
+    if (arena == NULL || buffer == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (capacity == 0U) {
+        return ERR_INVALID_PARAM;
+    }
+
+    arena->base = (uint8_t*)buffer;
+    arena->capacity = capacity;
+    arena->used = 0U;
+    arena->peak = 0U;
+    arena->high_water = 0U;
+    arena->failures = 0U;
+    arena->is_initialized = TRUE;
+
+    return ERR_OK;
+}
+
+void* aegis_scratch_arena_alloc(AegisScratchArena* arena, uint32_t size) {
+    uint32_t pad;
+    void* p;
+
+    if (arena == NULL || !arena->is_initialized || size == 0U) {
+        return NULL;
+    }
+
+    /* 按实际地址对齐 */
+    pad = (uint32_t)((ulong_t)0U - (ulong_t)(arena->base + arena->used)) & ((uint32_t)SCRATCH_ARENA_ALIGN - 1U);
+
+    if (pad > arena->capacity - arena->used || size > arena->capacity - arena->used - pad) {
+        arena->failures++;
+        return NULL;
+    }
+
+    p = arena->base + arena->used + pad;
+    arena->used += pad + size;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+        if (arena->peak > arena->high_water) {
+            arena->high_water = arena->peak;
+        }
+    }
+
+    return p;
+}
+
+AegisScratchArenaMark aegis_scratch_arena_mark(const AegisScratchArena* arena) {
+    if (arena == NULL) {
+        return 0U;
+    }
+    return arena->used;
+}
+
+AegisErrorCode aegis_scratch_arena_release(AegisScratchArena* arena, AegisScratchArenaMark mark) {
+    if (arena == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!arena->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    if (mark > arena->used) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    arena->used = mark;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_scratch_arena_reset(AegisScratchArena* arena) {
+    if (arena == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!arena->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    arena->used = 0U;
+    arena->peak = 0U;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_scratch_arena_get_stats(const AegisScratchArena* arena, AegisScratchArenaStats* stats) {
+    if (arena == NULL || stats == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!arena->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    stats->capacity = arena->capacity;
+    stats->used = arena->used;
+    stats->peak = arena->peak;
+    stats->high_water = arena->high_water;
+    stats->failures = arena->failures;
+    return ERR_OK;
+}
@@ -8,6 +8,10 @@
 #include "critical.h"
 #include <string.h>
 
+/* ==================== 内部辅助宏 ==================== */
+/* 逻辑容量（存储区可能被取整到2的幂，容量仍以 TRACE_LOG_SIZE 为准） */
+#define TRACE_LOG_CAPACITY_BYTES  ((uint16_t)(TRACE_LOG_SIZE * sizeof(AegisTraceEvent)))
+
 /* ==================== 公共接口实现 ==================== */
 uint32_t aegis_trace_get_timestamp(AegisTraceLog* log) {
     uint32_t ts;
@@ -37,8 +41,7 @@ AegisErrorCode aegis_trace_log_init(AegisTraceLog* log, TraceTimestampFn now_fn,
     memset(log, 0, sizeof(AegisTraceLog));
 
     /* 初始化环形缓冲区 */
-    aegis_ring_buffer_init(&log->ring, log->buffer,
-                     (uint16_t)(TRACE_LOG_SIZE * sizeof(AegisTraceEvent)));
+    aegis_ring_buffer_init(&log->ring, log->buffer, (uint16_t)sizeof(log->buffer));
 
     log->clock.now = now_fn;
     log->clock.ctx = now_ctx;
@@ -68,7 +71,11 @@ void aegis_trace_log_event(AegisTraceLog* log, AegisTraceEventType type, const c
 
     /* 写入环形缓冲区（如果满了会覆盖旧数据） */
     ENTER_CRITICAL();
-    written = aegis_ring_buffer_write(&log->ring, (const uint8_t*)&event, sizeof(AegisTraceEvent));
+    if (aegis_ring_buffer_get_count(&log->ring) >= TRACE_LOG_CAPACITY_BYTES) {
+        written = 0U;
+    } else {
+        written = aegis_ring_buffer_write(&log->ring, (const uint8_t*)&event, sizeof(AegisTraceEvent));
+    }
     EXIT_CRITICAL();
 
     /* 如果缓冲区满了，丢弃最早的事件 */
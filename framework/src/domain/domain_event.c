@@ -10,93 +10,107 @@
 #include "domain_event.h"
 #include "critical.h"
 #include "trace.h"
+#include "compile_time.h"
 #include <string.h>
 
+/* ==================== 领域事件对象池 ==================== */
+AEGIS_OBJECT_POOL_DEFINE(AegisDomainEventPool, aegis_domain_event_pool, AegisDomainEvent, DOMAIN_EVENT_POOL_SIZE)
+
+FW_STATIC_ASSERT(MAX_EVENT_SUBSCRIPTIONS < DISPATCH_INDEX_EMPTY, event_max_subscriptions);
+
+/* 订阅所属分组（索引/列表数组下标）：0=异步，1=同步 */
+#define SUBSCRIPTION_GROUP(is_sync)  ((is_sync) ? 1U : 0U)
+
+/* 槽位引用标志：全部清除时槽位归还空闲栈 */
+#define EVENT_SLOT_RESERVED     0x01U   /* 发布方持有（填写中或同步分发中） */
+#define EVENT_SLOT_QUEUED       0x02U   /* 在异步队列中 */
+#define EVENT_SLOT_IN_HISTORY   0x04U   /* 在历史记录中 */
+
+FW_STATIC_ASSERT(DOMAIN_EVENT_SLOT_COUNT <= 255, event_slot_count);
+
 /* ==================== 内部辅助函数 ==================== */
 /*
- * @brief: 异步事件队列入队（使用环形缓冲区）
- * @param event: 事件指针
- * @return: 错误码
+ * @brief: 由事件指针反查槽位下标
+ * @return: 槽位下标，不是本总线的槽位返回 -1
  */
-static AegisErrorCode event_queue_enqueue(AegisDomainEventBus* bus, const AegisDomainEvent* event)
+static int16_t slot_index_of(const AegisDomainEventBus* bus, const AegisDomainEvent* event)
 {
-    uint16_t written;
-    const uint8_t* event_bytes;
+    const AegisDomainEvent* base;
 
-    if (bus == NULL || event == NULL) {
-        return ERR_NULL_PTR;
+    base = &bus->slots[0];
+    if (event < base || event >= base + DOMAIN_EVENT_SLOT_COUNT) {
+        return -1;
     }
 
-    /* 检查环形缓冲区剩余空间是否足够存储一个事件 */
-    if (aegis_ring_buffer_get_free(&bus->async_queue) < sizeof(AegisDomainEvent)) {
-        bus->dropped_events++;
-        return ERR_CMD_QUEUE_FULL;  /* 复用命令队列满错误码 */
-    }
-
-    /* 将事件结构体作为字节流写入环形缓冲区 */
-    event_bytes = (const uint8_t*)event;
-    written = aegis_ring_buffer_write(&bus->async_queue, event_bytes, sizeof(AegisDomainEvent));
+    return (int16_t)(event - base);
+}
 
-    if (written != sizeof(AegisDomainEvent)) {
-        bus->dropped_events++;
-        return ERR_CMD_QUEUE_FULL;
+/*
+ * @brief: 清除槽位的一个引用标志，无引用时归还空闲栈（调用方持有临界区）
+ * @param slot: 槽位下标
+ * @param flag: 要清除的引用标志
+ */
+static void slot_release(AegisDomainEventBus* bus, uint8_t slot, uint8_t flag)
+{
+    bus->slot_flags[slot] = (uint8_t)(bus->slot_flags[slot] & (uint8_t)~flag);
+    if (bus->slot_flags[slot] == 0U) {
+        bus->free_slots[bus->free_count] = slot;
+        bus->free_count++;
     }
-
-    return ERR_OK;
 }
 
 /*
- * @brief: 异步事件队列出队（使用环形缓冲区）
- * @param event: 输出事件指针
+ * @brief: 异步事件队列入队（只记录槽位下标；调用方持有临界区）
+ * @param slot: 槽位下标
  * @return: 错误码
  */
-static AegisErrorCode event_queue_dequeue(AegisDomainEventBus* bus, AegisDomainEvent* event)
+static AegisErrorCode event_queue_enqueue(AegisDomainEventBus* bus, uint8_t slot)
 {
-    uint16_t read_count;
-    uint8_t* event_bytes;
+    uint8_t pos;
 
-    if (bus == NULL || event == NULL) {
-        return ERR_NULL_PTR;
-    }
-
-    /* 检查环形缓冲区是否有足够数据 */
-    if (aegis_ring_buffer_get_count(&bus->async_queue) < sizeof(AegisDomainEvent)) {
-        return ERR_EMPTY;
+    if (bus->async_count >= (uint8_t)DOMAIN_EVENT_QUEUE_SIZE) {
+        bus->dropped_events++;
+        return ERR_CMD_QUEUE_FULL;  /* 复用命令队列满错误码 */
     }
 
-    /* 从环形缓冲区读取一个事件 */
-    event_bytes = (uint8_t*)event;
-    read_count = aegis_ring_buffer_read(&bus->async_queue, event_bytes, sizeof(AegisDomainEvent));
-
-    if (read_count != sizeof(AegisDomainEvent)) {
-        return ERR_EMPTY;
-    }
+    pos = (uint8_t)((bus->async_head + bus->async_count) % DOMAIN_EVENT_QUEUE_SIZE);
+    bus->async_queue[pos] = slot;
+    bus->async_count++;
+    bus->slot_flags[slot] = (uint8_t)(bus->slot_flags[slot] | EVENT_SLOT_QUEUED);
 
     return ERR_OK;
 }
 
 /*
- * @brief: 添加事件到历史记录
- * @param event: 事件指针
+ * @brief: 弹出异步队列队首并释放其槽位引用（调用方持有临界区且队列非空）
  */
-static void event_history_add(AegisDomainEventBus* bus, const AegisDomainEvent* event)
+static void event_queue_pop(AegisDomainEventBus* bus)
 {
-    AegisDomainEventHistory* history;
+    slot_release(bus, bus->async_queue[bus->async_head], (uint8_t)EVENT_SLOT_QUEUED);
+    bus->async_head = (uint8_t)((bus->async_head + 1U) % DOMAIN_EVENT_QUEUE_SIZE);
+    bus->async_count--;
+}
 
-    if (bus == NULL || event == NULL) {
-        return;
-    }
+/*
+ * @brief: 添加事件到历史记录（记录槽位下标；调用方持有临界区）
+ * @param slot: 槽位下标
+ */
+static void event_history_add(AegisDomainEventBus* bus, uint8_t slot)
+{
+    AegisDomainEventHistory* history;
 
     history = &bus->history;
 
-    /* 拷贝事件到历史记录（环形缓冲区） */
-    memcpy(&history->history[history->head], event, sizeof(AegisDomainEvent));
-
-    /* 更新历史记录状态 */
-    history->head = (uint8_t)((history->head + 1) % DOMAIN_EVENT_HISTORY_SIZE);
-    if (history->count < DOMAIN_EVENT_HISTORY_SIZE) {
+    /* 历史已满：挤出最旧的一条（head 处） */
+    if (history->count >= DOMAIN_EVENT_HISTORY_SIZE) {
+        slot_release(bus, history->slot[history->head], (uint8_t)EVENT_SLOT_IN_HISTORY);
+    } else {
         history->count++;
     }
+
+    history->slot[history->head] = slot;
+    bus->slot_flags[slot] = (uint8_t)(bus->slot_flags[slot] | EVENT_SLOT_IN_HISTORY);
+    history->head = (uint8_t)((history->head + 1) % DOMAIN_EVENT_HISTORY_SIZE);
 }
 
 /*
@@ -152,14 +166,106 @@ static AegisEventHandlerResult invoke_handler_with_recursion(AegisDomainEventBus
 }
 
 /*
- * @brief: 按优先级排序订阅者并分发事件
+ * @brief: 订阅排序键比较（分组、事件类型、优先级）
+ * @return: a 应排在 b 之前返回 TRUE（键相同返回 FALSE，保证排序稳定）
+ */
+static bool_t subscription_before(const AegisEventSubscription* a, const AegisEventSubscription* b)
+{
+    if (SUBSCRIPTION_GROUP(a->is_sync) != SUBSCRIPTION_GROUP(b->is_sync)) {
+        return (SUBSCRIPTION_GROUP(a->is_sync) < SUBSCRIPTION_GROUP(b->is_sync)) ? TRUE : FALSE;
+    }
+
+    if (a->event_type != b->event_type) {
+        return (a->event_type < b->event_type) ? TRUE : FALSE;
+    }
+
+    return (a->priority < b->priority) ? TRUE : FALSE;
+}
+
+/*
+ * @brief: 构建订阅索引（init 时调用一次）
+ * @return: 错误码
+ * @note: 订阅下标按 (分组, 事件类型, 优先级) 稳定排序后切分为列表；
+ *        通配订阅者单独成表，分发时与具体类型列表按优先级归并。
+ */
+static AegisErrorCode build_subscription_index(AegisDomainEventBus* bus)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t group;
+    uint8_t list_count;
+    const AegisEventSubscription* sub;
+    const AegisEventSubscription* next;
+    AegisErrorCode ret;
+
+    aegis_dispatch_index_clear(bus->index_slots[0], (uint16_t)DOMAIN_EVENT_INDEX_SIZE);
+    aegis_dispatch_index_clear(bus->index_slots[1], (uint16_t)DOMAIN_EVENT_INDEX_SIZE);
+
+    /* 稳定插入排序（订阅数 <= MAX_EVENT_SUBSCRIPTIONS） */
+    for (i = 0; i < bus->subscription_count; i++) {
+        j = i;
+        while (j > 0U && subscription_before(&bus->subscriptions[i],
+                                             &bus->subscriptions[bus->sub_order[j - 1U]])) {
+            bus->sub_order[j] = bus->sub_order[j - 1U];
+            j--;
+        }
+        bus->sub_order[j] = i;
+    }
+
+    /* 切分为 (分组, 事件类型) 列表 */
+    list_count = 0U;
+    i = 0U;
+    while (i < bus->subscription_count) {
+        sub = &bus->subscriptions[bus->sub_order[i]];
+        group = (uint8_t)SUBSCRIPTION_GROUP(sub->is_sync);
+
+        j = (uint8_t)(i + 1U);
+        while (j < bus->subscription_count) {
+            next = &bus->subscriptions[bus->sub_order[j]];
+            if ((uint8_t)SUBSCRIPTION_GROUP(next->is_sync) != group || next->event_type != sub->event_type) {
+                break;
+            }
+            j++;
+        }
+
+        if (sub->event_type == DOMAIN_EVENT_NONE) {
+            bus->wildcard[group].start = i;
+            bus->wildcard[group].count = (uint8_t)(j - i);
+        } else {
+            bus->lists[list_count].start = i;
+            bus->lists[list_count].count = (uint8_t)(j - i);
+            ret = aegis_dispatch_index_insert(bus->index_keys[group], bus->index_slots[group],
+                                              (uint16_t)DOMAIN_EVENT_INDEX_SIZE,
+                                              (uint16_t)sub->event_type, list_count);
+            if (ret != ERR_OK) {
+                return ret;
+            }
+            list_count++;
+        }
+
+        i = j;
+    }
+
+    return ERR_OK;
+}
+
+/*
+ * @brief: 按优先级分发事件给匹配的订阅者
  * @param event: 事件指针
  * @param is_sync: TRUE=处理同步订阅者，FALSE=处理异步订阅者
  * @return: 处理的订阅者数量
+ * @note: 只遍历该事件类型的列表与通配列表（两者均已按优先级排序，此处归并），
+ *        优先级相同时订阅表中靠前者先调用。
  */
 static uint8_t dispatch_to_subscribers(AegisDomainEventBus* bus, const AegisDomainEvent* event, bool_t is_sync)
 {
-    uint8_t i;
+    uint8_t group;
+    uint8_t slot;
+    uint8_t typed_pos;
+    uint8_t typed_end;
+    uint8_t wild_pos;
+    uint8_t wild_end;
+    uint8_t sub_index;
     uint8_t handled_count;
     const AegisEventSubscription* sub;
     AegisEventHandlerResult result;
@@ -170,20 +276,40 @@ static uint8_t dispatch_to_subscribers(AegisDomainEventBus* bus, const AegisDoma
         return 0;
     }
 
-    /* 遍历所有订阅 */
-    for (i = 0; i < bus->subscription_count; i++) {
-        sub = &bus->subscriptions[i];
+    group = (uint8_t)SUBSCRIPTION_GROUP(is_sync);
+
+    wild_pos = bus->wildcard[group].start;
+    wild_end = (uint8_t)(wild_pos + bus->wildcard[group].count);
 
-        /* 检查订阅类型是否匹配（同步/异步） */
-        if (sub->is_sync != is_sync) {
-            continue;
+    typed_pos = 0U;
+    typed_end = 0U;
+    if (event->type != DOMAIN_EVENT_NONE) {
+        slot = aegis_dispatch_index_find(bus->index_keys[group], bus->index_slots[group],
+                                         (uint16_t)DOMAIN_EVENT_INDEX_SIZE, (uint16_t)event->type);
+        if (slot != (uint8_t)DISPATCH_INDEX_EMPTY) {
+            typed_pos = bus->lists[slot].start;
+            typed_end = (uint8_t)(typed_pos + bus->lists[slot].count);
         }
+    }
 
-        /* 检查事件类型是否匹配（0表示订阅所有事件） */
-        if (sub->event_type != 0 && sub->event_type != event->type) {
-            continue;
+    while (typed_pos < typed_end || wild_pos < wild_end) {
+        /* 取两列表中优先级更高（数值更小）者 */
+        if (wild_pos >= wild_end) {
+            sub_index = bus->sub_order[typed_pos++];
+        } else if (typed_pos >= typed_end) {
+            sub_index = bus->sub_order[wild_pos++];
+        } else if (bus->subscriptions[bus->sub_order[typed_pos]].priority <
+                       bus->subscriptions[bus->sub_order[wild_pos]].priority ||
+                   (bus->subscriptions[bus->sub_order[typed_pos]].priority ==
+                        bus->subscriptions[bus->sub_order[wild_pos]].priority &&
+                    bus->sub_order[typed_pos] < bus->sub_order[wild_pos])) {
+            sub_index = bus->sub_order[typed_pos++];
+        } else {
+            sub_index = bus->sub_order[wild_pos++];
         }
 
+        sub = &bus->subscriptions[sub_index];
+
         /* 调用处理器 */
         result = invoke_handler_with_recursion(bus, sub, event);
 
@@ -195,7 +321,7 @@ static uint8_t dispatch_to_subscribers(AegisDomainEventBus* bus, const AegisDoma
         if (result == EVENT_HANDLER_ERROR) {
             if (bus->trace != NULL) {
                 aegis_trace_log_event(bus->trace, TRACE_EVENT_APP_ERROR, "REQ-EVENT-009",
-                               (uint32_t)event->type, i);
+                               (uint32_t)event->type, sub_index);
             }
         }
     }
@@ -213,6 +339,7 @@ AegisErrorCode aegis_domain_event_bus_init(AegisDomainEventBus* bus,
                                 uint8_t count)
 {
     AegisErrorCode ret;
+    uint8_t i;
 
     if (bus == NULL) {
         return ERR_NULL_PTR;
@@ -229,18 +356,22 @@ AegisErrorCode aegis_domain_event_bus_init(AegisDomainEventBus* bus,
     /* 清空事件总线状态 */
     memset(bus, 0, sizeof(AegisDomainEventBus));
 
-    /* 初始化异步事件队列的环形缓冲区 */
-    ret = aegis_ring_buffer_init(&bus->async_queue,
-                           bus->async_queue_buffer,
-                           (uint16_t)sizeof(bus->async_queue_buffer));
-    if (ret != ERR_OK) {
-        return ret;
+    /* 所有事件槽位进入空闲栈（槽位0最先分配） */
+    for (i = 0; i < (uint8_t)DOMAIN_EVENT_SLOT_COUNT; i++) {
+        bus->free_slots[i] = (uint8_t)(DOMAIN_EVENT_SLOT_COUNT - 1 - i);
     }
+    bus->free_count = (uint8_t)DOMAIN_EVENT_SLOT_COUNT;
 
     /* 设置订阅表 */
     bus->subscriptions = subscriptions;
     bus->subscription_count = count;
 
+    /* 建立订阅索引（按事件类型分表、按优先级排序） */
+    ret = build_subscription_index(bus);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
     /* 初始化事件ID */
     bus->next_event_id = 1;
 
@@ -258,12 +389,56 @@ AegisErrorCode aegis_domain_event_bus_init(AegisDomainEventBus* bus,
 }
 
 /*
- * @brief: 发布领域事件（ISR安全）
+ * @brief: 预留事件槽位（ISR安全）
  */
-AegisErrorCode aegis_domain_event_publish(AegisDomainEventBus* bus, const AegisDomainEvent* event)
+AegisErrorCode aegis_domain_event_reserve(AegisDomainEventBus* bus, AegisDomainEvent** event)
 {
-    AegisDomainEvent event_copy;
+    uint8_t slot;
+    AegisDomainEvent* ev;
+
+    if (bus == NULL || event == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    *event = NULL;
+
+    if (!bus->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    ENTER_CRITICAL();
+    if (bus->free_count == 0U) {
+        bus->dropped_events++;
+        EXIT_CRITICAL();
+        return ERR_OUT_OF_RANGE;
+    }
+    bus->free_count--;
+    slot = bus->free_slots[bus->free_count];
+    bus->slot_flags[slot] = (uint8_t)EVENT_SLOT_RESERVED;
+    EXIT_CRITICAL();
+
+    /* 只复位事件头部，custom_data 由调用方按需填写 */
+    ev = &bus->slots[slot];
+    ev->event_id = 0U;
+    ev->type = DOMAIN_EVENT_NONE;
+    ev->aggregate_id = ENTITY_ID_INVALID;
+    ev->timestamp = 0U;
+    ev->aegis_trace_id = NULL;
+
+    *event = ev;
+    return ERR_OK;
+}
+
+/*
+ * @brief: 提交预留的事件（ISR安全）
+ */
+AegisErrorCode aegis_domain_event_commit(AegisDomainEventBus* bus, AegisDomainEvent* event)
+{
+    int16_t index;
+    uint8_t slot;
     uint8_t sync_count;
+    uint8_t pending;
+    AegisDomainEventType type;
     AegisErrorCode err;
 
     if (bus == NULL || event == NULL) {
@@ -274,58 +449,131 @@ AegisErrorCode aegis_domain_event_publish(AegisDomainEventBus* bus, const AegisD
         return ERR_NOT_INITIALIZED;
     }
 
-    /* 进入临界区 */
+    index = slot_index_of(bus, event);
+    if (index < 0) {
+        return ERR_INVALID_PARAM;
+    }
+    slot = (uint8_t)index;
+
     ENTER_CRITICAL();
 
-    /* 拷贝事件并分配事件ID */
-    memcpy(&event_copy, event, sizeof(AegisDomainEvent));
-    event_copy.event_id = bus->next_event_id;
+    if (bus->slot_flags[slot] != (uint8_t)EVENT_SLOT_RESERVED) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    /* 分配事件ID */
+    event->event_id = bus->next_event_id;
     bus->next_event_id++;
 
     /* 如果时间戳为0，自动填充 */
-    if (event_copy.timestamp == 0) {
+    if (event->timestamp == 0) {
         if (bus->trace != NULL) {
-            event_copy.timestamp = aegis_trace_get_timestamp(bus->trace);
+            event->timestamp = aegis_trace_get_timestamp(bus->trace);
         }
     }
 
-    /* 添加到历史记录 */
-    event_history_add(bus, &event_copy);
+    /* 添加到历史记录（引用槽位，不拷贝） */
+    event_history_add(bus, slot);
 
     /* 更新统计 */
     bus->total_published++;
 
-    /* 退出临界区 */
     EXIT_CRITICAL();
 
-    /* 1. 同步分发（不在临界区内执行，避免长时间占用） */
-    sync_count = dispatch_to_subscribers(bus, &event_copy, TRUE);
+    type = event->type;
+
+    /* 1. 同步分发（不在临界区内执行；发布方仍持有槽位，嵌套发布不会回收它） */
+    sync_count = dispatch_to_subscribers(bus, event, TRUE);
     bus->sync_handled += sync_count;
 
-    /* 2. 异步订阅者：将事件入队 */
+    /* 2. 异步订阅者：槽位入队，随后释放发布方引用 */
     ENTER_CRITICAL();
-    err = event_queue_enqueue(bus, &event_copy);
+    err = event_queue_enqueue(bus, slot);
+    pending = bus->async_count;
+    slot_release(bus, slot, (uint8_t)EVENT_SLOT_RESERVED);
     EXIT_CRITICAL();
 
     if (err != ERR_OK) {
         /* 队列满，记录错误但不影响同步分发 */
         if (bus->trace != NULL) {
             aegis_trace_log_event(bus->trace, TRACE_EVENT_DOMAIN_ERR, "REQ-EVENT-010",
-                           (uint32_t)event_copy.type, bus->async_queue.count);
+                           (uint32_t)type, (uint32_t)pending);
         }
     }
 
     return ERR_OK;
 }
 
+/*
+ * @brief: 放弃预留的事件槽位（ISR安全）
+ */
+AegisErrorCode aegis_domain_event_cancel(AegisDomainEventBus* bus, AegisDomainEvent* event)
+{
+    int16_t index;
+
+    if (bus == NULL || event == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!bus->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    index = slot_index_of(bus, event);
+    if (index < 0) {
+        return ERR_INVALID_PARAM;
+    }
+
+    ENTER_CRITICAL();
+    if (bus->slot_flags[index] != (uint8_t)EVENT_SLOT_RESERVED) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+    slot_release(bus, (uint8_t)index, (uint8_t)EVENT_SLOT_RESERVED);
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+/*
+ * @brief: 发布领域事件（ISR安全）
+ */
+AegisErrorCode aegis_domain_event_publish(AegisDomainEventBus* bus, const AegisDomainEvent* event)
+{
+    AegisDomainEvent* slot_event;
+    AegisErrorCode ret;
+
+    if (bus == NULL || event == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!bus->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    ret = aegis_domain_event_reserve(bus, &slot_event);
+    if (ret != ERR_OK) {
+        if (bus->trace != NULL) {
+            aegis_trace_log_event(bus->trace, TRACE_EVENT_DOMAIN_ERR, "REQ-EVENT-010",
+                           (uint32_t)event->type, (uint32_t)bus->async_count);
+        }
+        return ret;
+    }
+
+    /* 唯一一次拷贝：调用方事件 -> 槽位 */
+    memcpy(slot_event, event, sizeof(AegisDomainEvent));
+
+    return aegis_domain_event_commit(bus, slot_event);
+}
+
 /*
  * @brief: 处理异步事件队列（主循环调用）
  */
 uint8_t aegis_domain_event_process(AegisDomainEventBus* bus, uint8_t max_events)
 {
     uint8_t processed;
-    AegisDomainEvent event;
-    AegisErrorCode err;
+    uint8_t slot;
     uint8_t async_count;
 
     if (bus == NULL || !bus->is_initialized) {
@@ -336,18 +584,25 @@ uint8_t aegis_domain_event_process(AegisDomainEventBus* bus, uint8_t max_events)
 
     /* 处理队列中的事件 */
     while (processed < max_events || max_events == 0) {
-        /* 从队列取出事件 */
+        /* 取队首槽位（先不出队：处理期间槽位保持被引用） */
         ENTER_CRITICAL();
-        err = event_queue_dequeue(bus, &event);
-        EXIT_CRITICAL();
-
-        if (err != ERR_OK) {
+        if (bus->async_count == 0U) {
+            EXIT_CRITICAL();
             /* 队列为空，结束处理 */
             break;
         }
+        slot = bus->async_queue[bus->async_head];
+        EXIT_CRITICAL();
 
-        /* 分发给异步订阅者 */
-        async_count = dispatch_to_subscribers(bus, &event, FALSE);
+        /* 分发给异步订阅者（直接传槽位指针） */
+        async_count = dispatch_to_subscribers(bus, &bus->slots[slot], FALSE);
+
+        /* 出队（处理器中途 clear_queue 时队首已不是该槽位） */
+        ENTER_CRITICAL();
+        if (bus->async_count > 0U && bus->async_queue[bus->async_head] == slot) {
+            event_queue_pop(bus);
+        }
+        EXIT_CRITICAL();
 
         /* 更新统计 */
         bus->async_handled += async_count;
@@ -363,9 +618,6 @@ uint8_t aegis_domain_event_process(AegisDomainEventBus* bus, uint8_t max_events)
  */
 AegisErrorCode aegis_domain_event_get_stats(const AegisDomainEventBus* bus, uint8_t* pending_count, uint32_t* processed_count)
 {
-    uint16_t byte_count;
-    uint8_t event_count;
-
     if (bus == NULL) {
         return ERR_NULL_PTR;
     }
@@ -379,10 +631,7 @@ AegisErrorCode aegis_domain_event_get_stats(const AegisDomainEventBus* bus, uint
     }
 
     ENTER_CRITICAL();
-    /* 获取环形缓冲区中的字节数，除以事件大小得到事件数量 */
-    byte_count = aegis_ring_buffer_get_count(&bus->async_queue);
-    event_count = (uint8_t)(byte_count / sizeof(AegisDomainEvent));
-    *pending_count = event_count;
+    *pending_count = bus->async_count;
     *processed_count = bus->total_processed;
     EXIT_CRITICAL();
 
@@ -415,7 +664,7 @@ const AegisDomainEvent* aegis_domain_event_get_history(const AegisDomainEventBus
         actual_index = (uint8_t)(DOMAIN_EVENT_HISTORY_SIZE + history->head - index - 1);
     }
 
-    return &history->history[actual_index];
+    return &bus->slots[history->slot[actual_index]];
 }
 
 /*
@@ -431,7 +680,11 @@ AegisErrorCode aegis_domain_event_clear_queue(AegisDomainEventBus* bus)
         return ERR_NOT_INITIALIZED;
     }
 
-    aegis_ring_buffer_clear(&bus->async_queue);
+    ENTER_CRITICAL();
+    while (bus->async_count > 0U) {
+        event_queue_pop(bus);
+    }
+    EXIT_CRITICAL();
 
     return ERR_OK;
 }
@@ -9,6 +9,9 @@
 
 #include "domain_service.h"
 #include "critical.h"
+#include "compile_time.h"
+
+FW_STATIC_ASSERT(DOMAIN_SERVICE_MAX_HANDLERS < DISPATCH_INDEX_EMPTY, domain_service_max_handlers);
 
 AegisErrorCode aegis_domain_service_init(AegisDomainService* service) {
     uint8_t i;
@@ -24,6 +27,20 @@ AegisErrorCode aegis_domain_service_init(AegisDomainService* service) {
         service->handlers[i].ctx = NULL;
     }
     service->handler_count = 0;
+    aegis_dispatch_index_clear(service->index_slots, (uint16_t)DOMAIN_SERVICE_INDEX_SIZE);
+    service->is_sealed = FALSE;
+    EXIT_CRITICAL();
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_domain_service_seal(AegisDomainService* service) {
+    if (service == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ENTER_CRITICAL();
+    service->is_sealed = TRUE;
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -45,13 +62,19 @@ AegisErrorCode aegis_domain_service_register_handler(AegisDomainService* service
 
     ENTER_CRITICAL();
 
-    for (i = 0; i < service->handler_count; i++) {
-        if (service->handlers[i].op == op) {
-            service->handlers[i].handler = handler;
-            service->handlers[i].ctx = ctx;
-            EXIT_CRITICAL();
-            return ERR_OK;
-        }
+    if (service->is_sealed) {
+        EXIT_CRITICAL();
+        return ERR_INVALID_STATE;
+    }
+
+    /* 更新已存在的注册 */
+    i = aegis_dispatch_index_find(service->index_keys, service->index_slots,
+                                  (uint16_t)DOMAIN_SERVICE_INDEX_SIZE, op);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        service->handlers[i].handler = handler;
+        service->handlers[i].ctx = ctx;
+        EXIT_CRITICAL();
+        return ERR_OK;
     }
 
     if (service->handler_count >= (uint8_t)DOMAIN_SERVICE_MAX_HANDLERS) {
@@ -62,6 +85,8 @@ AegisErrorCode aegis_domain_service_register_handler(AegisDomainService* service
     service->handlers[service->handler_count].op = op;
     service->handlers[service->handler_count].handler = handler;
     service->handlers[service->handler_count].ctx = ctx;
+    (void)aegis_dispatch_index_insert(service->index_keys, service->index_slots,
+                                      (uint16_t)DOMAIN_SERVICE_INDEX_SIZE, op, service->handler_count);
     service->handler_count++;
 
     EXIT_CRITICAL();
@@ -73,6 +98,7 @@ AegisErrorCode aegis_domain_service_execute(const AegisDomainService* service,
                                  const AegisDomainServiceRequest* req,
                                  AegisDomainServiceResponse* resp) {
     uint8_t i;
+    AegisDomainServiceHandlerEntry entry;
     DomainServiceHandler handler;
     void* ctx;
 
@@ -94,15 +120,13 @@ AegisErrorCode aegis_domain_service_execute(const AegisDomainService* service,
     handler = NULL;
     ctx = NULL;
 
-    ENTER_CRITICAL();
-    for (i = 0; i < service->handler_count; i++) {
-        if (service->handlers[i].op == req->op) {
-            handler = service->handlers[i].handler;
-            ctx = service->handlers[i].ctx;
-            break;
-        }
+    i = aegis_dispatch_index_find_sealed(service->index_keys, service->index_slots,
+                                         (uint16_t)DOMAIN_SERVICE_INDEX_SIZE, req->op, service->is_sealed,
+                                         service->handlers, (uint16_t)sizeof(entry), &entry);
+    if (i != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        handler = entry.handler;
+        ctx = entry.ctx;
     }
-    EXIT_CRITICAL();
 
     if (handler == NULL) {
         resp->result = ERR_NOT_FOUND;
@@ -8,13 +8,123 @@
  */
 
 #include "entry_main.h"
-#include <string.h>
+#include "compile_time.h"
 
-AegisErrorCode aegis_entry_main_loop_once(AegisEntryRuntime* runtime) {
+/* 每个交替片内命令+事件的处理总数，按两个队列的积压深度分配 */
+#ifndef ENTRY_BATCH_SLICE
+#define ENTRY_BATCH_SLICE  8U
+#endif
+
+/* 每条命令的结果从暂存区分配，暂存区至少要容纳一个结果（含对齐填充） */
+FW_STATIC_ASSERT((uint32_t)ENTRY_SCRATCH_SIZE >= (uint32_t)sizeof(AegisCommandResult) + (uint32_t)SCRATCH_ARENA_ALIGN,
+                 entry_scratch_too_small);
+
+/* ==================== 内部辅助函数 ==================== */
+/*
+ * @brief: 原地执行命令队列中最早的一条命令
+ * @return: TRUE=已执行一条命令
+ */
+static bool_t entry_execute_one(AegisEntryRuntime* runtime, AegisEntryLoopStats* stats) {
     AegisErrorCode ret;
-    AegisCommand cmd;
-    AegisCommandResult result;
-    uint8_t cmd_count;
+    const AegisCommand* cmd;
+    AegisCommandResult* result;
+    AegisScratchArenaMark mark;
+
+    /* 结果及处理器的临时对象都在暂存区，本条命令结束即回退；先分配再 peek，失败路径不占用队首 */
+    mark = aegis_scratch_arena_mark(&runtime->scratch);
+    result = SCRATCH_NEW(&runtime->scratch, AegisCommandResult);
+    if (result == NULL) {
+        /* 暂存区被本次迭代中更早的分配占满：命令留在队列，复位后下次迭代再执行 */
+        if (runtime->trace.is_initialized) {
+            aegis_trace_log_event(&runtime->trace, TRACE_EVENT_SYSTEM_ERROR, "CMD-SCRATCH-FULL",
+                            (uint32_t)mark, 0);
+        }
+        return FALSE;
+    }
+
+    if (aegis_app_cmd_peek(&runtime->app.cmd_queue, &cmd) != ERR_OK) {
+        (void)aegis_scratch_arena_release(&runtime->scratch, mark);
+        return FALSE;
+    }
+
+    /* 原地执行记录内命令，执行完成后再释放记录 */
+    ret = aegis_app_cmd_service_execute(&runtime->app.cmd_service, cmd, result);
+
+    if (runtime->trace.is_initialized) {
+        aegis_trace_log_event(&runtime->trace, TRACE_EVENT_CMD_EXEC, "CMD-EXEC",
+                        (uint32_t)cmd->type, (uint32_t)ret);
+    }
+
+    if (ret != ERR_OK) {
+        aegis_trace_log_event(&runtime->trace, TRACE_EVENT_CMD_EXEC, "CMD-EXEC-ERR",
+                        (uint32_t)ret, 0);
+        stats->command_errors++;
+    }
+
+    (void)aegis_app_cmd_release(&runtime->app.cmd_queue);
+    (void)aegis_scratch_arena_release(&runtime->scratch, mark);
+    stats->commands_executed++;
+
+    return TRUE;
+}
+
+/*
+ * @brief: 读取两个队列的当前积压
+ */
+static void entry_get_backlog(AegisEntryRuntime* runtime, uint8_t* cmd_pending, uint8_t* evt_pending) {
+    uint32_t processed;
+
+    if (aegis_app_cmd_get_count(&runtime->app.cmd_queue, cmd_pending) != ERR_OK) {
+        *cmd_pending = 0U;
+    }
+    if (aegis_domain_event_get_stats(&runtime->app.event_bus, evt_pending, &processed) != ERR_OK) {
+        *evt_pending = 0U;
+    }
+}
+
+/*
+ * @brief: 时间预算是否已耗尽（无时间源或预算为0时永不耗尽）
+ */
+static bool_t entry_time_up(const AegisEntryBudget* budget, uint32_t start) {
+    if (budget->clock_fn == NULL || budget->time_budget == 0U) {
+        return FALSE;
+    }
+    return ((uint32_t)(budget->clock_fn(budget->clock_ctx) - start) >= budget->time_budget) ? TRUE : FALSE;
+}
+
+/*
+ * @brief: 在命令/事件处理之间压缩仓储（此时没有处理器持有实体指针）
+ */
+static void entry_compact_repo(AegisEntryRuntime* runtime, const AegisEntryBudget* budget, AegisEntryLoopStats* stats) {
+    const AegisDomainRepositoryWriteInterface* repo = runtime->app.write_repo;
+
+    if (budget->max_compaction == 0U || repo == NULL || repo->compact == NULL) {
+        return;
+    }
+
+    if (repo->compact(repo, budget->max_compaction, &stats->repo_holes) != ERR_OK) {
+        stats->repo_holes = 0U;
+    }
+}
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_entry_main_loop_step(AegisEntryRuntime* runtime,
+                                          const AegisEntryBudget* budget,
+                                          AegisEntryLoopStats* stats) {
+    AegisEntryLoopStats local_stats;
+    AegisEntryLoopStats* st;
+    uint32_t start;
+    uint16_t cmd_left;
+    uint16_t evt_left;
+    uint8_t cmd_pending;
+    uint8_t evt_pending;
+    uint16_t cmd_weight;
+    uint16_t evt_weight;
+    uint16_t cmd_slice;
+    uint16_t evt_slice;
+    uint8_t processed;
+    uint16_t progress;
+    bool_t time_up;
 
     if (runtime == NULL) {
         return ERR_NULL_PTR;
@@ -24,37 +134,120 @@ AegisErrorCode aegis_entry_main_loop_once(AegisEntryRuntime* runtime) {
         return ERR_NOT_INITIALIZED;
     }
 
-    /* 检查命令队列 */
-    ret = aegis_app_cmd_get_count(&runtime->app.cmd_queue, &cmd_count);
-    if (ret != ERR_OK) {
-        return ret;
+    if (budget == NULL) {
+        budget = &runtime->budget;
     }
 
-    /* 如果有命令，出队并执行一个 */
-    if (cmd_count > 0U) {
-        memset(&cmd, 0, sizeof(AegisCommand));
-        ret = aegis_app_cmd_dequeue(&runtime->app.cmd_queue, &cmd);
-        if (ret == ERR_OK) {
-            ret = aegis_app_cmd_service_execute(&runtime->app.cmd_service, &cmd, &result);
+    st = (stats != NULL) ? stats : &local_stats;
+    st->commands_executed = 0U;
+    st->command_errors = 0U;
+    st->events_processed = 0U;
+    st->elapsed = 0U;
+    st->repo_holes = 0U;
+    st->budget_exhausted = FALSE;
 
-            if (runtime->trace.is_initialized) {
-                aegis_trace_log_event(&runtime->trace, TRACE_EVENT_CMD_EXEC, "CMD-EXEC",
-                                (uint32_t)cmd.type, (uint32_t)ret);
-            }
+    start = (budget->clock_fn != NULL) ? budget->clock_fn(budget->clock_ctx) : 0U;
+    cmd_left = (budget->max_commands == 0U) ? 0xFFFFU : budget->max_commands;
+    evt_left = (budget->max_events == 0U) ? 0xFFFFU : budget->max_events;
+    time_up = FALSE;
+
+    entry_get_backlog(runtime, &cmd_pending, &evt_pending);
+
+    while (!time_up) {
+        /* 只统计仍有预算的队列 */
+        cmd_weight = (cmd_left > 0U) ? (uint16_t)cmd_pending : 0U;
+        evt_weight = (evt_left > 0U) ? (uint16_t)evt_pending : 0U;
+        if (cmd_weight == 0U && evt_weight == 0U) {
+            break;
+        }
 
-            if (ret != ERR_OK) {
-                aegis_trace_log_event(&runtime->trace, TRACE_EVENT_CMD_EXEC, "CMD-EXEC-ERR",
-                                (uint32_t)ret, 0);
+        /* 按积压深度分配本片配额：积压越深的队列分到越多，非空队列至少分到1 */
+        cmd_slice = (uint16_t)((cmd_weight * ENTRY_BATCH_SLICE) / (uint16_t)(cmd_weight + evt_weight));
+        if (cmd_slice == 0U && cmd_weight > 0U) {
+            cmd_slice = 1U;
+        }
+        evt_slice = (uint16_t)(ENTRY_BATCH_SLICE - cmd_slice);
+        if (evt_slice == 0U && evt_weight > 0U) {
+            evt_slice = 1U;
+        }
+        if (cmd_slice > cmd_left) {
+            cmd_slice = cmd_left;
+        }
+        if (evt_slice > evt_left) {
+            evt_slice = evt_left;
+        }
+
+        progress = 0U;
+        while (cmd_slice > 0U && cmd_weight > 0U) {
+            if (!entry_execute_one(runtime, st)) {
+                break;
             }
+            cmd_slice--;
+            cmd_left--;
+            progress++;
+            if (entry_time_up(budget, start)) {
+                time_up = TRUE;
+                break;
+            }
+        }
+
+        if (!time_up && evt_slice > 0U && evt_weight > 0U) {
+            /* evt_slice 不为0（0 表示处理全部） */
+            processed = aegis_app_init_process_domain_events(&runtime->app, (uint8_t)evt_slice);
+            st->events_processed = (uint16_t)(st->events_processed + processed);
+            evt_left = (uint16_t)(evt_left - processed);
+            progress = (uint16_t)(progress + processed);
+            time_up = entry_time_up(budget, start);
+        }
+
+        entry_get_backlog(runtime, &cmd_pending, &evt_pending);
+
+        /* 队首命令仍在生产者填写中等情况：本片无进展则留到下次迭代 */
+        if (progress == 0U) {
+            break;
         }
     }
 
-    /* 处理异步领域事件（每轮限制数量，避免长时间占用主循环） */
-    (void)aegis_app_init_process_domain_events(&runtime->app, 4);
+    /* 时间预算已耗尽时压缩留到下次迭代 */
+    if (!time_up) {
+        entry_compact_repo(runtime, budget, st);
+    }
+
+    if (budget->clock_fn != NULL) {
+        st->elapsed = (uint32_t)(budget->clock_fn(budget->clock_ctx) - start);
+    }
+    st->commands_pending = cmd_pending;
+    st->events_pending = evt_pending;
+    st->scratch_peak = runtime->scratch.peak;
+    st->budget_exhausted = ((time_up && (cmd_pending > 0U || evt_pending > 0U)) ||
+                            (cmd_left == 0U && cmd_pending > 0U) ||
+                            (evt_left == 0U && evt_pending > 0U)) ? TRUE : FALSE;
 
     return ERR_OK;
 }
 
+AegisErrorCode aegis_entry_main_loop_once(AegisEntryRuntime* runtime) {
+    AegisErrorCode ret;
+
+    if (runtime == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = aegis_entry_main_loop_step(runtime, NULL, &runtime->last_stats);
+
+    /* 本次迭代的临时对象整体失效 */
+    (void)aegis_scratch_arena_reset(&runtime->scratch);
+
+    /* 空闲路径：预算内处理完积压后巡检一批内存块（损坏记入 trace），
+     * 空闲迭代连续 MEM_POOL_SCRUB_SWEEP_CALLS 次即扫完整个内存池 */
+    runtime->last_stats.mem_corrupted = 0U;
+    if (ret == ERR_OK && !runtime->last_stats.budget_exhausted) {
+        (void)aegis_mem_pool_scrub_step(&runtime->mem_pool, &runtime->last_stats.mem_corrupted);
+    }
+
+    return ret;
+}
+
 AegisErrorCode aegis_entry_main_loop(AegisEntryRuntime* runtime) {
     AegisErrorCode ret;
 
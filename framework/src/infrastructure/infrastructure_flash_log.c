@@ -0,0 +1,656 @@
+/*
+ * @file: infrastructure_flash_log.c
+ * @brief: Flash 追加日志实现
+ * @author: jack liu
+ */
+
+#include "infrastructure_flash_log.h"
+#include "compile_time.h"
+#include "crc32.h"
+#include <string.h>
+
+#define FLASH_LOG_MAGIC  0x4C474541UL   /* "AEGL" */
+
+/* 页头（页起始处，CRC 覆盖 crc 之前的字段） */
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t tail_seq;
+    uint32_t tail_offset;
+    uint16_t tail_page;
+    uint16_t layout;
+    uint32_t crc;
+} AegisInfrastructureFlashLogPageHeader;
+
+/* 记录头（CRC 覆盖 kind/flags/len 与数据） */
+typedef struct {
+    uint8_t kind;
+    uint8_t flags;
+    uint16_t len;
+    uint32_t crc;
+} AegisInfrastructureFlashLogRecordHeader;
+
+/* CKPT_END 记录数据：检查点起点 */
+typedef struct {
+    uint32_t seq;
+    uint32_t offset;
+    uint16_t page;
+    uint16_t reserved;
+} AegisInfrastructureFlashLogCkptEnd;
+
+FW_STATIC_ASSERT(sizeof(AegisInfrastructureFlashLogPageHeader) == FLASH_LOG_PAGE_HEADER, flash_log_page_header_size);
+FW_STATIC_ASSERT(sizeof(AegisInfrastructureFlashLogRecordHeader) == FLASH_LOG_RECORD_HEADER, flash_log_record_header_size);
+FW_STATIC_ASSERT(FLASH_LOG_DATA_MAX <= 0xFFFFU, flash_log_data_max_fits);
+
+#define FLASH_LOG_RECORD_BUF  FLASH_LOG_RECORD_SPAN(FLASH_LOG_DATA_MAX)
+
+/* ==================== 内部辅助函数 ==================== */
+static uint32_t page_addr(const AegisInfrastructureFlashLog* log, uint16_t page) {
+    return (uint32_t)page * log->flash->page_size;
+}
+
+static uint16_t next_page(const AegisInfrastructureFlashLog* log, uint16_t page) {
+    return (uint16_t)(((uint32_t)page + 1U) % (uint32_t)log->flash->page_count);
+}
+
+/* 页序号 -> 物理页号（seq 须在 [head.seq - page_count + 1, head.seq] 内） */
+static uint16_t page_of_seq(const AegisInfrastructureFlashLog* log, uint32_t seq) {
+    uint32_t count = (uint32_t)log->flash->page_count;
+    uint32_t back = (log->head.seq - seq) % count;
+
+    return (uint16_t)(((uint32_t)log->head.page + count - back) % count);
+}
+
+static uint32_t header_crc(const AegisInfrastructureFlashLogPageHeader* hdr) {
+    return aegis_crc32_update(0U, hdr, (uint32_t)(sizeof(*hdr) - sizeof(hdr->crc)));
+}
+
+static uint32_t record_crc(const AegisInfrastructureFlashLogRecordHeader* hdr, const void* data) {
+    uint32_t crc = aegis_crc32_update(0U, hdr, 4U);
+    return aegis_crc32_update(crc, data, (uint32_t)hdr->len);
+}
+
+/* 读页头：ERR_OK=有效页头，ERR_NOT_FOUND=已擦除/损坏 */
+static AegisErrorCode read_page_header(const AegisInfrastructureFlashLog* log,
+                                       uint16_t page,
+                                       AegisInfrastructureFlashLogPageHeader* hdr) {
+    AegisErrorCode ret;
+
+    ret = log->flash->read(log->flash, page_addr(log, page), hdr, (uint32_t)sizeof(*hdr));
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if (hdr->magic != FLASH_LOG_MAGIC || hdr->crc != header_crc(hdr)) {
+        return ERR_NOT_FOUND;
+    }
+    return ERR_OK;
+}
+
+static AegisErrorCode erase_page(AegisInfrastructureFlashLog* log, uint16_t page) {
+    AegisErrorCode ret;
+
+    ret = log->flash->erase_page(log->flash, page);
+    if (ret == ERR_OK) {
+        log->stats.erases++;
+    }
+    return ret;
+}
+
+static AegisErrorCode write_page_header(AegisInfrastructureFlashLog* log, uint16_t page, uint32_t seq) {
+    AegisInfrastructureFlashLogPageHeader hdr;
+    AegisErrorCode ret;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = FLASH_LOG_MAGIC;
+    hdr.seq = seq;
+    hdr.tail_seq = log->tail.seq;
+    hdr.tail_offset = log->tail.offset;
+    hdr.tail_page = log->tail.page;
+    hdr.layout = log->layout;
+    hdr.crc = header_crc(&hdr);
+
+    ret = log->flash->program(log->flash, page_addr(log, page), &hdr, (uint32_t)sizeof(hdr));
+    if (ret == ERR_OK) {
+        log->stats.bytes += (uint32_t)sizeof(hdr);
+    }
+    return ret;
+}
+
+/*
+ * 读取 pos 处的记录：ERR_OK=有效记录（数据读入 buf），
+ * ERR_NOT_FOUND=本页没有更多有效记录（已擦除、越界或校验失败）
+ */
+static AegisErrorCode read_record(const AegisInfrastructureFlashLog* log,
+                                  const AegisInfrastructureFlashLogPos* pos,
+                                  AegisInfrastructureFlashLogRecordHeader* hdr,
+                                  void* buf) {
+    uint32_t page_size = log->flash->page_size;
+    uint32_t base = page_addr(log, pos->page);
+    AegisErrorCode ret;
+
+    if (pos->offset + FLASH_LOG_RECORD_HEADER > page_size) {
+        return ERR_NOT_FOUND;
+    }
+
+    ret = log->flash->read(log->flash, base + pos->offset, hdr, (uint32_t)sizeof(*hdr));
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if (hdr->kind == (uint8_t)HAL_FLASH_ERASED_BYTE ||
+        hdr->len > FLASH_LOG_DATA_MAX ||
+        FLASH_LOG_RECORD_SPAN(hdr->len) > page_size - pos->offset) {
+        return ERR_NOT_FOUND;
+    }
+
+    ret = log->flash->read(log->flash, base + pos->offset + FLASH_LOG_RECORD_HEADER, buf, (uint32_t)hdr->len);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if (hdr->crc != record_crc(hdr, buf)) {
+        return ERR_NOT_FOUND;
+    }
+    return ERR_OK;
+}
+
+/* 检查 [offset, page_size) 是否全为已擦除状态 */
+static AegisErrorCode page_tail_erased(const AegisInfrastructureFlashLog* log,
+                                       uint16_t page,
+                                       uint32_t offset,
+                                       bool_t* erased) {
+    uint8_t chunk[32];
+    uint32_t page_size = log->flash->page_size;
+    uint32_t n;
+    uint32_t i;
+    AegisErrorCode ret;
+
+    *erased = TRUE;
+    while (offset < page_size) {
+        n = page_size - offset;
+        if (n > (uint32_t)sizeof(chunk)) {
+            n = (uint32_t)sizeof(chunk);
+        }
+
+        ret = log->flash->read(log->flash, page_addr(log, page) + offset, chunk, n);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+
+        for (i = 0; i < n; i++) {
+            if (chunk[i] != (uint8_t)HAL_FLASH_ERASED_BYTE) {
+                *erased = FALSE;
+                return ERR_OK;
+            }
+        }
+        offset += n;
+    }
+    return ERR_OK;
+}
+
+/* 打开下一页：已预擦除时只写页头，否则先同步擦除（下一页仍在尾指针之后时日志已满） */
+static AegisErrorCode open_next_page(AegisInfrastructureFlashLog* log) {
+    uint16_t page = next_page(log, log->head.page);
+    AegisErrorCode ret;
+
+    if (page == log->tail.page) {
+        return ERR_DOMAIN_FULL;
+    }
+
+    if (log->erased_ahead > 0U) {
+        log->erased_ahead--;
+    } else {
+        ret = erase_page(log, page);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        log->stats.erases_inline++;
+    }
+
+    ret = write_page_header(log, page, log->head.seq + 1U);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    log->head.seq++;
+    log->head.page = page;
+    log->head.offset = FLASH_LOG_PAGE_HEADER;
+    log->stats.pages_opened++;
+    return ERR_OK;
+}
+
+static AegisErrorCode append_at(AegisInfrastructureFlashLog* log,
+                                uint8_t kind,
+                                uint8_t flags,
+                                const void* data,
+                                uint16_t len,
+                                AegisInfrastructureFlashLogPos* at) {
+    uint8_t buf[FLASH_LOG_RECORD_BUF];
+    AegisInfrastructureFlashLogRecordHeader hdr;
+    uint32_t span;
+    AegisErrorCode ret;
+
+    if (log == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!log->is_mounted) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (len > FLASH_LOG_DATA_MAX || (data == NULL && len > 0U) || kind == (uint8_t)HAL_FLASH_ERASED_BYTE) {
+        return ERR_INVALID_PARAM;
+    }
+
+    span = FLASH_LOG_RECORD_SPAN(len);
+    if (log->head.offset + span > log->flash->page_size) {
+        ret = open_next_page(log);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+    }
+
+    hdr.kind = kind;
+    hdr.flags = flags;
+    hdr.len = len;
+    hdr.crc = record_crc(&hdr, data);
+
+    memset(buf, (int)HAL_FLASH_ERASED_BYTE, (size_t)span);
+    memcpy(buf, &hdr, sizeof(hdr));
+    if (len > 0U) {
+        memcpy(&buf[FLASH_LOG_RECORD_HEADER], data, (size_t)len);
+    }
+
+    ret = log->flash->program(log->flash, page_addr(log, log->head.page) + log->head.offset, buf, span);
+    if (ret != ERR_OK) {
+        /* 该位置可能已部分编程：放弃本页剩余空间 */
+        log->head.offset = log->flash->page_size;
+        return ret;
+    }
+
+    if (at != NULL) {
+        *at = log->head;
+    }
+    log->head.offset += span;
+    log->stats.records++;
+    log->stats.bytes += span;
+    return ERR_OK;
+}
+
+/*
+ * 从页头记录的尾指针扫描到日志结尾：遇到 CKPT_END 前移尾指针，确定写入位置，
+ * 返回日志是否以未结束的记录组收尾。页链中可以有空洞（重用前被擦除的旧页），
+ * 但最终尾指针到最新页之间必须连续。
+ */
+static AegisErrorCode scan_log(AegisInfrastructureFlashLog* log,
+                               const AegisInfrastructureFlashLogPos* start,
+                               bool_t* in_group) {
+    uint8_t data[FLASH_LOG_DATA_MAX];
+    AegisInfrastructureFlashLogPageHeader page_hdr;
+    AegisInfrastructureFlashLogRecordHeader hdr;
+    AegisInfrastructureFlashLogCkptEnd ckpt;
+    AegisInfrastructureFlashLogPos pos;
+    AegisInfrastructureFlashLogPos tail = *start;
+    uint32_t head_seq = log->head.seq;
+    uint32_t gap_seq = 0U;
+    bool_t has_gap = FALSE;
+    bool_t erased;
+    uint32_t seq;
+    AegisErrorCode ret;
+
+    *in_group = FALSE;
+    log->head.offset = log->flash->page_size;
+
+    for (seq = start->seq; seq <= head_seq; seq++) {
+        pos.seq = seq;
+        pos.page = page_of_seq(log, seq);
+        pos.offset = (seq == start->seq) ? start->offset : FLASH_LOG_PAGE_HEADER;
+
+        ret = read_page_header(log, pos.page, &page_hdr);
+        if (ret == ERR_NOT_FOUND || (ret == ERR_OK && page_hdr.seq != seq)) {
+            has_gap = TRUE;
+            gap_seq = seq;
+            *in_group = FALSE;
+            continue;
+        }
+        if (ret != ERR_OK) {
+            return ret;
+        }
+
+        for (;;) {
+            ret = read_record(log, &pos, &hdr, data);
+            if (ret == ERR_NOT_FOUND) {
+                break;
+            }
+            if (ret != ERR_OK) {
+                return ret;
+            }
+
+            if (hdr.kind == FLASH_LOG_KIND_CKPT_END && hdr.len == (uint16_t)sizeof(ckpt)) {
+                memcpy(&ckpt, data, sizeof(ckpt));
+                if (ckpt.seq <= seq && seq - ckpt.seq < (uint32_t)log->flash->page_count) {
+                    tail.seq = ckpt.seq;
+                    tail.offset = ckpt.offset;
+                    tail.page = ckpt.page;
+                }
+            }
+            *in_group = (bool_t)((hdr.flags & FLASH_LOG_FLAG_GROUP) != 0U);
+            pos.offset += FLASH_LOG_RECORD_SPAN(hdr.len);
+        }
+
+        if (seq == head_seq) {
+            /* 结尾之后不是已擦除状态（写入中掉电）：下一条记录写到新页 */
+            ret = page_tail_erased(log, pos.page, pos.offset, &erased);
+            if (ret != ERR_OK) {
+                return ret;
+            }
+            log->head.offset = erased ? pos.offset : log->flash->page_size;
+        }
+    }
+
+    if (has_gap && gap_seq >= tail.seq) {
+        return ERR_INVALID_STATE;
+    }
+    if (tail.page != page_of_seq(log, tail.seq) || tail.offset < FLASH_LOG_PAGE_HEADER) {
+        return ERR_INVALID_STATE;
+    }
+
+    log->tail = tail;
+    return ERR_OK;
+}
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_infrastructure_flash_log_init(AegisInfrastructureFlashLog* log,
+                                                   const AegisHalFlash* flash,
+                                                   uint16_t layout) {
+    if (log == NULL || flash == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (flash->read == NULL || flash->program == NULL || flash->erase_page == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (flash->page_count < 2U ||
+        flash->program_unit == 0U || (FLASH_LOG_ALIGN % flash->program_unit) != 0U ||
+        (flash->page_size % FLASH_LOG_ALIGN) != 0U ||
+        flash->page_size < FLASH_LOG_PAGE_HEADER + FLASH_LOG_RECORD_BUF) {
+        return ERR_INVALID_PARAM;
+    }
+
+    memset(log, 0, sizeof(*log));
+    log->flash = flash;
+    log->layout = layout;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_format(AegisInfrastructureFlashLog* log) {
+    uint16_t page;
+    AegisErrorCode ret;
+
+    if (log == NULL || log->flash == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    log->is_mounted = FALSE;
+    log->ckpt_open = FALSE;
+    log->erased_ahead = 0U;
+    memset(&log->stats, 0, sizeof(log->stats));
+
+    for (page = 0; page < log->flash->page_count; page++) {
+        ret = erase_page(log, page);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+    }
+
+    log->tail.seq = 1U;
+    log->tail.page = 0U;
+    log->tail.offset = FLASH_LOG_PAGE_HEADER;
+
+    ret = write_page_header(log, 0U, 1U);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    log->head = log->tail;
+    log->erased_ahead = (uint16_t)(log->flash->page_count - 1U);
+    log->is_mounted = TRUE;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_mount(AegisInfrastructureFlashLog* log) {
+    AegisInfrastructureFlashLogPageHeader hdr;
+    AegisInfrastructureFlashLogPageHeader head_hdr;
+    AegisInfrastructureFlashLogPos start;
+    bool_t found = FALSE;
+    bool_t in_group;
+    uint16_t page;
+    AegisErrorCode ret;
+
+    if (log == NULL || log->flash == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    log->is_mounted = FALSE;
+    log->ckpt_open = FALSE;
+    log->erased_ahead = 0U;
+    memset(&log->stats, 0, sizeof(log->stats));
+    memset(&head_hdr, 0, sizeof(head_hdr));
+
+    /* 最新页 = 有效页头中序号最大者 */
+    for (page = 0; page < log->flash->page_count; page++) {
+        ret = read_page_header(log, page, &hdr);
+        if (ret == ERR_NOT_FOUND) {
+            continue;
+        }
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        if (!found || hdr.seq > head_hdr.seq) {
+            head_hdr = hdr;
+            log->head.page = page;
+            found = TRUE;
+        }
+    }
+
+    if (!found) {
+        return aegis_infrastructure_flash_log_format(log);
+    }
+
+    if (head_hdr.layout != log->layout ||
+        head_hdr.tail_seq > head_hdr.seq ||
+        head_hdr.seq - head_hdr.tail_seq >= (uint32_t)log->flash->page_count ||
+        head_hdr.tail_offset < FLASH_LOG_PAGE_HEADER ||
+        head_hdr.tail_offset > log->flash->page_size) {
+        return ERR_INVALID_STATE;
+    }
+
+    log->head.seq = head_hdr.seq;
+    start.seq = head_hdr.tail_seq;
+    start.offset = head_hdr.tail_offset;
+    start.page = head_hdr.tail_page;
+    if (start.page != page_of_seq(log, start.seq)) {
+        return ERR_INVALID_STATE;
+    }
+
+    ret = scan_log(log, &start, &in_group);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    log->is_mounted = TRUE;
+
+    /* 掉电时记录组未结束：补写 ABORT，重放方整组丢弃 */
+    if (in_group) {
+        ret = append_at(log, (uint8_t)FLASH_LOG_KIND_ABORT, 0U, NULL, 0U, NULL);
+        if (ret != ERR_OK) {
+            log->is_mounted = FALSE;
+            return ret;
+        }
+    }
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_append(AegisInfrastructureFlashLog* log,
+                                                     uint8_t kind,
+                                                     uint8_t flags,
+                                                     const void* data,
+                                                     uint16_t len) {
+    return append_at(log, kind, flags, data, len, NULL);
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_cursor(const AegisInfrastructureFlashLog* log,
+                                                     AegisInfrastructureFlashLogPos* cursor) {
+    if (log == NULL || cursor == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!log->is_mounted) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    *cursor = log->tail;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_read(const AegisInfrastructureFlashLog* log,
+                                                   AegisInfrastructureFlashLogPos* cursor,
+                                                   AegisInfrastructureFlashLogRecord* record,
+                                                   void* buf,
+                                                   uint16_t buf_size) {
+    AegisInfrastructureFlashLogRecordHeader hdr;
+    AegisErrorCode ret;
+
+    if (log == NULL || cursor == NULL || record == NULL || buf == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!log->is_mounted) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (buf_size < FLASH_LOG_DATA_MAX) {
+        return ERR_INVALID_PARAM;
+    }
+
+    for (;;) {
+        if (cursor->seq > log->head.seq ||
+            (cursor->seq == log->head.seq && cursor->offset >= log->head.offset)) {
+            return ERR_EMPTY;
+        }
+
+        ret = read_record(log, cursor, &hdr, buf);
+        if (ret == ERR_OK) {
+            break;
+        }
+        if (ret != ERR_NOT_FOUND) {
+            return ret;
+        }
+        if (cursor->seq == log->head.seq) {
+            return ERR_EMPTY;
+        }
+
+        /* 本页结束：转到下一页第一条记录 */
+        cursor->seq++;
+        cursor->page = next_page(log, cursor->page);
+        cursor->offset = FLASH_LOG_PAGE_HEADER;
+    }
+
+    record->kind = hdr.kind;
+    record->flags = hdr.flags;
+    record->len = hdr.len;
+    cursor->offset += FLASH_LOG_RECORD_SPAN(hdr.len);
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_checkpoint_begin(AegisInfrastructureFlashLog* log,
+                                                               const void* data,
+                                                               uint16_t len) {
+    AegisErrorCode ret;
+
+    if (log == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    log->ckpt_open = FALSE;
+    ret = append_at(log, (uint8_t)FLASH_LOG_KIND_CKPT_BEGIN, 0U, data, len, &log->ckpt);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    log->ckpt_open = TRUE;
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_checkpoint_commit(AegisInfrastructureFlashLog* log) {
+    AegisInfrastructureFlashLogCkptEnd ckpt;
+    AegisErrorCode ret;
+
+    if (log == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!log->ckpt_open) {
+        return ERR_INVALID_STATE;
+    }
+
+    ckpt.seq = log->ckpt.seq;
+    ckpt.offset = log->ckpt.offset;
+    ckpt.page = log->ckpt.page;
+    ckpt.reserved = 0U;
+
+    ret = append_at(log, (uint8_t)FLASH_LOG_KIND_CKPT_END, 0U, &ckpt, (uint16_t)sizeof(ckpt), NULL);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    log->tail = log->ckpt;
+    log->ckpt_open = FALSE;
+    return ERR_OK;
+}
+
+uint16_t aegis_infrastructure_flash_log_free_pages(const AegisInfrastructureFlashLog* log) {
+    if (log == NULL || !log->is_mounted) {
+        return 0U;
+    }
+
+    return (uint16_t)((uint32_t)log->flash->page_count - (log->head.seq - log->tail.seq) - 1U);
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_erase_ahead(AegisInfrastructureFlashLog* log, uint16_t max_pages) {
+    uint16_t done = 0U;
+    uint16_t page;
+    AegisErrorCode ret;
+
+    if (log == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!log->is_mounted) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    while (log->erased_ahead < (uint16_t)FLASH_LOG_ERASE_AHEAD && (max_pages == 0U || done < max_pages)) {
+        /* 只擦除写入页与尾指针之间的空闲页 */
+        page = (uint16_t)(((uint32_t)log->head.page + 1U + (uint32_t)log->erased_ahead) %
+                          (uint32_t)log->flash->page_count);
+        if (page == log->tail.page) {
+            break;
+        }
+
+        ret = erase_page(log, page);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        log->erased_ahead++;
+        done++;
+    }
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_flash_log_get_stats(const AegisInfrastructureFlashLog* log,
+                                                        AegisInfrastructureFlashLogStats* stats) {
+    if (log == NULL || stats == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    *stats = log->stats;
+    return ERR_OK;
+}
@@ -9,9 +9,30 @@
 
 #include "infrastructure_repository_inmem.h"
 #include "critical.h"
+#include "compile_time.h"
+#include "atomic_ops.h"
+#if REPOSITORY_LAYOUT_SOA
+#include "key_filter.h"
+#endif
 #include <stddef.h>
 #include <string.h>
 
+FW_STATIC_ASSERT(REPOSITORY_MAX_ENTITIES < REPOSITORY_SLOT_NONE, repository_slot_width);
+#if !REPOSITORY_LAYOUT_SOA
+FW_STATIC_ASSERT(REPOSITORY_MAX_TYPES < DISPATCH_INDEX_EMPTY, repository_type_table_width);
+#endif
+FW_STATIC_ASSERT(REPOSITORY_BATCH_MAX < DISPATCH_INDEX_EMPTY, repository_batch_width);
+FW_STATIC_ASSERT(DOMAIN_ENTITY_PAYLOAD_MAX <= 15U * REPOSITORY_DIRTY_CHUNK, repository_dirty_width);
+
+#define INDEX_MASK  ((uint32_t)REPOSITORY_INDEX_SIZE - 1U)
+
+/* apply_batch 批内ID查重集合的桶数（空桶为 ENTITY_ID_INVALID） */
+#define BATCH_SEEN_SIZE  DISPATCH_INDEX_SIZE(REPOSITORY_BATCH_MAX)
+#define BATCH_SEEN_MASK  ((uint32_t)BATCH_SEEN_SIZE - 1U)
+
+/* 乘法散列：顺序分配的ID也能均匀分布 */
+#define INDEX_HOME(id)  ((uint32_t)(((uint32_t)(id) * 0x9E3779B1UL) >> 16) & INDEX_MASK)
+
 /* ==================== 内部辅助函数 ==================== */
 static AegisInfrastructureRepositoryInmem* repo_from_read(const AegisDomainRepositoryReadInterface* self) {
     if (self == NULL) {
@@ -34,6 +55,507 @@ static uint32_t repo_now_ms(AegisInfrastructureRepositoryInmem* repo) {
     return repo->now_ms(repo->now_ms_ctx);
 }
 
+/*
+ * @brief: 顺序锁写开始（调用方持有临界区）：版本号变为奇数后再修改受保护数据
+ */
+static void seq_write_begin(volatile uint32_t* seq) {
+    *seq = *seq + 1U;
+    aegis_critical_barrier();
+}
+
+/*
+ * @brief: 顺序锁写结束（调用方持有临界区）：修改对读端可见后版本号恢复为偶数
+ */
+static void seq_write_end(volatile uint32_t* seq) {
+    AEGIS_ATOMIC_STORE_RELEASE(seq, *seq + 1U);
+}
+
+/*
+ * @brief: 查找实体ID所在的索引桶（调用方持有临界区；snapshot 无锁调用时由 index_seq 校验结果）
+ * @return: 桶位置，未找到返回 REPOSITORY_INDEX_SIZE
+ */
+static uint32_t index_locate(const AegisInfrastructureRepositoryInmem* repo, AegisEntityId entity_id) {
+    uint32_t pos;
+    uint32_t probes;
+
+    pos = INDEX_HOME(entity_id);
+    for (probes = 0; probes < (uint32_t)REPOSITORY_INDEX_SIZE; probes++) {
+        if (repo->index_slots[pos] == REPOSITORY_SLOT_NONE) {
+            break;
+        }
+        if (repo->index_ids[pos] == entity_id) {
+            return pos;
+        }
+        pos = (pos + 1U) & INDEX_MASK;
+    }
+
+    return (uint32_t)REPOSITORY_INDEX_SIZE;
+}
+
+/*
+ * @brief: 按实体ID查找槽位（调用方持有临界区）
+ * @return: 槽位，未找到返回 REPOSITORY_SLOT_NONE
+ */
+static AegisInfrastructureRepositorySlot find_entity_index(const AegisInfrastructureRepositoryInmem* repo, AegisEntityId entity_id) {
+    uint32_t pos;
+
+    if (repo == NULL) {
+        return REPOSITORY_SLOT_NONE;
+    }
+
+    pos = index_locate(repo, entity_id);
+    if (pos == (uint32_t)REPOSITORY_INDEX_SIZE) {
+        return REPOSITORY_SLOT_NONE;
+    }
+
+    return repo->index_slots[pos];
+}
+
+/*
+ * @brief: 索引插入（调用方保证ID未在索引中，且持有临界区）
+ */
+static void index_insert(AegisInfrastructureRepositoryInmem* repo, AegisEntityId entity_id, AegisInfrastructureRepositorySlot slot) {
+    uint32_t pos;
+
+    /* 负载因子 <= 0.5，必有空桶 */
+    pos = INDEX_HOME(entity_id);
+    while (repo->index_slots[pos] != REPOSITORY_SLOT_NONE) {
+        pos = (pos + 1U) & INDEX_MASK;
+    }
+
+    repo->index_ids[pos] = entity_id;
+    repo->index_slots[pos] = slot;
+}
+
+/*
+ * @brief: 索引删除（线性探测回移删除，不留墓碑；调用方持有临界区）
+ */
+static void index_remove(AegisInfrastructureRepositoryInmem* repo, AegisEntityId entity_id) {
+    uint32_t hole;
+    uint32_t pos;
+    uint32_t home;
+
+    hole = index_locate(repo, entity_id);
+    if (hole == (uint32_t)REPOSITORY_INDEX_SIZE) {
+        return;
+    }
+
+    /* 把后续探测链上可以前移的条目移入空洞，保证查找遇空桶即可终止 */
+    pos = hole;
+    for (;;) {
+        pos = (pos + 1U) & INDEX_MASK;
+        if (repo->index_slots[pos] == REPOSITORY_SLOT_NONE) {
+            break;
+        }
+        home = INDEX_HOME(repo->index_ids[pos]);
+        /* home 不在 (hole, pos] 循环区间内时才能前移 */
+        if (((pos - home) & INDEX_MASK) >= ((pos - hole) & INDEX_MASK)) {
+            repo->index_ids[hole] = repo->index_ids[pos];
+            repo->index_slots[hole] = repo->index_slots[pos];
+            hole = pos;
+        }
+    }
+
+    repo->index_slots[hole] = REPOSITORY_SLOT_NONE;
+}
+
+/*
+ * @brief: 清空索引
+ */
+static void index_clear(AegisInfrastructureRepositoryInmem* repo) {
+    uint32_t i;
+
+    for (i = 0; i < (uint32_t)REPOSITORY_INDEX_SIZE; i++) {
+        repo->index_slots[i] = REPOSITORY_SLOT_NONE;
+    }
+}
+
+#if REPOSITORY_LAYOUT_SOA
+/* ---- SoA 布局：类型集中在稠密数组 hot_type 中，空闲槽位记为 ENTITY_TYPE_INVALID ---- */
+
+static uint8_t type_index_prepare(AegisInfrastructureRepositoryInmem* repo, AegisEntityType type) {
+    (void)repo;
+    (void)type;
+    return 0U;      /* 类型数不受限 */
+}
+
+static void type_index_attach(AegisInfrastructureRepositoryInmem* repo, uint8_t token,
+                              AegisInfrastructureRepositorySlot slot, AegisEntityType type) {
+    (void)token;
+    repo->hot_type[slot] = type;
+}
+
+static void type_index_detach(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot) {
+    repo->hot_type[slot] = ENTITY_TYPE_INVALID;
+}
+
+static void type_index_move(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot from, AegisInfrastructureRepositorySlot to) {
+    repo->hot_type[to] = repo->hot_type[from];
+    repo->hot_type[from] = ENTITY_TYPE_INVALID;
+}
+
+static void type_index_clear(AegisInfrastructureRepositoryInmem* repo) {
+    uint32_t i;
+
+    for (i = 0; i < (uint32_t)REPOSITORY_MAX_ENTITIES; i++) {
+        repo->hot_type[i] = ENTITY_TYPE_INVALID;
+    }
+}
+
+static uint8_t type_index_mark(const AegisInfrastructureRepositoryInmem* repo) {
+    (void)repo;
+    return 0U;      /* prepare 不登记任何状态 */
+}
+
+static void type_index_rollback(AegisInfrastructureRepositoryInmem* repo, uint8_t mark) {
+    (void)repo;
+    (void)mark;
+}
+
+/*
+ * @brief: 按块扫描稠密类型数组收集实体（过滤核输出位掩码，只在命中时访问实体槽位；调用方持有临界区）
+ */
+static uint8_t type_index_collect(AegisInfrastructureRepositoryInmem* repo, AegisEntityType type,
+                                  AegisDomainEntity** entities, uint8_t max_count) {
+    uint32_t base;
+    uint32_t left;
+    uint32_t mask;
+    uint8_t found_count = 0U;
+
+    if (type == ENTITY_TYPE_INVALID) {
+        return 0U;
+    }
+
+    for (base = 0U; base < (uint32_t)repo->entity_count && found_count < max_count; base += KEY_FILTER_BLOCK) {
+        left = (uint32_t)repo->entity_count - base;
+        mask = aegis_key_filter_mask(&repo->hot_type[base],
+                                     (uint8_t)((left > KEY_FILTER_BLOCK) ? KEY_FILTER_BLOCK : left),
+                                     type);
+        while (mask != 0U && found_count < max_count) {
+            entities[found_count] = &repo->entity_pool[base + aegis_key_filter_pop(&mask)];
+            found_count++;
+        }
+    }
+
+    return found_count;
+}
+
+static uint32_t type_index_count(const AegisInfrastructureRepositoryInmem* repo, AegisEntityType type) {
+    if (type == ENTITY_TYPE_INVALID) {
+        return 0U;
+    }
+
+    return aegis_key_filter_count(repo->hot_type, (uint32_t)repo->entity_count, type);
+}
+
+#else
+/*
+ * @brief: 查找类型链表（调用方持有临界区）
+ * @return: 类型表下标，未登记返回 DISPATCH_INDEX_EMPTY
+ */
+static uint8_t type_list_find(const AegisInfrastructureRepositoryInmem* repo, AegisEntityType type) {
+    return aegis_dispatch_index_find(repo->type_index_keys, repo->type_index_slots,
+                                     (uint16_t)REPOSITORY_TYPE_INDEX_SIZE, (uint16_t)type);
+}
+
+/*
+ * @brief: 按类型表前 type_count 项重建类型索引（开放寻址索引不支持删除；调用方持有临界区）
+ */
+static void type_list_reindex(AegisInfrastructureRepositoryInmem* repo) {
+    uint8_t idx;
+
+    aegis_dispatch_index_clear(repo->type_index_slots, (uint16_t)REPOSITORY_TYPE_INDEX_SIZE);
+    for (idx = 0; idx < repo->type_count; idx++) {
+        (void)aegis_dispatch_index_insert(repo->type_index_keys, repo->type_index_slots,
+                                          (uint16_t)REPOSITORY_TYPE_INDEX_SIZE,
+                                          (uint16_t)repo->type_lists[idx].type, idx);
+    }
+}
+
+/*
+ * @brief: 类型表已满时找一个可复用的表项：链表已排空，且没有被本次校验登记（调用方持有临界区）
+ * @return: 类型表下标，没有可复用的表项返回 DISPATCH_INDEX_EMPTY
+ */
+static uint8_t type_list_find_drained(const AegisInfrastructureRepositoryInmem* repo) {
+    uint8_t idx;
+
+    for (idx = 0; idx < repo->type_count; idx++) {
+        if (repo->type_lists[idx].count == 0U && repo->type_lists[idx].pending == 0U) {
+            return idx;
+        }
+    }
+
+    return (uint8_t)DISPATCH_INDEX_EMPTY;
+}
+
+/*
+ * @brief: 查找或登记类型链表（调用方持有临界区）
+ * @note: 登记计入 pending，直到 type_list_link 链接实体或 type_index_rollback 撤销
+ * @return: 类型表下标，类型表已满且无已排空表项时返回 DISPATCH_INDEX_EMPTY
+ */
+static uint8_t type_list_acquire(AegisInfrastructureRepositoryInmem* repo, AegisEntityType type) {
+    uint8_t idx;
+    AegisInfrastructureRepositoryTypeList* list;
+
+    idx = type_list_find(repo, type);
+    if (idx != (uint8_t)DISPATCH_INDEX_EMPTY) {
+        repo->type_lists[idx].pending++;
+        return idx;
+    }
+
+    if (repo->type_count < (uint8_t)REPOSITORY_MAX_TYPES) {
+        idx = repo->type_count;
+        if (aegis_dispatch_index_insert(repo->type_index_keys, repo->type_index_slots,
+                                        (uint16_t)REPOSITORY_TYPE_INDEX_SIZE, (uint16_t)type, idx) != ERR_OK) {
+            return (uint8_t)DISPATCH_INDEX_EMPTY;
+        }
+        repo->type_count++;
+    } else {
+        /* 类型表已满：复用已排空的表项，旧类型的键须从索引中移除 */
+        idx = type_list_find_drained(repo);
+        if (idx == (uint8_t)DISPATCH_INDEX_EMPTY) {
+            return (uint8_t)DISPATCH_INDEX_EMPTY;
+        }
+        repo->type_lists[idx].type = type;
+        type_list_reindex(repo);
+    }
+
+    list = &repo->type_lists[idx];
+    list->type = type;
+    list->head = REPOSITORY_SLOT_NONE;
+    list->tail = REPOSITORY_SLOT_NONE;
+    list->count = 0U;
+    list->pending = 1U;
+
+    return idx;
+}
+
+/*
+ * @brief: 槽位追加到类型链表尾部，保持创建顺序（调用方持有临界区）
+ */
+static void type_list_link(AegisInfrastructureRepositoryInmem* repo, uint8_t idx, AegisInfrastructureRepositorySlot slot) {
+    AegisInfrastructureRepositoryTypeList* list = &repo->type_lists[idx];
+
+    repo->type_prev[slot] = list->tail;
+    repo->type_next[slot] = REPOSITORY_SLOT_NONE;
+    if (list->tail == REPOSITORY_SLOT_NONE) {
+        list->head = slot;
+    } else {
+        repo->type_next[list->tail] = slot;
+    }
+    list->tail = slot;
+    list->count++;
+    if (list->pending > 0U) {
+        list->pending--;
+    }
+}
+
+/*
+ * @brief: 槽位从类型链表摘除（调用方持有临界区）
+ */
+static void type_list_unlink(AegisInfrastructureRepositoryInmem* repo, uint8_t idx, AegisInfrastructureRepositorySlot slot) {
+    AegisInfrastructureRepositoryTypeList* list = &repo->type_lists[idx];
+    AegisInfrastructureRepositorySlot prev = repo->type_prev[slot];
+    AegisInfrastructureRepositorySlot next = repo->type_next[slot];
+
+    if (prev == REPOSITORY_SLOT_NONE) {
+        list->head = next;
+    } else {
+        repo->type_next[prev] = next;
+    }
+    if (next == REPOSITORY_SLOT_NONE) {
+        list->tail = prev;
+    } else {
+        repo->type_prev[next] = prev;
+    }
+    list->count--;
+}
+
+/*
+ * @brief: 实体搬移后，把类型链表中的节点从 from 改指向 to（调用方持有临界区）
+ */
+static void type_list_relocate(AegisInfrastructureRepositoryInmem* repo, uint8_t idx,
+                               AegisInfrastructureRepositorySlot from, AegisInfrastructureRepositorySlot to) {
+    AegisInfrastructureRepositoryTypeList* list = &repo->type_lists[idx];
+    AegisInfrastructureRepositorySlot prev = repo->type_prev[from];
+    AegisInfrastructureRepositorySlot next = repo->type_next[from];
+
+    repo->type_prev[to] = prev;
+    repo->type_next[to] = next;
+    if (prev == REPOSITORY_SLOT_NONE) {
+        list->head = to;
+    } else {
+        repo->type_next[prev] = to;
+    }
+    if (next == REPOSITORY_SLOT_NONE) {
+        list->tail = to;
+    } else {
+        repo->type_prev[next] = to;
+    }
+}
+
+/* ---- 类型索引钩子（两种布局统一的调用点） ---- */
+
+/*
+ * @brief: 为类型预留索引（写入实体前调用，失败时不做任何修改）
+ * @return: 类型表下标，类型表已满返回 DISPATCH_INDEX_EMPTY
+ */
+static uint8_t type_index_prepare(AegisInfrastructureRepositoryInmem* repo, AegisEntityType type) {
+    return type_list_acquire(repo, type);
+}
+
+static void type_index_attach(AegisInfrastructureRepositoryInmem* repo, uint8_t token,
+                              AegisInfrastructureRepositorySlot slot, AegisEntityType type) {
+    (void)type;
+    type_list_link(repo, token, slot);
+}
+
+/*
+ * @brief: 槽位移出类型索引（按池中仍保留的旧类型定位链表）
+ */
+static void type_index_detach(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot) {
+    type_list_unlink(repo, type_list_find(repo, repo->entity_pool[slot].base.type), slot);
+}
+
+static void type_index_move(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot from, AegisInfrastructureRepositorySlot to) {
+    type_list_relocate(repo, type_list_find(repo, repo->entity_pool[from].base.type), from, to);
+}
+
+static void type_index_clear(AegisInfrastructureRepositoryInmem* repo) {
+    repo->type_count = 0U;
+    aegis_dispatch_index_clear(repo->type_index_slots, (uint16_t)REPOSITORY_TYPE_INDEX_SIZE);
+}
+
+/*
+ * @brief: 记录类型表当前大小，供校验失败时 type_index_rollback 撤销其间 prepare 登记的类型
+ */
+static uint8_t type_index_mark(const AegisInfrastructureRepositoryInmem* repo) {
+    return repo->type_count;
+}
+
+/*
+ * @brief: 撤销 mark 之后登记的类型，并清除本次校验的全部登记（这些登记尚未链接任何实体；调用方持有临界区）
+ * @note: 复用的表项保留新类型：它与被替换的旧类型一样是空链表，查询结果不变；
+ *        只在批量校验失败时发生，类型数很小
+ */
+static void type_index_rollback(AegisInfrastructureRepositoryInmem* repo, uint8_t mark) {
+    uint8_t idx;
+
+    for (idx = 0; idx < repo->type_count; idx++) {
+        repo->type_lists[idx].pending = 0U;
+    }
+
+    if (repo->type_count == mark) {
+        return;
+    }
+
+    repo->type_count = mark;
+    type_list_reindex(repo);
+}
+
+/*
+ * @brief: 收集指定类型的实体（按创建顺序，最多 max_count 个；调用方持有临界区）
+ */
+static uint8_t type_index_collect(AegisInfrastructureRepositoryInmem* repo, AegisEntityType type,
+                                  AegisDomainEntity** entities, uint8_t max_count) {
+    AegisInfrastructureRepositorySlot slot;
+    uint8_t idx;
+    uint8_t found_count = 0U;
+
+    idx = type_list_find(repo, type);
+    if (idx == (uint8_t)DISPATCH_INDEX_EMPTY) {
+        return 0U;
+    }
+
+    slot = repo->type_lists[idx].head;
+    while (slot != REPOSITORY_SLOT_NONE && found_count < max_count) {
+        entities[found_count] = &repo->entity_pool[slot];
+        found_count++;
+        slot = repo->type_next[slot];
+    }
+
+    return found_count;
+}
+
+/*
+ * @brief: 指定类型的实体数（O(1)；调用方持有临界区）
+ */
+static uint32_t type_index_count(const AegisInfrastructureRepositoryInmem* repo, AegisEntityType type) {
+    uint8_t idx;
+
+    idx = type_list_find(repo, type);
+    if (idx == (uint8_t)DISPATCH_INDEX_EMPTY) {
+        return 0U;
+    }
+
+    return (uint32_t)repo->type_lists[idx].count;
+}
+
+#endif /* REPOSITORY_LAYOUT_SOA */
+
+/*
+ * @brief: 空闲槽位入栈（调用方持有临界区）
+ */
+static void free_push(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot) {
+    repo->free_pos[slot] = repo->free_count;
+    repo->free_slots[repo->free_count] = slot;
+    repo->free_count++;
+}
+
+/*
+ * @brief: 从空闲栈中摘除指定槽位（与栈顶交换，O(1)；调用方持有临界区）
+ */
+static void free_remove(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot) {
+    AegisInfrastructureRepositorySlot pos;
+    AegisInfrastructureRepositorySlot last;
+
+    pos = repo->free_pos[slot];
+    repo->free_count--;
+    last = repo->free_slots[repo->free_count];
+    repo->free_slots[pos] = last;
+    repo->free_pos[last] = pos;
+}
+
+/*
+ * @brief: 压缩一步：尾部为空洞则收缩，否则把尾部实体搬入栈顶空洞（调用方持有临界区）
+ * @return: TRUE=已处理一步，FALSE=已无空洞
+ */
+static bool_t compact_one(AegisInfrastructureRepositoryInmem* repo) {
+    AegisInfrastructureRepositorySlot tail;
+    AegisInfrastructureRepositorySlot hole;
+
+    if (repo->free_count == 0U) {
+        return FALSE;
+    }
+
+    tail = (AegisInfrastructureRepositorySlot)(repo->entity_count - 1U);
+    if (!repo->entity_pool[tail].base.is_valid) {
+        free_remove(repo, tail);
+    } else {
+        /* 尾部有效时栈中空洞必然位于尾部之前 */
+        repo->free_count--;
+        hole = repo->free_slots[repo->free_count];
+        seq_write_begin(&repo->index_seq);
+        seq_write_begin(&repo->slot_seq[hole]);
+        seq_write_begin(&repo->slot_seq[tail]);
+        memcpy(&repo->entity_pool[hole], &repo->entity_pool[tail], sizeof(AegisDomainEntity));
+        repo->index_slots[index_locate(repo, repo->entity_pool[hole].base.id)] = hole;
+        type_index_move(repo, tail, hole);
+        repo->dirty[hole] = repo->dirty[tail];
+        repo->dirty[tail] = 0U;
+        repo->entity_pool[tail].base.is_valid = FALSE;
+        seq_write_end(&repo->slot_seq[tail]);
+        seq_write_end(&repo->slot_seq[hole]);
+        seq_write_end(&repo->index_seq);
+    }
+    repo->entity_count--;
+
+    return TRUE;
+}
+
+/*
+ * @brief: 分配实体ID（跳过仍在使用的ID）
+ */
 static AegisEntityId allocate_entity_id(AegisInfrastructureRepositoryInmem* repo) {
     AegisEntityId id;
 
@@ -42,35 +564,224 @@ static AegisEntityId allocate_entity_id(AegisInfrastructureRepositoryInmem* repo
     }
 
     ENTER_CRITICAL();
-    id = repo->next_entity_id;
-    repo->next_entity_id++;
-    if (repo->next_entity_id == ENTITY_ID_INVALID) {
-        repo->next_entity_id = 1;
-    }
+    do {
+        id = repo->next_entity_id;
+        repo->next_entity_id++;
+        if (repo->next_entity_id == ENTITY_ID_INVALID) {
+            repo->next_entity_id = 1;
+        }
+    } while (find_entity_index(repo, id) != REPOSITORY_SLOT_NONE);
     EXIT_CRITICAL();
 
     return id;
 }
 
-static int8_t find_entity_index(AegisInfrastructureRepositoryInmem* repo, AegisEntityId entity_id) {
-    uint8_t i;
+/*
+ * @brief: 剩余可创建的实体数（空闲栈 + 未使用区间；调用方持有临界区）
+ */
+static uint32_t repo_available(const AegisInfrastructureRepositoryInmem* repo) {
+    return (uint32_t)repo->free_count + (uint32_t)REPOSITORY_MAX_ENTITIES - (uint32_t)repo->entity_count;
+}
 
-    if (repo == NULL) {
-        return -1;
+/*
+ * @brief: 创建前校验：指定的ID未被占用，且类型表可容纳该类型（调用方持有临界区，容量由调用方检查）
+ * @param type_idx: 输出类型索引令牌，供 apply_create 使用
+ */
+static AegisErrorCode prepare_create(AegisInfrastructureRepositoryInmem* repo,
+                                     const AegisDomainEntity* entity,
+                                     uint8_t* type_idx) {
+    if (entity->base.id != ENTITY_ID_INVALID && find_entity_index(repo, entity->base.id) != REPOSITORY_SLOT_NONE) {
+        /* 调用方指定的ID已存在 */
+        return ERR_INVALID_PARAM;
+    }
+
+    *type_idx = type_index_prepare(repo, entity->base.type);
+    if (*type_idx == (uint8_t)DISPATCH_INDEX_EMPTY) {
+        /* 类型表已满（REPOSITORY_MAX_TYPES） */
+        return ERR_OUT_OF_RANGE;
+    }
+
+    return ERR_OK;
+}
+
+/*
+ * @brief: 更新前校验：实体存在，类型变更时类型表可容纳新类型（调用方持有临界区）
+ */
+static AegisErrorCode prepare_update(AegisInfrastructureRepositoryInmem* repo,
+                                     const AegisDomainEntity* entity,
+                                     AegisInfrastructureRepositorySlot* slot,
+                                     uint8_t* type_idx) {
+    *slot = find_entity_index(repo, entity->base.id);
+    if (*slot == REPOSITORY_SLOT_NONE) {
+        return ERR_NOT_FOUND;
+    }
+
+    *type_idx = (uint8_t)DISPATCH_INDEX_EMPTY;
+    if (entity->base.type != repo->entity_pool[*slot].base.type) {
+        *type_idx = type_index_prepare(repo, entity->base.type);
+        if (*type_idx == (uint8_t)DISPATCH_INDEX_EMPTY) {
+            return ERR_OUT_OF_RANGE;
+        }
+    }
+
+    return ERR_OK;
+}
+
+/*
+ * @brief: 新实体的时间戳：created_at = updated_at = 当前时间
+ */
+static void stamp_create(AegisDomainEntity* entity, uint32_t timestamp) {
+    entity->base.created_at = timestamp;
+    entity->base.updated_at = timestamp;
+}
+
+/*
+ * @brief: 更新的时间戳：保留存储中的 created_at（避免调用方覆盖），updated_at = 当前时间
+ */
+static void stamp_update(const AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot,
+                         AegisDomainEntity* entity, uint32_t timestamp) {
+    entity->base.created_at = repo->entity_pool[slot].base.created_at;
+    entity->base.updated_at = timestamp;
+}
+
+/*
+ * @brief: 写入新实体（已通过 prepare_create 与容量校验，ID与时间戳已确定；调用方持有临界区）
+ * @return: 实体所在槽位
+ */
+static AegisInfrastructureRepositorySlot apply_create(AegisInfrastructureRepositoryInmem* repo,
+                                                      AegisDomainEntity* entity,
+                                                      uint8_t type_idx) {
+    AegisInfrastructureRepositorySlot slot;
+
+    entity->base.is_valid = TRUE;
+
+    /* 优先复用已删除的槽位，否则追加到已使用区间末尾 */
+    if (repo->free_count > 0U) {
+        repo->free_count--;
+        slot = repo->free_slots[repo->free_count];
+    } else {
+        slot = repo->entity_count;
+        repo->entity_count++;
+    }
+
+    seq_write_begin(&repo->index_seq);
+    seq_write_begin(&repo->slot_seq[slot]);
+    memcpy(&repo->entity_pool[slot], entity, sizeof(AegisDomainEntity));
+    index_insert(repo, entity->base.id, slot);
+    type_index_attach(repo, type_idx, slot, entity->base.type);
+    repo->dirty[slot] = REPOSITORY_DIRTY_ALL;
+    seq_write_end(&repo->slot_seq[slot]);
+    seq_write_end(&repo->index_seq);
+
+    return slot;
+}
+
+/*
+ * @brief: 覆盖已有实体（已通过 prepare_update，时间戳已确定；调用方持有临界区）
+ */
+static void apply_update(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot,
+                         AegisDomainEntity* entity, uint8_t type_idx) {
+    AegisDomainEntity* stored;
+
+    stored = &repo->entity_pool[slot];
+
+    /* 类型变更时迁移到新类型链表 */
+    if (entity->base.type != stored->base.type) {
+        type_index_detach(repo, slot);
+        type_index_attach(repo, type_idx, slot, entity->base.type);
     }
 
-    for (i = 0; i < repo->entity_count; i++) {
-        if (repo->entity_pool[i].base.id == entity_id && repo->entity_pool[i].base.is_valid) {
-            return (int8_t)i;
+    entity->base.is_valid = TRUE;
+
+    seq_write_begin(&repo->slot_seq[slot]);
+    if (entity != stored) {
+        /* 调用方传入 get 返回的存储本身时无需拷贝（memcpy 不允许重叠） */
+        memcpy(stored, entity, sizeof(AegisDomainEntity));
+    }
+    seq_write_end(&repo->slot_seq[slot]);
+    repo->dirty[slot] = REPOSITORY_DIRTY_ALL;
+}
+
+/*
+ * @brief: 删除实体并回收槽位（调用方持有临界区）
+ */
+static void apply_delete(AegisInfrastructureRepositoryInmem* repo, AegisInfrastructureRepositorySlot slot,
+                         AegisEntityId entity_id) {
+    type_index_detach(repo, slot);
+    seq_write_begin(&repo->index_seq);
+    seq_write_begin(&repo->slot_seq[slot]);
+    repo->entity_pool[slot].base.is_valid = FALSE;
+    repo->dirty[slot] = 0U;
+    index_remove(repo, entity_id);
+    seq_write_end(&repo->slot_seq[slot]);
+    seq_write_end(&repo->index_seq);
+
+    /* 删除尾部实体时直接收缩区间，其余留给空闲栈复用/压缩 */
+    if (slot == (AegisInfrastructureRepositorySlot)(repo->entity_count - 1U)) {
+        repo->entity_count--;
+    } else {
+        free_push(repo, slot);
+    }
+}
+
+/*
+ * @brief: payload 区间 [offset, offset + len) 覆盖的脏位（len > 0）
+ */
+static uint16_t dirty_range_mask(uint16_t offset, uint16_t len) {
+    uint32_t first;
+    uint32_t last;
+
+    first = (uint32_t)offset / REPOSITORY_DIRTY_CHUNK;
+    last = ((uint32_t)offset + (uint32_t)len - 1U) / REPOSITORY_DIRTY_CHUNK;
+    return (uint16_t)(((1UL << (last + 1U)) - 1UL) & ~((1UL << first) - 1UL));
+}
+
+/*
+ * @brief: 批量操作引用的实体ID（create 未指定ID时为 ENTITY_ID_INVALID）
+ */
+static AegisEntityId batch_op_id(const AegisDomainRepositoryOp* op) {
+    if (op->kind == DOMAIN_REPOSITORY_OP_DELETE) {
+        return op->entity_id;
+    }
+    return op->entity->base.id;
+}
+
+/*
+ * @brief: 把ID加入批内查重集合（线性探测，负载因子 <= 0.5）
+ * @return: TRUE=新加入，FALSE=本批中已出现
+ */
+static bool_t batch_seen_insert(AegisEntityId* seen, AegisEntityId id) {
+    uint32_t pos;
+
+    pos = (uint32_t)(((uint32_t)id * 0x9E3779B1UL) >> 16) & BATCH_SEEN_MASK;
+    while (seen[pos] != (AegisEntityId)ENTITY_ID_INVALID) {
+        if (seen[pos] == id) {
+            return FALSE;
         }
+        pos = (pos + 1U) & BATCH_SEEN_MASK;
     }
+    seen[pos] = id;
+    return TRUE;
+}
 
-    return -1;
+/*
+ * @brief: 本批操作是否引用了该ID
+ */
+static bool_t batch_uses_id(const AegisDomainRepositoryOp* ops, uint8_t count, AegisEntityId id) {
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        if (batch_op_id(&ops[i]) == id) {
+            return TRUE;
+        }
+    }
+    return FALSE;
 }
 
 /* ==================== 仓储接口实现 ==================== */
 static AegisErrorCode repository_init_impl(const AegisDomainRepositoryWriteInterface* self) {
     AegisInfrastructureRepositoryInmem* repo;
+    uint32_t i;
 
     repo = repo_from_write(self);
     if (repo == NULL) {
@@ -79,11 +790,25 @@ static AegisErrorCode repository_init_impl(const AegisDomainRepositoryWriteInter
 
     ENTER_CRITICAL();
 
+    seq_write_begin(&repo->index_seq);
+    for (i = 0; i < (uint32_t)REPOSITORY_MAX_ENTITIES; i++) {
+        seq_write_begin(&repo->slot_seq[i]);
+    }
+
     memset(repo->entity_pool, 0, sizeof(repo->entity_pool));
+    memset(repo->dirty, 0, sizeof(repo->dirty));
     repo->entity_count = 0;
+    repo->free_count = 0;
+    index_clear(repo);
+    type_index_clear(repo);
     repo->next_entity_id = 1;
     repo->is_initialized = TRUE;
 
+    for (i = 0; i < (uint32_t)REPOSITORY_MAX_ENTITIES; i++) {
+        seq_write_end(&repo->slot_seq[i]);
+    }
+    seq_write_end(&repo->index_seq);
+
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -93,7 +818,7 @@ static AegisErrorCode repository_get_impl(const AegisDomainRepositoryReadInterfa
                                      AegisEntityId entity_id,
                                      AegisDomainEntity** entity) {
     AegisInfrastructureRepositoryInmem* repo;
-    int8_t index;
+    AegisInfrastructureRepositorySlot index;
 
     if (entity == NULL) {
         return ERR_NULL_PTR;
@@ -111,7 +836,7 @@ static AegisErrorCode repository_get_impl(const AegisDomainRepositoryReadInterfa
     ENTER_CRITICAL();
 
     index = find_entity_index(repo, entity_id);
-    if (index < 0) {
+    if (index == REPOSITORY_SLOT_NONE) {
         EXIT_CRITICAL();
         return ERR_NOT_FOUND;
     }
@@ -123,14 +848,75 @@ static AegisErrorCode repository_get_impl(const AegisDomainRepositoryReadInterfa
     return ERR_OK;
 }
 
+/*
+ * 乐观读：不进入临界区。索引查找与槽位拷贝分别由 index_seq/slot_seq 校验，
+ * 版本变化（或槽位已被其他实体复用）时重试，写端无需等待读端。
+ */
+static AegisErrorCode repository_snapshot_impl(const AegisDomainRepositoryReadInterface* self,
+                                               AegisEntityId entity_id,
+                                               AegisDomainEntity* out) {
+    AegisInfrastructureRepositoryInmem* repo;
+    AegisInfrastructureRepositorySlot index;
+    uint32_t index_gen;
+    uint32_t slot_gen;
+    uint32_t attempt;
+
+    if (out == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    repo = repo_from_read(self);
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!repo->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    for (attempt = 0; attempt < (uint32_t)REPOSITORY_SNAPSHOT_RETRY_MAX; attempt++) {
+        index_gen = AEGIS_ATOMIC_LOAD_ACQUIRE(&repo->index_seq);
+        if ((index_gen & 1U) != 0U) {
+            continue;
+        }
+
+        index = find_entity_index(repo, entity_id);
+        if (index == REPOSITORY_SLOT_NONE) {
+            /* 索引未被并发修改时“未找到”才可信 */
+            aegis_critical_barrier();
+            if (AEGIS_ATOMIC_LOAD_RELAXED(&repo->index_seq) == index_gen) {
+                return ERR_NOT_FOUND;
+            }
+            continue;
+        }
+        if (index >= (AegisInfrastructureRepositorySlot)REPOSITORY_MAX_ENTITIES) {
+            continue;
+        }
+
+        slot_gen = AEGIS_ATOMIC_LOAD_ACQUIRE(&repo->slot_seq[index]);
+        if ((slot_gen & 1U) != 0U) {
+            continue;
+        }
+
+        memcpy(out, &repo->entity_pool[index], sizeof(AegisDomainEntity));
+        aegis_critical_barrier();
+
+        /* 查找后实体可能已被删除或搬移，槽位被复用时ID不再匹配 */
+        if (AEGIS_ATOMIC_LOAD_RELAXED(&repo->slot_seq[index]) == slot_gen &&
+            out->base.is_valid && out->base.id == entity_id) {
+            return ERR_OK;
+        }
+    }
+
+    return ERR_BUSY;
+}
+
 static AegisErrorCode repository_find_by_type_impl(const AegisDomainRepositoryReadInterface* self,
                                               AegisEntityType entity_type,
                                               AegisDomainEntity** entities,
                                               uint8_t max_count,
                                               uint8_t* actual_count) {
     AegisInfrastructureRepositoryInmem* repo;
-    uint8_t i;
-    uint8_t found_count;
 
     if (entities == NULL || actual_count == NULL) {
         return ERR_NULL_PTR;
@@ -145,20 +931,9 @@ static AegisErrorCode repository_find_by_type_impl(const AegisDomainRepositoryRe
         return ERR_NOT_INITIALIZED;
     }
 
-    found_count = 0;
-
+    /* 默认布局只遍历该类型的链表（最多 max_count 个节点），临界区与仓储总量无关 */
     ENTER_CRITICAL();
-
-    for (i = 0; i < repo->entity_count && found_count < max_count; i++) {
-        if (repo->entity_pool[i].base.is_valid &&
-            repo->entity_pool[i].base.type == entity_type) {
-            entities[found_count] = &repo->entity_pool[i];
-            found_count++;
-        }
-    }
-
-    *actual_count = found_count;
-
+    *actual_count = type_index_collect(repo, entity_type, entities, max_count);
     EXIT_CRITICAL();
 
     return ERR_OK;
@@ -168,8 +943,7 @@ static AegisErrorCode repository_count_by_type_impl(const AegisDomainRepositoryR
                                                AegisEntityType entity_type,
                                                uint8_t* count) {
     AegisInfrastructureRepositoryInmem* repo;
-    uint8_t i;
-    uint8_t type_count;
+    uint32_t type_count;
 
     if (count == NULL) {
         return ERR_NULL_PTR;
@@ -184,23 +958,23 @@ static AegisErrorCode repository_count_by_type_impl(const AegisDomainRepositoryR
         return ERR_NOT_INITIALIZED;
     }
 
-    type_count = 0;
-
     ENTER_CRITICAL();
-    for (i = 0; i < repo->entity_count; i++) {
-        if (repo->entity_pool[i].base.is_valid &&
-            repo->entity_pool[i].base.type == entity_type) {
-            type_count++;
-        }
-    }
-    *count = type_count;
+    type_count = type_index_count(repo, entity_type);
     EXIT_CRITICAL();
 
+    /* 接口为 uint8_t，超过 255 时饱和 */
+    if (type_count > 0xFFU) {
+        type_count = 0xFFU;
+    }
+    *count = (uint8_t)type_count;
+
     return ERR_OK;
 }
 
 static AegisErrorCode repository_create_impl(const AegisDomainRepositoryWriteInterface* self, AegisDomainEntity* entity) {
     AegisInfrastructureRepositoryInmem* repo;
+    AegisErrorCode ret;
+    uint8_t type_idx;
     uint32_t timestamp;
 
     repo = repo_from_write(self);
@@ -220,24 +994,27 @@ static AegisErrorCode repository_create_impl(const AegisDomainRepositoryWriteInt
         return ERR_OUT_OF_RANGE;
     }
 
+    /* 时间戳回调放在临界区外 */
+    timestamp = repo_now_ms(repo);
+
     ENTER_CRITICAL();
 
-    if (repo->entity_count >= (uint8_t)REPOSITORY_MAX_ENTITIES) {
+    if (repo_available(repo) == 0U) {
         EXIT_CRITICAL();
         return ERR_OUT_OF_RANGE;
     }
 
+    ret = prepare_create(repo, entity, &type_idx);
+    if (ret != ERR_OK) {
+        EXIT_CRITICAL();
+        return ret;
+    }
+
     if (entity->base.id == ENTITY_ID_INVALID) {
         entity->base.id = allocate_entity_id(repo);
     }
-
-    timestamp = repo_now_ms(repo);
-    entity->base.created_at = timestamp;
-    entity->base.updated_at = timestamp;
-    entity->base.is_valid = TRUE;
-
-    memcpy(&repo->entity_pool[repo->entity_count], entity, sizeof(AegisDomainEntity));
-    repo->entity_count++;
+    stamp_create(entity, timestamp);
+    (void)apply_create(repo, entity, type_idx);
 
     EXIT_CRITICAL();
 
@@ -246,9 +1023,10 @@ static AegisErrorCode repository_create_impl(const AegisDomainRepositoryWriteInt
 
 static AegisErrorCode repository_update_impl(const AegisDomainRepositoryWriteInterface* self, AegisDomainEntity* entity) {
     AegisInfrastructureRepositoryInmem* repo;
-    int8_t index;
+    AegisInfrastructureRepositorySlot index;
+    AegisErrorCode ret;
+    uint8_t type_idx;
     uint32_t timestamp;
-    AegisDomainEntity* stored;
 
     repo = repo_from_write(self);
     if (repo == NULL) {
@@ -267,24 +1045,73 @@ static AegisErrorCode repository_update_impl(const AegisDomainRepositoryWriteInt
         return ERR_OUT_OF_RANGE;
     }
 
+    timestamp = repo_now_ms(repo);
+
     ENTER_CRITICAL();
 
-    index = find_entity_index(repo, entity->base.id);
-    if (index < 0) {
+    ret = prepare_update(repo, entity, &index, &type_idx);
+    if (ret != ERR_OK) {
         EXIT_CRITICAL();
-        return ERR_NOT_FOUND;
+        return ret;
     }
+    stamp_update(repo, index, entity, timestamp);
+    apply_update(repo, index, entity, type_idx);
 
-    stored = &repo->entity_pool[index];
+    EXIT_CRITICAL();
 
-    /* 保留存储中的created_at，避免调用方覆盖 */
-    entity->base.created_at = stored->base.created_at;
-    entity->base.is_valid = TRUE;
+    return ERR_OK;
+}
+
+static AegisErrorCode repository_update_payload_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                     AegisEntityId entity_id,
+                                                     uint16_t offset,
+                                                     const void* data,
+                                                     uint16_t len) {
+    AegisInfrastructureRepositoryInmem* repo;
+    AegisInfrastructureRepositorySlot index;
+    AegisDomainEntity* stored;
+    uint16_t start;
+    uint32_t timestamp;
+
+    repo = repo_from_write(self);
+    if (repo == NULL || data == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!repo->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    if (len == 0U || (uint32_t)offset + (uint32_t)len > (uint32_t)DOMAIN_ENTITY_PAYLOAD_MAX) {
+        return ERR_OUT_OF_RANGE;
+    }
 
     timestamp = repo_now_ms(repo);
-    entity->base.updated_at = timestamp;
 
-    memcpy(stored, entity, sizeof(AegisDomainEntity));
+    ENTER_CRITICAL();
+
+    index = find_entity_index(repo, entity_id);
+    if (index == REPOSITORY_SLOT_NONE) {
+        EXIT_CRITICAL();
+        return ERR_NOT_FOUND;
+    }
+
+    /* 只拷贝修改的字节，关中断时间与 len 成正比 */
+    stored = &repo->entity_pool[index];
+    start = offset;
+    seq_write_begin(&repo->slot_seq[index]);
+    if (offset > stored->payload_size) {
+        /* 越过当前末尾写入：中间的空隙清零，之前较大 payload 留下的旧字节不能重新变为有效 */
+        start = stored->payload_size;
+        memset(&stored->payload[start], 0, (size_t)(offset - start));
+    }
+    memcpy(&stored->payload[offset], data, len);
+    if ((uint16_t)(offset + len) > stored->payload_size) {
+        stored->payload_size = (uint16_t)(offset + len);
+    }
+    stored->base.updated_at = timestamp;
+    seq_write_end(&repo->slot_seq[index]);
+    repo->dirty[index] = (uint16_t)(repo->dirty[index] | dirty_range_mask(start, (uint16_t)(offset + len - start)));
 
     EXIT_CRITICAL();
 
@@ -293,7 +1120,7 @@ static AegisErrorCode repository_update_impl(const AegisDomainRepositoryWriteInt
 
 static AegisErrorCode repository_delete_impl(const AegisDomainRepositoryWriteInterface* self, AegisEntityId entity_id) {
     AegisInfrastructureRepositoryInmem* repo;
-    int8_t index;
+    AegisInfrastructureRepositorySlot index;
 
     repo = repo_from_write(self);
     if (repo == NULL) {
@@ -307,18 +1134,148 @@ static AegisErrorCode repository_delete_impl(const AegisDomainRepositoryWriteInt
     ENTER_CRITICAL();
 
     index = find_entity_index(repo, entity_id);
-    if (index < 0) {
+    if (index == REPOSITORY_SLOT_NONE) {
         EXIT_CRITICAL();
         return ERR_NOT_FOUND;
     }
+    apply_delete(repo, index, entity_id);
+
+    EXIT_CRITICAL();
 
-    repo->entity_pool[index].base.is_valid = FALSE;
+    return ERR_OK;
+}
+
+/*
+ * 两阶段：先在临界区内按顺序校验全部操作（模拟容量变化），任一失败则不做任何修改；
+ * 全部通过后再依次写入。同一ID只出现一次，因此各操作的槽位在写入阶段保持不变。
+ */
+static AegisErrorCode repository_apply_batch_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                  AegisDomainRepositoryOp* ops,
+                                                  uint8_t count,
+                                                  uint8_t* failed_index) {
+    AegisInfrastructureRepositoryInmem* repo;
+    AegisInfrastructureRepositorySlot slots[REPOSITORY_BATCH_MAX];
+    uint8_t type_idx[REPOSITORY_BATCH_MAX];
+    AegisErrorCode ret;
+    AegisEntityId id;
+    uint32_t available;
+    uint32_t timestamp;
+    AegisEntityId seen_ids[BATCH_SEEN_SIZE];
+    uint8_t type_mark;
+    uint8_t i;
+
+    repo = repo_from_write(self);
+    if (repo == NULL || ops == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!repo->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    if (count > (uint8_t)REPOSITORY_BATCH_MAX) {
+        return ERR_OUT_OF_RANGE;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (ops[i].kind != DOMAIN_REPOSITORY_OP_DELETE && ops[i].entity == NULL) {
+            if (failed_index != NULL) {
+                *failed_index = i;
+            }
+            return ERR_NULL_PTR;
+        }
+    }
+
+    /* 整批共用一个时间戳 */
+    timestamp = repo_now_ms(repo);
+
+    ENTER_CRITICAL();
+
+    ret = ERR_OK;
+    available = repo_available(repo);
+    type_mark = type_index_mark(repo);
+    memset(seen_ids, 0xFF, sizeof(seen_ids));
+    for (i = 0; i < count; i++) {
+        /* 同一ID在一批中只能出现一次（批内ID集合，O(1) 查重） */
+        id = batch_op_id(&ops[i]);
+        if (id != ENTITY_ID_INVALID) {
+            if (!batch_seen_insert(seen_ids, id)) {
+                ret = ERR_INVALID_PARAM;
+            }
+        }
+
+        if (ret == ERR_OK) {
+            switch (ops[i].kind) {
+                case DOMAIN_REPOSITORY_OP_CREATE:
+                    if (ops[i].entity->payload_size > (uint16_t)DOMAIN_ENTITY_PAYLOAD_MAX || available == 0U) {
+                        ret = ERR_OUT_OF_RANGE;
+                    } else {
+                        ret = prepare_create(repo, ops[i].entity, &type_idx[i]);
+                        available--;
+                    }
+                    break;
+                case DOMAIN_REPOSITORY_OP_UPDATE:
+                    if (ops[i].entity->payload_size > (uint16_t)DOMAIN_ENTITY_PAYLOAD_MAX) {
+                        ret = ERR_OUT_OF_RANGE;
+                    } else {
+                        ret = prepare_update(repo, ops[i].entity, &slots[i], &type_idx[i]);
+                    }
+                    break;
+                case DOMAIN_REPOSITORY_OP_DELETE:
+                    slots[i] = find_entity_index(repo, ops[i].entity_id);
+                    if (slots[i] == REPOSITORY_SLOT_NONE) {
+                        ret = ERR_NOT_FOUND;
+                    } else {
+                        available++;
+                    }
+                    break;
+                default:
+                    ret = ERR_INVALID_PARAM;
+                    break;
+            }
+        }
+
+        if (ret != ERR_OK) {
+            /* 校验阶段为新类型登记的类型表项一并撤销，失败的批次不留下任何修改 */
+            type_index_rollback(repo, type_mark);
+            EXIT_CRITICAL();
+            if (failed_index != NULL) {
+                *failed_index = i;
+            }
+            return ret;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        if (ops[i].kind == DOMAIN_REPOSITORY_OP_CREATE) {
+            if (ops[i].entity->base.id == ENTITY_ID_INVALID) {
+                /* 跳过本批中其他操作引用的ID */
+                do {
+                    id = allocate_entity_id(repo);
+                } while (batch_uses_id(ops, count, id));
+                ops[i].entity->base.id = id;
+            }
+            stamp_create(ops[i].entity, timestamp);
+            (void)apply_create(repo, ops[i].entity, type_idx[i]);
+        } else if (ops[i].kind == DOMAIN_REPOSITORY_OP_UPDATE) {
+            stamp_update(repo, slots[i], ops[i].entity, timestamp);
+            apply_update(repo, slots[i], ops[i].entity, type_idx[i]);
+        } else {
+            apply_delete(repo, slots[i], ops[i].entity_id);
+        }
+    }
 
     EXIT_CRITICAL();
 
     return ERR_OK;
 }
 
+static AegisErrorCode repository_compact_impl(const AegisDomainRepositoryWriteInterface* self,
+                                              uint16_t budget,
+                                              uint16_t* remaining) {
+    return aegis_infrastructure_repository_inmem_compact(repo_from_write(self), budget, remaining);
+}
+
 AegisErrorCode aegis_infrastructure_repository_inmem_init(AegisInfrastructureRepositoryInmem* repo,
                                                InfrastructureNowMsFn now_ms_fn,
                                                void* now_ms_ctx) {
@@ -327,6 +1284,8 @@ AegisErrorCode aegis_infrastructure_repository_inmem_init(AegisInfrastructureRep
     }
 
     memset(repo, 0, sizeof(AegisInfrastructureRepositoryInmem));
+    index_clear(repo);
+    type_index_clear(repo);
 
     repo->now_ms = now_ms_fn;
     repo->now_ms_ctx = now_ms_ctx;
@@ -335,12 +1294,16 @@ AegisErrorCode aegis_infrastructure_repository_inmem_init(AegisInfrastructureRep
     repo->read_if.get = repository_get_impl;
     repo->read_if.find_by_type = repository_find_by_type_impl;
     repo->read_if.count_by_type = repository_count_by_type_impl;
+    repo->read_if.snapshot = repository_snapshot_impl;
 
     repo->write_if.read = repo->read_if;
     repo->write_if.init = repository_init_impl;
     repo->write_if.create = repository_create_impl;
     repo->write_if.update = repository_update_impl;
     repo->write_if.delete_entity = repository_delete_impl;
+    repo->write_if.compact = repository_compact_impl;
+    repo->write_if.apply_batch = repository_apply_batch_impl;
+    repo->write_if.update_payload = repository_update_payload_impl;
 
     return ERR_OK;
 }
@@ -359,3 +1322,127 @@ const AegisDomainRepositoryWriteInterface* aegis_infrastructure_repository_inmem
     return &repo->write_if;
 }
 
+AegisErrorCode aegis_infrastructure_repository_inmem_compact(AegisInfrastructureRepositoryInmem* repo,
+                                                             uint16_t budget,
+                                                             uint16_t* remaining) {
+    uint16_t steps;
+    bool_t progressed;
+
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!repo->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    steps = 0U;
+    progressed = TRUE;
+    while (progressed && (budget == 0U || steps < budget)) {
+        /* 每步单独进入临界区，关中断时间与空洞数量无关 */
+        ENTER_CRITICAL();
+        progressed = compact_one(repo);
+        EXIT_CRITICAL();
+        steps++;
+    }
+
+    if (remaining != NULL) {
+        *remaining = (uint16_t)repo->free_count;
+    }
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_repository_inmem_take_dirty(AegisInfrastructureRepositoryInmem* repo,
+                                                                uint16_t* cursor,
+                                                                AegisEntityId* entity_id,
+                                                                uint16_t* mask) {
+    AegisInfrastructureRepositorySlot slot;
+    bool_t taken;
+
+    if (repo == NULL || cursor == NULL || entity_id == NULL || mask == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!repo->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    taken = FALSE;
+    while (!taken) {
+        /* 每个槽位单独进入临界区，关中断时间与仓储容量无关 */
+        ENTER_CRITICAL();
+        if ((uint32_t)*cursor >= (uint32_t)repo->entity_count) {
+            EXIT_CRITICAL();
+            return ERR_NOT_FOUND;
+        }
+        slot = (AegisInfrastructureRepositorySlot)*cursor;
+        (*cursor)++;
+        if (repo->entity_pool[slot].base.is_valid && repo->dirty[slot] != 0U) {
+            *entity_id = repo->entity_pool[slot].base.id;
+            *mask = repo->dirty[slot];
+            repo->dirty[slot] = 0U;
+            taken = TRUE;
+        }
+        EXIT_CRITICAL();
+    }
+
+    return ERR_OK;
+}
+
+AegisErrorCode aegis_infrastructure_repository_inmem_restore(AegisInfrastructureRepositoryInmem* repo,
+                                                             const AegisDomainEntity* entity) {
+    AegisDomainEntity copy;
+    AegisInfrastructureRepositorySlot slot;
+    AegisErrorCode ret;
+    uint8_t type_idx;
+
+    if (repo == NULL || entity == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    if (!repo->is_initialized) {
+        return ERR_NOT_INITIALIZED;
+    }
+
+    if (entity->base.id == ENTITY_ID_INVALID || entity->payload_size > (uint16_t)DOMAIN_ENTITY_PAYLOAD_MAX) {
+        return ERR_INVALID_PARAM;
+    }
+
+    /* 时间戳等字段按原样写入，调用方的实体不被修改 */
+    memcpy(&copy, entity, sizeof(copy));
+
+    ENTER_CRITICAL();
+
+    slot = find_entity_index(repo, copy.base.id);
+    if (slot != REPOSITORY_SLOT_NONE) {
+        ret = prepare_update(repo, &copy, &slot, &type_idx);
+        if (ret == ERR_OK) {
+            apply_update(repo, slot, &copy, type_idx);
+        }
+    } else if (repo_available(repo) == 0U) {
+        ret = ERR_OUT_OF_RANGE;
+    } else {
+        ret = prepare_create(repo, &copy, &type_idx);
+        if (ret == ERR_OK) {
+            slot = apply_create(repo, &copy, type_idx);
+        }
+    }
+
+    if (ret == ERR_OK) {
+        /* 已与持久化副本一致，不再视为修改 */
+        repo->dirty[slot] = 0U;
+
+        /* 之后自动分配的ID从恢复的ID之后开始 */
+        if (copy.base.id >= repo->next_entity_id) {
+            repo->next_entity_id = (AegisEntityId)(copy.base.id + 1U);
+            if (repo->next_entity_id == ENTITY_ID_INVALID) {
+                repo->next_entity_id = 1;
+            }
+        }
+    }
+
+    EXIT_CRITICAL();
+
+    return ret;
+}
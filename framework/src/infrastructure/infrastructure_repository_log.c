@@ -0,0 +1,698 @@
+/*
+ * @file: infrastructure_repository_log.c
+ * @brief: 持久化仓储实现（内存仓储 + Flash 追加日志）
+ * @author: jack liu
+ */
+
+#include "infrastructure_repository_log.h"
+#include "compile_time.h"
+#include <stddef.h>
+#include <string.h>
+
+/* 日志记录类型 */
+#define REPOSITORY_LOG_KIND_PUT    0x01U   /* 整实体（头部 + payload_size + 有效 payload） */
+#define REPOSITORY_LOG_KIND_DEL    0x02U   /* 实体ID */
+#define REPOSITORY_LOG_KIND_PATCH  0x03U   /* payload 区间（AegisInfrastructureRepositoryLogPatch + 数据） */
+
+/* PUT 记录 = 实体结构体中 payload 之前的部分 + 有效 payload */
+#define REPOSITORY_LOG_ENTITY_HEAD  ((uint16_t)offsetof(AegisDomainEntity, payload))
+#define REPOSITORY_LOG_ENTITY_MAX   (offsetof(AegisDomainEntity, payload) + DOMAIN_ENTITY_PAYLOAD_MAX)
+
+/* 记录布局版本：格式版本 + 实体结构大小（结构变化后旧日志拒绝挂载） */
+#define REPOSITORY_LOG_LAYOUT  ((uint16_t)(0x1000U | ((uint16_t)sizeof(AegisDomainEntity) & 0x0FFFU)))
+
+/* PATCH 记录头 */
+typedef struct {
+    AegisEntityId id;
+    uint16_t offset;
+    uint32_t updated_at;
+} AegisInfrastructureRepositoryLogPatch;
+
+FW_STATIC_ASSERT(offsetof(AegisInfrastructureRepositoryLog, mem) == 0U, repository_log_mem_first);
+FW_STATIC_ASSERT(REPOSITORY_LOG_ENTITY_MAX <= FLASH_LOG_DATA_MAX, repository_log_entity_fits);
+FW_STATIC_ASSERT(sizeof(AegisInfrastructureRepositoryLogPatch) + DOMAIN_ENTITY_PAYLOAD_MAX <= FLASH_LOG_DATA_MAX,
+                 repository_log_patch_fits);
+
+/* ==================== 内部辅助函数 ==================== */
+static AegisInfrastructureRepositoryLog* repo_from_write(const AegisDomainRepositoryWriteInterface* self) {
+    if (self == NULL) {
+        return NULL;
+    }
+    /* mem 为首个成员，读接口 ctx（内存仓储地址）即本实例地址 */
+    return (AegisInfrastructureRepositoryLog*)self->read.ctx;
+}
+
+/* 向上取整的除法 */
+static uint16_t div_ceil(uint32_t n, uint32_t d) {
+    return (uint16_t)((n + d - 1U) / d);
+}
+
+/*
+ * @brief: 追加一条记录；Flash 写入失败则进入故障态
+ */
+static AegisErrorCode log_append(AegisInfrastructureRepositoryLog* repo,
+                                 uint8_t kind,
+                                 uint8_t flags,
+                                 const void* data,
+                                 uint16_t len) {
+    AegisErrorCode ret;
+
+    ret = aegis_infrastructure_flash_log_append(&repo->log, kind, flags, data, len);
+    if (ret != ERR_OK) {
+        repo->is_faulted = TRUE;
+        return ret;
+    }
+
+    if (repo->records_since_checkpoint < MAX_UINT16) {
+        repo->records_since_checkpoint++;
+    }
+    return ERR_OK;
+}
+
+static AegisErrorCode log_append_put(AegisInfrastructureRepositoryLog* repo,
+                                     const AegisDomainEntity* entity,
+                                     uint8_t flags) {
+    return log_append(repo, (uint8_t)REPOSITORY_LOG_KIND_PUT, flags, entity,
+                      (uint16_t)(REPOSITORY_LOG_ENTITY_HEAD + entity->payload_size));
+}
+
+static AegisErrorCode log_append_del(AegisInfrastructureRepositoryLog* repo, AegisEntityId entity_id, uint8_t flags) {
+    return log_append(repo, (uint8_t)REPOSITORY_LOG_KIND_DEL, flags, &entity_id, (uint16_t)sizeof(entity_id));
+}
+
+/*
+ * @brief: 写检查点：快照全部实体，提交后尾指针前移
+ */
+static AegisErrorCode log_checkpoint(AegisInfrastructureRepositoryLog* repo) {
+    AegisInfrastructureRepositoryInmem* mem = &repo->mem;
+    AegisInfrastructureRepositorySlot slot;
+    AegisEntityId next_id;
+    AegisErrorCode ret;
+
+    next_id = mem->next_entity_id;
+    ret = aegis_infrastructure_flash_log_checkpoint_begin(&repo->log, &next_id, (uint16_t)sizeof(next_id));
+    if (ret != ERR_OK) {
+        repo->is_faulted = TRUE;
+        return ret;
+    }
+
+    /* 写操作只在主循环进行，遍历期间实体不会变化 */
+    for (slot = 0; slot < mem->entity_count; slot++) {
+        if (mem->entity_pool[slot].base.is_valid) {
+            ret = log_append_put(repo, &mem->entity_pool[slot], 0U);
+            if (ret != ERR_OK) {
+                return ret;
+            }
+        }
+    }
+
+    ret = aegis_infrastructure_flash_log_checkpoint_commit(&repo->log);
+    if (ret != ERR_OK) {
+        repo->is_faulted = TRUE;
+        return ret;
+    }
+
+    repo->records_since_checkpoint = 0U;
+    return ERR_OK;
+}
+
+/*
+ * @brief: 写操作前检查：已挂载且未故障；空间不足或累积记录过多时先同步写检查点
+ */
+static AegisErrorCode log_prepare_write(AegisInfrastructureRepositoryLog* repo) {
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!repo->is_mounted) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (repo->is_faulted) {
+        return ERR_INVALID_STATE;
+    }
+
+    if (aegis_infrastructure_flash_log_free_pages(&repo->log) < repo->reserve_pages ||
+        repo->records_since_checkpoint >= (uint16_t)REPOSITORY_LOG_REPLAY_MAX) {
+        return log_checkpoint(repo);
+    }
+    return ERR_OK;
+}
+
+/* ==================== 重放 ==================== */
+static AegisErrorCode replay_put(AegisInfrastructureRepositoryLog* repo, const uint8_t* data, uint16_t len) {
+    AegisDomainEntity entity;
+
+    if (len < REPOSITORY_LOG_ENTITY_HEAD || len > (uint16_t)REPOSITORY_LOG_ENTITY_MAX) {
+        return ERR_INVALID_STATE;
+    }
+
+    memset(&entity, 0, sizeof(entity));
+    memcpy(&entity, data, len);
+    if (entity.payload_size != (uint16_t)(len - REPOSITORY_LOG_ENTITY_HEAD)) {
+        return ERR_INVALID_STATE;
+    }
+
+    return aegis_infrastructure_repository_inmem_restore(&repo->mem, &entity);
+}
+
+static AegisErrorCode replay_del(AegisInfrastructureRepositoryLog* repo, const uint8_t* data, uint16_t len) {
+    AegisEntityId entity_id;
+    AegisErrorCode ret;
+
+    if (len != (uint16_t)sizeof(entity_id)) {
+        return ERR_INVALID_STATE;
+    }
+
+    memcpy(&entity_id, data, sizeof(entity_id));
+    ret = repo->mem.write_if.delete_entity(&repo->mem.write_if, entity_id);
+    return (ret == ERR_NOT_FOUND) ? ERR_OK : ret;
+}
+
+static AegisErrorCode replay_patch(AegisInfrastructureRepositoryLog* repo, const uint8_t* data, uint16_t len) {
+    AegisInfrastructureRepositoryLogPatch patch;
+    AegisDomainEntity entity;
+    uint16_t n;
+    AegisErrorCode ret;
+
+    if (len <= (uint16_t)sizeof(patch)) {
+        return ERR_INVALID_STATE;
+    }
+
+    memcpy(&patch, data, sizeof(patch));
+    n = (uint16_t)(len - (uint16_t)sizeof(patch));
+    if ((uint32_t)patch.offset + (uint32_t)n > (uint32_t)DOMAIN_ENTITY_PAYLOAD_MAX) {
+        return ERR_INVALID_STATE;
+    }
+
+    ret = repo->mem.read_if.snapshot(&repo->mem.read_if, patch.id, &entity);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if (patch.offset > entity.payload_size) {
+        memset(&entity.payload[entity.payload_size], 0, (size_t)(patch.offset - entity.payload_size));
+    }
+    memcpy(&entity.payload[patch.offset], &data[sizeof(patch)], n);
+    if ((uint16_t)(patch.offset + n) > entity.payload_size) {
+        entity.payload_size = (uint16_t)(patch.offset + n);
+    }
+    entity.base.updated_at = patch.updated_at;
+
+    return aegis_infrastructure_repository_inmem_restore(&repo->mem, &entity);
+}
+
+/*
+ * @brief: 记录涉及的实体ID（PUT/DEL/PATCH 记录的首字段），其他记录返回 ENTITY_ID_INVALID
+ */
+static AegisEntityId record_entity_id(const AegisInfrastructureFlashLogRecord* record, const uint8_t* data) {
+    AegisEntityId entity_id = ENTITY_ID_INVALID;
+
+    if ((record->kind == REPOSITORY_LOG_KIND_PUT || record->kind == REPOSITORY_LOG_KIND_DEL ||
+         record->kind == REPOSITORY_LOG_KIND_PATCH) && record->len >= (uint16_t)sizeof(entity_id)) {
+        memcpy(&entity_id, data, sizeof(entity_id));
+    }
+    return entity_id;
+}
+
+/*
+ * @param ids: 只应用涉及这些实体的记录（NULL 表示全部应用）；筛选重放不改变记录计数与下一个实体ID
+ * @param id_count: ids 的个数
+ */
+static AegisErrorCode replay_record(AegisInfrastructureRepositoryLog* repo,
+                                    const AegisInfrastructureFlashLogRecord* record,
+                                    const uint8_t* data,
+                                    const AegisEntityId* ids,
+                                    uint8_t id_count) {
+    AegisEntityId entity_id;
+    AegisEntityId next_id;
+    uint8_t i;
+
+    if (ids != NULL) {
+        entity_id = record_entity_id(record, data);
+        for (i = 0; i < id_count; i++) {
+            if (ids[i] == entity_id) {
+                break;
+            }
+        }
+        if (entity_id == ENTITY_ID_INVALID || i == id_count) {
+            return ERR_OK;
+        }
+    } else {
+        repo->replayed_records++;
+        if (repo->records_since_checkpoint < MAX_UINT16) {
+            repo->records_since_checkpoint++;
+        }
+    }
+
+    switch (record->kind) {
+        case REPOSITORY_LOG_KIND_PUT:
+            return replay_put(repo, data, record->len);
+        case REPOSITORY_LOG_KIND_DEL:
+            return replay_del(repo, data, record->len);
+        case REPOSITORY_LOG_KIND_PATCH:
+            return replay_patch(repo, data, record->len);
+        case FLASH_LOG_KIND_CKPT_BEGIN:
+            if (record->len == (uint16_t)sizeof(next_id)) {
+                memcpy(&next_id, data, sizeof(next_id));
+                repo->mem.next_entity_id = next_id;
+            }
+            return ERR_OK;
+        case FLASH_LOG_KIND_CKPT_END:
+            repo->records_since_checkpoint = 0U;
+            return ERR_OK;
+        default:
+            /* COMMIT/ABORT 及未知类型不影响状态 */
+            return ERR_OK;
+    }
+}
+
+/*
+ * @brief: 从日志尾指针重放到结尾；记录组先向后找到结束记录，COMMIT 才整组应用
+ * @param ids: 只重放涉及这些实体的记录（NULL 表示全部重放）
+ * @param id_count: ids 的个数
+ */
+static AegisErrorCode replay_log(AegisInfrastructureRepositoryLog* repo, const AegisEntityId* ids, uint8_t id_count) {
+    uint8_t data[FLASH_LOG_DATA_MAX];
+    AegisInfrastructureFlashLogRecord record;
+    AegisInfrastructureFlashLogPos cursor;
+    AegisInfrastructureFlashLogPos group_start;
+    AegisErrorCode ret;
+
+    ret = aegis_infrastructure_flash_log_cursor(&repo->log, &cursor);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    for (;;) {
+        group_start = cursor;
+        ret = aegis_infrastructure_flash_log_read(&repo->log, &cursor, &record, data, (uint16_t)sizeof(data));
+        if (ret == ERR_EMPTY) {
+            return ERR_OK;
+        }
+        if (ret != ERR_OK) {
+            return ret;
+        }
+
+        if ((record.flags & FLASH_LOG_FLAG_GROUP) != 0U) {
+            /* 找到组结束记录（挂载保证日志不以未结束的组收尾；追加失败后未结束的组读到结尾，整组丢弃） */
+            do {
+                ret = aegis_infrastructure_flash_log_read(&repo->log, &cursor, &record, data, (uint16_t)sizeof(data));
+            } while (ret == ERR_OK && (record.flags & FLASH_LOG_FLAG_GROUP) != 0U);
+
+            if (ret == ERR_EMPTY) {
+                return ERR_OK;
+            }
+            if (ret != ERR_OK) {
+                return ret;
+            }
+            if (record.kind != FLASH_LOG_KIND_COMMIT) {
+                /* ABORT：整组丢弃 */
+                continue;
+            }
+
+            /* COMMIT：回到组起点逐条应用，读到 COMMIT 为止 */
+            cursor = group_start;
+            for (;;) {
+                ret = aegis_infrastructure_flash_log_read(&repo->log, &cursor, &record, data, (uint16_t)sizeof(data));
+                if (ret != ERR_OK) {
+                    return ret;
+                }
+                if ((record.flags & FLASH_LOG_FLAG_GROUP) == 0U) {
+                    break;
+                }
+                ret = replay_record(repo, &record, data, ids, id_count);
+                if (ret != ERR_OK) {
+                    return ret;
+                }
+            }
+            continue;
+        }
+
+        ret = replay_record(repo, &record, data, ids, id_count);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+    }
+}
+
+/*
+ * @brief: 日志追加失败后重新载入本次写操作涉及的实体：先从内存删除，再从日志尾指针起只重放涉及它们的记录。
+ *         修改前的状态取自日志中已完整写入的记录而不是内存中的副本，调用方经 get() 指针直接改过的实体
+ *         同样恢复为最后一次持久化的状态，与重启后一致（重放失败时这些实体保持删除，仓储已处于故障态）
+ * @param ids: 涉及的实体ID（创建的实体使用新分配的ID）
+ * @param id_count: ids 的个数
+ * @param next_id: 写操作前的下一个实体ID
+ */
+static void log_reload(AegisInfrastructureRepositoryLog* repo,
+                       const AegisEntityId* ids,
+                       uint8_t id_count,
+                       AegisEntityId next_id) {
+    uint8_t i;
+
+    for (i = 0; i < id_count; i++) {
+        (void)repo->mem.write_if.delete_entity(&repo->mem.write_if, ids[i]);
+    }
+    /* 重新载入的实体（含恰好写完的创建记录）按重放规则推进下一个实体ID */
+    repo->mem.next_entity_id = next_id;
+    (void)replay_log(repo, ids, id_count);
+}
+
+/* ==================== 写接口实现 ==================== */
+static AegisErrorCode repository_log_init_impl(const AegisDomainRepositoryWriteInterface* self) {
+    AegisInfrastructureRepositoryLog* repo;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    repo->is_mounted = FALSE;
+    repo->is_faulted = FALSE;
+    repo->records_since_checkpoint = 0U;
+    repo->replayed_records = 0U;
+
+    ret = repo->mem.write_if.init(&repo->mem.write_if);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = aegis_infrastructure_flash_log_mount(&repo->log);
+    if (ret == ERR_OK) {
+        ret = replay_log(repo, NULL, 0U);
+    }
+    if (ret != ERR_OK) {
+        /* 不暴露重放了一半的状态 */
+        (void)repo->mem.write_if.init(&repo->mem.write_if);
+        return ret;
+    }
+
+    repo->is_mounted = TRUE;
+    return ERR_OK;
+}
+
+static AegisErrorCode repository_log_create_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                 AegisDomainEntity* entity) {
+    AegisInfrastructureRepositoryLog* repo;
+    AegisEntityId next_id;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    ret = log_prepare_write(repo);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    next_id = repo->mem.next_entity_id;
+    ret = repo->mem.write_if.create(&repo->mem.write_if, entity);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = log_append_put(repo, entity, 0U);
+    if (ret != ERR_OK) {
+        log_reload(repo, &entity->base.id, 1U, next_id);
+    }
+    return ret;
+}
+
+static AegisErrorCode repository_log_update_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                 AegisDomainEntity* entity) {
+    AegisInfrastructureRepositoryLog* repo;
+    AegisEntityId next_id;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    ret = log_prepare_write(repo);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if (entity == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    next_id = repo->mem.next_entity_id;
+    ret = repo->mem.write_if.update(&repo->mem.write_if, entity);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = log_append_put(repo, entity, 0U);
+    if (ret != ERR_OK) {
+        log_reload(repo, &entity->base.id, 1U, next_id);
+    }
+    return ret;
+}
+
+static AegisErrorCode repository_log_delete_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                 AegisEntityId entity_id) {
+    AegisInfrastructureRepositoryLog* repo;
+    AegisEntityId next_id;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    ret = log_prepare_write(repo);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    next_id = repo->mem.next_entity_id;
+    ret = repo->mem.write_if.delete_entity(&repo->mem.write_if, entity_id);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = log_append_del(repo, entity_id, 0U);
+    if (ret != ERR_OK) {
+        log_reload(repo, &entity_id, 1U, next_id);
+    }
+    return ret;
+}
+
+static AegisErrorCode repository_log_apply_batch_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                      AegisDomainRepositoryOp* ops,
+                                                      uint8_t count,
+                                                      uint8_t* failed_index) {
+    AegisEntityId ids[REPOSITORY_BATCH_MAX];
+    AegisInfrastructureRepositoryLog* repo;
+    AegisEntityId next_id;
+    uint8_t flags;
+    uint8_t i;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    ret = log_prepare_write(repo);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    if (ops == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    next_id = repo->mem.next_entity_id;
+    ret = repo->mem.write_if.apply_batch(&repo->mem.write_if, ops, count, failed_index);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    /* 单条操作无需成组 */
+    flags = (count > 1U) ? (uint8_t)FLASH_LOG_FLAG_GROUP : 0U;
+    for (i = 0; i < count && ret == ERR_OK; i++) {
+        if (ops[i].kind == DOMAIN_REPOSITORY_OP_DELETE) {
+            ret = log_append_del(repo, ops[i].entity_id, flags);
+        } else {
+            ret = log_append_put(repo, ops[i].entity, flags);
+        }
+    }
+
+    if (ret == ERR_OK && count > 1U) {
+        ret = log_append(repo, (uint8_t)FLASH_LOG_KIND_COMMIT, 0U, NULL, 0U);
+    }
+
+    if (ret != ERR_OK) {
+        /* 组缺 COMMIT，重放时整组丢弃：整批重新载入（内存仓储已接受的批次不超过 REPOSITORY_BATCH_MAX 条） */
+        for (i = 0; i < count; i++) {
+            ids[i] = (ops[i].kind == DOMAIN_REPOSITORY_OP_DELETE) ? ops[i].entity_id : ops[i].entity->base.id;
+        }
+        log_reload(repo, ids, count, next_id);
+    }
+    return ret;
+}
+
+static AegisErrorCode repository_log_update_payload_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                         AegisEntityId entity_id,
+                                                         uint16_t offset,
+                                                         const void* data,
+                                                         uint16_t len) {
+    uint8_t buf[sizeof(AegisInfrastructureRepositoryLogPatch) + DOMAIN_ENTITY_PAYLOAD_MAX];
+    AegisInfrastructureRepositoryLogPatch patch;
+    AegisInfrastructureRepositoryLog* repo;
+    AegisDomainEntity* stored;
+    AegisEntityId next_id;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    ret = log_prepare_write(repo);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    next_id = repo->mem.next_entity_id;
+    ret = repo->mem.write_if.update_payload(&repo->mem.write_if, entity_id, offset, data, len);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = repo->mem.read_if.get(&repo->mem.read_if, entity_id, &stored);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    /* 只记录修改的区间与新的 updated_at */
+    patch.id = entity_id;
+    patch.offset = offset;
+    patch.updated_at = stored->base.updated_at;
+    memcpy(buf, &patch, sizeof(patch));
+    memcpy(&buf[sizeof(patch)], data, len);
+
+    ret = log_append(repo, (uint8_t)REPOSITORY_LOG_KIND_PATCH, 0U, buf, (uint16_t)(sizeof(patch) + (uint32_t)len));
+    if (ret != ERR_OK) {
+        log_reload(repo, &entity_id, 1U, next_id);
+    }
+    return ret;
+}
+
+static AegisErrorCode repository_log_compact_impl(const AegisDomainRepositoryWriteInterface* self,
+                                                  uint16_t budget,
+                                                  uint16_t* remaining) {
+    AegisInfrastructureRepositoryLog* repo;
+    AegisErrorCode ret;
+
+    repo = repo_from_write(self);
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    ret = repo->mem.write_if.compact(&repo->mem.write_if, budget, remaining);
+    if (ret != ERR_OK || !repo->is_mounted || repo->is_faulted) {
+        return ret;
+    }
+
+    /* 主循环空闲时提前写检查点，尽量不让写操作承担检查点耗时 */
+    if (repo->records_since_checkpoint >= (uint16_t)(REPOSITORY_LOG_REPLAY_MAX / 2U) ||
+        aegis_infrastructure_flash_log_free_pages(&repo->log) < (uint16_t)(repo->reserve_pages + repo->checkpoint_pages)) {
+        ret = log_checkpoint(repo);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+    }
+
+    /* 每次最多预擦除一页，写操作换页时只需写页头 */
+    return aegis_infrastructure_flash_log_erase_ahead(&repo->log, 1U);
+}
+
+/* ==================== 公共接口实现 ==================== */
+AegisErrorCode aegis_infrastructure_repository_log_init(AegisInfrastructureRepositoryLog* repo,
+                                                        const AegisHalFlash* flash,
+                                                        InfrastructureNowMsFn now_ms_fn,
+                                                        void* now_ms_ctx) {
+    uint32_t per_page;
+    uint16_t batch_pages;
+    AegisErrorCode ret;
+
+    if (repo == NULL || flash == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    memset(repo, 0, sizeof(*repo));
+
+    ret = aegis_infrastructure_repository_inmem_init(&repo->mem, now_ms_fn, now_ms_ctx);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = aegis_infrastructure_flash_log_init(&repo->log, flash, REPOSITORY_LOG_LAYOUT);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    /*
+     * 空间预算（按最大 PUT 记录估算，+1 页覆盖从写到一半的页开始的情况）：
+     * 检查点 = 全部实体 + CKPT_BEGIN/END；一批 = REPOSITORY_BATCH_MAX 条 + COMMIT。
+     * 写操作前保留 检查点 + 一批 的空闲页；检查点完成后须仍满足该保留量，否则会反复写检查点。
+     */
+    per_page = (flash->page_size - FLASH_LOG_PAGE_HEADER) / FLASH_LOG_RECORD_SPAN(REPOSITORY_LOG_ENTITY_MAX);
+    repo->checkpoint_pages = (uint16_t)(div_ceil((uint32_t)REPOSITORY_MAX_ENTITIES + 2U, per_page) + 1U);
+    batch_pages = (uint16_t)(div_ceil((uint32_t)REPOSITORY_BATCH_MAX + 1U, per_page) + 1U);
+    repo->reserve_pages = (uint16_t)(repo->checkpoint_pages + batch_pages);
+
+    if ((uint32_t)flash->page_count < (uint32_t)repo->reserve_pages + (uint32_t)repo->checkpoint_pages + 1U) {
+        return ERR_INVALID_PARAM;
+    }
+
+    repo->write_if.read = repo->mem.read_if;
+    repo->write_if.init = repository_log_init_impl;
+    repo->write_if.create = repository_log_create_impl;
+    repo->write_if.update = repository_log_update_impl;
+    repo->write_if.delete_entity = repository_log_delete_impl;
+    repo->write_if.compact = repository_log_compact_impl;
+    repo->write_if.apply_batch = repository_log_apply_batch_impl;
+    repo->write_if.update_payload = repository_log_update_payload_impl;
+
+    return ERR_OK;
+}
+
+const AegisDomainRepositoryReadInterface* aegis_infrastructure_repository_log_read(AegisInfrastructureRepositoryLog* repo) {
+    if (repo == NULL) {
+        return NULL;
+    }
+    return &repo->write_if.read;
+}
+
+const AegisDomainRepositoryWriteInterface* aegis_infrastructure_repository_log_write(AegisInfrastructureRepositoryLog* repo) {
+    if (repo == NULL) {
+        return NULL;
+    }
+    return &repo->write_if;
+}
+
+AegisErrorCode aegis_infrastructure_repository_log_checkpoint(AegisInfrastructureRepositoryLog* repo) {
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+    if (!repo->is_mounted) {
+        return ERR_NOT_INITIALIZED;
+    }
+    if (repo->is_faulted) {
+        return ERR_INVALID_STATE;
+    }
+
+    return log_checkpoint(repo);
+}
+
+AegisErrorCode aegis_infrastructure_repository_log_format(AegisInfrastructureRepositoryLog* repo) {
+    AegisErrorCode ret;
+
+    if (repo == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    repo->is_mounted = FALSE;
+    repo->is_faulted = FALSE;
+    repo->records_since_checkpoint = 0U;
+    repo->replayed_records = 0U;
+
+    ret = repo->mem.write_if.init(&repo->mem.write_if);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = aegis_infrastructure_flash_log_format(&repo->log);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    repo->is_mounted = TRUE;
+    return ERR_OK;
+}
@@ -0,0 +1,143 @@
+/*
+ * @file: bench_dispatch.c
+ * @brief: 命令处理器分发延迟基准测试（8 / 32 / 128 个处理器）
+ * @author: jack liu
+ * @req: REQ-TEST-BENCH-DISPATCH
+ *
+ * 对比：
+ * 1. 旧实现的临界区内线性扫描（在此按公开注册表字段复现）
+ * 2. aegis_app_cmd_service_execute 未封存（临界区 + 哈希索引）
+ * 3. aegis_app_cmd_service_execute 已封存（无锁哈希索引）
+ *
+ * 本目标以 APP_CMD_SERVICE_MAX_HANDLERS=128 单独编译 app_cmd_service.c。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "app_cmd_service.h"
+#include "critical.h"
+#include "bench_cycles.h"
+
+/* ==================== 函数原型声明 ==================== */
+static AegisErrorCode bench_handler(const AegisCommand* cmd, AegisCommandResult* result, void* ctx);
+static AegisErrorCode legacy_execute(const AegisAppCmdService* service,
+                                     const AegisCommand* cmd,
+                                     AegisCommandResult* result);
+static int bench_handlers(uint8_t handler_count);
+
+#define BENCH_DISPATCH_OPS  400000UL
+
+/* 类型值刻意不连续，模拟按模块分段编号 */
+#define BENCH_TYPE_OF(i)    ((AegisCommandType)(0x0100U + (uint16_t)(i) * 37U))
+
+static AegisErrorCode bench_handler(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
+    uint32_t* hits = (uint32_t*)ctx;
+    (void)cmd;
+    (void)result;
+    (*hits)++;
+    return ERR_OK;
+}
+
+/*
+ * @brief: 旧实现：临界区内逐项比较类型
+ */
+static AegisErrorCode legacy_execute(const AegisAppCmdService* service,
+                                     const AegisCommand* cmd,
+                                     AegisCommandResult* result) {
+    uint8_t i;
+    AppCmdHandler handler = NULL;
+    void* ctx = NULL;
+
+    ENTER_CRITICAL();
+    for (i = 0; i < service->handler_count; i++) {
+        if (service->handlers[i].type == cmd->type) {
+            handler = service->handlers[i].handler;
+            ctx = service->handlers[i].ctx;
+            break;
+        }
+    }
+    EXIT_CRITICAL();
+
+    if (handler == NULL) {
+        return ERR_NOT_FOUND;
+    }
+    return handler(cmd, result, ctx);
+}
+
+static int bench_handlers(uint8_t handler_count) {
+    static AegisAppCmdService service;
+    static AegisCommand cmds[APP_CMD_SERVICE_MAX_HANDLERS];
+    AegisCommandResult result;
+    uint32_t hits = 0U;
+    unsigned long op;
+    uint8_t i;
+    double t0;
+    double legacy_total;
+    double locked_total;
+    double sealed_total;
+
+    (void)aegis_app_cmd_service_init(&service);
+    for (i = 0; i < handler_count; i++) {
+        if (aegis_app_cmd_service_register_handler(&service, BENCH_TYPE_OF(i), bench_handler, &hits) != ERR_OK) {
+            printf("  ✗ 注册失败: %u\n", (unsigned int)i);
+            return 1;
+        }
+        memset(&cmds[i], 0, sizeof(AegisCommand));
+        cmds[i].type = BENCH_TYPE_OF(i);
+    }
+
+    /* 正确性：每个类型都能分发，未注册类型返回 ERR_NOT_FOUND */
+    for (i = 0; i < handler_count; i++) {
+        if (aegis_app_cmd_service_execute(&service, &cmds[i], &result) != ERR_OK) {
+            printf("  ✗ 分发失败: type=%u\n", (unsigned int)cmds[i].type);
+            return 1;
+        }
+    }
+    cmds[0].type = (AegisCommandType)0x0001U;
+    if (aegis_app_cmd_service_execute(&service, &cmds[0], &result) != ERR_NOT_FOUND) {
+        printf("  ✗ 未注册类型应返回 ERR_NOT_FOUND\n");
+        return 1;
+    }
+    cmds[0].type = BENCH_TYPE_OF(0);
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_DISPATCH_OPS; op++) {
+        (void)legacy_execute(&service, &cmds[op % handler_count], &result);
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_DISPATCH_OPS; op++) {
+        (void)aegis_app_cmd_service_execute(&service, &cmds[op % handler_count], &result);
+    }
+    locked_total = bench_cycles_now() - t0;
+
+    (void)aegis_app_cmd_service_seal(&service);
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_DISPATCH_OPS; op++) {
+        (void)aegis_app_cmd_service_execute(&service, &cmds[op % handler_count], &result);
+    }
+    sealed_total = bench_cycles_now() - t0;
+
+    printf("  -- %u handlers --\n", (unsigned int)handler_count);
+    bench_cycles_report("legacy linear scan", legacy_total, BENCH_DISPATCH_OPS);
+    bench_cycles_report("hash index (unsealed, locked)", locked_total, BENCH_DISPATCH_OPS);
+    bench_cycles_report("hash index (sealed, lock-free)", sealed_total, BENCH_DISPATCH_OPS);
+
+    return 0;
+}
+
+/* ==================== 入口 ==================== */
+int main(void) {
+    int failed = 0;
+
+    printf("========================================\n");
+    printf("  命令分发基准测试\n");
+    printf("========================================\n");
+
+    failed |= bench_handlers(8U);
+    failed |= bench_handlers(32U);
+    failed |= bench_handlers(128U);
+
+    return failed;
+}
@@ -8,6 +8,7 @@
  */
 
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include <assert.h>
 #include "app_init.h"
@@ -280,6 +281,280 @@ static void drain_one_command(AegisAppRuntime* app, AegisCommandResult* out_resu
     }
 }
 
+/*
+ * @test: 定长槽命令队列 reserve/commit/peek/release（原地构造/原地执行）
+ */
+static void test_cmd_slot_queue(void) {
+    AegisErrorCode ret;
+    AegisTraceLog trace;
+    uint32_t tick;
+    AegisAppCmdQueue queue;
+    AegisCommand* a;
+    AegisCommand* b;
+    AegisCommand* c;
+    const AegisCommand* view;
+    AegisCommand cmd;
+    uint8_t count;
+    uint8_t i;
+
+    tick = 0U;
+    (void)aegis_trace_log_init(&trace, test_now_ms, &tick);
+    ret = aegis_app_cmd_init(&queue, &trace);
+    assert(ret == ERR_OK);
+
+    /* 空队列：peek/release 均失败 */
+    assert(aegis_app_cmd_peek(&queue, &view) == ERR_EMPTY);
+    assert(aegis_app_cmd_release(&queue) == ERR_INVALID_STATE);
+
+    /* 两个生产者交错：后预留的先提交，消费仍按预留顺序 */
+    ret = aegis_app_cmd_reserve(&queue, &a);
+    assert(ret == ERR_OK);
+    ret = aegis_app_cmd_reserve(&queue, &b);
+    assert(ret == ERR_OK);
+
+    APP_CMD_INIT(b, TEST_CMD_SET_POWER);
+    ret = aegis_app_cmd_commit(&queue, b);
+    assert(ret == ERR_OK);
+    assert(aegis_app_cmd_peek(&queue, &view) == ERR_EMPTY);
+
+    APP_CMD_INIT(a, TEST_CMD_CREATE_CHARGER);
+    a->payload_size = 1U;
+    a->payload[0] = 7U;
+    ret = aegis_app_cmd_commit(&queue, a);
+    assert(ret == ERR_OK);
+    assert(a->timestamp != 0U);
+
+    (void)aegis_app_cmd_get_count(&queue, &count);
+    assert(count == 2U);
+
+    /* 原地读取：返回的就是生产者写入的槽 */
+    ret = aegis_app_cmd_peek(&queue, &view);
+    assert(ret == ERR_OK);
+    assert(view == a);
+    assert(view->type == TEST_CMD_CREATE_CHARGER && view->payload[0] == 7U);
+    ret = aegis_app_cmd_release(&queue);
+    assert(ret == ERR_OK);
+
+    ret = aegis_app_cmd_peek(&queue, &view);
+    assert(ret == ERR_OK && view == b);
+    ret = aegis_app_cmd_release(&queue);
+    assert(ret == ERR_OK);
+
+    /* 作废与非法提交：消费者自动跳过 */
+    ret = aegis_app_cmd_reserve(&queue, &a);
+    assert(ret == ERR_OK);
+    ret = aegis_app_cmd_reserve(&queue, &b);
+    assert(ret == ERR_OK);
+    ret = aegis_app_cmd_reserve(&queue, &c);
+    assert(ret == ERR_OK);
+    assert(aegis_app_cmd_cancel(&queue, a) == ERR_OK);
+    assert(aegis_app_cmd_cancel(&queue, a) == ERR_INVALID_STATE);
+    APP_CMD_INIT(b, CMD_TYPE_INVALID);
+    assert(aegis_app_cmd_commit(&queue, b) == ERR_INVALID_PARAM);
+    APP_CMD_INIT(c, TEST_CMD_SET_POWER);
+    assert(aegis_app_cmd_commit(&queue, c) == ERR_OK);
+
+    ret = aegis_app_cmd_peek(&queue, &view);
+    assert(ret == ERR_OK && view == c);
+    (void)aegis_app_cmd_release(&queue);
+    assert(aegis_app_cmd_peek(&queue, &view) == ERR_EMPTY);
+
+    /* dequeue 兼容路径 */
+    for (i = 0; i < 4U; i++) {
+        memset(&cmd, 0, sizeof(cmd));
+        APP_CMD_INIT(&cmd, TEST_CMD_SET_POWER);
+        cmd.payload_size = 1U;
+        cmd.payload[0] = i;
+        ret = aegis_app_cmd_enqueue(&queue, &cmd);
+        assert(ret == ERR_OK);
+    }
+    for (i = 0; i < 4U; i++) {
+        memset(&cmd, 0, sizeof(cmd));
+        ret = aegis_app_cmd_dequeue(&queue, &cmd);
+        assert(ret == ERR_OK);
+        assert(cmd.payload_size == 1U && cmd.payload[0] == i);
+    }
+    assert(aegis_app_cmd_dequeue(&queue, &cmd) == ERR_EMPTY);
+
+    /* payload 超限被拒绝 */
+    memset(&cmd, 0, sizeof(cmd));
+    APP_CMD_INIT(&cmd, TEST_CMD_SET_POWER);
+    cmd.payload_size = (uint16_t)(APP_CMD_PAYLOAD_MAX + 1U);
+    assert(aegis_app_cmd_enqueue(&queue, &cmd) == ERR_INVALID_PARAM);
+
+    (void)ret;
+    printf("  ✓ slot command queue reserve/commit/peek/release\n");
+}
+
+/* 静态分发表用处理器：ctx 为计数器，返回命令类型便于校验分发目标 */
+static AegisErrorCode handle_static_count(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
+    (*(uint32_t*)ctx)++;
+    result->created_id = (AegisEntityId)cmd->type;
+    return ERR_OK;
+}
+
+/*
+ * @test: 静态分发表（const 稠密跳转表，优先于运行时注册）
+ */
+static void test_cmd_static_table(void) {
+    static const AppCmdHandler handlers[3] = { handle_static_count, NULL, handle_static_count };
+    static const AegisAppCmdStaticTable table = { (AegisCommandType)0x20U, 3U, handlers };
+    static const AegisAppCmdStaticTable overlap = { (AegisCommandType)0x22U, 3U, handlers };
+    static const AegisAppCmdStaticTable bad_range = { (AegisCommandType)0xFFFEU, 2U, handlers };
+    AegisAppCmdService service;
+    AegisCommand cmd;
+    AegisCommandResult result;
+    uint32_t table_hits = 0U;
+    uint32_t runtime_hits = 0U;
+
+    assert(aegis_app_cmd_service_init(&service) == ERR_OK);
+    assert(aegis_app_cmd_service_bind_table(&service, NULL, NULL) == ERR_NULL_PTR);
+    assert(aegis_app_cmd_service_bind_table(&service, &bad_range, NULL) == ERR_INVALID_PARAM);
+    assert(aegis_app_cmd_service_bind_table(&service, &table, &table_hits) == ERR_OK);
+    assert(aegis_app_cmd_service_bind_table(&service, &overlap, NULL) == ERR_INVALID_PARAM);
+
+    /* 表内空洞回落到运行时注册；表内已有类型以静态表为准 */
+    assert(aegis_app_cmd_service_register_handler(&service, (AegisCommandType)0x21U,
+                                                  handle_static_count, &runtime_hits) == ERR_OK);
+    assert(aegis_app_cmd_service_register_handler(&service, (AegisCommandType)0x20U,
+                                                  handle_static_count, &runtime_hits) == ERR_OK);
+
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.type = (AegisCommandType)0x20U;
+    assert(aegis_app_cmd_service_execute(&service, &cmd, &result) == ERR_OK);
+    assert(result.created_id == (AegisEntityId)0x20U);
+    cmd.type = (AegisCommandType)0x22U;
+    assert(aegis_app_cmd_service_execute(&service, &cmd, &result) == ERR_OK);
+    assert(table_hits == 2U && runtime_hits == 0U);
+
+    cmd.type = (AegisCommandType)0x21U;
+    assert(aegis_app_cmd_service_execute(&service, &cmd, &result) == ERR_OK);
+    assert(runtime_hits == 1U);
+
+    cmd.type = (AegisCommandType)0x23U;
+    assert(aegis_app_cmd_service_execute(&service, &cmd, &result) == ERR_NOT_FOUND);
+    cmd.type = (AegisCommandType)0x1FU;
+    assert(aegis_app_cmd_service_execute(&service, &cmd, &result) == ERR_NOT_FOUND);
+
+    /* 封存后不再接受绑定，静态表分发照常 */
+    assert(aegis_app_cmd_service_seal(&service) == ERR_OK);
+    assert(aegis_app_cmd_service_bind_table(&service, &overlap, NULL) == ERR_INVALID_STATE);
+    cmd.type = (AegisCommandType)0x22U;
+    assert(aegis_app_cmd_service_execute(&service, &cmd, &result) == ERR_OK);
+    assert(table_hits == 3U);
+
+    (void)table_hits;
+    (void)runtime_hits;
+    printf("  ✓ static const dispatch table\n");
+}
+
+static void test_cmd_variable_length(void) {
+    AegisErrorCode ret;
+    AegisAppCmdQueue queue;
+    AegisCommand* a;
+    AegisCommand* b;
+    const AegisCommand* view;
+    AegisCommand cmd;
+    uint8_t count;
+    uint16_t n;
+    uint16_t full_n;
+    uint16_t i;
+
+    ret = aegis_app_cmd_init(&queue, NULL);
+    assert(ret == ERR_OK);
+
+    /* 小命令按实际长度存放：同样RAM可容纳远多于 CMD_QUEUE_SIZE 条 */
+    n = 0U;
+    for (;;) {
+        memset(&cmd, 0, sizeof(cmd));
+        APP_CMD_INIT(&cmd, TEST_CMD_SET_POWER);
+        cmd.payload_size = 2U;
+        cmd.payload[0] = (uint8_t)n;
+        cmd.payload[1] = (uint8_t)(n >> 8);
+        if (aegis_app_cmd_enqueue(&queue, &cmd) != ERR_OK) {
+            break;
+        }
+        n++;
+    }
+    assert(n >= (uint16_t)(2U * CMD_QUEUE_SIZE));
+    (void)aegis_app_cmd_get_count(&queue, &count);
+    assert(count == (uint8_t)n);
+
+    /* 满payload命令仍可排入默认预算下接近 CMD_QUEUE_SIZE 条 */
+    full_n = 0U;
+    (void)aegis_app_cmd_clear(&queue);
+    for (;;) {
+        memset(&cmd, 0, sizeof(cmd));
+        APP_CMD_INIT(&cmd, TEST_CMD_SET_POWER);
+        cmd.payload_size = (uint16_t)APP_CMD_PAYLOAD_MAX;
+        if (aegis_app_cmd_enqueue(&queue, &cmd) != ERR_OK) {
+            break;
+        }
+        full_n++;
+    }
+    assert(full_n > 0U && full_n < n);
+    (void)aegis_app_cmd_clear(&queue);
+
+    /* 回绕：反复入队/出队不同长度的命令，视图内容与顺序保持正确 */
+    for (i = 0; i < 500U; i++) {
+        memset(&cmd, 0, sizeof(cmd));
+        APP_CMD_INIT(&cmd, TEST_CMD_SET_POWER);
+        cmd.entity_id = (AegisEntityId)i;
+        cmd.payload_size = (uint16_t)(i % (APP_CMD_PAYLOAD_MAX + 1U));
+        memset(cmd.payload, (int)(i & 0xFFU), cmd.payload_size);
+        ret = aegis_app_cmd_enqueue(&queue, &cmd);
+        assert(ret == ERR_OK);
+
+        if ((i % 3U) != 0U) {
+            continue;
+        }
+        while (aegis_app_cmd_peek(&queue, &view) == ERR_OK) {
+            assert(view->payload_size == (uint16_t)(view->entity_id % (APP_CMD_PAYLOAD_MAX + 1U)));
+            assert(view->payload_size == 0U ||
+                   view->payload[view->payload_size - 1U] == (uint8_t)(view->entity_id & 0xFFU));
+            (void)aegis_app_cmd_release(&queue);
+        }
+    }
+
+    /* reserve 预留满长度，commit 按实际payload收缩 */
+    (void)aegis_app_cmd_clear(&queue);
+    ret = aegis_app_cmd_reserve(&queue, &a);
+    assert(ret == ERR_OK);
+    APP_CMD_INIT(a, TEST_CMD_SET_POWER);
+    a->payload_size = 0U;
+    assert(aegis_app_cmd_commit(&queue, a) == ERR_OK);
+    ret = aegis_app_cmd_reserve_sized(&queue, 0U, &b);
+    assert(ret == ERR_OK);
+    assert((const uint8_t*)b - (const uint8_t*)a == (ptrdiff_t)(offsetof(AegisCommand, payload) + 4U));
+
+    /* 按长度预留：payload超出预留长度的提交被拒绝 */
+    APP_CMD_INIT(b, TEST_CMD_SET_POWER);
+    b->payload_size = 4U;
+    assert(aegis_app_cmd_commit(&queue, b) == ERR_INVALID_PARAM);
+    assert(aegis_app_cmd_reserve_sized(&queue, (uint16_t)(APP_CMD_PAYLOAD_MAX + 1U), &b) == ERR_INVALID_PARAM);
+
+    assert(aegis_app_cmd_peek(&queue, &view) == ERR_OK && view == a);
+    (void)aegis_app_cmd_release(&queue);
+    assert(aegis_app_cmd_peek(&queue, &view) == ERR_EMPTY);
+
+    /* 有在途预留时拒绝清空，避免旧指针 commit 出队列之外的幽灵命令 */
+    ret = aegis_app_cmd_reserve(&queue, &a);
+    assert(ret == ERR_OK);
+    APP_CMD_INIT(a, TEST_CMD_SET_POWER);
+    a->payload_size = 0U;
+    assert(aegis_app_cmd_clear(&queue) == ERR_BUSY);
+    assert(aegis_app_cmd_commit(&queue, a) == ERR_OK);
+    assert(aegis_app_cmd_clear(&queue) == ERR_OK);
+    assert(aegis_app_cmd_commit(&queue, a) == ERR_INVALID_STATE);
+    assert(aegis_app_cmd_cancel(&queue, a) == ERR_INVALID_STATE);
+    (void)aegis_app_cmd_get_count(&queue, &count);
+    assert(count == 0U);
+    assert(aegis_app_cmd_peek(&queue, &view) == ERR_EMPTY);
+
+    (void)ret;
+    printf("  ✓ variable-length command records\n");
+}
+
 int main(void) {
     AegisErrorCode ret;
     AegisTraceLog trace;
@@ -408,6 +683,37 @@ int main(void) {
     assert(dto.charger_model == 1001U);
     assert(dto.power_level == 55U);
 
+    /* 4) 封存注册表：拒绝后续注册，分发照常（无锁路径） */
+    ret = aegis_app_init_seal(&app);
+    assert(ret == ERR_OK);
+    ret = aegis_app_cmd_service_register_handler(&app.cmd_service, (AegisCommandType)0x7777U, handle_set_power, &cmd_ctx);
+    assert(ret == ERR_INVALID_STATE);
+    ret = aegis_app_query_register_handler(&app.query, TEST_QUERY_GET_CHARGER, handle_get_charger, &query_ctx);
+    assert(ret == ERR_INVALID_STATE);
+
+    memset(&cmd, 0, sizeof(cmd));
+    APP_CMD_INIT(&cmd, TEST_CMD_SET_POWER);
+    APP_CMD_SET_ENTITY_ID(&cmd, result.created_id);
+    cmd.payload_size = 1U;
+    cmd.payload[0] = 60U;
+    ret = aegis_app_cmd_enqueue(&app.cmd_queue, &cmd);
+    assert(ret == ERR_OK);
+    drain_one_command(&app, NULL);
+    assert(stats.power_changed_count == 2U);
+
+    memset(&qr, 0, sizeof(qr));
+    ret = aegis_app_query_execute(&app.query, &q, &qr);
+    assert(ret == ERR_OK && qr.result == ERR_OK);
+
+    cmd.type = (AegisCommandType)0x7777U;
+    ret = aegis_app_cmd_service_execute(&app.cmd_service, &cmd, &result);
+    assert(ret == ERR_NOT_FOUND);
+
+    /* 5) 定长槽命令队列 */
+    test_cmd_slot_queue();
+    test_cmd_variable_length();
+    test_cmd_static_table();
+
     printf("\n✅ CQRS command/query tests passed.\n");
     return 0;
 }
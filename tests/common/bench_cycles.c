@@ -0,0 +1,47 @@
+/*
+ * @file: bench_cycles.c
+ * @brief: 基准测试计时工具实现
+ * @author: jack liu
+ * @req: REQ-TEST-BENCH
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "bench_cycles.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define BENCH_HAS_RDTSC 1
+#else
+#define BENCH_HAS_RDTSC 0
+#endif
+
+double bench_cycles_now(void) {
+#if BENCH_HAS_RDTSC
+    unsigned int lo;
+    unsigned int hi;
+
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (double)hi * 4294967296.0 + (double)lo;
+#else
+    return (double)clock();
+#endif
+}
+
+const char* bench_cycles_unit(void) {
+#if BENCH_HAS_RDTSC
+    return "cycles";
+#else
+    return "clock ticks";
+#endif
+}
+
+double bench_cycles_report(const char* name, double total, unsigned long ops) {
+    double per_op = 0.0;
+
+    if (ops > 0UL) {
+        per_op = total / (double)ops;
+    }
+
+    printf("  %-40s %10.2f %s/op\n", name, per_op, bench_cycles_unit());
+    return per_op;
+}
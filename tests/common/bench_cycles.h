@@ -0,0 +1,39 @@
+/*
+ * @file: bench_cycles.h
+ * @brief: 基准测试计时工具（x86 使用 rdtsc，其余平台回退 clock()）
+ * @author: jack liu
+ * @req: REQ-TEST-BENCH
+ */
+
+#ifndef BENCH_CYCLES_H
+#define BENCH_CYCLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief: 读取当前计数（CPU周期或 clock() 滴答）
+ * @return: 计数值（浮点，避免C89下缺少64位整型）
+ */
+double bench_cycles_now(void);
+
+/*
+ * @brief: 计数单位名称（"cycles" 或 "clock ticks"）
+ */
+const char* bench_cycles_unit(void);
+
+/*
+ * @brief: 打印单项基准结果（每次操作的平均计数）
+ * @param name: 测试项名称
+ * @param total: 总计数
+ * @param ops: 操作次数
+ * @return: 每次操作的平均计数
+ */
+double bench_cycles_report(const char* name, double total, unsigned long ops);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_CYCLES_H */
@@ -0,0 +1,384 @@
+/*
+ * @file: bench_mem_pool.c
+ * @brief: 内存池 指针->块、请求大小->尺寸类 查找与分配/释放路径基准测试
+ * @author: jack liu
+ * @req: REQ-TEST-BENCH-MEM-POOL
+ *
+ * 对比：
+ * 1. 旧实现的逐区域扫描 + 乘除法查找（在此按公开区域字段复现）
+ * 2. 当前实现的查找（区域结束偏移二分 + 移位）
+ * 3. 请求大小->尺寸类：旧实现从尺寸类0起逐个比较，当前实现查表 + 至多一次比较
+ * 4. aegis_mem_pool_alloc / aegis_mem_pool_free 完整路径（每次的平均周期）
+ * 5. 稳态分配/释放：共享池（每次进入临界区）与每上下文缓存（命中时不进入临界区）
+ * 6. 魔法数检查的单次调用耗时：check_all_magic（一次临界区扫全部块）与 scrub_step（每次 MEM_POOL_SCRUB_BATCH 块）
+ *
+ * bench_mem_pool_classes 以 24 个尺寸类的配置（mem_pool_classes_wide.h）编译同一份源码。
+ */
+
+#include <stdio.h>
+#include "mem_pool.h"
+#include "bench_cycles.h"
+
+/* ==================== 函数原型声明 ==================== */
+static int legacy_find(const AegisMemPool* pool, const uint8_t* p, AegisMemPoolIndex* meta_idx);
+static int fast_find(const AegisMemPool* pool, const uint8_t* p, AegisMemPoolIndex* meta_idx);
+static uint32_t legacy_size_class(const AegisMemPool* pool, uint32_t size);
+static uint32_t fast_size_class(const AegisMemPool* pool, uint32_t size);
+static uint32_t collect_blocks(AegisMemPool* pool, uint8_t** blocks);
+static int bench_lookup(AegisMemPool* pool);
+static int bench_size_class(AegisMemPool* pool);
+static int bench_free(AegisMemPool* pool);
+static int bench_cache(AegisMemPool* pool);
+static int bench_scrub(AegisMemPool* pool);
+
+/* 与 mem_pool.c 一致：用户指针前的头部魔法数字节数 */
+#define MEM_MAGIC_SIZE       2U
+
+#define BENCH_LOOKUP_ROUNDS  20000UL
+#define BENCH_CLASS_ROUNDS   2000UL
+#define BENCH_FREE_ROUNDS    5000UL
+#define BENCH_PAIR_ROUNDS    200000UL
+#define BENCH_PAIR_BURST     4U     /* 每轮连续分配的块数（不超过缓存深度时稳态全部命中） */
+#define BENCH_SCRUB_ROUNDS   2000UL
+#define BENCH_PAIR_MAX_SIZE  ((uint32_t)(MEM_POOL_CLASS_MIN_SIZE) - MEM_POOL_GUARD_SIZE)   /* 只用最小尺寸类 */
+
+/* ==================== 查找实现 ==================== */
+
+/*
+ * @brief: 旧实现：遍历区域，每次计算区域大小；元数据索引累加前序块数
+ */
+static int legacy_find(const AegisMemPool* pool, const uint8_t* p, AegisMemPoolIndex* meta_idx) {
+    uint32_t i;
+    uint32_t j;
+    uint32_t base;
+
+    for (i = 0; i < (uint32_t)MEM_POOL_CLASS_COUNT; i++) {
+        const AegisMemPoolRegion* region = &pool->regions[i];
+        uint32_t region_size = (uint32_t)region->block_size * (uint32_t)region->block_count;
+
+        if (p >= region->start_addr && p < region->start_addr + region_size) {
+            uint32_t offset = (uint32_t)(p - region->start_addr);
+            base = 0;
+            for (j = 0; j < i; j++) {
+                base += pool->regions[j].block_count;
+            }
+            *meta_idx = (AegisMemPoolIndex)(base + offset / (uint32_t)region->block_size);
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * @brief: 当前实现：区域结束偏移二分 + 移位 + 元数据基址
+ */
+static int fast_find(const AegisMemPool* pool, const uint8_t* p, AegisMemPoolIndex* meta_idx) {
+    const AegisMemPoolRegion* region;
+    uint32_t offset;
+    uint32_t r = 0U;
+    uint32_t hi = (uint32_t)MEM_POOL_CLASS_COUNT - 1U;
+    uint32_t mid;
+
+    if (p < pool->buffer || p >= pool->buffer + MEM_POOL_TOTAL_SIZE) {
+        return -1;
+    }
+
+    offset = (uint32_t)(p - pool->buffer);
+    while (r < hi) {
+        mid = (r + hi) >> 1;
+        if (offset < pool->regions[mid].end_offset) {
+            hi = mid;
+        } else {
+            r = mid + 1U;
+        }
+    }
+
+    region = &pool->regions[r];
+    offset -= region->start_offset;
+    if (region->block_shift != 0U) {
+        *meta_idx = (AegisMemPoolIndex)(region->meta_base + (offset >> region->block_shift));
+    } else {
+        *meta_idx = (AegisMemPoolIndex)(region->meta_base + offset / (uint32_t)region->block_size);
+    }
+
+    return (int)r;
+}
+
+/*
+ * @brief: 旧实现：从尺寸类0起逐个比较可用大小
+ */
+static uint32_t legacy_size_class(const AegisMemPool* pool, uint32_t size) {
+    uint32_t c;
+
+    for (c = 0; c < (uint32_t)MEM_POOL_CLASS_COUNT; c++) {
+        if (size <= (uint32_t)pool->regions[c].block_size - MEM_POOL_GUARD_SIZE) {
+            break;
+        }
+    }
+    return c;
+}
+
+/*
+ * @brief: 当前实现：按分桶粒度查表，桶内跨过尺寸类边界时再进一位
+ */
+static uint32_t fast_size_class(const AegisMemPool* pool, uint32_t size) {
+    uint32_t c = pool->size_class[(size - 1U) >> MEM_POOL_CLASS_GRANULE_SHIFT];
+
+    if (size > (uint32_t)pool->regions[c].block_size - MEM_POOL_GUARD_SIZE) {
+        c++;
+    }
+    return c;
+}
+
+/*
+ * @brief: 分配全部块并返回块起始地址（含头部魔法数）
+ */
+static uint32_t collect_blocks(AegisMemPool* pool, uint8_t** blocks) {
+    uint32_t n = 0;
+    void* p;
+
+    while (n < (uint32_t)MEM_POOL_TOTAL_BLOCKS) {
+        p = MEM_ALLOC(pool, 1);
+        if (p == NULL) {
+            break;
+        }
+        blocks[n] = (uint8_t*)p;
+        n++;
+    }
+
+    return n;
+}
+
+/* ==================== 基准测试 ==================== */
+
+static int bench_lookup(AegisMemPool* pool) {
+    static uint8_t* blocks[MEM_POOL_TOTAL_BLOCKS];
+    uint32_t n;
+    uint32_t i;
+    unsigned long round;
+    AegisMemPoolIndex meta_a = 0;
+    AegisMemPoolIndex meta_b = 0;
+    uint32_t sink = 0;
+    double t0;
+    double legacy_total;
+    double fast_total;
+
+    (void)aegis_mem_pool_init(pool, NULL);
+    n = collect_blocks(pool, blocks);
+
+    /* 正确性：两种查找结果必须一致 */
+    for (i = 0; i < n; i++) {
+        const uint8_t* bp = blocks[i] - MEM_MAGIC_SIZE;
+        if (legacy_find(pool, bp, &meta_a) != fast_find(pool, bp, &meta_b) || meta_a != meta_b) {
+            printf("  ✗ 查找结果不一致: block %lu\n", (unsigned long)i);
+            return 1;
+        }
+    }
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_LOOKUP_ROUNDS; round++) {
+        for (i = 0; i < n; i++) {
+            sink += (uint32_t)legacy_find(pool, blocks[i] - MEM_MAGIC_SIZE, &meta_a) + meta_a;
+        }
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_LOOKUP_ROUNDS; round++) {
+        for (i = 0; i < n; i++) {
+            sink += (uint32_t)fast_find(pool, blocks[i] - MEM_MAGIC_SIZE, &meta_b) + meta_b;
+        }
+    }
+    fast_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("lookup: legacy region scan", legacy_total, BENCH_LOOKUP_ROUNDS * (unsigned long)n);
+    bench_cycles_report("lookup: offset bisect + shift", fast_total, BENCH_LOOKUP_ROUNDS * (unsigned long)n);
+    printf("  (sink=%lu)\n", (unsigned long)(sink & 0xFFUL));
+
+    return 0;
+}
+
+static int bench_size_class(AegisMemPool* pool) {
+    uint32_t size;
+    unsigned long round;
+    uint32_t sink = 0;
+    double t0;
+    double legacy_total;
+    double fast_total;
+
+    (void)aegis_mem_pool_init(pool, NULL);
+
+    /* 正确性：全部请求大小上两种选择一致 */
+    for (size = 1U; size <= MEM_POOL_MAX_ALLOC; size++) {
+        if (legacy_size_class(pool, size) != fast_size_class(pool, size)) {
+            printf("  ✗ 尺寸类选择不一致: size %lu\n", (unsigned long)size);
+            return 1;
+        }
+    }
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_CLASS_ROUNDS; round++) {
+        for (size = 1U; size <= MEM_POOL_MAX_ALLOC; size++) {
+            sink += legacy_size_class(pool, size);
+        }
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_CLASS_ROUNDS; round++) {
+        for (size = 1U; size <= MEM_POOL_MAX_ALLOC; size++) {
+            sink += fast_size_class(pool, size);
+        }
+    }
+    fast_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("size->class: legacy linear scan", legacy_total,
+                        BENCH_CLASS_ROUNDS * (unsigned long)MEM_POOL_MAX_ALLOC);
+    bench_cycles_report("size->class: table lookup", fast_total,
+                        BENCH_CLASS_ROUNDS * (unsigned long)MEM_POOL_MAX_ALLOC);
+    printf("  (sink=%lu)\n", (unsigned long)(sink & 0xFFUL));
+
+    return 0;
+}
+
+static int bench_free(AegisMemPool* pool) {
+    static uint8_t* blocks[MEM_POOL_TOTAL_BLOCKS];
+    uint32_t n;
+    uint32_t i;
+    unsigned long round;
+    unsigned long ops = 0;
+    double t0;
+    double alloc_total = 0.0;
+    double total = 0.0;
+
+    for (round = 0; round < BENCH_FREE_ROUNDS; round++) {
+        (void)aegis_mem_pool_init(pool, NULL);
+
+        t0 = bench_cycles_now();
+        n = collect_blocks(pool, blocks);
+        alloc_total += bench_cycles_now() - t0;
+
+        t0 = bench_cycles_now();
+        for (i = 0; i < n; i++) {
+            if (aegis_mem_pool_free(pool, blocks[i]) != ERR_OK) {
+                printf("  ✗ 释放失败: block %lu\n", (unsigned long)i);
+                return 1;
+            }
+        }
+        total += bench_cycles_now() - t0;
+        ops += (unsigned long)n;
+    }
+
+    bench_cycles_report("aegis_mem_pool_alloc (1 byte, spills)", alloc_total, ops);
+    bench_cycles_report("aegis_mem_pool_free (all regions)", total, ops);
+    return 0;
+}
+
+static int bench_cache(AegisMemPool* pool) {
+    static AegisMemPoolCache cache;
+    void* ptrs[BENCH_PAIR_BURST];
+    uint32_t size;
+    uint32_t i;
+    unsigned long round;
+    double t0;
+    double shared_total;
+    double cache_total;
+
+    (void)aegis_mem_pool_init(pool, NULL);
+    (void)aegis_mem_pool_cache_init(&cache, pool);
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_PAIR_ROUNDS; round++) {
+        size = 1U + (uint32_t)(round % (unsigned long)BENCH_PAIR_MAX_SIZE);
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            ptrs[i] = aegis_mem_pool_alloc(pool, size, NULL, 0U);
+        }
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            if (ptrs[i] == NULL || aegis_mem_pool_free(pool, ptrs[i]) != ERR_OK) {
+                printf("  ✗ 共享池分配/释放失败\n");
+                return 1;
+            }
+        }
+    }
+    shared_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_PAIR_ROUNDS; round++) {
+        size = 1U + (uint32_t)(round % (unsigned long)BENCH_PAIR_MAX_SIZE);
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            ptrs[i] = aegis_mem_pool_cache_alloc(&cache, size, NULL, 0U);
+        }
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            if (ptrs[i] == NULL || aegis_mem_pool_cache_free(&cache, ptrs[i]) != ERR_OK) {
+                printf("  ✗ 缓存分配/释放失败\n");
+                return 1;
+            }
+        }
+    }
+    cache_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("alloc+free: shared pool (min class)", shared_total, BENCH_PAIR_ROUNDS * BENCH_PAIR_BURST);
+    bench_cycles_report("alloc+free: per-context cache", cache_total, BENCH_PAIR_ROUNDS * BENCH_PAIR_BURST);
+    printf("  (cache hits=%lu refills=%lu flushes=%lu)\n", (unsigned long)cache.hits,
+           (unsigned long)cache.refills, (unsigned long)cache.flushes);
+    return 0;
+}
+
+static int bench_scrub(AegisMemPool* pool) {
+    static uint8_t* blocks[MEM_POOL_TOTAL_BLOCKS];
+    AegisMemPoolIndex corrupted;
+    unsigned long round;
+    double t0;
+    double full_total;
+    double step_total;
+
+    /* 全部块已分配：每块都要检查魔法数 */
+    (void)aegis_mem_pool_init(pool, NULL);
+    (void)collect_blocks(pool, blocks);
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_SCRUB_ROUNDS; round++) {
+        if (aegis_mem_pool_check_all_magic(pool, &corrupted) != ERR_OK) {
+            printf("  ✗ 全量检查失败\n");
+            return 1;
+        }
+    }
+    full_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_SCRUB_ROUNDS * (unsigned long)MEM_POOL_SCRUB_SWEEP_CALLS; round++) {
+        if (aegis_mem_pool_scrub_step(pool, &corrupted) != ERR_OK) {
+            printf("  ✗ 增量巡检失败\n");
+            return 1;
+        }
+    }
+    step_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("check_all_magic (per call)", full_total, BENCH_SCRUB_ROUNDS);
+    bench_cycles_report("scrub_step (per call)", step_total, BENCH_SCRUB_ROUNDS * (unsigned long)MEM_POOL_SCRUB_SWEEP_CALLS);
+    printf("  (%lu blocks: check_all_magic holds one critical section for all of them; "
+           "scrub_step checks %lu per call, one block per critical section, full sweep in %lu calls)\n",
+           (unsigned long)MEM_POOL_TOTAL_BLOCKS, (unsigned long)MEM_POOL_SCRUB_BATCH,
+           (unsigned long)MEM_POOL_SCRUB_SWEEP_CALLS);
+    return 0;
+}
+
+/* ==================== 入口 ==================== */
+int main(void) {
+    static AegisMemPool pool;
+    int failed = 0;
+
+    printf("========================================\n");
+    printf("  内存池基准测试 (%d 个尺寸类，%lu 块，POW2_BLOCKS=%d)\n", (int)MEM_POOL_CLASS_COUNT,
+           (unsigned long)MEM_POOL_TOTAL_BLOCKS, (int)MEM_POOL_POW2_BLOCKS);
+    printf("========================================\n");
+
+    failed |= bench_lookup(&pool);
+    failed |= bench_size_class(&pool);
+    failed |= bench_free(&pool);
+    failed |= bench_cache(&pool);
+    failed |= bench_scrub(&pool);
+
+    return failed;
+}
@@ -0,0 +1,138 @@
+/*
+ * @file: bench_object_pool.c
+ * @brief: 定长对象池与通用内存池的分配/释放路径及每对象占用对比
+ * @author: jack liu
+ * @req: REQ-TEST-BENCH-OBJECT-POOL
+ *
+ * 对比（以 AegisDomainEvent / AegisCommand / AegisAppDto 为对象）：
+ * 1. 每对象占用字节：内存池 = 所落尺寸类块大小 + 块元数据；对象池 = 槽位大小 + 位图
+ * 2. 稳态分配/释放：aegis_mem_pool_alloc/free 与 aegis_domain_event_pool_alloc/free（每次的平均周期）
+ */
+
+#include <stdio.h>
+#include "mem_pool.h"
+#include "object_pool.h"
+#include "domain_event.h"
+#include "app_command.h"
+#include "app_dto.h"
+#include "bench_cycles.h"
+
+/* ==================== 函数原型声明 ==================== */
+static uint32_t mem_pool_block_size(AegisMemPool* pool, uint32_t size);
+static void report_footprint(AegisMemPool* pool, const char* name, uint32_t size, uint32_t slot_size);
+static int bench_footprint(AegisMemPool* pool);
+static int bench_alloc_free(AegisMemPool* pool);
+
+#define BENCH_PAIR_ROUNDS  200000UL
+#define BENCH_PAIR_BURST   2U      /* 每轮连续分配的对象数（不超过超大块数与对象池容量） */
+
+/*
+ * @brief: 请求 size 字节时内存池实际占用的块大小（分配一次，按各尺寸类已用数定位）
+ */
+static uint32_t mem_pool_block_size(AegisMemPool* pool, uint32_t size) {
+    AegisMemPoolStats stats;
+    uint32_t block_size = 0U;
+    uint32_t c;
+    void* p;
+
+    p = aegis_mem_pool_alloc(pool, size, NULL, 0U);
+    if (p == NULL) {
+        return 0U;
+    }
+    if (aegis_mem_pool_get_stats(pool, &stats) == ERR_OK) {
+        for (c = 0; c < (uint32_t)MEM_POOL_CLASS_COUNT; c++) {
+            if (stats.class_used[c] != 0U) {
+                block_size = pool->regions[c].block_size;
+            }
+        }
+    }
+    (void)aegis_mem_pool_free(pool, p);
+    return block_size;
+}
+
+static void report_footprint(AegisMemPool* pool, const char* name, uint32_t size, uint32_t slot_size) {
+    uint32_t block_size = mem_pool_block_size(pool, size);
+    uint32_t mem_bytes = block_size + (uint32_t)sizeof(AegisMemPoolBlockMeta);
+
+    /* 对象池另有每槽位1位的已分配位图，不足1字节，此处不计 */
+    printf("  %-18s 对象 %3lu 字节 | mem_pool 块 %3lu + 元数据 %lu = %3lu 字节 | object_pool 槽位 %3lu 字节"
+           " (节省 %lu)\n",
+           name, (unsigned long)size, (unsigned long)block_size, (unsigned long)sizeof(AegisMemPoolBlockMeta),
+           (unsigned long)mem_bytes, (unsigned long)slot_size,
+           (unsigned long)((mem_bytes > slot_size) ? (mem_bytes - slot_size) : 0U));
+}
+
+static int bench_footprint(AegisMemPool* pool) {
+    if (aegis_mem_pool_init(pool, NULL) != ERR_OK) {
+        printf("  ✗ 内存池初始化失败\n");
+        return 1;
+    }
+
+    report_footprint(pool, "AegisDomainEvent", (uint32_t)sizeof(AegisDomainEvent),
+                     (uint32_t)sizeof(AegisDomainEventPoolSlot));
+    report_footprint(pool, "AegisCommand", (uint32_t)sizeof(AegisCommand), (uint32_t)sizeof(AegisCommandPoolSlot));
+    report_footprint(pool, "AegisAppDto", (uint32_t)sizeof(AegisAppDto), (uint32_t)sizeof(AegisAppDtoPoolSlot));
+    return 0;
+}
+
+static int bench_alloc_free(AegisMemPool* pool) {
+    static AegisDomainEventPool event_pool;
+    AegisDomainEvent* events[BENCH_PAIR_BURST];
+    void* ptrs[BENCH_PAIR_BURST];
+    uint32_t i;
+    unsigned long round;
+    double t0;
+    double mem_total;
+    double obj_total;
+
+    (void)aegis_mem_pool_init(pool, NULL);
+    (void)aegis_domain_event_pool_init(&event_pool);
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_PAIR_ROUNDS; round++) {
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            ptrs[i] = MEM_ALLOC(pool, (uint32_t)sizeof(AegisDomainEvent));
+        }
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            if (ptrs[i] == NULL || MEM_FREE(pool, ptrs[i]) != ERR_OK) {
+                printf("  ✗ 内存池分配/释放失败\n");
+                return 1;
+            }
+        }
+    }
+    mem_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (round = 0; round < BENCH_PAIR_ROUNDS; round++) {
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            events[i] = aegis_domain_event_pool_alloc(&event_pool);
+        }
+        for (i = 0; i < BENCH_PAIR_BURST; i++) {
+            if (events[i] == NULL || aegis_domain_event_pool_free(&event_pool, events[i]) != ERR_OK) {
+                printf("  ✗ 对象池分配/释放失败\n");
+                return 1;
+            }
+        }
+    }
+    obj_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("alloc+free: mem_pool (AegisDomainEvent)", mem_total, BENCH_PAIR_ROUNDS * BENCH_PAIR_BURST);
+    bench_cycles_report("alloc+free: object pool (AegisDomainEvent)", obj_total,
+                        BENCH_PAIR_ROUNDS * BENCH_PAIR_BURST);
+    return 0;
+}
+
+/* ==================== 入口 ==================== */
+int main(void) {
+    static AegisMemPool pool;
+    int failed = 0;
+
+    printf("========================================\n");
+    printf("  对象池基准测试 (OBJECT_POOL_GUARD=%d)\n", (int)OBJECT_POOL_GUARD);
+    printf("========================================\n");
+
+    failed |= bench_footprint(&pool);
+    failed |= bench_alloc_free(&pool);
+
+    return failed;
+}
@@ -0,0 +1,24 @@
+/*
+ * @file: mem_pool_classes_wide.h
+ * @brief: 测试用内存池尺寸类表（24 个尺寸类、1000+ 块，模拟网关构建）
+ * @author: jack liu
+ * @req: REQ-TEST-MEM-POOL
+ *
+ * 通过 MEM_POOL_CLASS_CONFIG="mem_pool_classes_wide.h" 引入；总块数超过 254，块下标自动切换为 16 位。
+ */
+
+#ifndef MEM_POOL_CLASSES_WIDE_H
+#define MEM_POOL_CLASSES_WIDE_H
+
+#define MEM_POOL_CLASS_LIST(X) \
+    X(16, 128)   X(24, 128)   X(32, 128)   X(40, 128) \
+    X(48, 128)   X(56, 128)   X(64, 128)   X(80, 32) \
+    X(96, 32)    X(112, 32)   X(128, 32)   X(160, 32) \
+    X(192, 32)   X(224, 32)   X(256, 32)   X(320, 16) \
+    X(384, 16)   X(448, 16)   X(512, 16)   X(640, 8) \
+    X(768, 8)    X(896, 8)    X(1024, 8)   X(2048, 4)
+
+#define MEM_POOL_CLASS_MIN_SIZE  16
+#define MEM_POOL_CLASS_MAX_SIZE  2048
+
+#endif /* MEM_POOL_CLASSES_WIDE_H */
@@ -0,0 +1,201 @@
+/*
+ * @file: test_dispatch_index.c
+ * @brief: 处理器分发索引单元测试
+ * @author: jack liu
+ * @req: REQ-TEST-DISPATCH-INDEX
+ */
+
+#include <stdio.h>
+#include "dispatch_index.h"
+
+/* ==================== 函数原型声明 ==================== */
+static void test_index_size(void);
+static void test_index_insert_find(void);
+static void test_index_collisions(void);
+static void test_index_params(void);
+static void test_index_find_sealed(void);
+
+/* ==================== 测试用例计数 ==================== */
+static int g_test_passed = 0;
+static int g_test_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            g_test_passed++; \
+            printf("  ✓ %s\n", message); \
+        } else { \
+            g_test_failed++; \
+            printf("  ✗ %s (FAILED at %s:%d)\n", message, __FILE__, __LINE__); \
+        } \
+    } while(0)
+
+#define TEST_INDEX_SIZE  DISPATCH_INDEX_SIZE(16)
+
+/* ==================== 测试用例 ==================== */
+
+/*
+ * @test: 桶数计算（2的幂且不小于2倍容量）
+ */
+static void test_index_size(void) {
+    printf("\n[TEST] test_index_size\n");
+
+    TEST_ASSERT(DISPATCH_INDEX_SIZE(1) == 2U, "容量1 -> 2桶");
+    TEST_ASSERT(DISPATCH_INDEX_SIZE(8) == 16U, "容量8 -> 16桶");
+    TEST_ASSERT(DISPATCH_INDEX_SIZE(9) == 32U, "容量9 -> 32桶");
+    TEST_ASSERT(DISPATCH_INDEX_SIZE(32) == 64U, "容量32 -> 64桶");
+    TEST_ASSERT(DISPATCH_INDEX_SIZE(128) == 256U, "容量128 -> 256桶");
+}
+
+/*
+ * @test: 插入后可查找，未插入的键返回空
+ */
+static void test_index_insert_find(void) {
+    uint16_t keys[TEST_INDEX_SIZE];
+    uint8_t slots[TEST_INDEX_SIZE];
+    uint8_t i;
+    bool_t all_found = TRUE;
+
+    printf("\n[TEST] test_index_insert_find\n");
+
+    aegis_dispatch_index_clear(slots, (uint16_t)TEST_INDEX_SIZE);
+    TEST_ASSERT(aegis_dispatch_index_find(keys, slots, (uint16_t)TEST_INDEX_SIZE, 1U) == DISPATCH_INDEX_EMPTY,
+                "空索引查找返回空");
+
+    for (i = 0; i < 16U; i++) {
+        if (aegis_dispatch_index_insert(keys, slots, (uint16_t)TEST_INDEX_SIZE,
+                                        (uint16_t)(i + 1U), i) != ERR_OK) {
+            all_found = FALSE;
+        }
+    }
+    TEST_ASSERT(all_found == TRUE, "连续类型值全部插入成功");
+
+    for (i = 0; i < 16U; i++) {
+        if (aegis_dispatch_index_find(keys, slots, (uint16_t)TEST_INDEX_SIZE, (uint16_t)(i + 1U)) != i) {
+            all_found = FALSE;
+        }
+    }
+    TEST_ASSERT(all_found == TRUE, "连续类型值全部命中正确槽位");
+    TEST_ASSERT(aegis_dispatch_index_find(keys, slots, (uint16_t)TEST_INDEX_SIZE, 0U) == DISPATCH_INDEX_EMPTY,
+                "未插入的键返回空");
+    TEST_ASSERT(aegis_dispatch_index_find(keys, slots, (uint16_t)TEST_INDEX_SIZE, 0xFFFFU) == DISPATCH_INDEX_EMPTY,
+                "CMD_TYPE_INVALID 返回空");
+}
+
+/*
+ * @test: 同桶冲突（线性探测）与满索引
+ */
+static void test_index_collisions(void) {
+    uint16_t keys[4];
+    uint8_t slots[4];
+    uint8_t i;
+    bool_t all_found = TRUE;
+
+    printf("\n[TEST] test_index_collisions\n");
+
+    aegis_dispatch_index_clear(slots, 4U);
+    for (i = 0; i < 4U; i++) {
+        /* 低位相同、高位不同：在4桶索引里大量冲突 */
+        if (aegis_dispatch_index_insert(keys, slots, 4U, (uint16_t)((uint16_t)i << 12), i) != ERR_OK) {
+            all_found = FALSE;
+        }
+    }
+    TEST_ASSERT(all_found == TRUE, "冲突键填满索引");
+
+    for (i = 0; i < 4U; i++) {
+        if (aegis_dispatch_index_find(keys, slots, 4U, (uint16_t)((uint16_t)i << 12)) != i) {
+            all_found = FALSE;
+        }
+    }
+    TEST_ASSERT(all_found == TRUE, "冲突键均可查找");
+    TEST_ASSERT(aegis_dispatch_index_insert(keys, slots, 4U, 0x5000U, 0U) == ERR_OUT_OF_RANGE,
+                "索引满返回 ERR_OUT_OF_RANGE");
+    TEST_ASSERT(aegis_dispatch_index_find(keys, slots, 4U, 0x5000U) == DISPATCH_INDEX_EMPTY,
+                "满索引中未命中的键返回空");
+}
+
+/*
+ * @test: 参数校验
+ */
+static void test_index_params(void) {
+    uint16_t keys[4];
+    uint8_t slots[4];
+
+    printf("\n[TEST] test_index_params\n");
+
+    aegis_dispatch_index_clear(slots, 4U);
+    TEST_ASSERT(aegis_dispatch_index_insert(NULL, slots, 4U, 1U, 0U) == ERR_NULL_PTR, "空键数组被拒绝");
+    TEST_ASSERT(aegis_dispatch_index_insert(keys, NULL, 4U, 1U, 0U) == ERR_NULL_PTR, "空槽位数组被拒绝");
+    TEST_ASSERT(aegis_dispatch_index_insert(keys, slots, 3U, 1U, 0U) == ERR_INVALID_PARAM, "非2的幂桶数被拒绝");
+    TEST_ASSERT(aegis_dispatch_index_insert(keys, slots, 4U, 1U, (uint8_t)DISPATCH_INDEX_EMPTY) == ERR_INVALID_PARAM,
+                "空标记槽位被拒绝");
+    TEST_ASSERT(aegis_dispatch_index_find(NULL, slots, 4U, 1U) == DISPATCH_INDEX_EMPTY, "空指针查找返回空");
+}
+
+/*
+ * @test: 封存/未封存两种状态下的分发查找（拷出注册项）
+ */
+static void test_index_find_sealed(void) {
+    typedef struct {
+        uint16_t type;
+        uint32_t value;
+    } TestEntry;
+    uint16_t keys[8];
+    uint8_t slots[8];
+    TestEntry entries[4];
+    TestEntry out;
+    uint8_t i;
+
+    printf("\n[TEST] test_index_find_sealed\n");
+
+    aegis_dispatch_index_clear(slots, 8U);
+    for (i = 0; i < 4U; i++) {
+        entries[i].type = (uint16_t)(100U + i);
+        entries[i].value = 1000UL + i;
+        (void)aegis_dispatch_index_insert(keys, slots, 8U, entries[i].type, i);
+    }
+
+    out.type = 0U;
+    out.value = 0UL;
+    TEST_ASSERT(aegis_dispatch_index_find_sealed(keys, slots, 8U, 102U, FALSE,
+                                                 entries, (uint16_t)sizeof(out), &out) == 2U &&
+                out.value == 1002UL, "未封存：查找命中并拷出注册项");
+    TEST_ASSERT(aegis_dispatch_index_find_sealed(keys, slots, 8U, 103U, TRUE,
+                                                 entries, (uint16_t)sizeof(out), &out) == 3U &&
+                out.value == 1003UL, "已封存：查找命中并拷出注册项");
+    TEST_ASSERT(aegis_dispatch_index_find_sealed(keys, slots, 8U, 7U, FALSE,
+                                                 entries, (uint16_t)sizeof(out), &out) == DISPATCH_INDEX_EMPTY &&
+                out.value == 1003UL, "未注册：返回空且不写输出");
+    TEST_ASSERT(aegis_dispatch_index_find_sealed(keys, slots, 8U, 100U, TRUE,
+                                                 NULL, (uint16_t)sizeof(out), &out) == DISPATCH_INDEX_EMPTY,
+                "空注册项数组返回空");
+    TEST_ASSERT(aegis_dispatch_index_lock(TRUE) == FALSE, "已封存不进入临界区");
+    aegis_dispatch_index_unlock(aegis_dispatch_index_lock(FALSE));
+}
+
+/* ==================== 测试入口 ==================== */
+int main(void) {
+    printf("========================================\n");
+    printf("  分发索引单元测试\n");
+    printf("========================================\n");
+
+    test_index_size();
+    test_index_insert_find();
+    test_index_collisions();
+    test_index_params();
+    test_index_find_sealed();
+
+    printf("\n========================================\n");
+    printf("测试结果:\n");
+    printf("  通过: %d\n", g_test_passed);
+    printf("  失败: %d\n", g_test_failed);
+    printf("========================================\n");
+
+    if (g_test_failed == 0) {
+        printf("✅ 所有测试通过!\n");
+        return 0;
+    } else {
+        printf("❌ 存在失败的测试!\n");
+        return 1;
+    }
+}
@@ -0,0 +1,171 @@
+/*
+ * @file: test_key_filter.c
+ * @brief: 16位键过滤核单元测试（与逐项比较的参考结果对照）
+ * @author: jack liu
+ * @req: REQ-TEST-KEY-FILTER
+ */
+
+#include <stdio.h>
+#include "key_filter.h"
+
+/* ==================== 函数原型声明 ==================== */
+static uint32_t reference_mask(const uint16_t* keys, uint8_t count, uint16_t key);
+static void fill_keys(void);
+static void test_mask_all_lengths(void);
+static void test_count_unaligned(void);
+static void test_pop_order(void);
+static void test_params(void);
+
+/* ==================== 测试用例计数 ==================== */
+static int g_test_passed = 0;
+static int g_test_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            g_test_passed++; \
+            printf("  ✓ %s\n", message); \
+        } else { \
+            g_test_failed++; \
+            printf("  ✗ %s (FAILED at %s:%d)\n", message, __FILE__, __LINE__); \
+        } \
+    } while(0)
+
+#define TEST_KEYS  300U
+
+static uint16_t g_keys[TEST_KEYS];
+
+static uint32_t reference_mask(const uint16_t* keys, uint8_t count, uint16_t key) {
+    uint32_t mask = 0U;
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        if (keys[i] == key) {
+            mask |= (uint32_t)1U << i;
+        }
+    }
+    return mask;
+}
+
+/* 伪随机填充：键集中在少量值上，且包含 0x8000 以上的值（检验有符号打包不影响结果） */
+static void fill_keys(void) {
+    uint32_t seed = 12345U;
+    uint32_t i;
+
+    for (i = 0; i < TEST_KEYS; i++) {
+        seed = (uint32_t)(seed * 1103515245UL + 12345UL);
+        g_keys[i] = (uint16_t)(((seed >> 16) % 4U == 3U) ? 0xFFFFU : (seed >> 16) % 3U + 0x7FFFU);
+    }
+}
+
+/* ==================== 测试用例 ==================== */
+
+/*
+ * @test: 0..32 个键、各种起始偏移下掩码与参考实现一致
+ */
+static void test_mask_all_lengths(void) {
+    uint8_t count;
+    uint16_t offset;
+    uint16_t key;
+    bool_t all_match = TRUE;
+
+    printf("\n[TEST] test_mask_all_lengths (%s)\n", aegis_key_filter_kernel());
+
+    for (key = 0x7FFFU; key != 0x8003U; key++) {
+        for (offset = 0; offset < 8U; offset++) {
+            for (count = 0; count <= (uint8_t)KEY_FILTER_BLOCK; count++) {
+                if (aegis_key_filter_mask(&g_keys[offset], count, key) !=
+                    reference_mask(&g_keys[offset], count, key)) {
+                    all_match = FALSE;
+                }
+            }
+        }
+    }
+    TEST_ASSERT(all_match == TRUE, "掩码与参考实现一致");
+    TEST_ASSERT(aegis_key_filter_mask(g_keys, 40U, 0x7FFFU) == reference_mask(g_keys, 32U, 0x7FFFU),
+                "超过一块的部分被忽略");
+    TEST_ASSERT(aegis_key_filter_mask(g_keys, 32U, 0x1234U) == 0U, "无匹配返回0");
+}
+
+/*
+ * @test: 任意长度、非对齐起点的计数与参考实现一致
+ */
+static void test_count_unaligned(void) {
+    uint32_t count;
+    uint32_t expected;
+    uint32_t i;
+    uint16_t offset;
+    bool_t all_match = TRUE;
+
+    printf("\n[TEST] test_count_unaligned\n");
+
+    for (offset = 0; offset < 3U; offset++) {
+        for (count = 0; count + offset <= TEST_KEYS; count += 7U) {
+            expected = 0U;
+            for (i = 0; i < count; i++) {
+                if (g_keys[offset + i] == 0xFFFFU) {
+                    expected++;
+                }
+            }
+            if (aegis_key_filter_count(&g_keys[offset], count, 0xFFFFU) != expected) {
+                all_match = FALSE;
+            }
+        }
+    }
+    TEST_ASSERT(all_match == TRUE, "计数与参考实现一致");
+    TEST_ASSERT(aegis_key_filter_count(g_keys, 0U, 0x7FFFU) == 0U, "空数组计数为0");
+}
+
+/*
+ * @test: pop 按从低到高的顺序取出置位下标
+ */
+static void test_pop_order(void) {
+    uint32_t mask = 0x80010005UL;
+
+    printf("\n[TEST] test_pop_order\n");
+
+    TEST_ASSERT(aegis_key_filter_pop(&mask) == 0U, "第1个置位");
+    TEST_ASSERT(aegis_key_filter_pop(&mask) == 2U, "第2个置位");
+    TEST_ASSERT(aegis_key_filter_pop(&mask) == 16U, "第3个置位");
+    TEST_ASSERT(aegis_key_filter_pop(&mask) == 31U, "第4个置位");
+    TEST_ASSERT(mask == 0U, "掩码已清空");
+    TEST_ASSERT(aegis_key_filter_pop(&mask) == (uint8_t)KEY_FILTER_BLOCK, "空掩码返回 KEY_FILTER_BLOCK");
+}
+
+/*
+ * @test: 参数校验
+ */
+static void test_params(void) {
+    printf("\n[TEST] test_params\n");
+
+    TEST_ASSERT(aegis_key_filter_mask(NULL, 8U, 1U) == 0U, "空键数组掩码为0");
+    TEST_ASSERT(aegis_key_filter_count(NULL, 8U, 1U) == 0U, "空键数组计数为0");
+    TEST_ASSERT(aegis_key_filter_pop(NULL) == (uint8_t)KEY_FILTER_BLOCK, "空掩码指针被拒绝");
+}
+
+/* ==================== 测试入口 ==================== */
+int main(void) {
+    printf("========================================\n");
+    printf("  键过滤核单元测试\n");
+    printf("========================================\n");
+
+    fill_keys();
+    test_mask_all_lengths();
+    test_count_unaligned();
+    test_pop_order();
+    test_params();
+
+    printf("\n========================================\n");
+    printf("测试结果:\n");
+    printf("  通过: %d\n", g_test_passed);
+    printf("  失败: %d\n", g_test_failed);
+    printf("========================================\n");
+
+    if (g_test_failed == 0) {
+        printf("✅ 所有测试通过!\n");
+        return 0;
+    } else {
+        printf("❌ 存在失败的测试!\n");
+        return 1;
+    }
+}
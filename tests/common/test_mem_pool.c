@@ -17,6 +17,9 @@ static void test_mem_pool_alloc_free(void);
 static void test_mem_pool_stats(void);
 static void test_mem_pool_overflow_detection(void);
 static void test_mem_pool_exhaustion(void);
+static void test_mem_pool_free_lookup_all_regions(void);
+static void test_mem_pool_cache(void);
+static void test_mem_pool_scrub(void);
 
 /* ==================== 测试用例计数 ==================== */
 static int g_test_passed = 0;
@@ -139,7 +142,7 @@ static void test_mem_pool_stats(void) {
     ret = aegis_mem_pool_get_stats(&pool, &stats);
     TEST_ASSERT(ret == ERR_OK, "获取统计信息成功");
     TEST_ASSERT(stats.used_blocks == 1, "已用块数为1");
-    TEST_ASSERT(stats.small_used == 1, "小块已用数为1");
+    TEST_ASSERT(stats.class_used[0] == 1, "小块（尺寸类0）已用数为1");
 
     /* 释放 */
     MEM_FREE(&pool, ptr);
@@ -221,6 +224,216 @@ static void test_mem_pool_exhaustion(void) {
     }
 }
 
+/*
+ * @test: 测试各区域指针->块查找（逆序释放全部块 + 非法指针）
+ * @req: REQ-TEST-006
+ */
+static void test_mem_pool_free_lookup_all_regions(void) {
+    void* ptrs[MEM_POOL_TOTAL_BLOCKS];
+    static uint8_t foreign[16];     /* 池外缓冲区：作为非法指针来源，避免构造越界指针 */
+    AegisMemPoolStats stats;
+    int i;
+    int allocated = 0;
+    int freed = 0;
+    AegisTraceLog trace;
+    AegisMemPool pool;
+
+    printf("\n[TEST] test_mem_pool_free_lookup_all_regions\n");
+
+    (void)aegis_trace_log_init(&trace, test_now_ms, NULL);
+    (void)aegis_mem_pool_init(&pool, &trace);
+
+    for (i = 0; i < (int)MEM_POOL_TOTAL_BLOCKS; i++) {
+        ptrs[i] = MEM_ALLOC(&pool, 1);
+        if (ptrs[i] == NULL) {
+            break;
+        }
+        allocated++;
+    }
+    TEST_ASSERT(allocated == (int)MEM_POOL_TOTAL_BLOCKS, "分配覆盖全部区域");
+
+    /* 块内部指针（非用户指针）必须被拒绝 */
+    TEST_ASSERT(MEM_FREE(&pool, (uint8_t*)ptrs[allocated - 1] + 1) == ERR_MEM_POOL_INVALID,
+                "块内部指针释放被拒绝");
+    TEST_ASSERT(aegis_mem_pool_check_magic(&pool, foreign + 2) == ERR_MEM_POOL_INVALID,
+                "池外指针检查被拒绝");
+
+    for (i = allocated - 1; i >= 0; i--) {
+        if (MEM_FREE(&pool, ptrs[i]) == ERR_OK) {
+            freed++;
+        }
+    }
+    TEST_ASSERT(freed == allocated, "逆序释放全部块成功");
+
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(stats.used_blocks == 0, "释放后各区域已用块数为0");
+}
+
+/*
+ * @test: 测试每上下文缓存（批量取回/归还、统计、与共享池混用、耗尽）
+ * @req: REQ-TEST-007
+ */
+static void test_mem_pool_cache(void) {
+    static void* ptrs[MEM_POOL_TOTAL_BLOCKS];
+    AegisMemPoolStats stats;
+    AegisMemPoolCache cache;
+    AegisMemPoolIndex corrupted;
+    AegisMemPool pool;
+    void* p;
+    void* q;
+    int i;
+    int allocated;
+    uint8_t saved;
+
+    printf("\n[TEST] test_mem_pool_cache\n");
+
+    (void)aegis_mem_pool_init(&pool, NULL);
+    TEST_ASSERT(aegis_mem_pool_cache_init(NULL, &pool) == ERR_NULL_PTR, "缓存空指针被拒绝");
+    TEST_ASSERT(aegis_mem_pool_cache_init(&cache, &pool) == ERR_OK, "缓存初始化成功");
+    TEST_ASSERT(aegis_mem_pool_cache_init(&cache, &pool) == ERR_OK && pool.caches == &cache &&
+                cache.next == NULL, "重复初始化不重复注册");
+
+    /* 首次分配：批量取回 MEM_POOL_CACHE_BATCH 块 */
+    p = MEM_CACHE_ALLOC(&cache, 1);
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(p != NULL && cache.refills == 1U && cache.hits == 0U, "缓存未命中时批量取回");
+    TEST_ASSERT(stats.used_blocks == 1U && stats.cached_blocks == (AegisMemPoolIndex)(MEM_POOL_CACHE_BATCH - 1U) &&
+                stats.class_used[0] == 1U, "统计区分已用块与缓存块");
+    TEST_ASSERT(stats.used_blocks + stats.cached_blocks + stats.free_blocks == stats.total_blocks,
+                "已用+缓存+空闲=总块数");
+    TEST_ASSERT(aegis_mem_pool_check_magic(&pool, p) == ERR_OK, "缓存分配的块写入魔法数");
+
+    /* 释放后再分配：命中缓存，LIFO 返回同一块 */
+    TEST_ASSERT(MEM_CACHE_FREE(&cache, p) == ERR_OK, "释放到缓存成功");
+    TEST_ASSERT(MEM_CACHE_FREE(&cache, p) == ERR_MEM_POOL_DOUBLE_FREE, "缓存检测重复释放");
+    q = MEM_CACHE_ALLOC(&cache, 1);
+    TEST_ASSERT(q == p && cache.hits == 2U && cache.refills == 1U, "命中缓存不进入共享池");
+
+    /* 缓存分配的块可由共享池释放，共享池分配的块也可释放到缓存 */
+    TEST_ASSERT(MEM_FREE(&pool, q) == ERR_OK, "共享池释放缓存分配的块");
+    p = MEM_ALLOC(&pool, 1);
+    TEST_ASSERT(MEM_CACHE_FREE(&cache, p) == ERR_OK, "缓存释放共享池分配的块");
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(stats.used_blocks == 0U && stats.cached_blocks == (AegisMemPoolIndex)MEM_POOL_CACHE_BATCH,
+                "混用后统计一致");
+
+    /* 缓存满时批量归还 */
+    for (i = 0; i < (int)MEM_POOL_CACHE_DEPTH + 1; i++) {
+        ptrs[i] = MEM_ALLOC(&pool, 1);
+    }
+    for (i = 0; i < (int)MEM_POOL_CACHE_DEPTH + 1; i++) {
+        (void)MEM_CACHE_FREE(&cache, ptrs[i]);
+    }
+    TEST_ASSERT(cache.flushes >= 1U && cache.count[0] <= (uint8_t)MEM_POOL_CACHE_DEPTH, "缓存满时批量归还");
+
+    /* 魔法数损坏的块不会进入缓存 */
+    p = MEM_CACHE_ALLOC(&cache, 8);
+    saved = ((uint8_t*)p)[MEM_POOL_SMALL_SIZE - MEM_POOL_GUARD_SIZE];
+    ((uint8_t*)p)[MEM_POOL_SMALL_SIZE - MEM_POOL_GUARD_SIZE] = (uint8_t)~saved;
+    TEST_ASSERT(MEM_CACHE_FREE(&cache, p) == ERR_MEM_POOL_INVALID, "缓存释放检测魔法数损坏");
+    TEST_ASSERT(MEM_CACHE_FREE(&cache, (uint8_t*)p + 1) == ERR_MEM_POOL_INVALID, "缓存拒绝块内部指针");
+    ((uint8_t*)p)[MEM_POOL_SMALL_SIZE - MEM_POOL_GUARD_SIZE] = saved;
+    TEST_ASSERT(MEM_CACHE_FREE(&cache, p) == ERR_OK, "恢复后释放成功");
+
+    TEST_ASSERT(aegis_mem_pool_cache_flush(&cache) == ERR_OK, "flush 成功");
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(stats.cached_blocks == 0U && stats.free_blocks == stats.total_blocks, "flush 后全部块回到共享池");
+
+    /* 经缓存分配全部块：最佳尺寸类耗尽后向上借用 */
+    allocated = 0;
+    for (i = 0; i < (int)MEM_POOL_TOTAL_BLOCKS; i++) {
+        ptrs[i] = MEM_CACHE_ALLOC(&cache, 1);
+        if (ptrs[i] == NULL) {
+            break;
+        }
+        allocated++;
+    }
+    TEST_ASSERT(allocated == (int)MEM_POOL_TOTAL_BLOCKS && MEM_CACHE_ALLOC(&cache, 1) == NULL,
+                "经缓存可分配全部块");
+    TEST_ASSERT(aegis_mem_pool_check_all_magic(&pool, &corrupted) == ERR_OK && corrupted == 0U,
+                "全部块魔法数完整");
+    for (i = allocated - 1; i >= 0; i--) {
+        (void)MEM_CACHE_FREE(&cache, ptrs[i]);
+    }
+    (void)aegis_mem_pool_cache_flush(&cache);
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(stats.used_blocks == 0U && stats.free_blocks == stats.total_blocks, "释放并 flush 后全部空闲");
+}
+
+/*
+ * @test: 测试增量巡检（有界批次、整轮覆盖、trace 记录分配位置）
+ * @req: REQ-TEST-008
+ */
+static void test_mem_pool_scrub(void) {
+    AegisMemPoolStats stats;
+    AegisMemPoolIndex corrupted;
+    AegisTraceLog trace;
+    AegisTraceEvent ev;
+    AegisMemPool pool;
+    uint8_t* p;
+    void* q;
+    uint32_t tail;
+    uint32_t calls;
+    uint32_t found;
+    uint8_t saved;
+    bool_t logged;
+
+    printf("\n[TEST] test_mem_pool_scrub\n");
+
+    (void)aegis_trace_log_init(&trace, test_now_ms, NULL);
+    (void)aegis_mem_pool_init(&pool, &trace);
+
+    TEST_ASSERT(aegis_mem_pool_scrub_step(NULL, &corrupted) == ERR_NULL_PTR, "空指针被拒绝");
+    TEST_ASSERT((uint32_t)MEM_POOL_SCRUB_BATCH * (uint32_t)MEM_POOL_SCRUB_SWEEP_CALLS >= (uint32_t)MEM_POOL_TOTAL_BLOCKS,
+                "批次 x 调用次数覆盖全部块");
+
+    p = (uint8_t*)aegis_mem_pool_alloc(&pool, 8U, "scrub_owner.c", 1234U);
+    q = MEM_ALLOC(&pool, 8U);
+    TEST_ASSERT(p != NULL && q != NULL, "分配两块");
+
+    /* 破坏 p 的尾部魔法数 */
+    tail = (uint32_t)pool.regions[0].block_size - MEM_POOL_GUARD_SIZE;
+    saved = p[tail];
+    p[tail] = (uint8_t)~saved;
+
+    /* 丢弃分配产生的 trace，只看巡检写入的事件 */
+    while (aegis_ring_buffer_read(&trace.ring, (uint8_t*)&ev, (uint16_t)sizeof(ev)) == (uint16_t)sizeof(ev)) {
+    }
+
+    /* 从游标0开始，至多 MEM_POOL_SCRUB_SWEEP_CALLS 次调用完成一轮 */
+    found = 0U;
+    for (calls = 0U; pool.scrub_sweeps == 0U && calls <= (uint32_t)MEM_POOL_SCRUB_SWEEP_CALLS; calls++) {
+        (void)aegis_mem_pool_scrub_step(&pool, &corrupted);
+        found += corrupted;
+    }
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(calls <= (uint32_t)MEM_POOL_SCRUB_SWEEP_CALLS && stats.scrub_sweeps == 1U,
+                "MEM_POOL_SCRUB_SWEEP_CALLS 次调用内完成一轮");
+    TEST_ASSERT(found == 1U && stats.scrub_corrupted == 1U, "一轮内发现唯一损坏块");
+
+    logged = FALSE;
+    while (aegis_ring_buffer_read(&trace.ring, (uint8_t*)&ev, (uint16_t)sizeof(ev)) == (uint16_t)sizeof(ev)) {
+        if (ev.event_type == TRACE_EVENT_MEM_CORRUPT && ev.aegis_trace_id != NULL &&
+            strcmp(ev.aegis_trace_id, "scrub_owner.c") == 0 && ev.param1 == 1234U &&
+            ev.param2 == (uint32_t)((ulong_t)p & 0xFFFFFFFFUL)) {
+            logged = TRUE;
+        }
+    }
+    TEST_ASSERT(logged, "trace 记录分配文件/行号");
+
+    /* 恢复后下一轮无损坏 */
+    p[tail] = saved;
+    found = 0U;
+    for (calls = 0U; calls < 2U * (uint32_t)MEM_POOL_SCRUB_SWEEP_CALLS; calls++) {
+        (void)aegis_mem_pool_scrub_step(&pool, &corrupted);
+        found += corrupted;
+    }
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT(found == 0U && stats.scrub_sweeps >= 2U && stats.scrub_corrupted == 0U, "恢复后整轮无损坏");
+
+    TEST_ASSERT(MEM_FREE(&pool, p) == ERR_OK && MEM_FREE(&pool, q) == ERR_OK, "释放成功");
+}
+
 /* ==================== 测试入口 ==================== */
 int main(void) {
     printf("========================================\n");
@@ -233,6 +446,9 @@ int main(void) {
     test_mem_pool_stats();
     test_mem_pool_overflow_detection();
     test_mem_pool_exhaustion();
+    test_mem_pool_free_lookup_all_regions();
+    test_mem_pool_cache();
+    test_mem_pool_scrub();
 
     /* 输出测试结果 */
     printf("\n========================================\n");
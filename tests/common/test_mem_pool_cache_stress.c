@@ -0,0 +1,359 @@
+/*
+ * @file: test_mem_pool_cache_stress.c
+ * @brief: 内存池每上下文缓存多线程压力测试（x86_sim）
+ * @author: jack liu
+ * @req: REQ-TEST-MEM-POOL-CACHE-STRESS
+ *
+ * 多个工作线程各持有一个 AegisMemPoolCache，共享同一个内存池：随机大小分配、写入校验图样、
+ * 释放前逐字节校验；部分块经邮箱交给下一个线程释放（块在缓存之间迁移）。
+ * 主线程同时读取统计并检查全部魔法数。结束后 flush 全部缓存，要求所有块回到共享池。
+ *
+ * 第二阶段：两个线程各持有一个缓存，同时释放主线程分配的同一个块，
+ * 要求每轮恰好一次成功、一次 ERR_MEM_POOL_DOUBLE_FREE，且块不会进入两个缓存。
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include "mem_pool.h"
+
+/* ==================== 测试配置 ==================== */
+#define STRESS_WORKERS      4U
+#define STRESS_ROUNDS       200000UL
+#define STRESS_LIVE_MAX     6U      /* 每线程同时持有的块数上限 */
+#define STRESS_HANDOFF_MOD  16UL    /* 每 N 次释放有一次交给下一个线程 */
+#define RACE_THREADS        2U
+#define RACE_ROUNDS         20000UL
+
+typedef struct StressWorker StressWorker;
+
+struct StressWorker {
+    AegisMemPool* pool;
+    AegisMemPoolCache cache;
+    void* volatile mailbox;         /* 上一个线程交来的块（原子交换） */
+    StressWorker* next;
+    uint32_t seed;
+    unsigned long errors;
+    unsigned long allocs;
+    unsigned long handoffs;
+};
+
+typedef struct {
+    AegisMemPool pool;
+    StressWorker workers[STRESS_WORKERS];
+    unsigned long errors;
+} StressContext;
+
+/* 重复释放竞争：主线程发布块与轮次号，两个线程同时释放 */
+typedef struct {
+    AegisMemPoolCache caches[RACE_THREADS];
+    void* volatile target;
+    volatile unsigned long round;   /* 当前轮次（从1开始，0=未开始） */
+    volatile unsigned long done;    /* 已完成释放的线程次数 */
+    volatile unsigned long freed;   /* 返回 ERR_OK 的次数 */
+    volatile unsigned long rejected;/* 返回 ERR_MEM_POOL_DOUBLE_FREE 的次数 */
+    volatile unsigned long errors;
+} RaceContext;
+
+typedef struct {
+    RaceContext* ctx;
+    uint32_t id;
+} RaceWorker;
+
+/* ==================== 函数原型声明 ==================== */
+static uint32_t next_rand(uint32_t* seed);
+static void fill_block(void* p, uint32_t size, uint8_t tag);
+static bool_t verify_block(const void* p);
+static void release_block(StressWorker* w, void* p);
+static void* worker_main(void* arg);
+static void* race_main(void* arg);
+static int run_double_free_race(void);
+
+static uint32_t next_rand(uint32_t* seed) {
+    *seed = *seed * 1103515245U + 12345U;
+    return *seed >> 8;
+}
+
+/* 块内容：前2字节为大小，其余为同一标记字节 */
+static void fill_block(void* p, uint32_t size, uint8_t tag) {
+    uint8_t* b = (uint8_t*)p;
+    uint32_t i;
+
+    b[0] = (uint8_t)(size & 0xFFU);
+    b[1] = (uint8_t)(size >> 8);
+    for (i = 2; i < size; i++) {
+        b[i] = tag;
+    }
+}
+
+static bool_t verify_block(const void* p) {
+    const uint8_t* b = (const uint8_t*)p;
+    uint32_t size;
+    uint32_t i;
+
+    size = (uint32_t)b[0] | ((uint32_t)b[1] << 8);
+    if (size < 3U || size > MEM_POOL_MAX_ALLOC) {
+        return FALSE;
+    }
+    for (i = 3; i < size; i++) {
+        if (b[i] != b[2]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void release_block(StressWorker* w, void* p) {
+    if (!verify_block(p)) {
+        w->errors++;
+    }
+    if (MEM_CACHE_FREE(&w->cache, p) != ERR_OK) {
+        w->errors++;
+    }
+}
+
+static void* worker_main(void* arg) {
+    StressWorker* w = (StressWorker*)arg;
+    void* live[STRESS_LIVE_MAX];
+    uint32_t n_live = 0;
+    unsigned long round;
+    unsigned long frees = 0;
+    uint32_t size;
+    uint32_t k;
+    void* p;
+    void* prev;
+
+    for (round = 0; round < STRESS_ROUNDS; round++) {
+        /* 先处理上一个线程交来的块 */
+        p = __atomic_exchange_n(&w->mailbox, (void*)NULL, __ATOMIC_ACQ_REL);
+        if (p != NULL) {
+            release_block(w, p);
+        }
+
+        if (n_live < STRESS_LIVE_MAX && (next_rand(&w->seed) & 1U) == 0U) {
+            size = 3U + next_rand(&w->seed) % (MEM_POOL_MAX_ALLOC - 2U);
+            p = MEM_CACHE_ALLOC(&w->cache, size);
+            if (p != NULL) {
+                fill_block(p, size, (uint8_t)next_rand(&w->seed));
+                live[n_live] = p;
+                n_live++;
+                w->allocs++;
+            } else {
+                sched_yield();
+            }
+        } else if (n_live > 0U) {
+            k = next_rand(&w->seed) % n_live;
+            p = live[k];
+            n_live--;
+            live[k] = live[n_live];
+            frees++;
+
+            if (frees % STRESS_HANDOFF_MOD == 0UL) {
+                prev = __atomic_exchange_n(&w->next->mailbox, p, __ATOMIC_ACQ_REL);
+                w->handoffs++;
+                if (prev != NULL) {
+                    release_block(w, prev);
+                }
+            } else {
+                release_block(w, p);
+            }
+        }
+    }
+
+    while (n_live > 0U) {
+        n_live--;
+        release_block(w, live[n_live]);
+    }
+
+    return NULL;
+}
+
+static void* race_main(void* arg) {
+    RaceWorker* w = (RaceWorker*)arg;
+    RaceContext* ctx = w->ctx;
+    unsigned long r;
+    AegisErrorCode err;
+
+    for (r = 1; r <= RACE_ROUNDS; r++) {
+        while (__atomic_load_n(&ctx->round, __ATOMIC_ACQUIRE) != r) {
+            sched_yield();
+        }
+
+        err = MEM_CACHE_FREE(&ctx->caches[w->id], ctx->target);
+        if (err == ERR_OK) {
+            (void)__atomic_add_fetch(&ctx->freed, 1UL, __ATOMIC_ACQ_REL);
+        } else if (err == ERR_MEM_POOL_DOUBLE_FREE) {
+            (void)__atomic_add_fetch(&ctx->rejected, 1UL, __ATOMIC_ACQ_REL);
+        } else {
+            (void)__atomic_add_fetch(&ctx->errors, 1UL, __ATOMIC_ACQ_REL);
+        }
+        (void)__atomic_add_fetch(&ctx->done, 1UL, __ATOMIC_ACQ_REL);
+    }
+
+    return NULL;
+}
+
+static int run_double_free_race(void) {
+    static RaceContext ctx;
+    static AegisMemPool pool;
+    RaceWorker workers[RACE_THREADS];
+    pthread_t threads[RACE_THREADS];
+    AegisMemPoolStats stats;
+    unsigned long r;
+    uint32_t i;
+    void* p;
+
+    printf("\n[测试] 两个线程同时释放同一块（%lu 轮）...\n", RACE_ROUNDS);
+
+    if (aegis_mem_pool_init(&pool, NULL) != ERR_OK) {
+        printf("❌ 初始化失败\n");
+        return 1;
+    }
+    for (i = 0; i < RACE_THREADS; i++) {
+        if (aegis_mem_pool_cache_init(&ctx.caches[i], &pool) != ERR_OK) {
+            printf("❌ 缓存初始化失败\n");
+            return 1;
+        }
+        workers[i].ctx = &ctx;
+        workers[i].id = i;
+        if (pthread_create(&threads[i], NULL, race_main, &workers[i]) != 0) {
+            printf("❌ 创建线程失败\n");
+            return 1;
+        }
+    }
+
+    for (r = 1; r <= RACE_ROUNDS; r++) {
+        /* 从共享池分配：块若曾被两个缓存同时收下，共享池会提前耗尽或重复发放 */
+        p = MEM_ALLOC(&pool, 1U + (uint32_t)(r % MEM_POOL_MAX_ALLOC));
+        if (p == NULL) {
+            ctx.errors++;
+            break;
+        }
+        ctx.target = p;
+        __atomic_store_n(&ctx.round, r, __ATOMIC_RELEASE);
+        while (__atomic_load_n(&ctx.done, __ATOMIC_ACQUIRE) != r * RACE_THREADS) {
+            sched_yield();
+        }
+        if (ctx.freed != r || ctx.rejected != r) {
+            ctx.errors++;
+            break;
+        }
+
+        /* 把缓存中的块还回共享池，下一轮才能再次分配到 */
+        for (i = 0; i < RACE_THREADS; i++) {
+            (void)aegis_mem_pool_cache_flush(&ctx.caches[i]);
+        }
+    }
+
+    if (r <= RACE_ROUNDS) {
+        /* 提前退出：放行工作线程到最后一轮 */
+        for (; r <= RACE_ROUNDS; r++) {
+            ctx.target = NULL;
+            __atomic_store_n(&ctx.round, r, __ATOMIC_RELEASE);
+            while (__atomic_load_n(&ctx.done, __ATOMIC_ACQUIRE) < r * RACE_THREADS) {
+                sched_yield();
+            }
+        }
+    }
+
+    for (i = 0; i < RACE_THREADS; i++) {
+        (void)pthread_join(threads[i], NULL);
+    }
+
+    (void)aegis_mem_pool_get_stats(&pool, &stats);
+    printf("  成功释放 %lu 次，拒绝重复释放 %lu 次，错误 %lu\n", ctx.freed, ctx.rejected, ctx.errors);
+
+    if (ctx.errors == 0UL && ctx.freed == RACE_ROUNDS && ctx.rejected == RACE_ROUNDS &&
+        stats.used_blocks == 0U && stats.cached_blocks == 0U && stats.free_blocks == stats.total_blocks) {
+        printf("  ✓ 每轮恰好一次成功释放\n");
+        return 0;
+    }
+
+    printf("  ✗ 重复释放未被拒绝或块进入了两个缓存\n");
+    return 1;
+}
+
+/* ==================== 测试入口 ==================== */
+int main(void) {
+    static StressContext ctx;
+    pthread_t threads[STRESS_WORKERS];
+    AegisMemPoolStats stats;
+    AegisMemPoolIndex corrupted;
+    unsigned long allocs = 0;
+    unsigned long handoffs = 0;
+    unsigned long hits = 0;
+    unsigned long checks = 0;
+    uint32_t i;
+    void* p;
+
+    printf("========================================\n");
+    printf("  内存池每上下文缓存多线程压力测试（%u 线程）\n", (unsigned)STRESS_WORKERS);
+    printf("========================================\n");
+
+    if (aegis_mem_pool_init(&ctx.pool, NULL) != ERR_OK) {
+        printf("❌ 初始化失败\n");
+        return 1;
+    }
+
+    for (i = 0; i < STRESS_WORKERS; i++) {
+        ctx.workers[i].pool = &ctx.pool;
+        ctx.workers[i].next = &ctx.workers[(i + 1U) % STRESS_WORKERS];
+        ctx.workers[i].seed = 0x9E3779B9U * (i + 1U);
+        if (aegis_mem_pool_cache_init(&ctx.workers[i].cache, &ctx.pool) != ERR_OK) {
+            printf("❌ 缓存初始化失败\n");
+            return 1;
+        }
+    }
+
+    for (i = 0; i < STRESS_WORKERS; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, &ctx.workers[i]) != 0) {
+            printf("❌ 创建线程失败\n");
+            return 1;
+        }
+    }
+
+    /* 工作线程运行期间：统计恒等式与魔法数检查 */
+    for (checks = 0; checks < 2000UL; checks++) {
+        if (aegis_mem_pool_get_stats(&ctx.pool, &stats) != ERR_OK ||
+            (uint32_t)stats.used_blocks + stats.cached_blocks + stats.free_blocks != (uint32_t)stats.total_blocks) {
+            ctx.errors++;
+        }
+        if (aegis_mem_pool_check_all_magic(&ctx.pool, &corrupted) != ERR_OK) {
+            ctx.errors++;
+        }
+        sched_yield();
+    }
+
+    for (i = 0; i < STRESS_WORKERS; i++) {
+        (void)pthread_join(threads[i], NULL);
+    }
+
+    /* 邮箱中剩余的块由主线程经各自缓存释放 */
+    for (i = 0; i < STRESS_WORKERS; i++) {
+        p = ctx.workers[i].mailbox;
+        if (p != NULL) {
+            release_block(&ctx.workers[i], p);
+        }
+        if (aegis_mem_pool_cache_flush(&ctx.workers[i].cache) != ERR_OK) {
+            ctx.errors++;
+        }
+        ctx.errors += ctx.workers[i].errors;
+        allocs += ctx.workers[i].allocs;
+        handoffs += ctx.workers[i].handoffs;
+        hits += ctx.workers[i].cache.hits;
+    }
+
+    (void)aegis_mem_pool_get_stats(&ctx.pool, &stats);
+    printf("  分配次数: %lu（缓存命中 %lu，跨线程释放 %lu）\n", allocs, hits, handoffs);
+    printf("  校验错误: %lu\n", ctx.errors);
+
+    if (ctx.errors == 0UL && allocs > 0UL && stats.used_blocks == 0U && stats.cached_blocks == 0U &&
+        stats.free_blocks == stats.total_blocks &&
+        aegis_mem_pool_check_all_magic(&ctx.pool, &corrupted) == ERR_OK && run_double_free_race() == 0) {
+        printf("✅ 压力测试通过!\n");
+        return 0;
+    }
+
+    printf("❌ 压力测试失败!\n");
+    return 1;
+}
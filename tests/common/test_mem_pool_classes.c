@@ -0,0 +1,118 @@
+/*
+ * @file: test_mem_pool_classes.c
+ * @brief: 内存池多尺寸类配置单元测试（24 个尺寸类、16 位块下标）
+ * @author: jack liu
+ * @req: REQ-TEST-MEM-POOL
+ *
+ * 本目标以 MEM_POOL_CLASS_CONFIG="mem_pool_classes_wide.h" 单独编译 mem_pool.c。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "mem_pool.h"
+
+/* 请求大小 size 的最佳尺寸类（逐个比较的参考实现） */
+static uint32_t expected_class(const AegisMemPool* pool, uint32_t size) {
+    uint32_t c;
+
+    for (c = 0; c < (uint32_t)MEM_POOL_CLASS_COUNT; c++) {
+        if (size <= (uint32_t)pool->regions[c].block_size - MEM_POOL_GUARD_SIZE) {
+            break;
+        }
+    }
+    return c;
+}
+
+int main(void) {
+    static AegisMemPool pool;
+    static void* ptrs[MEM_POOL_TOTAL_BLOCKS];
+    AegisMemPoolStats stats;
+    AegisMemPoolIndex corrupted;
+    uint32_t allocated;
+    uint32_t size;
+    uint32_t c;
+    uint32_t i;
+    uint8_t saved;
+    void* p;
+
+    printf("========================================\n");
+    printf("  内存池多尺寸类测试（%d 个尺寸类，%lu 块）\n", (int)MEM_POOL_CLASS_COUNT,
+           (unsigned long)MEM_POOL_TOTAL_BLOCKS);
+    printf("========================================\n");
+
+    /* 1. 尺寸类表展开与下标宽度 */
+    assert(MEM_POOL_CLASS_COUNT == 24);
+    assert(MEM_POOL_TOTAL_BLOCKS > 254);
+    assert(sizeof(AegisMemPoolIndex) == 2U);
+    assert(aegis_mem_pool_init(&pool, NULL) == ERR_OK);
+    assert(aegis_mem_pool_get_stats(&pool, &stats) == ERR_OK);
+    assert(stats.total_blocks == (AegisMemPoolIndex)MEM_POOL_TOTAL_BLOCKS);
+    assert(pool.regions[MEM_POOL_CLASS_COUNT - 1].block_size == 2048U);
+    printf("  ✓ 尺寸类表展开与16位块下标\n");
+
+    /* 2. 每个请求大小都落在最小的可容纳尺寸类 */
+    for (size = 1U; size <= MEM_POOL_MAX_ALLOC; size++) {
+        c = expected_class(&pool, size);
+        p = MEM_ALLOC(&pool, size);
+        assert(p != NULL);
+        memset(p, 0x5A, (size_t)size);
+        assert(aegis_mem_pool_get_stats(&pool, &stats) == ERR_OK);
+        assert(stats.used_blocks == 1U && stats.class_used[c] == 1U);
+        assert(aegis_mem_pool_check_magic(&pool, p) == ERR_OK);
+        assert(MEM_FREE(&pool, p) == ERR_OK);
+    }
+    assert(MEM_ALLOC(&pool, MEM_POOL_MAX_ALLOC + 1U) == NULL);
+    assert(MEM_ALLOC(&pool, 0U) == NULL);
+    printf("  ✓ 请求大小 1 ~ %lu 的尺寸类选择\n", (unsigned long)MEM_POOL_MAX_ALLOC);
+
+    /* 3. 最佳尺寸类耗尽后使用下一个更大的尺寸类 */
+    for (i = 0; i < (uint32_t)pool.regions[0].block_count; i++) {
+        ptrs[i] = MEM_ALLOC(&pool, 1U);
+        assert(ptrs[i] != NULL);
+    }
+    p = MEM_ALLOC(&pool, 1U);
+    assert(p != NULL);
+    assert(aegis_mem_pool_get_stats(&pool, &stats) == ERR_OK);
+    assert(stats.class_used[0] == pool.regions[0].block_count && stats.class_used[1] == 1U);
+    assert(MEM_FREE(&pool, p) == ERR_OK);
+    for (i = 0; i < (uint32_t)pool.regions[0].block_count; i++) {
+        assert(MEM_FREE(&pool, ptrs[i]) == ERR_OK);
+    }
+    printf("  ✓ 尺寸类耗尽时向上借用\n");
+
+    /* 4. 分配全部块（超过 254 块），逆序释放 */
+    allocated = 0U;
+    while (allocated < (uint32_t)MEM_POOL_TOTAL_BLOCKS) {
+        ptrs[allocated] = MEM_ALLOC(&pool, 1U);
+        if (ptrs[allocated] == NULL) {
+            break;
+        }
+        allocated++;
+    }
+    assert(allocated == (uint32_t)MEM_POOL_TOTAL_BLOCKS);
+    assert(MEM_ALLOC(&pool, 1U) == NULL);
+    assert(aegis_mem_pool_get_stats(&pool, &stats) == ERR_OK);
+    assert(stats.free_blocks == 0U && stats.peak_usage == (AegisMemPoolIndex)MEM_POOL_TOTAL_BLOCKS);
+
+    /* 破坏最后一个尺寸类中一块的尾部魔法数，再恢复 */
+    saved = ((uint8_t*)ptrs[allocated - 1U])[MEM_POOL_MAX_ALLOC];
+    ((uint8_t*)ptrs[allocated - 1U])[MEM_POOL_MAX_ALLOC] = (uint8_t)~saved;
+    assert(aegis_mem_pool_check_all_magic(&pool, &corrupted) == ERR_MEM_POOL_INVALID);
+    assert(corrupted == 1U);
+    assert(MEM_FREE(&pool, ptrs[allocated - 1U]) == ERR_MEM_POOL_INVALID);
+    ((uint8_t*)ptrs[allocated - 1U])[MEM_POOL_MAX_ALLOC] = saved;
+    assert(aegis_mem_pool_check_all_magic(&pool, &corrupted) == ERR_OK);
+
+    assert(MEM_FREE(&pool, (uint8_t*)ptrs[allocated / 2U] + 1) == ERR_MEM_POOL_INVALID);
+    for (i = allocated; i > 0U; i--) {
+        assert(MEM_FREE(&pool, ptrs[i - 1U]) == ERR_OK);
+    }
+    assert(MEM_FREE(&pool, ptrs[0]) == ERR_MEM_POOL_DOUBLE_FREE);
+    assert(aegis_mem_pool_get_stats(&pool, &stats) == ERR_OK);
+    assert(stats.used_blocks == 0U && stats.free_blocks == (AegisMemPoolIndex)MEM_POOL_TOTAL_BLOCKS);
+    printf("  ✓ 分配/释放全部 %lu 块\n", (unsigned long)allocated);
+
+    printf("✅ 所有测试通过!\n");
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * @file: test_object_pool.c
+ * @brief: 按类型生成的定长对象池单元测试
+ * @author: jack liu
+ * @req: REQ-TEST-OBJECT-POOL
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "object_pool.h"
+#include "domain_event.h"
+#include "app_command.h"
+#include "app_dto.h"
+
+/* 测试用的奇数大小结构体：槽位不向上取整到2的幂 */
+typedef struct {
+    uint8_t tag;
+    uint8_t payload[12];
+} TestRecord;
+
+#define TEST_RECORD_POOL_SIZE  40U     /* 超过一个位图字 */
+
+AEGIS_OBJECT_POOL_DECLARE(TestRecordPool, test_record_pool, TestRecord, TEST_RECORD_POOL_SIZE)
+AEGIS_OBJECT_POOL_DEFINE(TestRecordPool, test_record_pool, TestRecord, TEST_RECORD_POOL_SIZE)
+
+/* ==================== 函数原型声明 ==================== */
+static void test_init(void);
+static void test_alloc_until_exhausted(void);
+static void test_invalid_free(void);
+static void test_guard(void);
+static void test_framework_pools(void);
+
+static TestRecordPool g_pool;
+
+static void test_init(void) {
+    AegisObjectPoolStats stats;
+
+    printf("\n[测试] 初始化与槽位大小...\n");
+
+    assert(test_record_pool_init(NULL) == ERR_NULL_PTR);
+    assert(test_record_pool_alloc(NULL) == NULL);
+    assert(test_record_pool_init(&g_pool) == ERR_OK);
+    assert(test_record_pool_get_stats(&g_pool, &stats) == ERR_OK);
+    assert(stats.capacity == TEST_RECORD_POOL_SIZE && stats.used == 0U && stats.peak == 0U);
+
+    /* 槽位 = 对象（含自身对齐）+ 保护字 */
+    assert(sizeof(TestRecordPoolSlot) <= sizeof(TestRecord) + 3U + (OBJECT_POOL_GUARD ? 4U : 0U));
+    assert(sizeof(g_pool.used_map) == 2U * sizeof(uint32_t));
+
+    printf("  ✓ 槽位 %lu 字节（对象 %lu 字节）\n", (unsigned long)sizeof(TestRecordPoolSlot),
+           (unsigned long)sizeof(TestRecord));
+}
+
+static void test_alloc_until_exhausted(void) {
+    static TestRecord* objs[TEST_RECORD_POOL_SIZE];
+    AegisObjectPoolStats stats;
+    TestRecord* p;
+    uint32_t i;
+
+    printf("\n[测试] 分配至耗尽与复用...\n");
+
+    assert(test_record_pool_init(&g_pool) == ERR_OK);
+    for (i = 0; i < TEST_RECORD_POOL_SIZE; i++) {
+        objs[i] = test_record_pool_alloc(&g_pool);
+        assert(objs[i] != NULL);
+        assert(objs[i] == &g_pool.slots[i].u.obj);
+        memset(objs[i], (int)i, sizeof(TestRecord));
+    }
+    assert(test_record_pool_alloc(&g_pool) == NULL);
+    assert(test_record_pool_get_stats(&g_pool, &stats) == ERR_OK);
+    assert(stats.used == TEST_RECORD_POOL_SIZE && stats.peak == TEST_RECORD_POOL_SIZE);
+
+    /* 写满对象不影响相邻槽位 */
+    for (i = 0; i < TEST_RECORD_POOL_SIZE; i++) {
+        assert(objs[i]->tag == (uint8_t)i && objs[i]->payload[11] == (uint8_t)i);
+    }
+
+    /* 后进先出：最近释放的槽位最先被复用 */
+    assert(test_record_pool_free(&g_pool, objs[33]) == ERR_OK);
+    assert(test_record_pool_free(&g_pool, objs[5]) == ERR_OK);
+    p = test_record_pool_alloc(&g_pool);
+    assert(p == objs[5]);
+    p = test_record_pool_alloc(&g_pool);
+    assert(p == objs[33]);
+
+    for (i = 0; i < TEST_RECORD_POOL_SIZE; i++) {
+        assert(test_record_pool_free(&g_pool, objs[i]) == ERR_OK);
+    }
+    assert(test_record_pool_get_stats(&g_pool, &stats) == ERR_OK);
+    assert(stats.used == 0U && stats.peak == TEST_RECORD_POOL_SIZE);
+
+    printf("  ✓ 分配 %u 个对象后返回 NULL，释放后全部可复用\n", (unsigned)TEST_RECORD_POOL_SIZE);
+}
+
+static void test_invalid_free(void) {
+    static TestRecordPool other;
+    TestRecord local;
+    TestRecord* p;
+
+    printf("\n[测试] 非法释放...\n");
+
+    assert(test_record_pool_init(&g_pool) == ERR_OK);
+    assert(test_record_pool_init(&other) == ERR_OK);
+
+    p = test_record_pool_alloc(&g_pool);
+    assert(p != NULL);
+
+    assert(test_record_pool_free(&g_pool, NULL) == ERR_NULL_PTR);
+    assert(test_record_pool_free(NULL, p) == ERR_NULL_PTR);
+    assert(test_record_pool_free(&g_pool, &local) == ERR_MEM_POOL_INVALID);
+    assert(test_record_pool_free(&g_pool, (TestRecord*)((uint8_t*)p + 1)) == ERR_MEM_POOL_INVALID);
+    assert(test_record_pool_free(&other, p) == ERR_MEM_POOL_INVALID);
+    assert(test_record_pool_free(&g_pool, &g_pool.slots[1].u.obj) == ERR_MEM_POOL_DOUBLE_FREE);
+
+    assert(test_record_pool_free(&g_pool, p) == ERR_OK);
+    assert(test_record_pool_free(&g_pool, p) == ERR_MEM_POOL_DOUBLE_FREE);
+
+    /* 核心接口的下标检查 */
+    assert(aegis_object_pool_release(&g_pool.core, (AegisObjectPoolIndex)TEST_RECORD_POOL_SIZE) == ERR_OUT_OF_RANGE);
+    assert(aegis_object_pool_release(&g_pool.core, OBJECT_POOL_INDEX_NONE) == ERR_OUT_OF_RANGE);
+
+    printf("  ✓ 外部指针/内部偏移/其他池/重复释放均被拒绝\n");
+}
+
+static void test_guard(void) {
+    AegisObjectPoolStats stats;
+    AegisObjectPoolIndex corrupted;
+    TestRecord* p;
+    TestRecord* q;
+
+    printf("\n[测试] 保护字...\n");
+
+    assert(test_record_pool_init(&g_pool) == ERR_OK);
+    assert(aegis_object_pool_check_guards(&g_pool.core, &corrupted) == ERR_OK);
+    assert(corrupted == 0U);
+
+#if OBJECT_POOL_GUARD
+    p = test_record_pool_alloc(&g_pool);
+    q = test_record_pool_alloc(&g_pool);
+    assert(p != NULL && q != NULL);
+
+    /* 模拟越界写覆盖保护字 */
+    g_pool.slots[0].guard ^= 0x1U;
+    assert(aegis_object_pool_check_guards(&g_pool.core, &corrupted) == ERR_MEM_POOL_INVALID);
+    assert(corrupted == 1U);
+
+    /* 保护字损坏的槽位不回收 */
+    assert(test_record_pool_free(&g_pool, p) == ERR_MEM_POOL_INVALID);
+    assert(test_record_pool_get_stats(&g_pool, &stats) == ERR_OK);
+    assert(stats.used == 2U);
+    assert(test_record_pool_free(&g_pool, q) == ERR_OK);
+    assert(test_record_pool_alloc(&g_pool) == q);
+
+    g_pool.slots[0].guard ^= 0x1U;
+    assert(aegis_object_pool_check_guards(&g_pool.core, &corrupted) == ERR_OK);
+    assert(test_record_pool_free(&g_pool, p) == ERR_OK);
+    assert(test_record_pool_free(&g_pool, q) == ERR_OK);
+    printf("  ✓ 保护字损坏被检测，槽位未回收\n");
+#else
+    (void)stats;
+    (void)p;
+    (void)q;
+    printf("  - OBJECT_POOL_GUARD=0，跳过\n");
+#endif
+}
+
+static void test_framework_pools(void) {
+    static AegisDomainEventPool event_pool;
+    static AegisCommandPool cmd_pool;
+    static AegisAppDtoPool dto_pool;
+    AegisObjectPoolStats stats;
+    AegisDomainEvent* events[DOMAIN_EVENT_POOL_SIZE];
+    AegisCommand* cmd;
+    AegisAppDto* dto;
+    uint32_t i;
+
+    printf("\n[测试] 框架内置对象池...\n");
+
+    assert(aegis_domain_event_pool_init(&event_pool) == ERR_OK);
+    for (i = 0; i < DOMAIN_EVENT_POOL_SIZE; i++) {
+        events[i] = aegis_domain_event_pool_alloc(&event_pool);
+        assert(events[i] != NULL);
+        events[i]->aggregate_id = (AegisEntityId)(i + 1U);
+    }
+    assert(aegis_domain_event_pool_alloc(&event_pool) == NULL);
+    for (i = 0; i < DOMAIN_EVENT_POOL_SIZE; i++) {
+        assert(events[i]->aggregate_id == (AegisEntityId)(i + 1U));
+        assert(aegis_domain_event_pool_free(&event_pool, events[i]) == ERR_OK);
+    }
+    assert(aegis_domain_event_pool_get_stats(&event_pool, &stats) == ERR_OK);
+    assert(stats.used == 0U && stats.peak == DOMAIN_EVENT_POOL_SIZE);
+
+    assert(aegis_app_cmd_pool_init(&cmd_pool) == ERR_OK);
+    cmd = aegis_app_cmd_pool_alloc(&cmd_pool);
+    assert(cmd != NULL);
+    cmd->payload[APP_CMD_PAYLOAD_MAX - 1U] = 0xA5U;
+    assert(aegis_app_cmd_pool_free(&cmd_pool, cmd) == ERR_OK);
+    assert(aegis_app_cmd_pool_free(&cmd_pool, cmd) == ERR_MEM_POOL_DOUBLE_FREE);
+
+    assert(aegis_app_dto_pool_init(&dto_pool) == ERR_OK);
+    dto = aegis_app_dto_pool_alloc(&dto_pool);
+    assert(dto != NULL);
+    assert(aegis_app_dto_pool_free(&dto_pool, dto) == ERR_OK);
+
+    printf("  ✓ 事件槽位 %lu 字节、命令槽位 %lu 字节、DTO 槽位 %lu 字节\n",
+           (unsigned long)sizeof(AegisDomainEventPoolSlot), (unsigned long)sizeof(AegisCommandPoolSlot),
+           (unsigned long)sizeof(AegisAppDtoPoolSlot));
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("  对象池单元测试\n");
+    printf("========================================\n");
+
+    test_init();
+    test_alloc_until_exhausted();
+    test_invalid_free();
+    test_guard();
+    test_framework_pools();
+
+    printf("\n✅ 所有测试通过!\n");
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * @file: test_ring_buffer.c
+ * @brief: 环形缓冲区单元测试（2的幂掩码模式 / 通用模式）
+ * @author: jack liu
+ * @req: REQ-TEST-RING
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ring_buffer.h"
+
+/* ==================== 函数原型声明 ==================== */
+static void test_ring_buffer_mode_detect(void);
+static void run_fifo_wrap(uint16_t size);
+static void test_ring_buffer_fifo_wrap(void);
+static void test_ring_buffer_index_overflow(void);
+static void test_ring_buffer_pow2_ceil(void);
+
+/* ==================== 测试用例计数 ==================== */
+static int g_test_passed = 0;
+static int g_test_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            g_test_passed++; \
+            printf("  ✓ %s\n", message); \
+        } else { \
+            g_test_failed++; \
+            printf("  ✗ %s (FAILED at %s:%d)\n", message, __FILE__, __LINE__); \
+        } \
+    } while(0)
+
+/* ==================== 测试用例 ==================== */
+
+/*
+ * @test: init 自动检测2的幂容量
+ */
+static void test_ring_buffer_mode_detect(void) {
+    AegisRingBuffer rb;
+    uint8_t buf[16];
+
+    printf("\n[TEST] test_ring_buffer_mode_detect\n");
+
+    TEST_ASSERT(aegis_ring_buffer_init(&rb, buf, 16) == ERR_OK && rb.is_pow2, "16字节使用掩码模式");
+#if RING_BUFFER_POW2_ONLY
+    TEST_ASSERT(aegis_ring_buffer_init(&rb, buf, 12) == ERR_INVALID_PARAM, "仅2的幂模式拒绝12字节");
+#else
+    TEST_ASSERT(aegis_ring_buffer_init(&rb, buf, 12) == ERR_OK && !rb.is_pow2, "12字节使用通用模式");
+#endif
+}
+
+/*
+ * @brief: 反复写读跨越回绕，校验FIFO顺序与数据量
+ */
+static void run_fifo_wrap(uint16_t size) {
+    AegisRingBuffer rb;
+    uint8_t buf[16];
+    uint8_t in[7];
+    uint8_t out[7];
+    uint8_t* p;
+    uint8_t next_in = 0;
+    uint8_t next_out = 0;
+    uint16_t i;
+    uint16_t n;
+    int round;
+    int ok = 1;
+
+    (void)aegis_ring_buffer_init(&rb, buf, size);
+
+    for (round = 0; round < 50; round++) {
+        for (i = 0; i < 7U; i++) {
+            in[i] = (uint8_t)(next_in + i);
+        }
+        n = aegis_ring_buffer_write(&rb, in, 7);
+        next_in = (uint8_t)(next_in + n);
+
+        if (aegis_ring_buffer_put(&rb, next_in) == ERR_OK) {
+            next_in++;
+        }
+
+        n = aegis_ring_buffer_read(&rb, out, 5);
+        for (i = 0; i < n; i++) {
+            if (out[i] != (uint8_t)(next_out + i)) {
+                ok = 0;
+            }
+        }
+        next_out = (uint8_t)(next_out + n);
+
+        n = aegis_ring_buffer_get_read_ptr(&rb, &p);
+        if (n > 2U) {
+            n = 2U;
+        }
+        for (i = 0; i < n; i++) {
+            if (p[i] != (uint8_t)(next_out + i)) {
+                ok = 0;
+            }
+        }
+        (void)aegis_ring_buffer_commit_read(&rb, n);
+        next_out = (uint8_t)(next_out + n);
+
+        if (aegis_ring_buffer_get_count(&rb) != (uint16_t)(uint8_t)(next_in - next_out) ||
+            aegis_ring_buffer_get_free(&rb) != (uint16_t)(size - aegis_ring_buffer_get_count(&rb))) {
+            ok = 0;
+        }
+    }
+
+    TEST_ASSERT(ok, size == 16U ? "掩码模式回绕读写一致" : "通用模式回绕读写一致");
+}
+
+/*
+ * @test: 两种模式的回绕读写
+ */
+static void test_ring_buffer_fifo_wrap(void) {
+    printf("\n[TEST] test_ring_buffer_fifo_wrap\n");
+
+    run_fifo_wrap(16);
+#if !RING_BUFFER_POW2_ONLY
+    run_fifo_wrap(13);
+#endif
+}
+
+/*
+ * @test: 掩码模式下16位自由递增索引溢出
+ */
+static void test_ring_buffer_index_overflow(void) {
+    AegisRingBuffer rb;
+    uint8_t buf[8];
+    uint8_t out[6];
+
+    printf("\n[TEST] test_ring_buffer_index_overflow\n");
+
+    (void)aegis_ring_buffer_init(&rb, buf, 8);
+    rb.head = 0xFFFDU;
+    rb.tail = 0xFFFDU;
+
+    TEST_ASSERT(aegis_ring_buffer_write(&rb, (const uint8_t*)"abcdef", 6) == 6U, "跨溢出写入6字节");
+    TEST_ASSERT(aegis_ring_buffer_get_count(&rb) == 6U, "溢出后数据量正确");
+    TEST_ASSERT(aegis_ring_buffer_write(&rb, (const uint8_t*)"ghij", 4) == 2U, "溢出后满判断正确");
+    TEST_ASSERT(aegis_ring_buffer_read(&rb, out, 6) == 6U && memcmp(out, "abcdef", 6) == 0,
+                "跨溢出读出数据一致");
+}
+
+/*
+ * @test: 编译期2的幂取整
+ */
+static void test_ring_buffer_pow2_ceil(void) {
+    printf("\n[TEST] test_ring_buffer_pow2_ceil\n");
+
+    TEST_ASSERT(RING_BUFFER_POW2_CEIL(1U) == 1U, "1 -> 1");
+    TEST_ASSERT(RING_BUFFER_POW2_CEIL(256U) == 256U, "256 -> 256");
+    TEST_ASSERT(RING_BUFFER_POW2_CEIL(257U) == 512U, "257 -> 512");
+    TEST_ASSERT(RING_BUFFER_POW2_CEIL(704U) == 1024U, "704 -> 1024");
+    TEST_ASSERT(RING_BUFFER_POW2_CEIL(20000U) == 32768U, "20000 -> 32768");
+}
+
+/* ==================== 测试入口 ==================== */
+int main(void) {
+    printf("========================================\n");
+    printf("  环形缓冲区单元测试\n");
+    printf("========================================\n");
+
+    test_ring_buffer_mode_detect();
+    test_ring_buffer_fifo_wrap();
+    test_ring_buffer_index_overflow();
+    test_ring_buffer_pow2_ceil();
+
+    printf("\n========================================\n");
+    printf("测试结果:\n");
+    printf("  通过: %d\n", g_test_passed);
+    printf("  失败: %d\n", g_test_failed);
+    printf("========================================\n");
+
+    if (g_test_failed == 0) {
+        printf("✅ 所有测试通过!\n");
+        return 0;
+    } else {
+        printf("❌ 存在失败的测试!\n");
+        return 1;
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * @file: test_ring_buffer_spsc.c
+ * @brief: 无锁 SPSC 环形缓冲区单元测试
+ * @author: jack liu
+ * @req: REQ-TEST-RING-SPSC
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ring_buffer_spsc.h"
+
+/* ==================== 函数原型声明 ==================== */
+static void test_spsc_init(void);
+static void test_spsc_put_get(void);
+static void test_spsc_bulk_wrap(void);
+static void test_spsc_dma_ptr(void);
+static void test_spsc_index_overflow(void);
+
+/* ==================== 测试用例计数 ==================== */
+static int g_test_passed = 0;
+static int g_test_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            g_test_passed++; \
+            printf("  ✓ %s\n", message); \
+        } else { \
+            g_test_failed++; \
+            printf("  ✗ %s (FAILED at %s:%d)\n", message, __FILE__, __LINE__); \
+        } \
+    } while(0)
+
+/* ==================== 测试用例 ==================== */
+
+/*
+ * @test: 初始化参数校验
+ */
+static void test_spsc_init(void) {
+    AegisRingBufferSpsc rb;
+    uint8_t buf[16];
+
+    printf("\n[TEST] test_spsc_init\n");
+
+    TEST_ASSERT(aegis_ring_buffer_spsc_init(NULL, buf, 16) == ERR_NULL_PTR, "空指针被拒绝");
+    TEST_ASSERT(aegis_ring_buffer_spsc_init(&rb, buf, 0) == ERR_INVALID_PARAM, "容量0被拒绝");
+    TEST_ASSERT(aegis_ring_buffer_spsc_init(&rb, buf, 12) == ERR_INVALID_PARAM, "非2的幂容量被拒绝");
+    TEST_ASSERT(aegis_ring_buffer_spsc_init(&rb, buf, 16) == ERR_OK, "2的幂容量初始化成功");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_count(&rb) == 0U, "初始数据量为0");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_free(&rb) == 16U, "初始剩余空间为容量");
+}
+
+/*
+ * @test: 单字节读写与满/空判断
+ */
+static void test_spsc_put_get(void) {
+    AegisRingBufferSpsc rb;
+    uint8_t buf[8];
+    uint8_t v = 0;
+    uint8_t i;
+    int ok = 1;
+
+    printf("\n[TEST] test_spsc_put_get\n");
+
+    (void)aegis_ring_buffer_spsc_init(&rb, buf, 8);
+
+    TEST_ASSERT(aegis_ring_buffer_spsc_get(&rb, &v) == ERR_OUT_OF_RANGE, "空缓冲区读取失败");
+
+    for (i = 0; i < 8U; i++) {
+        if (aegis_ring_buffer_spsc_put(&rb, i) != ERR_OK) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "写满8字节成功");
+    TEST_ASSERT(aegis_ring_buffer_spsc_put(&rb, 0xAA) == ERR_OUT_OF_RANGE, "已满时写入失败");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_free(&rb) == 0U, "已满时剩余空间为0");
+
+    for (i = 0; i < 8U; i++) {
+        if (aegis_ring_buffer_spsc_get(&rb, &v) != ERR_OK || v != i) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "按FIFO顺序读出");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_count(&rb) == 0U, "读空后数据量为0");
+}
+
+/*
+ * @test: 批量读写跨越回绕边界
+ */
+static void test_spsc_bulk_wrap(void) {
+    AegisRingBufferSpsc rb;
+    uint8_t buf[16];
+    uint8_t in[12];
+    uint8_t out[12];
+    uint8_t i;
+
+    printf("\n[TEST] test_spsc_bulk_wrap\n");
+
+    (void)aegis_ring_buffer_spsc_init(&rb, buf, 16);
+    for (i = 0; i < 12U; i++) {
+        in[i] = (uint8_t)(0x10U + i);
+    }
+
+    TEST_ASSERT(aegis_ring_buffer_spsc_write(&rb, in, 12) == 12U, "首次写入12字节");
+    TEST_ASSERT(aegis_ring_buffer_spsc_read(&rb, out, 10) == 10U, "读出10字节");
+
+    /* head=12, tail=10：再写12字节会跨越末尾 */
+    TEST_ASSERT(aegis_ring_buffer_spsc_write(&rb, in, 12) == 12U, "回绕写入12字节");
+    TEST_ASSERT(aegis_ring_buffer_spsc_write(&rb, in, 12) == 2U, "剩余空间不足时部分写入");
+    TEST_ASSERT(aegis_ring_buffer_spsc_read(&rb, out, 2) == 2U, "读出残留2字节");
+
+    memset(out, 0, sizeof(out));
+    TEST_ASSERT(aegis_ring_buffer_spsc_read(&rb, out, 12) == 12U, "回绕读出12字节");
+    TEST_ASSERT(memcmp(in, out, 12) == 0, "回绕数据一致");
+}
+
+/*
+ * @test: DMA 连续区指针与提交
+ */
+static void test_spsc_dma_ptr(void) {
+    AegisRingBufferSpsc rb;
+    uint8_t buf[8];
+    uint8_t* p = NULL;
+    uint8_t out[8];
+    uint16_t n;
+
+    printf("\n[TEST] test_spsc_dma_ptr\n");
+
+    (void)aegis_ring_buffer_spsc_init(&rb, buf, 8);
+    (void)aegis_ring_buffer_spsc_write(&rb, (const uint8_t*)"abcdef", 6);
+    (void)aegis_ring_buffer_spsc_read(&rb, out, 6);
+
+    n = aegis_ring_buffer_spsc_get_write_ptr(&rb, &p);
+    TEST_ASSERT(n == 2U && p == &buf[6], "连续可写区截止到末尾");
+    p[0] = 'x';
+    p[1] = 'y';
+    TEST_ASSERT(aegis_ring_buffer_spsc_commit_write(&rb, 2) == ERR_OK, "提交写入成功");
+    TEST_ASSERT(aegis_ring_buffer_spsc_commit_write(&rb, 7) == ERR_OUT_OF_RANGE, "超量提交写入被拒绝");
+
+    n = aegis_ring_buffer_spsc_get_read_ptr(&rb, &p);
+    TEST_ASSERT(n == 2U && p[0] == 'x' && p[1] == 'y', "连续可读区内容正确");
+    TEST_ASSERT(aegis_ring_buffer_spsc_commit_read(&rb, 3) == ERR_OUT_OF_RANGE, "超量提交读取被拒绝");
+    TEST_ASSERT(aegis_ring_buffer_spsc_commit_read(&rb, 2) == ERR_OK, "提交读取成功");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_count(&rb) == 0U, "提交后数据量为0");
+}
+
+/*
+ * @test: 自由递增计数跨越32位溢出
+ */
+static void test_spsc_index_overflow(void) {
+    AegisRingBufferSpsc rb;
+    uint8_t buf[8];
+    uint8_t out[6];
+
+    printf("\n[TEST] test_spsc_index_overflow\n");
+
+    (void)aegis_ring_buffer_spsc_init(&rb, buf, 8);
+    rb.head = 0xFFFFFFFDUL;
+    rb.tail = 0xFFFFFFFDUL;
+
+    TEST_ASSERT(aegis_ring_buffer_spsc_write(&rb, (const uint8_t*)"123456", 6) == 6U, "跨溢出写入6字节");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_count(&rb) == 6U, "溢出后数据量正确");
+    TEST_ASSERT(aegis_ring_buffer_spsc_get_free(&rb) == 2U, "溢出后剩余空间正确");
+    TEST_ASSERT(aegis_ring_buffer_spsc_read(&rb, out, 6) == 6U && memcmp(out, "123456", 6) == 0,
+                "跨溢出读出数据一致");
+}
+
+/* ==================== 测试入口 ==================== */
+int main(void) {
+    printf("========================================\n");
+    printf("  SPSC 环形缓冲区单元测试\n");
+    printf("========================================\n");
+
+    test_spsc_init();
+    test_spsc_put_get();
+    test_spsc_bulk_wrap();
+    test_spsc_dma_ptr();
+    test_spsc_index_overflow();
+
+    printf("\n========================================\n");
+    printf("测试结果:\n");
+    printf("  通过: %d\n", g_test_passed);
+    printf("  失败: %d\n", g_test_failed);
+    printf("========================================\n");
+
+    if (g_test_failed == 0) {
+        printf("✅ 所有测试通过!\n");
+        return 0;
+    } else {
+        printf("❌ 存在失败的测试!\n");
+        return 1;
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ * @file: test_ring_buffer_spsc_stress.c
+ * @brief: 无锁 SPSC 环形缓冲区双线程压力测试（x86_sim）
+ * @author: jack liu
+ * @req: REQ-TEST-RING-SPSC-STRESS
+ *
+ * 生产者线程交替使用 put/write/DMA提交写入递增序列，消费者线程交替使用
+ * get/read/DMA提交读取并逐字节校验；任何丢失、重复或乱序都会导致失败。
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ring_buffer_spsc.h"
+
+/* ==================== 测试配置 ==================== */
+#define STRESS_RING_SIZE    64U
+#define STRESS_TOTAL_BYTES  4000000UL
+
+typedef struct {
+    AegisRingBufferSpsc rb;
+    uint8_t storage[STRESS_RING_SIZE];
+    unsigned long errors;
+    unsigned long received;
+} StressContext;
+
+/* ==================== 函数原型声明 ==================== */
+static uint8_t seq_byte(unsigned long n);
+static void* producer_main(void* arg);
+static void* consumer_main(void* arg);
+
+static uint8_t seq_byte(unsigned long n) {
+    return (uint8_t)((n * 31UL + (n >> 8)) & 0xFFUL);
+}
+
+static void* producer_main(void* arg) {
+    StressContext* ctx = (StressContext*)arg;
+    unsigned long sent = 0;
+    unsigned long round = 0;
+    uint8_t chunk[23];
+    uint8_t* wp;
+    uint16_t i;
+    uint16_t n;
+    uint16_t want;
+
+    while (sent < STRESS_TOTAL_BYTES) {
+        switch (round % 3UL) {
+        case 0:
+            if (aegis_ring_buffer_spsc_put(&ctx->rb, seq_byte(sent)) == ERR_OK) {
+                sent++;
+            }
+            break;
+        case 1:
+            want = (uint16_t)(1UL + (round % (unsigned long)sizeof(chunk)));
+            if ((unsigned long)want > STRESS_TOTAL_BYTES - sent) {
+                want = (uint16_t)(STRESS_TOTAL_BYTES - sent);
+            }
+            for (i = 0; i < want; i++) {
+                chunk[i] = seq_byte(sent + i);
+            }
+            sent += aegis_ring_buffer_spsc_write(&ctx->rb, chunk, want);
+            break;
+        default:
+            n = aegis_ring_buffer_spsc_get_write_ptr(&ctx->rb, &wp);
+            if ((unsigned long)n > STRESS_TOTAL_BYTES - sent) {
+                n = (uint16_t)(STRESS_TOTAL_BYTES - sent);
+            }
+            for (i = 0; i < n; i++) {
+                wp[i] = seq_byte(sent + i);
+            }
+            if (n > 0U && aegis_ring_buffer_spsc_commit_write(&ctx->rb, n) == ERR_OK) {
+                sent += n;
+            }
+            break;
+        }
+
+        if (aegis_ring_buffer_spsc_get_free(&ctx->rb) == 0U) {
+            sched_yield();
+        }
+        round++;
+    }
+
+    return NULL;
+}
+
+static void* consumer_main(void* arg) {
+    StressContext* ctx = (StressContext*)arg;
+    unsigned long round = 0;
+    uint8_t chunk[19];
+    uint8_t* rp;
+    uint8_t v;
+    uint16_t i;
+    uint16_t n;
+
+    while (ctx->received < STRESS_TOTAL_BYTES) {
+        switch (round % 3UL) {
+        case 0:
+            if (aegis_ring_buffer_spsc_get(&ctx->rb, &v) == ERR_OK) {
+                if (v != seq_byte(ctx->received)) {
+                    ctx->errors++;
+                }
+                ctx->received++;
+            }
+            break;
+        case 1:
+            n = aegis_ring_buffer_spsc_read(&ctx->rb, chunk,
+                                            (uint16_t)(1UL + (round % (unsigned long)sizeof(chunk))));
+            for (i = 0; i < n; i++) {
+                if (chunk[i] != seq_byte(ctx->received + i)) {
+                    ctx->errors++;
+                }
+            }
+            ctx->received += n;
+            break;
+        default:
+            n = aegis_ring_buffer_spsc_get_read_ptr(&ctx->rb, &rp);
+            for (i = 0; i < n; i++) {
+                if (rp[i] != seq_byte(ctx->received + i)) {
+                    ctx->errors++;
+                }
+            }
+            if (n > 0U && aegis_ring_buffer_spsc_commit_read(&ctx->rb, n) == ERR_OK) {
+                ctx->received += n;
+            }
+            break;
+        }
+
+        if (aegis_ring_buffer_spsc_get_count(&ctx->rb) == 0U) {
+            sched_yield();
+        }
+        round++;
+    }
+
+    return NULL;
+}
+
+/* ==================== 测试入口 ==================== */
+int main(void) {
+    static StressContext ctx;
+    pthread_t producer;
+    pthread_t consumer;
+
+    printf("========================================\n");
+    printf("  SPSC 环形缓冲区双线程压力测试\n");
+    printf("========================================\n");
+
+    if (aegis_ring_buffer_spsc_init(&ctx.rb, ctx.storage, (uint16_t)STRESS_RING_SIZE) != ERR_OK) {
+        printf("❌ 初始化失败\n");
+        return 1;
+    }
+
+    if (pthread_create(&consumer, NULL, consumer_main, &ctx) != 0 ||
+        pthread_create(&producer, NULL, producer_main, &ctx) != 0) {
+        printf("❌ 创建线程失败\n");
+        return 1;
+    }
+
+    (void)pthread_join(producer, NULL);
+    (void)pthread_join(consumer, NULL);
+
+    printf("  传输字节: %lu\n", ctx.received);
+    printf("  校验错误: %lu\n", ctx.errors);
+
+    if (ctx.errors == 0UL && ctx.received == STRESS_TOTAL_BYTES &&
+        aegis_ring_buffer_spsc_get_count(&ctx.rb) == 0U) {
+        printf("✅ 压力测试通过!\n");
+        return 0;
+    }
+
+    printf("❌ 压力测试失败!\n");
+    return 1;
+}
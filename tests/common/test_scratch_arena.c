@@ -0,0 +1,84 @@
+/*
+ * @file: test_scratch_arena.c
+ * @brief: 临时对象暂存区单元测试
+ * @author: jack liu
+ * @req: REQ-TEST-SCRATCH-ARENA
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "scratch_arena.h"
+
+#define TEST_ARENA_SIZE  128U
+
+int main(void) {
+    static uint8_t buffer[TEST_ARENA_SIZE + 1U];
+    AegisScratchArena arena;
+    AegisScratchArenaStats stats;
+    AegisScratchArenaMark mark;
+    uint8_t* p;
+    uint8_t* q;
+    uint8_t* r;
+
+    printf("========================================\n");
+    printf("  暂存区单元测试\n");
+    printf("========================================\n");
+
+    /* 1. 参数校验 */
+    assert(aegis_scratch_arena_init(NULL, buffer, TEST_ARENA_SIZE) == ERR_NULL_PTR);
+    assert(aegis_scratch_arena_init(&arena, NULL, TEST_ARENA_SIZE) == ERR_NULL_PTR);
+    assert(aegis_scratch_arena_init(&arena, buffer, 0U) == ERR_INVALID_PARAM);
+    assert(aegis_scratch_arena_alloc(NULL, 1U) == NULL);
+
+    /* 缓冲区故意错开1字节：对齐按实际地址计算 */
+    assert(aegis_scratch_arena_init(&arena, buffer + 1, TEST_ARENA_SIZE) == ERR_OK);
+    assert(aegis_scratch_arena_alloc(&arena, 0U) == NULL);
+    printf("  ✓ 参数校验\n");
+
+    /* 2. 分配按 SCRATCH_ARENA_ALIGN 对齐，互不重叠 */
+    p = (uint8_t*)aegis_scratch_arena_alloc(&arena, 3U);
+    q = (uint8_t*)aegis_scratch_arena_alloc(&arena, 10U);
+    assert(p != NULL && q != NULL);
+    assert(((ulong_t)p & ((ulong_t)SCRATCH_ARENA_ALIGN - 1UL)) == 0UL);
+    assert(((ulong_t)q & ((ulong_t)SCRATCH_ARENA_ALIGN - 1UL)) == 0UL);
+    assert(q >= p + 3);
+    assert(p >= buffer + 1 && q + 10 <= buffer + 1 + TEST_ARENA_SIZE);
+    memset(p, 0x11, 3U);
+    memset(q, 0x22, 10U);
+    assert(p[2] == 0x11U && q[0] == 0x22U);
+    printf("  ✓ 对齐分配\n");
+
+    /* 3. 标记与回退：回退后重新分配得到同一地址 */
+    mark = aegis_scratch_arena_mark(&arena);
+    r = (uint8_t*)aegis_scratch_arena_alloc(&arena, 32U);
+    assert(r != NULL);
+    assert(aegis_scratch_arena_release(&arena, mark) == ERR_OK);
+    assert((uint8_t*)aegis_scratch_arena_alloc(&arena, 32U) == r);
+    assert(aegis_scratch_arena_release(&arena, mark) == ERR_OK);
+    assert(aegis_scratch_arena_release(&arena, arena.used + 1U) == ERR_OUT_OF_RANGE);
+    printf("  ✓ 标记与回退\n");
+
+    /* 4. 空间不足返回 NULL 并计数，不改变已用量 */
+    mark = aegis_scratch_arena_mark(&arena);
+    assert(aegis_scratch_arena_alloc(&arena, TEST_ARENA_SIZE) == NULL);
+    assert(aegis_scratch_arena_mark(&arena) == mark);
+    r = (uint8_t*)aegis_scratch_arena_alloc(&arena, TEST_ARENA_SIZE - mark - (uint32_t)SCRATCH_ARENA_ALIGN);
+    assert(r != NULL);
+    assert(aegis_scratch_arena_get_stats(&arena, &stats) == ERR_OK);
+    assert(stats.capacity == TEST_ARENA_SIZE && stats.failures == 1U);
+    assert(stats.used <= TEST_ARENA_SIZE && stats.peak == stats.used && stats.high_water == stats.used);
+    printf("  ✓ 空间不足（已用 %lu / %lu 字节）\n", (unsigned long)stats.used, (unsigned long)stats.capacity);
+
+    /* 5. 整体复位：清零本轮峰值，保留历史高水位 */
+    assert(aegis_scratch_arena_reset(&arena) == ERR_OK);
+    assert(aegis_scratch_arena_get_stats(&arena, &stats) == ERR_OK);
+    assert(stats.used == 0U && stats.peak == 0U && stats.high_water > 0U);
+    assert((uint8_t*)aegis_scratch_arena_alloc(&arena, 3U) == p);
+    assert(aegis_scratch_arena_get_stats(&arena, &stats) == ERR_OK);
+    assert(stats.peak < stats.high_water);
+    printf("  ✓ 整体复位与高水位统计\n");
+
+    printf("✅ 所有测试通过!\n");
+    return 0;
+}
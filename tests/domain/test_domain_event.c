@@ -62,6 +62,37 @@ static AegisEventHandlerResult on_async_all(const AegisDomainEvent* event, void*
     return EVENT_HANDLER_OK;
 }
 
+typedef struct {
+    uint8_t order[8];
+    uint8_t calls;
+} OrderLog;
+
+typedef struct {
+    OrderLog* log;
+    uint8_t tag;
+} OrderCtx;
+
+static AegisEventHandlerResult on_record_order(const AegisDomainEvent* event, void* ctx) {
+    OrderCtx* c;
+    if (event == NULL || ctx == NULL) {
+        return EVENT_HANDLER_ERROR;
+    }
+    c = (OrderCtx*)ctx;
+    if (c->log->calls < (uint8_t)sizeof(c->log->order)) {
+        c->log->order[c->log->calls] = c->tag;
+    }
+    c->log->calls++;
+    return EVENT_HANDLER_OK;
+}
+
+static AegisEventHandlerResult on_record_pointer(const AegisDomainEvent* event, void* ctx) {
+    if (event == NULL || ctx == NULL) {
+        return EVENT_HANDLER_ERROR;
+    }
+    *(const AegisDomainEvent**)ctx = event;
+    return EVENT_HANDLER_OK;
+}
+
 static void test_event_bus_init(void) {
     AegisErrorCode ret;
     AegisDomainEventBus bus;
@@ -201,6 +232,153 @@ static void test_event_history(void) {
     assert(latest->type == DOMAIN_EVENT_ENTITY_CREATED);
 }
 
+/*
+ * @test: 按事件类型索引 + priority 排序（通配订阅者参与归并，同优先级按订阅表顺序）
+ */
+static void test_priority_order_and_wildcard_merge(void) {
+    AegisErrorCode ret;
+    AegisDomainEventBus bus;
+    AegisDomainEvent event;
+    OrderLog log;
+    OrderCtx ctx[6];
+    AegisEventSubscription subs[6];
+    uint8_t i;
+
+    static const AegisDomainEventType types[6] = {
+        DOMAIN_EVENT_ENTITY_CREATED, DOMAIN_EVENT_NONE, DOMAIN_EVENT_ENTITY_CREATED,
+        DOMAIN_EVENT_ENTITY_UPDATED, DOMAIN_EVENT_NONE, DOMAIN_EVENT_ENTITY_CREATED
+    };
+    static const uint8_t priorities[6] = { 20U, 10U, 5U, 0U, 20U, 30U };
+
+    printf("\n[TEST] test_priority_order_and_wildcard_merge\n");
+
+    memset(&log, 0, sizeof(log));
+    for (i = 0; i < 6U; i++) {
+        ctx[i].log = &log;
+        ctx[i].tag = i;
+        subs[i].event_type = types[i];
+        subs[i].handler = on_record_order;
+        subs[i].ctx = &ctx[i];
+        subs[i].is_sync = TRUE;
+        subs[i].priority = priorities[i];
+    }
+    /* 异步订阅者不参与同步分发 */
+    subs[5].is_sync = FALSE;
+
+    ret = aegis_domain_event_bus_init(&bus, NULL, subs, 6);
+    assert(ret == ERR_OK);
+
+    memset(&event, 0, sizeof(event));
+    event.type = DOMAIN_EVENT_ENTITY_CREATED;
+    ret = aegis_domain_event_publish(&bus, &event);
+    assert(ret == ERR_OK);
+
+    /* 同步：2(p5) -> 1(*,p10) -> 0(p20) -> 4(*,p20)；UPDATED 订阅者(3)不被调用 */
+    assert(log.calls == 4U);
+    assert(log.order[0] == 2U && log.order[1] == 1U && log.order[2] == 0U && log.order[3] == 4U);
+
+    assert(aegis_domain_event_process(&bus, 0) == 1U);
+    assert(log.calls == 5U && log.order[4] == 5U);
+
+    /* 无具体订阅的类型只分发给通配订阅者 */
+    memset(&log, 0, sizeof(log));
+    event.type = (AegisDomainEventType)(DOMAIN_EVENT_USER_BASE + 7);
+    ret = aegis_domain_event_publish(&bus, &event);
+    assert(ret == ERR_OK);
+    assert(log.calls == 2U && log.order[0] == 1U && log.order[1] == 4U);
+
+    /* UPDATED：3(p0) 先于通配订阅者 */
+    memset(&log, 0, sizeof(log));
+    event.type = DOMAIN_EVENT_ENTITY_UPDATED;
+    ret = aegis_domain_event_publish(&bus, &event);
+    assert(ret == ERR_OK);
+    assert(log.calls == 3U && log.order[0] == 3U && log.order[1] == 1U && log.order[2] == 4U);
+
+    (void)ret;
+}
+
+/*
+ * @test: 零拷贝发布：槽位内原地构造，历史/异步处理器引用同一槽位
+ */
+static void test_zero_copy_publish(void) {
+    AegisErrorCode ret;
+    AegisDomainEventBus bus;
+    AegisDomainEvent* ev;
+    AegisDomainEvent* held[DOMAIN_EVENT_SLOT_COUNT];
+    AegisDomainEvent outside;
+    const AegisDomainEvent* seen_sync;
+    const AegisDomainEvent* seen_async;
+    AegisEventSubscription subs[2];
+    uint8_t pending;
+    uint32_t processed;
+    uint8_t i;
+
+    printf("\n[TEST] test_zero_copy_publish\n");
+
+    seen_sync = NULL;
+    seen_async = NULL;
+    subs[0].event_type = DOMAIN_EVENT_ENTITY_UPDATED;
+    subs[0].handler = on_record_pointer;
+    subs[0].ctx = (void*)&seen_sync;
+    subs[0].is_sync = TRUE;
+    subs[0].priority = 0U;
+    subs[1] = subs[0];
+    subs[1].ctx = (void*)&seen_async;
+    subs[1].is_sync = FALSE;
+
+    ret = aegis_domain_event_bus_init(&bus, NULL, subs, 2);
+    assert(ret == ERR_OK);
+
+    ret = aegis_domain_event_reserve(&bus, &ev);
+    assert(ret == ERR_OK && ev != NULL);
+    assert(ev->type == DOMAIN_EVENT_NONE && ev->timestamp == 0U);
+    ev->type = DOMAIN_EVENT_ENTITY_UPDATED;
+    ev->aggregate_id = 42U;
+    ev->data.custom_data[0] = 0xA5U;
+    ret = aegis_domain_event_commit(&bus, ev);
+    assert(ret == ERR_OK);
+
+    /* 同步处理器、历史记录与异步处理器看到的都是同一槽位 */
+    assert(seen_sync == ev);
+    assert(aegis_domain_event_get_history(&bus, 0) == ev);
+    assert(ev->event_id == 1U);
+    assert(aegis_domain_event_process(&bus, 0) == 1U);
+    assert(seen_async == ev);
+    assert(seen_async->data.custom_data[0] == 0xA5U);
+
+    /* 重复提交 / 非本总线指针 */
+    assert(aegis_domain_event_commit(&bus, ev) == ERR_INVALID_STATE);
+    assert(aegis_domain_event_commit(&bus, &outside) == ERR_INVALID_PARAM);
+    assert(aegis_domain_event_cancel(&bus, ev) == ERR_INVALID_STATE);
+
+    /* 作废的槽位不入历史、不入队 */
+    ret = aegis_domain_event_reserve(&bus, &ev);
+    assert(ret == ERR_OK);
+    ev->type = DOMAIN_EVENT_ENTITY_UPDATED;
+    assert(aegis_domain_event_cancel(&bus, ev) == ERR_OK);
+    ret = aegis_domain_event_get_stats(&bus, &pending, &processed);
+    assert(ret == ERR_OK && pending == 0U);
+    assert(aegis_domain_event_get_history(&bus, 1) == NULL);
+
+    /* 槽位耗尽后 reserve 失败，释放后恢复 */
+    for (i = 0; i < (uint8_t)DOMAIN_EVENT_SLOT_COUNT; i++) {
+        held[i] = NULL;
+        if (aegis_domain_event_reserve(&bus, &held[i]) != ERR_OK) {
+            break;
+        }
+    }
+    assert(i == (uint8_t)(DOMAIN_EVENT_SLOT_COUNT - 1));   /* 1 个槽位仍被历史引用 */
+    assert(aegis_domain_event_reserve(&bus, &ev) == ERR_OUT_OF_RANGE);
+    while (i > 0U) {
+        i--;
+        assert(aegis_domain_event_cancel(&bus, held[i]) == ERR_OK);
+    }
+    assert(aegis_domain_event_reserve(&bus, &ev) == ERR_OK);
+    assert(aegis_domain_event_cancel(&bus, ev) == ERR_OK);
+
+    (void)ret;
+}
+
 int main(void) {
     printf("========================================\n");
     printf("  领域事件总线单元测试\n");
@@ -209,6 +387,8 @@ int main(void) {
     test_event_bus_init();
     test_sync_and_async_dispatch();
     test_event_history();
+    test_priority_order_and_wildcard_merge();
+    test_zero_copy_publish();
 
     printf("\n✅ aegis_domain_event tests finished.\n");
     return 0;
@@ -0,0 +1,251 @@
+/*
+ * @file: bench_repository.c
+ * @brief: 内存仓储按ID查找 / 按类型计数延迟基准测试（32 ~ 4096 个实体）
+ * @author: jack liu
+ * @req: REQ-TEST-BENCH-REPO
+ *
+ * 对比：
+ * 1. 旧实现的临界区内线性扫描（在此按公开仓储字段复现）
+ * 2. read_if.get（临界区 + 实体ID哈希索引）
+ * 3. 旧实现的按类型计数（逐实体读取交织在 payload 之间的头部）
+ * 4. read_if.count_by_type（默认布局：类型链表计数；SoA 布局：扫描稠密类型数组）
+ * 5. 20 个实体的扫描式更新：逐个 update（每次一个临界区 + 时间戳回调）与一次 apply_batch 对比
+ * 6. 修改一个 4 字节字段：整实体 update 与 update_payload 对比
+ *
+ * 本目标以 REPOSITORY_MAX_ENTITIES=4096 单独编译 infrastructure_repository_inmem.c；
+ * bench_repository_soa 另以 REPOSITORY_LAYOUT_SOA=1 编译同一份源码。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "infrastructure_repository_inmem.h"
+#include "key_filter.h"
+#include "critical.h"
+#include "bench_cycles.h"
+
+/* ==================== 函数原型声明 ==================== */
+static AegisErrorCode legacy_get(const AegisInfrastructureRepositoryInmem* repo,
+                                 AegisEntityId entity_id,
+                                 AegisDomainEntity** entity);
+static uint8_t legacy_count_by_type(const AegisInfrastructureRepositoryInmem* repo, AegisEntityType entity_type);
+static uint32_t bench_now_ms(void* ctx);
+static int bench_entities(uint16_t entity_count);
+
+#define BENCH_REPO_OPS  200000UL
+#define BENCH_SCAN_OPS  2000UL
+#define BENCH_SWEEP_OPS 20000UL
+
+/* 一次扫描更新的实体数（32 个实体时打散选取仍不重复） */
+#define BENCH_SWEEP     20U
+
+/* 实体轮流分布在4个类型上 */
+#define BENCH_TYPE_COUNT   4U
+#define BENCH_TYPE_OF(i)   ((AegisEntityType)(1U + (uint16_t)(i) % BENCH_TYPE_COUNT))
+
+/* 查找顺序打散，避免线性扫描总是命中表头 */
+#define BENCH_PICK(op, n)  ((uint16_t)(((op) * 7919UL) % (unsigned long)(n)))
+
+/*
+ * @brief: 旧实现：临界区内逐项比较实体ID
+ */
+static AegisErrorCode legacy_get(const AegisInfrastructureRepositoryInmem* repo,
+                                 AegisEntityId entity_id,
+                                 AegisDomainEntity** entity) {
+    AegisInfrastructureRepositorySlot i;
+    AegisErrorCode ret = ERR_NOT_FOUND;
+
+    ENTER_CRITICAL();
+    for (i = 0; i < repo->entity_count; i++) {
+        if (repo->entity_pool[i].base.is_valid && repo->entity_pool[i].base.id == entity_id) {
+            *entity = (AegisDomainEntity*)&repo->entity_pool[i];
+            ret = ERR_OK;
+            break;
+        }
+    }
+    EXIT_CRITICAL();
+
+    return ret;
+}
+
+/*
+ * @brief: 旧实现：临界区内逐实体比较有效位与类型
+ */
+static uint8_t legacy_count_by_type(const AegisInfrastructureRepositoryInmem* repo, AegisEntityType entity_type) {
+    AegisInfrastructureRepositorySlot i;
+    uint8_t type_count = 0U;
+
+    ENTER_CRITICAL();
+    for (i = 0; i < repo->entity_count; i++) {
+        if (repo->entity_pool[i].base.is_valid &&
+            repo->entity_pool[i].base.type == entity_type &&
+            type_count < 0xFFU) {
+            type_count++;
+        }
+    }
+    EXIT_CRITICAL();
+
+    return type_count;
+}
+
+/*
+ * @brief: 时间戳回调（计数器，模拟读取时钟）
+ */
+static uint32_t bench_now_ms(void* ctx) {
+    volatile uint32_t* tick = (volatile uint32_t*)ctx;
+    *tick = *tick + 1U;
+    return *tick;
+}
+
+static int bench_entities(uint16_t entity_count) {
+    static AegisInfrastructureRepositoryInmem repo;
+    static AegisEntityId ids[REPOSITORY_MAX_ENTITIES];
+    static AegisDomainEntity sweep[BENCH_SWEEP];
+    AegisDomainRepositoryOp ops[BENCH_SWEEP];
+    static volatile uint32_t tick;
+    const AegisDomainRepositoryWriteInterface* write_repo;
+    const AegisDomainRepositoryReadInterface* read_repo;
+    AegisDomainEntity entity;
+    AegisDomainEntity* found;
+    unsigned long op;
+    uint16_t i;
+    double t0;
+    double legacy_total;
+    double indexed_total;
+    uint8_t expected_count;
+    uint8_t count;
+
+    tick = 0U;
+    (void)aegis_infrastructure_repository_inmem_init(&repo, bench_now_ms, (void*)&tick);
+    write_repo = aegis_infrastructure_repository_inmem_write(&repo);
+    read_repo = aegis_infrastructure_repository_inmem_read(&repo);
+    (void)write_repo->init(write_repo);
+
+    for (i = 0; i < entity_count; i++) {
+        memset(&entity, 0, sizeof(entity));
+        (void)aegis_domain_entity_init(&entity.base, ENTITY_ID_INVALID, BENCH_TYPE_OF(i));
+        if (write_repo->create(write_repo, &entity) != ERR_OK) {
+            printf("  ✗ 创建失败: %u\n", (unsigned int)i);
+            return 1;
+        }
+        ids[i] = entity.base.id;
+    }
+
+    /* 正确性：两种实现命中同一槽位 */
+    for (i = 0; i < entity_count; i++) {
+        AegisDomainEntity* expected = NULL;
+        found = NULL;
+        if (read_repo->get(read_repo, ids[i], &found) != ERR_OK ||
+            legacy_get(&repo, ids[i], &expected) != ERR_OK ||
+            found != expected) {
+            printf("  ✗ 查找不一致: id=%u\n", (unsigned int)ids[i]);
+            return 1;
+        }
+    }
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_REPO_OPS; op++) {
+        (void)legacy_get(&repo, ids[BENCH_PICK(op, entity_count)], &found);
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_REPO_OPS; op++) {
+        (void)read_repo->get(read_repo, ids[BENCH_PICK(op, entity_count)], &found);
+    }
+    indexed_total = bench_cycles_now() - t0;
+
+    printf("  -- %u entities --\n", (unsigned int)entity_count);
+    bench_cycles_report("get: legacy linear scan", legacy_total, BENCH_REPO_OPS);
+    bench_cycles_report("get: id hash index", indexed_total, BENCH_REPO_OPS);
+
+    /* 正确性：两种计数一致 */
+    expected_count = legacy_count_by_type(&repo, BENCH_TYPE_OF(1));
+    if (read_repo->count_by_type(read_repo, BENCH_TYPE_OF(1), &count) != ERR_OK || count != expected_count) {
+        printf("  ✗ 计数不一致: %u / %u\n", (unsigned int)count, (unsigned int)expected_count);
+        return 1;
+    }
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_SCAN_OPS; op++) {
+        count = legacy_count_by_type(&repo, BENCH_TYPE_OF(op));
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_SCAN_OPS; op++) {
+        (void)read_repo->count_by_type(read_repo, BENCH_TYPE_OF(op), &count);
+    }
+    indexed_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("count_by_type: legacy AoS scan", legacy_total, BENCH_SCAN_OPS);
+    bench_cycles_report(REPOSITORY_LAYOUT_SOA ? "count_by_type: SoA key filter" : "count_by_type: type lists",
+                        indexed_total, BENCH_SCAN_OPS);
+
+    /* 扫描更新：打散选取 BENCH_SWEEP 个实体，逐个 update 与整批 apply_batch 对比 */
+    for (i = 0; i < BENCH_SWEEP; i++) {
+        if (read_repo->snapshot(read_repo, ids[BENCH_PICK(i, entity_count)], &sweep[i]) != ERR_OK) {
+            printf("  ✗ 快照失败: id=%u\n", (unsigned int)ids[BENCH_PICK(i, entity_count)]);
+            return 1;
+        }
+        ops[i].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+        ops[i].entity = &sweep[i];
+        ops[i].entity_id = sweep[i].base.id;
+    }
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_SWEEP_OPS; op++) {
+        for (i = 0; i < BENCH_SWEEP; i++) {
+            (void)write_repo->update(write_repo, &sweep[i]);
+        }
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_SWEEP_OPS; op++) {
+        if (write_repo->apply_batch(write_repo, ops, (uint8_t)BENCH_SWEEP, NULL) != ERR_OK) {
+            printf("  ✗ 批量更新失败\n");
+            return 1;
+        }
+    }
+    indexed_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("20-entity sweep: update x20", legacy_total, BENCH_SWEEP_OPS);
+    bench_cycles_report("20-entity sweep: apply_batch", indexed_total, BENCH_SWEEP_OPS);
+
+    /* 单字段修改：update 拷贝整个实体，update_payload 只拷贝4字节并记录脏块 */
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_REPO_OPS; op++) {
+        sweep[0].payload[4] = (uint8_t)op;
+        (void)write_repo->update(write_repo, &sweep[0]);
+    }
+    legacy_total = bench_cycles_now() - t0;
+
+    t0 = bench_cycles_now();
+    for (op = 0; op < BENCH_REPO_OPS; op++) {
+        sweep[0].payload[4] = (uint8_t)op;
+        (void)write_repo->update_payload(write_repo, sweep[0].base.id, 4U, &sweep[0].payload[4], 4U);
+    }
+    indexed_total = bench_cycles_now() - t0;
+
+    bench_cycles_report("4-byte field: update", legacy_total, BENCH_REPO_OPS);
+    bench_cycles_report("4-byte field: update_payload", indexed_total, BENCH_REPO_OPS);
+
+    return 0;
+}
+
+/* ==================== 入口 ==================== */
+int main(void) {
+    int failed = 0;
+    uint32_t n;
+
+    printf("========================================\n");
+    printf("  内存仓储查找基准测试（%s 布局，过滤核 %s）\n",
+           REPOSITORY_LAYOUT_SOA ? "SoA" : "默认", aegis_key_filter_kernel());
+    printf("========================================\n");
+
+    for (n = 32U; n <= (uint32_t)REPOSITORY_MAX_ENTITIES; n *= 2U) {
+        failed |= bench_entities((uint16_t)n);
+    }
+
+    return failed;
+}
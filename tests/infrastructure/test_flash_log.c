@@ -0,0 +1,319 @@
+/*
+ * @file: test_flash_log.c
+ * @brief: Flash 追加日志单元测试（页轮转、重新挂载、写入中掉电、未结束记录组、检查点回收、写满、预擦除与统计）
+ * @author: jack liu
+ * @req: REQ-TEST-FLASH-LOG
+ * @design: DES-TEST-FLASH-LOG
+ * @asil: ASIL-B
+ *
+ * 使用 x86_sim 的文件模拟 Flash（当前目录下的 test_flash_log.bin）。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "infrastructure_flash_log.h"
+
+#define TEST_FLASH_PATH   "test_flash_log.bin"
+#define TEST_PAGE_SIZE    256U
+#define TEST_PAGE_COUNT   6U
+#define TEST_LAYOUT       ((uint16_t)0x0101U)
+#define TEST_KIND         ((uint8_t)0x10U)
+
+/* 记录 i 的数据：长度 1 ~ 40 变化，内容由 i 决定 */
+#define TEST_LEN(i)       ((uint16_t)(1U + ((i) * 7U) % 40U))
+
+static AegisHalFlash g_flash;
+
+static void flash_open(bool_t fresh) {
+    AegisHalFlashConfig cfg;
+
+    if (fresh) {
+        (void)remove(TEST_FLASH_PATH);
+    }
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.backing_path = TEST_FLASH_PATH;
+    cfg.page_size = TEST_PAGE_SIZE;
+    cfg.page_count = (uint16_t)TEST_PAGE_COUNT;
+    assert(aegis_hal_flash_init(&g_flash, &cfg) == ERR_OK);
+}
+
+static void flash_close(void) {
+    assert(aegis_hal_flash_deinit(&g_flash) == ERR_OK);
+}
+
+/* 模拟重启：关闭并重新映射 Flash，用新实例挂载 */
+static void remount(AegisInfrastructureFlashLog* log) {
+    flash_close();
+    flash_open(FALSE);
+    assert(aegis_infrastructure_flash_log_init(log, &g_flash, TEST_LAYOUT) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_mount(log) == ERR_OK);
+}
+
+static void fill(uint8_t* buf, uint32_t i) {
+    uint16_t k;
+
+    for (k = 0; k < TEST_LEN(i); k++) {
+        buf[k] = (uint8_t)(i * 31U + k);
+    }
+}
+
+static AegisErrorCode append_n(AegisInfrastructureFlashLog* log, uint32_t first, uint32_t count) {
+    uint8_t buf[FLASH_LOG_DATA_MAX];
+    uint32_t i;
+    AegisErrorCode ret;
+
+    for (i = first; i < first + count; i++) {
+        fill(buf, i);
+        ret = aegis_infrastructure_flash_log_append(log, TEST_KIND, 0U, buf, TEST_LEN(i));
+        if (ret != ERR_OK) {
+            return ret;
+        }
+    }
+    return ERR_OK;
+}
+
+/* 从尾指针读到结尾，校验为记录 first .. first+count-1，返回读到的条数 */
+static uint32_t verify_from_tail(const AegisInfrastructureFlashLog* log, uint32_t first) {
+    uint8_t buf[FLASH_LOG_DATA_MAX];
+    uint8_t expect[FLASH_LOG_DATA_MAX];
+    AegisInfrastructureFlashLogPos cursor;
+    AegisInfrastructureFlashLogRecord record;
+    uint32_t n = 0U;
+
+    assert(aegis_infrastructure_flash_log_cursor(log, &cursor) == ERR_OK);
+    while (aegis_infrastructure_flash_log_read(log, &cursor, &record, buf, (uint16_t)sizeof(buf)) == ERR_OK) {
+        if (record.kind != TEST_KIND) {
+            continue;
+        }
+        fill(expect, first + n);
+        assert(record.len == TEST_LEN(first + n));
+        assert(memcmp(buf, expect, record.len) == 0);
+        n++;
+    }
+    return n;
+}
+
+static uint8_t last_kind(const AegisInfrastructureFlashLog* log) {
+    uint8_t buf[FLASH_LOG_DATA_MAX];
+    AegisInfrastructureFlashLogPos cursor;
+    AegisInfrastructureFlashLogRecord record;
+    uint8_t kind = 0U;
+
+    assert(aegis_infrastructure_flash_log_cursor(log, &cursor) == ERR_OK);
+    while (aegis_infrastructure_flash_log_read(log, &cursor, &record, buf, (uint16_t)sizeof(buf)) == ERR_OK) {
+        kind = record.kind;
+    }
+    return kind;
+}
+
+int main(void) {
+    static AegisInfrastructureFlashLog log;
+    uint8_t buf[FLASH_LOG_DATA_MAX];
+    uint8_t garbage[16];
+    AegisInfrastructureFlashLogPos cursor;
+    AegisInfrastructureFlashLogRecord record;
+    AegisInfrastructureFlashLogStats stats;
+    AegisHalFlash small;
+    uint16_t free_before;
+    uint32_t acked;
+    uint32_t bytes;
+    uint32_t cut;
+    uint32_t head_seq;
+    uint32_t i;
+
+    printf("========================================\n");
+    printf("  Flash 追加日志测试\n");
+    printf("========================================\n");
+
+    /* 1. 参数校验与空白 Flash 自动格式化 */
+    flash_open(TRUE);
+    small = g_flash;
+    small.page_count = 1U;
+    assert(aegis_infrastructure_flash_log_init(&log, &small, TEST_LAYOUT) == ERR_INVALID_PARAM);
+    small = g_flash;
+    small.page_size = 64U;
+    assert(aegis_infrastructure_flash_log_init(&log, &small, TEST_LAYOUT) == ERR_INVALID_PARAM);
+    assert(aegis_infrastructure_flash_log_init(NULL, &g_flash, TEST_LAYOUT) == ERR_NULL_PTR);
+
+    assert(aegis_infrastructure_flash_log_init(&log, &g_flash, TEST_LAYOUT) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_append(&log, TEST_KIND, 0U, buf, 1U) == ERR_NOT_INITIALIZED);
+    assert(aegis_infrastructure_flash_log_mount(&log) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_free_pages(&log) == (uint16_t)(TEST_PAGE_COUNT - 1U));
+    assert(aegis_infrastructure_flash_log_cursor(&log, &cursor) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_read(&log, &cursor, &record, buf, (uint16_t)sizeof(buf)) == ERR_EMPTY);
+    assert(aegis_infrastructure_flash_log_read(&log, &cursor, &record, buf, 4U) == ERR_INVALID_PARAM);
+    assert(aegis_infrastructure_flash_log_append(&log, TEST_KIND, 0U, buf, (uint16_t)(FLASH_LOG_DATA_MAX + 1U)) == ERR_INVALID_PARAM);
+    assert(aegis_infrastructure_flash_log_append(&log, 0xFFU, 0U, buf, 1U) == ERR_INVALID_PARAM);
+    printf("  ✓ 参数校验与自动格式化\n");
+
+    /* 2. 跨页追加，读回与重新挂载后一致 */
+    assert(append_n(&log, 0U, 20U) == ERR_OK);
+    assert(log.head.seq > 1U);
+    assert(verify_from_tail(&log, 0U) == 20U);
+    head_seq = log.head.seq;
+    remount(&log);
+    assert(log.head.seq == head_seq);
+    assert(verify_from_tail(&log, 0U) == 20U);
+    assert(append_n(&log, 20U, 3U) == ERR_OK);
+    assert(verify_from_tail(&log, 0U) == 23U);
+    printf("  ✓ 页轮转与重新挂载\n");
+
+    /* 3. 写入中掉电：结尾残留半条记录，挂载后丢弃并改写到新页 */
+    memset(garbage, 0x5A, sizeof(garbage));
+    assert(g_flash.program(&g_flash, (uint32_t)log.head.page * TEST_PAGE_SIZE + log.head.offset,
+                           garbage, (uint32_t)sizeof(garbage)) == ERR_OK);
+    head_seq = log.head.seq;
+    remount(&log);
+    assert(log.head.seq == head_seq && log.head.offset == TEST_PAGE_SIZE);
+    assert(verify_from_tail(&log, 0U) == 23U);
+    assert(append_n(&log, 23U, 1U) == ERR_OK);
+    assert(log.head.seq == head_seq + 1U);
+    remount(&log);
+    assert(verify_from_tail(&log, 0U) == 24U);
+    printf("  ✓ 写入中掉电的记录被丢弃\n");
+
+    /* 4. 未结束的记录组：挂载时补写 ABORT */
+    assert(aegis_infrastructure_flash_log_append(&log, TEST_KIND, FLASH_LOG_FLAG_GROUP, buf, 4U) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_append(&log, TEST_KIND, FLASH_LOG_FLAG_GROUP, buf, 4U) == ERR_OK);
+    remount(&log);
+    assert(last_kind(&log) == FLASH_LOG_KIND_ABORT);
+    assert(aegis_infrastructure_flash_log_append(&log, TEST_KIND, FLASH_LOG_FLAG_GROUP, buf, 4U) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_append(&log, FLASH_LOG_KIND_COMMIT, 0U, NULL, 0U) == ERR_OK);
+    remount(&log);
+    assert(last_kind(&log) == FLASH_LOG_KIND_COMMIT);
+    printf("  ✓ 未结束的记录组自动 ABORT\n");
+
+    /* 5. 检查点：尾指针前移、旧页回收，重新挂载后尾指针保持 */
+    flash_close();
+    flash_open(TRUE);
+    assert(aegis_infrastructure_flash_log_init(&log, &g_flash, TEST_LAYOUT) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_mount(&log) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_checkpoint_commit(&log) == ERR_INVALID_STATE);
+    assert(append_n(&log, 0U, 20U) == ERR_OK);
+    free_before = aegis_infrastructure_flash_log_free_pages(&log);
+    assert(aegis_infrastructure_flash_log_checkpoint_begin(&log, NULL, 0U) == ERR_OK);
+    assert(append_n(&log, 100U, 2U) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_checkpoint_commit(&log) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_free_pages(&log) > free_before);
+    assert(verify_from_tail(&log, 100U) == 2U);
+    remount(&log);
+    assert(verify_from_tail(&log, 100U) == 2U);
+    assert(aegis_infrastructure_flash_log_cursor(&log, &cursor) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_read(&log, &cursor, &record, buf, (uint16_t)sizeof(buf)) == ERR_OK);
+    assert(record.kind == FLASH_LOG_KIND_CKPT_BEGIN);
+    printf("  ✓ 检查点回收旧页\n");
+
+    /* 6. 反复检查点使写入位置绕环多圈 */
+    for (i = 0; i < 40U; i++) {
+        assert(append_n(&log, 200U + i * 8U, 8U) == ERR_OK);
+        assert(aegis_infrastructure_flash_log_checkpoint_begin(&log, NULL, 0U) == ERR_OK);
+        assert(append_n(&log, 1000U + i, 1U) == ERR_OK);
+        assert(aegis_infrastructure_flash_log_checkpoint_commit(&log) == ERR_OK);
+    }
+    assert(log.head.seq > 3U * TEST_PAGE_COUNT);
+    remount(&log);
+    assert(verify_from_tail(&log, 1039U) == 1U);
+    printf("  ✓ 绕环后挂载\n");
+
+    /* 7. 不写检查点时写满 */
+    i = 0U;
+    while (append_n(&log, i, 1U) == ERR_OK) {
+        i++;
+        assert(i < 1000U);
+    }
+    assert(append_n(&log, i, 1U) == ERR_DOMAIN_FULL);
+    assert(aegis_infrastructure_flash_log_free_pages(&log) == 0U);
+    remount(&log);
+    assert(append_n(&log, i, 1U) == ERR_DOMAIN_FULL);
+    printf("  ✓ 写满返回 ERR_DOMAIN_FULL\n");
+
+    /* 8. 布局版本不符拒绝挂载，格式化后可用 */
+    assert(aegis_infrastructure_flash_log_init(&log, &g_flash, (uint16_t)(TEST_LAYOUT + 1U)) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_mount(&log) == ERR_INVALID_STATE);
+    assert(aegis_infrastructure_flash_log_format(&log) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_free_pages(&log) == (uint16_t)(TEST_PAGE_COUNT - 1U));
+    assert(aegis_infrastructure_flash_log_mount(&log) == ERR_OK);
+    assert(verify_from_tail(&log, 0U) == 0U);
+    printf("  ✓ 布局版本校验\n");
+
+    /* 9. 预擦除：空闲时擦好后续页，追加换页时不再同步擦除；统计与写入量一致 */
+    assert(aegis_infrastructure_flash_log_init(&log, &g_flash, TEST_LAYOUT) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_format(&log) == ERR_OK);
+    assert(aegis_infrastructure_flash_log_get_stats(&log, &stats) == ERR_OK);
+    assert(stats.erases == TEST_PAGE_COUNT && log.erased_ahead == (uint16_t)(TEST_PAGE_COUNT - 1U));
+    remount(&log);
+    assert(aegis_infrastructure_flash_log_erase_ahead(NULL, 0U) == ERR_NULL_PTR);
+    assert(aegis_infrastructure_flash_log_get_stats(&log, &stats) == ERR_OK);
+    assert(stats.records == 0U && stats.erases == 0U && log.erased_ahead == 0U);
+    assert(aegis_infrastructure_flash_log_erase_ahead(&log, 1U) == ERR_OK);
+    assert(log.erased_ahead == 1U);
+    assert(aegis_infrastructure_flash_log_erase_ahead(&log, 0U) == ERR_OK);
+    assert(log.erased_ahead == (uint16_t)FLASH_LOG_ERASE_AHEAD);
+
+    bytes = 0U;
+    for (i = 0; i < 60U; i++) {
+        assert(append_n(&log, i, 1U) == ERR_OK);
+        bytes += FLASH_LOG_RECORD_SPAN(TEST_LEN(i));
+        if ((i % 4U) == 3U) {
+            assert(aegis_infrastructure_flash_log_checkpoint_begin(&log, NULL, 0U) == ERR_OK);
+            assert(aegis_infrastructure_flash_log_checkpoint_commit(&log) == ERR_OK);
+            bytes += FLASH_LOG_RECORD_SPAN(0U) + FLASH_LOG_RECORD_SPAN(12U);
+            assert(aegis_infrastructure_flash_log_erase_ahead(&log, 1U) == ERR_OK);
+        }
+    }
+    assert(aegis_infrastructure_flash_log_get_stats(&log, &stats) == ERR_OK);
+    assert(stats.pages_opened > TEST_PAGE_COUNT);
+    assert(stats.erases_inline == 0U);
+    assert(stats.erases == stats.pages_opened + (uint32_t)log.erased_ahead);
+    assert(stats.records == 60U + 15U * 2U);
+    assert(stats.bytes == bytes + stats.pages_opened * FLASH_LOG_PAGE_HEADER);
+
+    /* 不预擦除时换页同步擦除 */
+    remount(&log);
+    free_before = aegis_infrastructure_flash_log_free_pages(&log);
+    head_seq = log.head.seq;
+    i = 0U;
+    while (log.head.seq == head_seq) {
+        assert(append_n(&log, i, 1U) == ERR_OK);
+        i++;
+    }
+    assert(aegis_infrastructure_flash_log_get_stats(&log, &stats) == ERR_OK);
+    assert(stats.erases_inline == 1U && stats.erases == 1U && stats.pages_opened == 1U);
+    assert(aegis_infrastructure_flash_log_free_pages(&log) == (uint16_t)(free_before - 1U));
+    printf("  ✓ 预擦除与吞吐/擦除统计\n");
+
+    /* 10. 在每一个写入字节处掉电（含页头与擦除）：重新挂载后恰好读回全部已确认的记录 */
+    for (cut = 0U; ; cut++) {
+        assert(aegis_infrastructure_flash_log_format(&log) == ERR_OK);
+        remount(&log);
+        aegis_hal_flash_sim_set_power_cut(cut);
+        for (acked = 0U; acked < 24U; acked++) {
+            if (append_n(&log, acked, 1U) != ERR_OK) {
+                break;
+            }
+            if ((acked % 8U) == 7U && aegis_infrastructure_flash_log_erase_ahead(&log, 1U) != ERR_OK) {
+                acked++;
+                break;
+            }
+        }
+        if (!aegis_hal_flash_sim_power_lost()) {
+            break;
+        }
+        aegis_hal_flash_sim_set_power_cut(HAL_FLASH_SIM_POWER_CUT_OFF);
+        remount(&log);
+        i = verify_from_tail(&log, 0U);
+        assert(i == acked || i == acked + 1U);
+        assert(append_n(&log, i, 1U) == ERR_OK);
+        remount(&log);
+        assert(verify_from_tail(&log, 0U) == i + 1U);
+    }
+    assert(acked == 24U);
+    printf("  ✓ 任意写入字节处掉电均可恢复（%lu 个掉电点）\n", (unsigned long)cut);
+
+    flash_close();
+    (void)remove(TEST_FLASH_PATH);
+
+    printf("✅ 所有测试通过!\n");
+    return 0;
+}
@@ -0,0 +1,502 @@
+/*
+ * @file: test_repository_inmem.c
+ * @brief: 内存仓储单元测试（实体ID索引、类型索引、槽位复用、增量压缩、快照读、批量写入、局部更新）
+ * @author: jack liu
+ * @req: REQ-TEST-REPO-INMEM
+ * @design: DES-TEST-REPO-INMEM
+ * @asil: ASIL-B
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "infrastructure_repository_inmem.h"
+
+#define TEST_ENTITY_TYPE_A ((AegisEntityType)1U)
+#define TEST_ENTITY_TYPE_B ((AegisEntityType)2U)
+
+#define TEST_INITIAL_COUNT  20U
+
+/* find_by_type 单次最多返回 255 个 */
+#define TEST_FIND_MAX  ((REPOSITORY_MAX_ENTITIES > 255U) ? 255U : REPOSITORY_MAX_ENTITIES)
+
+static uint32_t test_now_ms(void* ctx) {
+    uint32_t* tick = (uint32_t*)ctx;
+    (*tick)++;
+    return *tick;
+}
+
+static AegisErrorCode create_entity(const AegisDomainRepositoryWriteInterface* repo,
+                                    AegisEntityId id,
+                                    AegisEntityType type,
+                                    uint8_t value,
+                                    AegisEntityId* out_id) {
+    AegisDomainEntity entity;
+    AegisErrorCode ret;
+
+    memset(&entity, 0, sizeof(entity));
+    (void)aegis_domain_entity_init(&entity.base, id, type);
+    ret = aegis_domain_entity_payload_set(&entity, &value, 1U);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = repo->create(repo, &entity);
+    if (ret == ERR_OK && out_id != NULL) {
+        *out_id = entity.base.id;
+    }
+    return ret;
+}
+
+static uint8_t stored_value(const AegisDomainRepositoryReadInterface* repo, AegisEntityId id) {
+    AegisDomainEntity* stored = NULL;
+
+    assert(repo->get(repo, id, &stored) == ERR_OK);
+    assert(stored != NULL);
+    assert(stored->base.id == id);
+    return stored->payload[0];
+}
+
+/* 查询结果的 payload 值集合（值 < 32） */
+static uint32_t payload_mask(AegisDomainEntity* const* found, uint8_t count) {
+    uint32_t mask = 0U;
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        mask |= (uint32_t)1U << found[i]->payload[0];
+    }
+    return mask;
+}
+
+int main(void) {
+    AegisInfrastructureRepositoryInmem repo;
+    const AegisDomainRepositoryWriteInterface* write_repo;
+    const AegisDomainRepositoryReadInterface* read_repo;
+    AegisEntityId ids[TEST_INITIAL_COUNT];
+    AegisDomainEntity* stored;
+    AegisDomainEntity entity;
+    AegisDomainEntity* found[REPOSITORY_MAX_ENTITIES];
+    AegisEntityId id;
+    AegisInfrastructureRepositorySlot slot;
+    uint16_t remaining;
+    uint16_t prev_remaining;
+    uint16_t live;
+    uint32_t seq;
+    uint32_t tick;
+    AegisDomainEntity batch[3];
+    AegisDomainRepositoryOp ops[4];
+    uint8_t field[4];
+    uint16_t cursor;
+    uint16_t mask;
+    uint16_t n;
+    uint8_t count;
+    uint8_t i;
+
+    printf("========================================\n");
+    printf("  内存仓储单元测试\n");
+    printf("========================================\n");
+
+    assert(aegis_infrastructure_repository_inmem_init(&repo, NULL, NULL) == ERR_OK);
+    write_repo = aegis_infrastructure_repository_inmem_write(&repo);
+    read_repo = aegis_infrastructure_repository_inmem_read(&repo);
+    assert(write_repo->init(write_repo) == ERR_OK);
+
+    /* 1) 调用方指定ID；自动分配跳过已占用的ID */
+    assert(create_entity(write_repo, 2U, TEST_ENTITY_TYPE_A, 0U, &ids[0]) == ERR_OK);
+    assert(ids[0] == 2U);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_B, 1U, &ids[1]) == ERR_OK);
+    assert(ids[1] == 1U);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 2U, &ids[2]) == ERR_OK);
+    assert(ids[2] == 3U);
+
+    /* 2) 重复ID被拒绝 */
+    assert(create_entity(write_repo, 3U, TEST_ENTITY_TYPE_A, 0U, NULL) == ERR_INVALID_PARAM);
+
+    for (i = 3U; i < TEST_INITIAL_COUNT; i++) {
+        assert(create_entity(write_repo, ENTITY_ID_INVALID,
+                             (i % 2U) ? TEST_ENTITY_TYPE_B : TEST_ENTITY_TYPE_A, i, &ids[i]) == ERR_OK);
+    }
+    for (i = 0; i < TEST_INITIAL_COUNT; i++) {
+        assert(stored_value(read_repo, ids[i]) == i);
+    }
+    assert(read_repo->get(read_repo, 999U, &stored) == ERR_NOT_FOUND);
+    printf("  ✓ 创建/索引查找\n");
+
+    /* 3) 删除一半：被删ID不可见，同一探测链上的其余ID仍可查找 */
+    for (i = 0; i < TEST_INITIAL_COUNT; i += 2U) {
+        assert(write_repo->delete_entity(write_repo, ids[i]) == ERR_OK);
+    }
+    for (i = 0; i < TEST_INITIAL_COUNT; i++) {
+        if ((i % 2U) == 0U) {
+            assert(read_repo->get(read_repo, ids[i], &stored) == ERR_NOT_FOUND);
+            assert(write_repo->delete_entity(write_repo, ids[i]) == ERR_NOT_FOUND);
+        } else {
+            assert(stored_value(read_repo, ids[i]) == i);
+        }
+    }
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_B, &count) == ERR_OK);
+    assert(count == (uint8_t)(TEST_INITIAL_COUNT / 2U));
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_A, &count) == ERR_OK);
+    assert(count == 0U);
+    printf("  ✓ 删除后索引一致\n");
+
+    /* 4) 更新：已删除ID返回 ERR_NOT_FOUND，存活ID就地更新 */
+    memset(&entity, 0, sizeof(entity));
+    (void)aegis_domain_entity_init(&entity.base, ids[0], TEST_ENTITY_TYPE_A);
+    assert(write_repo->update(write_repo, &entity) == ERR_NOT_FOUND);
+    (void)aegis_domain_entity_init(&entity.base, ids[1], TEST_ENTITY_TYPE_B);
+    entity.payload[0] = 0xAAU;
+    entity.payload_size = 1U;
+    assert(write_repo->update(write_repo, &entity) == ERR_OK);
+    assert(stored_value(read_repo, ids[1]) == 0xAAU);
+    printf("  ✓ 按索引更新\n");
+
+    /* 5) 已删除的ID可重新使用 */
+    assert(create_entity(write_repo, ids[0], TEST_ENTITY_TYPE_A, 0x55U, &id) == ERR_OK);
+    assert(id == ids[0]);
+    assert(stored_value(read_repo, ids[0]) == 0x55U);
+    printf("  ✓ 删除后ID复用\n");
+
+    /* 6) 填满后返回 ERR_OUT_OF_RANGE */
+    while (create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 0U, &id) == ERR_OK) {
+        assert(stored_value(read_repo, id) == 0U);
+    }
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 0U, NULL) == ERR_OUT_OF_RANGE);
+    printf("  ✓ 容量上限\n");
+
+    /* 7) 全部删除后槽位可再次填满（空闲栈复用 + 压缩收缩区间） */
+    for (slot = 0; slot < repo.entity_count; slot++) {
+        if (repo.entity_pool[slot].base.is_valid) {
+            assert(write_repo->delete_entity(write_repo, repo.entity_pool[slot].base.id) == ERR_OK);
+        }
+    }
+    assert(aegis_infrastructure_repository_inmem_compact(&repo, 0U, &remaining) == ERR_OK);
+    assert(remaining == 0U);
+    assert(repo.entity_count == 0U);
+    for (n = 0; n < (uint16_t)REPOSITORY_MAX_ENTITIES; n++) {
+        assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, (uint8_t)n, &id) == ERR_OK);
+    }
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 0U, NULL) == ERR_OUT_OF_RANGE);
+    printf("  ✓ 删除后槽位复用\n");
+
+    /* 8) 按预算逐步压缩：每步空洞数递减，实体内容与索引保持一致 */
+    for (slot = 0; slot < repo.entity_count; slot += 3U) {
+        assert(write_repo->delete_entity(write_repo, repo.entity_pool[slot].base.id) == ERR_OK);
+    }
+    live = (uint16_t)(repo.entity_count - repo.free_count);
+    prev_remaining = (uint16_t)repo.free_count;
+    assert(prev_remaining > 0U);
+    do {
+        assert(write_repo->compact(write_repo, 1U, &remaining) == ERR_OK);
+        assert(remaining <= prev_remaining);
+        prev_remaining = remaining;
+    } while (remaining > 0U);
+    assert(repo.entity_count == live);
+    for (slot = 0; slot < repo.entity_count; slot++) {
+        assert(repo.entity_pool[slot].base.is_valid);
+        assert(stored_value(read_repo, repo.entity_pool[slot].base.id) == repo.entity_pool[slot].payload[0]);
+    }
+    assert(read_repo->find_by_type(read_repo, TEST_ENTITY_TYPE_A, found,
+                                   (uint8_t)TEST_FIND_MAX, &count) == ERR_OK);
+    assert(count == ((live > 255U) ? 255U : live));
+    assert(aegis_infrastructure_repository_inmem_compact(NULL, 1U, NULL) == ERR_NULL_PTR);
+    printf("  ✓ 增量压缩\n");
+
+    /* 9) init 清空索引 */
+    assert(write_repo->init(write_repo) == ERR_OK);
+    assert(read_repo->get(read_repo, ids[1], &stored) == ERR_NOT_FOUND);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 0U, &id) == ERR_OK);
+    assert(id == 1U);
+    printf("  ✓ 重新初始化\n");
+
+    /* 10) 类型索引：类型变更/删除/压缩后查询结果与计数一致（默认布局按创建顺序返回） */
+    for (i = 1U; i < 7U; i++) {
+        assert(create_entity(write_repo, ENTITY_ID_INVALID,
+                             (i < 4U) ? TEST_ENTITY_TYPE_A : TEST_ENTITY_TYPE_B, i, &ids[i]) == ERR_OK);
+    }
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_A, &count) == ERR_OK && count == 4U);
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_B, &count) == ERR_OK && count == 3U);
+    assert(read_repo->count_by_type(read_repo, (AegisEntityType)99U, &count) == ERR_OK && count == 0U);
+    assert(read_repo->find_by_type(read_repo, TEST_ENTITY_TYPE_A, found, 2U, &count) == ERR_OK);
+    assert(count == 2U && payload_mask(found, count) == 0x03UL);
+
+    memcpy(&entity, found[1], sizeof(entity));
+    entity.base.type = TEST_ENTITY_TYPE_B;
+    assert(write_repo->update(write_repo, &entity) == ERR_OK);
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_A, &count) == ERR_OK && count == 3U);
+    assert(read_repo->find_by_type(read_repo, TEST_ENTITY_TYPE_B, found,
+                                   (uint8_t)TEST_FIND_MAX, &count) == ERR_OK);
+    assert(count == 4U && payload_mask(found, count) == 0x72UL);
+#if !REPOSITORY_LAYOUT_SOA
+    assert(found[3]->payload[0] == 1U);
+#endif
+
+    assert(write_repo->delete_entity(write_repo, ids[2]) == ERR_OK);
+    assert(write_repo->delete_entity(write_repo, ids[4]) == ERR_OK);
+    assert(write_repo->compact(write_repo, 0U, &remaining) == ERR_OK && remaining == 0U);
+    assert(read_repo->find_by_type(read_repo, TEST_ENTITY_TYPE_A, found,
+                                   (uint8_t)TEST_FIND_MAX, &count) == ERR_OK);
+    assert(count == 2U && payload_mask(found, count) == 0x09UL);
+    assert(read_repo->find_by_type(read_repo, TEST_ENTITY_TYPE_B, found,
+                                   (uint8_t)TEST_FIND_MAX, &count) == ERR_OK);
+    assert(count == 3U && payload_mask(found, count) == 0x62UL);
+#if !REPOSITORY_LAYOUT_SOA
+    assert(found[0]->payload[0] == 5U && found[1]->payload[0] == 6U && found[2]->payload[0] == 1U);
+#endif
+    assert(read_repo->count_by_type(read_repo, ENTITY_TYPE_INVALID, &count) == ERR_OK && count == 0U);
+    printf("  ✓ 类型索引\n");
+
+#if !REPOSITORY_LAYOUT_SOA
+    /* 11) 类型表已满时创建新类型返回 ERR_OUT_OF_RANGE，已有类型不受影响 */
+    for (i = 2U; i < (uint8_t)REPOSITORY_MAX_TYPES; i++) {
+        assert(create_entity(write_repo, ENTITY_ID_INVALID, (AegisEntityType)(100U + i), i, NULL) == ERR_OK);
+    }
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, (AegisEntityType)99U, 0U, NULL) == ERR_OUT_OF_RANGE);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 0U, NULL) == ERR_OK);
+
+    /* 类型的实体全部删除后，其表项可被新类型复用 */
+    {
+        AegisEntityId drained[2];
+
+        assert(read_repo->find_by_type(read_repo, (AegisEntityType)102U, found, 1U, &count) == ERR_OK && count == 1U);
+        drained[0] = found[0]->base.id;
+        assert(read_repo->find_by_type(read_repo, (AegisEntityType)103U, found, 1U, &count) == ERR_OK && count == 1U);
+        drained[1] = found[0]->base.id;
+        assert(write_repo->delete_entity(write_repo, drained[0]) == ERR_OK);
+        assert(repo.type_count == (uint8_t)REPOSITORY_MAX_TYPES);
+        assert(create_entity(write_repo, ENTITY_ID_INVALID, (AegisEntityType)99U, 9U, NULL) == ERR_OK);
+        assert(read_repo->count_by_type(read_repo, (AegisEntityType)99U, &count) == ERR_OK && count == 1U);
+        assert(read_repo->count_by_type(read_repo, (AegisEntityType)102U, &count) == ERR_OK && count == 0U);
+        assert(create_entity(write_repo, ENTITY_ID_INVALID, (AegisEntityType)98U, 0U, NULL) == ERR_OUT_OF_RANGE);
+
+        /* 批内已登记的排空表项不会被同批的另一个新类型抢占 */
+        assert(write_repo->delete_entity(write_repo, drained[1]) == ERR_OK);
+        memset(batch, 0, sizeof(batch));
+        (void)aegis_domain_entity_init(&batch[0].base, ENTITY_ID_INVALID, (AegisEntityType)103U);
+        (void)aegis_domain_entity_init(&batch[1].base, ENTITY_ID_INVALID, (AegisEntityType)98U);
+        ops[0].kind = DOMAIN_REPOSITORY_OP_CREATE;
+        ops[0].entity = &batch[0];
+        ops[1].kind = DOMAIN_REPOSITORY_OP_CREATE;
+        ops[1].entity = &batch[1];
+        assert(write_repo->apply_batch(write_repo, ops, 2U, &i) == ERR_OUT_OF_RANGE && i == 1U);
+        assert(create_entity(write_repo, ENTITY_ID_INVALID, (AegisEntityType)98U, 8U, NULL) == ERR_OK);
+        assert(read_repo->find_by_type(read_repo, (AegisEntityType)98U, found,
+                                       (uint8_t)TEST_FIND_MAX, &count) == ERR_OK);
+        assert(count == 1U && found[0]->payload[0] == 8U);
+        assert(read_repo->count_by_type(read_repo, (AegisEntityType)103U, &count) == ERR_OK && count == 0U);
+        assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_B, &count) == ERR_OK && count == 3U);
+    }
+    printf("  ✓ 类型表容量\n");
+#else
+    /* 11) SoA 布局：类型数不受限，空闲槽位在热数组中为 ENTITY_TYPE_INVALID */
+    for (i = 0; i < 20U; i++) {
+        assert(create_entity(write_repo, ENTITY_ID_INVALID, (AegisEntityType)(100U + i), i, NULL) == ERR_OK);
+    }
+    for (slot = repo.entity_count; slot < (AegisInfrastructureRepositorySlot)REPOSITORY_MAX_ENTITIES; slot++) {
+        assert(repo.hot_type[slot] == ENTITY_TYPE_INVALID);
+    }
+    printf("  ✓ SoA 热数组\n");
+#endif
+
+    /* 12) 快照读：拷贝与之后的写入隔离；写入中（版本为奇数）时重试到上限返回 ERR_BUSY */
+    assert(write_repo->init(write_repo) == ERR_OK);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 7U, &id) == ERR_OK);
+    assert(read_repo->snapshot(read_repo, id, &entity) == ERR_OK);
+    assert(entity.base.id == id && entity.payload[0] == 7U);
+    slot = (AegisInfrastructureRepositorySlot)(repo.entity_count - 1U);
+    assert((repo.slot_seq[slot] & 1U) == 0U && (repo.index_seq & 1U) == 0U);
+
+    seq = repo.slot_seq[slot];
+    entity.payload[0] = 8U;
+    assert(write_repo->update(write_repo, &entity) == ERR_OK);
+    assert(repo.slot_seq[slot] == seq + 2U);
+    assert(read_repo->snapshot(read_repo, id, &entity) == ERR_OK);
+    assert(entity.payload[0] == 8U);
+
+    /* 传入 get 返回的存储本身：不做重叠拷贝，版本号照常推进 */
+    assert(read_repo->get(read_repo, id, &stored) == ERR_OK);
+    seq = repo.slot_seq[slot];
+    assert(write_repo->update(write_repo, stored) == ERR_OK);
+    assert(repo.slot_seq[slot] == seq + 2U);
+    assert(read_repo->snapshot(read_repo, id, &entity) == ERR_OK && entity.payload[0] == 8U);
+
+    repo.slot_seq[slot]++;
+    assert(read_repo->snapshot(read_repo, id, &entity) == ERR_BUSY);
+    repo.slot_seq[slot]++;
+    repo.index_seq++;
+    assert(read_repo->snapshot(read_repo, 999U, &entity) == ERR_BUSY);
+    repo.index_seq++;
+    assert(read_repo->snapshot(read_repo, 999U, &entity) == ERR_NOT_FOUND);
+
+    assert(write_repo->delete_entity(write_repo, id) == ERR_OK);
+    assert(read_repo->snapshot(read_repo, id, &entity) == ERR_NOT_FOUND);
+    assert(read_repo->snapshot(read_repo, id, NULL) == ERR_NULL_PTR);
+    printf("  ✓ 快照读\n");
+
+    /* 13) 批量写入：整批共用一个时间戳；任一操作不合法时整批不生效 */
+    tick = 0U;
+    assert(aegis_infrastructure_repository_inmem_init(&repo, test_now_ms, &tick) == ERR_OK);
+    assert(write_repo->init(write_repo) == ERR_OK);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 1U, &ids[0]) == ERR_OK);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 2U, &ids[1]) == ERR_OK);
+    assert(tick == 2U);
+
+    memset(batch, 0, sizeof(batch));
+    (void)aegis_domain_entity_init(&batch[0].base, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_B);
+    (void)aegis_domain_entity_init(&batch[1].base, 40U, TEST_ENTITY_TYPE_B);
+    assert(read_repo->snapshot(read_repo, ids[0], &batch[2]) == ERR_OK);
+    batch[2].base.type = TEST_ENTITY_TYPE_B;
+    batch[2].payload[0] = 9U;
+    ops[0].kind = DOMAIN_REPOSITORY_OP_CREATE;
+    ops[0].entity = &batch[0];
+    ops[1].kind = DOMAIN_REPOSITORY_OP_CREATE;
+    ops[1].entity = &batch[1];
+    ops[2].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+    ops[2].entity = &batch[2];
+    ops[3].kind = DOMAIN_REPOSITORY_OP_DELETE;
+    ops[3].entity = NULL;
+    ops[3].entity_id = 999U;
+
+    /* 最后一个操作失败：前面的 create/update 均未生效，时间戳回调只调用一次 */
+    i = 0xFFU;
+    assert(write_repo->apply_batch(write_repo, ops, 4U, &i) == ERR_NOT_FOUND);
+    assert(i == 3U && tick == 3U);
+    assert(repo.entity_count == 2U && batch[0].base.id == ENTITY_ID_INVALID);
+    assert(stored_value(read_repo, ids[0]) == 1U);
+    assert(read_repo->get(read_repo, 40U, &stored) == ERR_NOT_FOUND);
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_B, &count) == ERR_OK && count == 0U);
+
+    ops[3].entity_id = ids[1];
+    assert(write_repo->apply_batch(write_repo, ops, 4U, &i) == ERR_OK);
+    assert(tick == 4U);
+    assert(batch[0].base.id != ENTITY_ID_INVALID && batch[0].base.id != 40U && batch[0].base.id != ids[1]);
+    assert(batch[0].base.created_at == 4U && batch[1].base.created_at == 4U && batch[2].base.updated_at == 4U);
+    assert(stored_value(read_repo, ids[0]) == 9U);
+    assert(read_repo->get(read_repo, ids[1], &stored) == ERR_NOT_FOUND);
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_B, &count) == ERR_OK && count == 3U);
+    assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_A, &count) == ERR_OK && count == 0U);
+
+    /* 同一ID出现两次被拒绝 */
+    ops[0].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+    ops[1].kind = DOMAIN_REPOSITORY_OP_DELETE;
+    ops[1].entity = NULL;
+    ops[1].entity_id = batch[0].base.id;
+    assert(write_repo->apply_batch(write_repo, ops, 2U, &i) == ERR_INVALID_PARAM && i == 1U);
+
+#if !REPOSITORY_LAYOUT_SOA
+    /* 校验阶段为新类型登记的类型表项随失败的批次撤销：反复失败不会耗尽类型表 */
+    {
+        uint8_t types = repo.type_count;
+        uint8_t k;
+
+        memset(batch, 0, sizeof(batch));
+        (void)aegis_domain_entity_init(&batch[1].base, 999U, TEST_ENTITY_TYPE_A);
+        ops[0].kind = DOMAIN_REPOSITORY_OP_CREATE;
+        ops[0].entity = &batch[0];
+        ops[0].entity_id = ENTITY_ID_INVALID;
+        ops[1].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+        ops[1].entity = &batch[1];
+        ops[1].entity_id = 999U;
+        for (k = 0; k <= (uint8_t)REPOSITORY_MAX_TYPES; k++) {
+            (void)aegis_domain_entity_init(&batch[0].base, ENTITY_ID_INVALID, (AegisEntityType)(200U + k));
+            assert(write_repo->apply_batch(write_repo, ops, 2U, &i) == ERR_NOT_FOUND && i == 1U);
+            assert(repo.type_count == types);
+        }
+        assert(read_repo->count_by_type(read_repo, TEST_ENTITY_TYPE_B, &count) == ERR_OK && count == 3U);
+        assert(read_repo->count_by_type(read_repo, (AegisEntityType)200U, &count) == ERR_OK && count == 0U);
+    }
+#endif
+
+    /* 容量按顺序模拟：先删后建可在满仓时成功，连续创建超出容量则整批失败 */
+    while (create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 0U, &id) == ERR_OK) {
+    }
+    live = (uint16_t)(repo.entity_count - repo.free_count);
+    memset(batch, 0, sizeof(batch));
+    (void)aegis_domain_entity_init(&batch[0].base, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A);
+    (void)aegis_domain_entity_init(&batch[1].base, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A);
+    ops[0].kind = DOMAIN_REPOSITORY_OP_DELETE;
+    ops[0].entity = NULL;
+    ops[0].entity_id = id;
+    ops[1].kind = DOMAIN_REPOSITORY_OP_CREATE;
+    ops[1].entity = &batch[0];
+    ops[2].kind = DOMAIN_REPOSITORY_OP_CREATE;
+    ops[2].entity = &batch[1];
+    assert(write_repo->apply_batch(write_repo, ops, 3U, &i) == ERR_OUT_OF_RANGE && i == 2U);
+    assert((uint16_t)(repo.entity_count - repo.free_count) == live);
+    assert(read_repo->get(read_repo, id, &stored) == ERR_OK);
+    assert(write_repo->apply_batch(write_repo, ops, 2U, NULL) == ERR_OK);
+    assert((uint16_t)(repo.entity_count - repo.free_count) == live);
+    assert(read_repo->get(read_repo, id, &stored) == ERR_NOT_FOUND);
+
+    assert(write_repo->apply_batch(write_repo, ops, 0U, NULL) == ERR_OK);
+    assert(write_repo->apply_batch(write_repo, ops, (uint8_t)(REPOSITORY_BATCH_MAX + 1U), NULL) == ERR_OUT_OF_RANGE);
+    assert(write_repo->apply_batch(write_repo, NULL, 1U, NULL) == ERR_NULL_PTR);
+    printf("  ✓ 批量写入\n");
+
+    /* 14) 局部更新：只覆盖指定区间，脏位图按块记录修改，take_dirty 读取后清零 */
+    assert(write_repo->init(write_repo) == ERR_OK);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 5U, &ids[0]) == ERR_OK);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 6U, &ids[1]) == ERR_OK);
+    cursor = 0U;
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_OK);
+    assert(id == ids[0] && mask == REPOSITORY_DIRTY_ALL);
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_OK);
+    assert(id == ids[1] && mask == REPOSITORY_DIRTY_ALL);
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_NOT_FOUND);
+
+    seq = tick;
+    field[0] = 0xA1U;
+    field[1] = 0xA2U;
+    field[2] = 0xA3U;
+    field[3] = 0xA4U;
+    assert(write_repo->update_payload(write_repo, ids[1], 6U, field, 4U) == ERR_OK);
+    assert(tick == seq + 1U);
+    assert(read_repo->snapshot(read_repo, ids[1], &entity) == ERR_OK);
+    assert(entity.payload[0] == 6U && entity.payload[5] == 0U);
+    assert(entity.payload[6] == 0xA1U && entity.payload[9] == 0xA4U && entity.payload[10] == 0U);
+    assert(entity.payload_size == 10U && entity.base.updated_at == tick);
+
+    /* 区间 [6, 10) 跨越第0、1块 */
+    cursor = 0U;
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_OK);
+    assert(id == ids[1] && mask == 0x0003U);
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_NOT_FOUND);
+
+    /* 越过末尾写入：空隙清零（缩短前留下的旧字节不重新生效），空隙所在块同样记脏 */
+    assert(read_repo->snapshot(read_repo, ids[0], &entity) == ERR_OK);
+    memset(entity.payload, 0xEE, sizeof(entity.payload));
+    entity.payload_size = 1U;
+    assert(write_repo->update(write_repo, &entity) == ERR_OK);
+    cursor = 0U;
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_OK);
+    assert(id == ids[0] && mask == REPOSITORY_DIRTY_ALL);
+    assert(write_repo->update_payload(write_repo, ids[0], (uint16_t)(DOMAIN_ENTITY_PAYLOAD_MAX - 1U), field, 1U) == ERR_OK);
+    assert(read_repo->snapshot(read_repo, ids[0], &entity) == ERR_OK);
+    assert(entity.payload_size == (uint16_t)DOMAIN_ENTITY_PAYLOAD_MAX);
+    assert(entity.payload[0] == 0xEEU && entity.payload[1] == 0U);
+    assert(entity.payload[DOMAIN_ENTITY_PAYLOAD_MAX - 2U] == 0U && entity.payload[DOMAIN_ENTITY_PAYLOAD_MAX - 1U] == 0xA1U);
+    assert(write_repo->update_payload(write_repo, ids[0], (uint16_t)(DOMAIN_ENTITY_PAYLOAD_MAX - 1U), field, 2U) == ERR_OUT_OF_RANGE);
+    assert(write_repo->update_payload(write_repo, ids[0], 0U, field, 0U) == ERR_OUT_OF_RANGE);
+    assert(write_repo->update_payload(write_repo, 999U, 0U, field, 1U) == ERR_NOT_FOUND);
+    assert(write_repo->update_payload(write_repo, ids[0], 0U, NULL, 1U) == ERR_NULL_PTR);
+    cursor = 0U;
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_OK);
+    assert(id == ids[0] && mask == (uint16_t)((1UL << (DOMAIN_ENTITY_PAYLOAD_MAX / REPOSITORY_DIRTY_CHUNK)) - 1UL));
+
+    /* 删除的实体不再上报；压缩搬移后脏位图随实体移动 */
+    assert(write_repo->update_payload(write_repo, ids[0], 0U, field, 1U) == ERR_OK);
+    assert(write_repo->update_payload(write_repo, ids[1], 16U, field, 1U) == ERR_OK);
+    assert(write_repo->delete_entity(write_repo, ids[0]) == ERR_OK);
+    assert(create_entity(write_repo, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_A, 7U, &ids[2]) == ERR_OK);
+    assert(write_repo->delete_entity(write_repo, ids[2]) == ERR_OK);
+    assert(aegis_infrastructure_repository_inmem_compact(&repo, 0U, NULL) == ERR_OK);
+    cursor = 0U;
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_OK);
+    assert(id == ids[1] && mask == 0x0006U);   /* 写入 [16, 17) 与空隙 [10, 16) */
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, &cursor, &id, &mask) == ERR_NOT_FOUND);
+    assert(aegis_infrastructure_repository_inmem_take_dirty(&repo, NULL, &id, &mask) == ERR_NULL_PTR);
+    printf("  ✓ 局部更新与脏位图\n");
+
+    printf("✅ 所有测试通过!\n");
+    return 0;
+}
@@ -0,0 +1,537 @@
+/*
+ * @file: test_repository_log.c
+ * @brief: 持久化仓储单元测试（重启重放、检查点与重放上界、批量原子性、Flash 故障与内存撤销、逐字节掉电恢复、格式化）
+ * @author: jack liu
+ * @req: REQ-TEST-REPO-LOG
+ * @design: DES-TEST-REPO-LOG
+ * @asil: ASIL-B
+ *
+ * 使用 x86_sim 的文件模拟 Flash（当前目录下的 test_repository_log.bin）；
+ * 通过 aegis_hal_flash_sim_set_power_cut() 在任意写入字节处注入掉电。
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "infrastructure_repository_log.h"
+#include "crc32.h"
+
+#define TEST_FLASH_PATH   "test_repository_log.bin"
+#define TEST_PAGE_SIZE    1024U
+#define TEST_EXTRA_PAGES  4U
+
+#define TEST_ENTITY_TYPE_A ((AegisEntityType)1U)
+#define TEST_ENTITY_TYPE_B ((AegisEntityType)2U)
+
+/* 逐字节掉电测试的工作负载步数与其使用的实体数 */
+#define TEST_CUT_STEPS     96U
+#define TEST_CUT_ENTITIES  6U
+
+static uint32_t test_now_ms(void* ctx) {
+    uint32_t* tick = (uint32_t*)ctx;
+    (*tick)++;
+    return *tick;
+}
+
+static void flash_open(AegisHalFlash* flash, uint16_t page_count, bool_t fresh) {
+    AegisHalFlashConfig cfg;
+
+    aegis_hal_flash_sim_set_power_cut(HAL_FLASH_SIM_POWER_CUT_OFF);
+
+    if (fresh) {
+        (void)remove(TEST_FLASH_PATH);
+    }
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.backing_path = TEST_FLASH_PATH;
+    cfg.page_size = TEST_PAGE_SIZE;
+    cfg.page_count = page_count;
+    assert(aegis_hal_flash_init(flash, &cfg) == ERR_OK);
+}
+
+/* 模拟重启：恢复供电、重新映射 Flash，用新的仓储实例挂载并重放 */
+static const AegisDomainRepositoryWriteInterface* reboot(AegisInfrastructureRepositoryLog* repo,
+                                                         AegisHalFlash* flash,
+                                                         uint32_t* tick) {
+    const AegisDomainRepositoryWriteInterface* write_repo;
+    uint16_t page_count = flash->page_count;
+
+    assert(aegis_hal_flash_deinit(flash) == ERR_OK);
+    flash_open(flash, page_count, FALSE);
+
+    assert(aegis_infrastructure_repository_log_init(repo, flash, test_now_ms, tick) == ERR_OK);
+    write_repo = aegis_infrastructure_repository_log_write(repo);
+    assert(write_repo->init(write_repo) == ERR_OK);
+    return write_repo;
+}
+
+static AegisErrorCode create_entity(const AegisDomainRepositoryWriteInterface* repo,
+                                    AegisEntityType type,
+                                    uint8_t value,
+                                    AegisEntityId* out_id) {
+    AegisDomainEntity entity;
+    AegisErrorCode ret;
+
+    memset(&entity, 0, sizeof(entity));
+    (void)aegis_domain_entity_init(&entity.base, ENTITY_ID_INVALID, type);
+    ret = aegis_domain_entity_payload_set(&entity, &value, 1U);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+
+    ret = repo->create(repo, &entity);
+    if (ret == ERR_OK && out_id != NULL) {
+        *out_id = entity.base.id;
+    }
+    return ret;
+}
+
+static void assert_same_entity(const AegisDomainRepositoryReadInterface* repo, const AegisDomainEntity* expect) {
+    AegisDomainEntity entity;
+
+    assert(repo->snapshot(repo, expect->base.id, &entity) == ERR_OK);
+    assert(entity.base.type == expect->base.type);
+    assert(entity.base.state == expect->base.state);
+    assert(entity.base.created_at == expect->base.created_at);
+    assert(entity.base.updated_at == expect->base.updated_at);
+    assert(entity.payload_size == expect->payload_size);
+    assert(memcmp(entity.payload, expect->payload, expect->payload_size) == 0);
+}
+
+static uint8_t count_type(const AegisDomainRepositoryReadInterface* repo, AegisEntityType type) {
+    uint8_t count = 0U;
+
+    assert(repo->count_by_type(repo, type, &count) == ERR_OK);
+    return count;
+}
+
+/* 全部实体内容的摘要（与槽位顺序无关），用于比较两次运行的仓储状态 */
+static uint32_t state_digest(const AegisDomainRepositoryReadInterface* repo) {
+    static const AegisEntityType types[2] = { TEST_ENTITY_TYPE_A, TEST_ENTITY_TYPE_B };
+    AegisDomainEntity* found[TEST_CUT_ENTITIES];
+    const AegisDomainEntity* e;
+    uint32_t digest = 0U;
+    uint32_t crc;
+    uint8_t count;
+    uint8_t t;
+    uint8_t k;
+
+    for (t = 0; t < 2U; t++) {
+        assert(repo->find_by_type(repo, types[t], found, (uint8_t)TEST_CUT_ENTITIES, &count) == ERR_OK);
+        for (k = 0; k < count; k++) {
+            e = found[k];
+            crc = aegis_crc32_update(0U, &e->base.id, (uint32_t)sizeof(e->base.id));
+            crc = aegis_crc32_update(crc, &e->base.type, (uint32_t)sizeof(e->base.type));
+            crc = aegis_crc32_update(crc, &e->base.state, (uint32_t)sizeof(e->base.state));
+            crc = aegis_crc32_update(crc, &e->base.created_at, (uint32_t)sizeof(e->base.created_at));
+            crc = aegis_crc32_update(crc, &e->base.updated_at, (uint32_t)sizeof(e->base.updated_at));
+            crc = aegis_crc32_update(crc, &e->payload_size, (uint32_t)sizeof(e->payload_size));
+            crc = aegis_crc32_update(crc, e->payload, (uint32_t)e->payload_size);
+            digest += crc;
+        }
+    }
+    return digest;
+}
+
+/*
+ * 逐字节掉电测试的工作负载第 step 步：先创建实体，之后轮流执行整实体更新、局部更新、
+ * 两实体批量更新、压缩钩子（检查点/预擦除）、删除与重建；第 20、70 步改为写显式检查点。
+ */
+static AegisErrorCode cut_step(AegisInfrastructureRepositoryLog* repo,
+                               AegisEntityId* ids,
+                               uint32_t step) {
+    const AegisDomainRepositoryWriteInterface* write_repo = aegis_infrastructure_repository_log_write(repo);
+    const AegisDomainRepositoryReadInterface* read_repo = aegis_infrastructure_repository_log_read(repo);
+    AegisDomainRepositoryOp ops[2];
+    AegisDomainEntity entity[2];
+    uint32_t j = (step / 6U) % TEST_CUT_ENTITIES;
+    uint32_t j2 = (j + 1U) % TEST_CUT_ENTITIES;
+    uint8_t field[4];
+    AegisErrorCode ret;
+
+    if (step < TEST_CUT_ENTITIES) {
+        return create_entity(write_repo, (step % 2U) ? TEST_ENTITY_TYPE_B : TEST_ENTITY_TYPE_A,
+                             (uint8_t)step, &ids[step]);
+    }
+    if (step == 20U || step == 70U) {
+        return aegis_infrastructure_repository_log_checkpoint(repo);
+    }
+
+    switch (step % 6U) {
+    case 0U:
+        assert(read_repo->snapshot(read_repo, ids[j], &entity[0]) == ERR_OK);
+        entity[0].base.state = ENTITY_STATE_ACTIVE;
+        entity[0].payload[0] = (uint8_t)step;
+        entity[0].payload_size = 3U;
+        return write_repo->update(write_repo, &entity[0]);
+    case 1U:
+        memset(field, (int)step, sizeof(field));
+        return write_repo->update_payload(write_repo, ids[j], 4U, field, 4U);
+    case 2U:
+        assert(read_repo->snapshot(read_repo, ids[j], &entity[0]) == ERR_OK);
+        assert(read_repo->snapshot(read_repo, ids[j2], &entity[1]) == ERR_OK);
+        entity[0].payload[1] = (uint8_t)step;
+        entity[1].payload[1] = (uint8_t)(step + 1U);
+        ops[0].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+        ops[0].entity = &entity[0];
+        ops[0].entity_id = ids[j];
+        ops[1].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+        ops[1].entity = &entity[1];
+        ops[1].entity_id = ids[j2];
+        return write_repo->apply_batch(write_repo, ops, 2U, NULL);
+    case 3U:
+        return write_repo->compact(write_repo, 0U, NULL);
+    case 4U:
+        return write_repo->delete_entity(write_repo, ids[j]);
+    default:
+        ret = create_entity(write_repo, (j % 2U) ? TEST_ENTITY_TYPE_B : TEST_ENTITY_TYPE_A,
+                            (uint8_t)step, &ids[j]);
+        return ret;
+    }
+}
+
+/*
+ * 注入编程失败执行第 kind 种写操作（创建/整实体更新/局部更新/删除/批量），须返回错误；
+ * 实体使用 ids[0..2]，其中 ids[2] 不被删除
+ */
+static AegisErrorCode failed_write(AegisInfrastructureRepositoryLog* repo, const AegisEntityId* ids, uint32_t kind) {
+    const AegisDomainRepositoryWriteInterface* write_repo = aegis_infrastructure_repository_log_write(repo);
+    const AegisDomainRepositoryReadInterface* read_repo = aegis_infrastructure_repository_log_read(repo);
+    AegisDomainRepositoryOp ops[3];
+    AegisDomainEntity entity[2];
+    uint8_t field[4];
+
+    memset(field, 0xC5, sizeof(field));
+    aegis_hal_flash_sim_set_power_cut((uint32_t)FLASH_LOG_RECORD_HEADER);
+
+    switch (kind) {
+    case 0U:
+        return create_entity(write_repo, TEST_ENTITY_TYPE_A, 0xC0U, NULL);
+    case 1U:
+        assert(read_repo->snapshot(read_repo, ids[0], &entity[0]) == ERR_OK);
+        entity[0].payload[0] = 0xC1U;
+        entity[0].payload_size = 5U;
+        return write_repo->update(write_repo, &entity[0]);
+    case 2U:
+        return write_repo->update_payload(write_repo, ids[2], 2U, field, 4U);
+    case 3U:
+        return write_repo->delete_entity(write_repo, ids[1]);
+    default:
+        memset(&entity[0], 0, sizeof(entity[0]));
+        (void)aegis_domain_entity_init(&entity[0].base, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_B);
+        entity[0].payload_size = 1U;
+        assert(read_repo->snapshot(read_repo, ids[0], &entity[1]) == ERR_OK);
+        entity[1].payload[0] = 0xC4U;
+        ops[0].kind = DOMAIN_REPOSITORY_OP_CREATE;
+        ops[0].entity = &entity[0];
+        ops[0].entity_id = ENTITY_ID_INVALID;
+        ops[1].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+        ops[1].entity = &entity[1];
+        ops[1].entity_id = ids[0];
+        ops[2].kind = DOMAIN_REPOSITORY_OP_DELETE;
+        ops[2].entity = NULL;
+        ops[2].entity_id = ids[1];
+        return write_repo->apply_batch(write_repo, ops, 3U, NULL);
+    }
+}
+
+/*
+ * 格式化并重新挂载（预擦除状态清零，换页时需要擦除）后设置掉电点 cut，运行工作负载，遇到第一个失败即停止；
+ * 返回成功的步数，digests（可为NULL）[k] 为成功 k 步后的状态摘要
+ */
+static uint32_t cut_run(AegisInfrastructureRepositoryLog* repo,
+                        const AegisHalFlash* flash,
+                        uint32_t* tick,
+                        uint32_t cut,
+                        uint32_t* digests) {
+    const AegisDomainRepositoryWriteInterface* write_repo;
+    const AegisDomainRepositoryReadInterface* read_repo;
+    AegisEntityId ids[TEST_CUT_ENTITIES];
+    uint32_t step;
+
+    *tick = 0U;
+    assert(aegis_infrastructure_repository_log_format(repo) == ERR_OK);
+    assert(aegis_infrastructure_repository_log_init(repo, flash, test_now_ms, tick) == ERR_OK);
+    write_repo = aegis_infrastructure_repository_log_write(repo);
+    read_repo = aegis_infrastructure_repository_log_read(repo);
+    assert(write_repo->init(write_repo) == ERR_OK);
+    aegis_hal_flash_sim_set_power_cut(cut);
+    if (digests != NULL) {
+        digests[0] = state_digest(read_repo);
+    }
+
+    for (step = 0; step < TEST_CUT_STEPS; step++) {
+        if (cut_step(repo, ids, step) != ERR_OK) {
+            break;
+        }
+        if (digests != NULL) {
+            digests[step + 1U] = state_digest(read_repo);
+        }
+    }
+    return step;
+}
+
+int main(void) {
+    static AegisInfrastructureRepositoryLog repo;
+    const AegisDomainRepositoryWriteInterface* write_repo;
+    const AegisDomainRepositoryReadInterface* read_repo;
+    AegisHalFlash flash;
+    AegisDomainEntity expect[3];
+    AegisDomainEntity batch[2];
+    AegisDomainRepositoryOp ops[3];
+    AegisDomainEntity entity;
+    AegisDomainEntity* stored;
+    uint32_t digests[TEST_CUT_STEPS + 1U];
+    uint32_t digest;
+    uint32_t done;
+    uint32_t cut;
+    AegisEntityId ids[4];
+    AegisEntityId id;
+    uint8_t field[4];
+    uint16_t min_pages;
+    uint16_t pages;
+    uint32_t tick = 0U;
+    uint32_t i;
+
+    printf("========================================\n");
+    printf("  持久化仓储测试\n");
+    printf("========================================\n");
+
+    /* 1. Flash 容量须容纳检查点与一个最大批次 */
+    min_pages = 2U;
+    for (;;) {
+        flash_open(&flash, min_pages, TRUE);
+        if (aegis_infrastructure_repository_log_init(&repo, &flash, test_now_ms, &tick) == ERR_OK) {
+            break;
+        }
+        assert(aegis_hal_flash_deinit(&flash) == ERR_OK);
+        min_pages++;
+        assert(min_pages < 1000U);
+    }
+    assert(repo.reserve_pages > repo.checkpoint_pages);
+    assert(aegis_hal_flash_deinit(&flash) == ERR_OK);
+
+    pages = (uint16_t)(min_pages + TEST_EXTRA_PAGES);
+    flash_open(&flash, pages, TRUE);
+    assert(aegis_infrastructure_repository_log_init(&repo, &flash, test_now_ms, &tick) == ERR_OK);
+    write_repo = aegis_infrastructure_repository_log_write(&repo);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_A, 1U, &id) == ERR_NOT_INITIALIZED);
+    assert(write_repo->init(write_repo) == ERR_OK);
+    assert(count_type(read_repo, TEST_ENTITY_TYPE_A) == 0U);
+    printf("  ✓ 容量校验与空白 Flash 挂载（最少 %u 页）\n", (unsigned int)min_pages);
+
+    /* 2. 各类写操作在重启后按原样恢复（含时间戳） */
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_A, 10U, &ids[0]) == ERR_OK);
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_A, 11U, &ids[1]) == ERR_OK);
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_B, 12U, &ids[2]) == ERR_OK);
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_B, 13U, &ids[3]) == ERR_OK);
+
+    assert(read_repo->snapshot(read_repo, ids[1], &entity) == ERR_OK);
+    entity.base.state = ENTITY_STATE_ACTIVE;
+    entity.payload[1] = 0x55U;
+    entity.payload_size = 2U;
+    assert(write_repo->update(write_repo, &entity) == ERR_OK);
+
+    field[0] = 0xA1U;
+    field[1] = 0xA2U;
+    field[2] = 0xA3U;
+    field[3] = 0xA4U;
+    assert(write_repo->update_payload(write_repo, ids[2], 8U, field, 4U) == ERR_OK);
+    assert(write_repo->delete_entity(write_repo, ids[3]) == ERR_OK);
+
+    assert(read_repo->snapshot(read_repo, ids[0], &expect[0]) == ERR_OK);
+    assert(read_repo->snapshot(read_repo, ids[1], &expect[1]) == ERR_OK);
+    assert(read_repo->snapshot(read_repo, ids[2], &expect[2]) == ERR_OK);
+
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert_same_entity(read_repo, &expect[0]);
+    assert_same_entity(read_repo, &expect[1]);
+    assert_same_entity(read_repo, &expect[2]);
+    assert(read_repo->snapshot(read_repo, ids[3], &entity) == ERR_NOT_FOUND);
+    assert(count_type(read_repo, TEST_ENTITY_TYPE_A) == 2U && count_type(read_repo, TEST_ENTITY_TYPE_B) == 1U);
+
+    /* 自动分配的ID不与恢复的实体冲突 */
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_B, 14U, &id) == ERR_OK);
+    assert(id != ids[0] && id != ids[1] && id != ids[2]);
+    assert(write_repo->delete_entity(write_repo, id) == ERR_OK);
+    printf("  ✓ 重启后重放恢复全部写操作\n");
+
+    /* 3. 批量写入：整组提交，重启后全部生效 */
+    memset(batch, 0, sizeof(batch));
+    (void)aegis_domain_entity_init(&batch[0].base, ENTITY_ID_INVALID, TEST_ENTITY_TYPE_B);
+    batch[0].payload[0] = 20U;
+    batch[0].payload_size = 1U;
+    memcpy(&batch[1], &expect[0], sizeof(batch[1]));
+    batch[1].payload[0] = 21U;
+    ops[0].kind = DOMAIN_REPOSITORY_OP_CREATE;
+    ops[0].entity = &batch[0];
+    ops[0].entity_id = ENTITY_ID_INVALID;
+    ops[1].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+    ops[1].entity = &batch[1];
+    ops[1].entity_id = batch[1].base.id;
+    ops[2].kind = DOMAIN_REPOSITORY_OP_DELETE;
+    ops[2].entity = NULL;
+    ops[2].entity_id = ids[1];
+    assert(write_repo->apply_batch(write_repo, ops, 3U, NULL) == ERR_OK);
+
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert_same_entity(read_repo, &batch[0]);
+    assert_same_entity(read_repo, &batch[1]);
+    assert(read_repo->snapshot(read_repo, ids[1], &entity) == ERR_NOT_FOUND);
+    memcpy(&expect[0], &batch[1], sizeof(expect[0]));
+    memcpy(&expect[1], &batch[0], sizeof(expect[1]));
+    printf("  ✓ 批量写入整组持久化\n");
+
+    /* 4. 批量写入中掉电：整组丢弃（组记录写完、缺 COMMIT 的情况见第6步逐字节掉电）；失败后拒绝写入 */
+    memcpy(&batch[0], &expect[0], sizeof(batch[0]));
+    batch[0].payload[0] = 30U;
+    memcpy(&batch[1], &expect[1], sizeof(batch[1]));
+    batch[1].payload[0] = 31U;
+    ops[0].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+    ops[0].entity = &batch[0];
+    ops[0].entity_id = batch[0].base.id;
+    ops[1].kind = DOMAIN_REPOSITORY_OP_UPDATE;
+    ops[1].entity = &batch[1];
+    ops[1].entity_id = batch[1].base.id;
+    aegis_hal_flash_sim_set_power_cut((uint32_t)FLASH_LOG_RECORD_HEADER + 8U);
+    assert(write_repo->apply_batch(write_repo, ops, 2U, NULL) == ERR_HAL_ERROR);
+    assert(aegis_hal_flash_sim_power_lost());
+    assert(repo.is_faulted);
+    aegis_hal_flash_sim_set_power_cut(HAL_FLASH_SIM_POWER_CUT_OFF);
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_A, 1U, &id) == ERR_INVALID_STATE);
+
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert_same_entity(read_repo, &expect[0]);
+    assert_same_entity(read_repo, &expect[1]);
+    assert_same_entity(read_repo, &expect[2]);
+
+    /* 单条写入中掉电：写了一半的记录被丢弃，之前的写入保留 */
+    assert(read_repo->snapshot(read_repo, ids[2], &entity) == ERR_OK);
+    entity.payload[0] = 40U;
+    aegis_hal_flash_sim_set_power_cut((uint32_t)FLASH_LOG_RECORD_HEADER);
+    assert(write_repo->update(write_repo, &entity) == ERR_HAL_ERROR);
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert_same_entity(read_repo, &expect[2]);
+    assert(write_repo->update(write_repo, &entity) == ERR_OK);
+    assert(read_repo->snapshot(read_repo, ids[2], &expect[2]) == ERR_OK);
+    printf("  ✓ 写入中掉电后恢复到最后一次完整写入\n");
+
+    /* 日志写入失败的操作不留在内存中：失败后与重启后的状态都等于操作前的状态 */
+    ids[0] = expect[0].base.id;
+    ids[1] = expect[1].base.id;
+    for (i = 0; i < 5U; i++) {
+        digest = state_digest(read_repo);
+        assert(failed_write(&repo, ids, i) == ERR_HAL_ERROR);
+        assert(aegis_hal_flash_sim_power_lost());
+        assert(state_digest(read_repo) == digest);
+        assert(count_type(read_repo, TEST_ENTITY_TYPE_A) + count_type(read_repo, TEST_ENTITY_TYPE_B) == 3U);
+
+        write_repo = reboot(&repo, &flash, &tick);
+        read_repo = aegis_infrastructure_repository_log_read(&repo);
+        assert(state_digest(read_repo) == digest);
+    }
+    assert_same_entity(read_repo, &expect[0]);
+    assert_same_entity(read_repo, &expect[1]);
+    assert_same_entity(read_repo, &expect[2]);
+    printf("  ✓ 日志写入失败时撤销内存修改（创建/更新/局部更新/删除/批量）\n");
+
+    /* 经 get() 指针直接改过的实体：写入失败后恢复为日志中的状态，而不是修改后的内存状态 */
+    for (i = 0; i < 2U; i++) {
+        digest = state_digest(read_repo);
+        assert(read_repo->get(read_repo, ids[2], &stored) == ERR_OK);
+        stored->payload[0] = 99U;
+        stored->payload_size = 6U;
+        aegis_hal_flash_sim_set_power_cut((uint32_t)FLASH_LOG_RECORD_HEADER);
+        if (i == 0U) {
+            assert(write_repo->update(write_repo, stored) == ERR_HAL_ERROR);
+        } else {
+            assert(write_repo->update_payload(write_repo, ids[2], 1U, field, 1U) == ERR_HAL_ERROR);
+        }
+        assert(state_digest(read_repo) == digest);
+        assert_same_entity(read_repo, &expect[2]);
+
+        write_repo = reboot(&repo, &flash, &tick);
+        read_repo = aegis_infrastructure_repository_log_read(&repo);
+        assert(state_digest(read_repo) == digest);
+        assert_same_entity(read_repo, &expect[2]);
+    }
+    printf("  ✓ 经 get() 指针修改后写入失败，内存恢复为持久化的状态\n");
+
+    /* 5. 大量写入：检查点限制重放长度，日志页绕环重用 */
+    for (i = 0; i < (uint32_t)REPOSITORY_LOG_REPLAY_MAX * 6U || repo.log.head.seq <= (uint32_t)pages; i++) {
+        assert(i < 1000000UL);
+        field[0] = (uint8_t)i;
+        assert(write_repo->update_payload(write_repo, ids[2], 0U, field, 1U) == ERR_OK);
+        assert(repo.records_since_checkpoint <= (uint16_t)REPOSITORY_LOG_REPLAY_MAX);
+        if ((i % 64U) == 0U) {
+            assert(write_repo->compact(write_repo, 0U, NULL) == ERR_OK);
+        }
+    }
+    assert(repo.log.head.seq > (uint32_t)pages);
+    assert(read_repo->snapshot(read_repo, ids[2], &expect[2]) == ERR_OK);
+
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert(repo.replayed_records <= (uint16_t)(3U + 2U + REPOSITORY_LOG_REPLAY_MAX));
+    assert_same_entity(read_repo, &expect[0]);
+    assert_same_entity(read_repo, &expect[1]);
+    assert_same_entity(read_repo, &expect[2]);
+
+    /* 显式检查点后只需重放快照 */
+    assert(aegis_infrastructure_repository_log_checkpoint(&repo) == ERR_OK);
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert(repo.replayed_records == 3U + 2U);
+    assert(repo.records_since_checkpoint == 0U);
+    assert_same_entity(read_repo, &expect[2]);
+    printf("  ✓ 检查点限制重放长度（%u 页绕环）\n", (unsigned int)repo.log.head.seq);
+
+    /*
+     * 6. 在每一个写入字节处掉电：重启后的状态必须等于最后一次成功写操作之后的状态，
+     *    或者（记录恰好写完、只差对齐填充或 COMMIT 之后的字节时）等于掉电那一步也成功的状态
+     */
+    done = cut_run(&repo, &flash, &tick, HAL_FLASH_SIM_POWER_CUT_OFF, digests);
+    assert(repo.log.stats.erases > 0U && repo.log.head.seq > 2U);
+    assert(done == TEST_CUT_STEPS);
+    for (cut = 0U; ; cut++) {
+        done = cut_run(&repo, &flash, &tick, cut, NULL);
+        if (!aegis_hal_flash_sim_power_lost()) {
+            assert(done == TEST_CUT_STEPS);
+            break;
+        }
+        assert(done < TEST_CUT_STEPS);
+
+        /* 失败的那一步从日志重新载入：内存等于已持久化的状态（记录恰好写完时该步已生效） */
+        digest = state_digest(aegis_infrastructure_repository_log_read(&repo));
+        assert(digest == digests[done] || digest == digests[done + 1U]);
+
+        /* 重启：恢复供电后在同一映射上重新挂载（省去每次重新映射文件） */
+        aegis_hal_flash_sim_set_power_cut(HAL_FLASH_SIM_POWER_CUT_OFF);
+        assert(aegis_infrastructure_repository_log_init(&repo, &flash, test_now_ms, &tick) == ERR_OK);
+        write_repo = aegis_infrastructure_repository_log_write(&repo);
+        assert(write_repo->init(write_repo) == ERR_OK);
+        assert(state_digest(aegis_infrastructure_repository_log_read(&repo)) == digest);
+    }
+    aegis_hal_flash_sim_set_power_cut(HAL_FLASH_SIM_POWER_CUT_OFF);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    printf("  ✓ 任意写入字节处掉电均可恢复（%lu 个掉电点）\n", (unsigned long)cut);
+
+    /* 7. 格式化清空持久化数据 */
+    assert(aegis_infrastructure_repository_log_format(&repo) == ERR_OK);
+    assert(count_type(read_repo, TEST_ENTITY_TYPE_A) == 0U);
+    write_repo = reboot(&repo, &flash, &tick);
+    read_repo = aegis_infrastructure_repository_log_read(&repo);
+    assert(count_type(read_repo, TEST_ENTITY_TYPE_A) == 0U && count_type(read_repo, TEST_ENTITY_TYPE_B) == 0U);
+    assert(create_entity(write_repo, TEST_ENTITY_TYPE_A, 1U, &id) == ERR_OK);
+    printf("  ✓ 格式化\n");
+
+    assert(aegis_hal_flash_deinit(&flash) == ERR_OK);
+    (void)remove(TEST_FLASH_PATH);
+
+    printf("✅ 所有测试通过!\n");
+    return 0;
+}
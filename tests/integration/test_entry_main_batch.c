@@ -0,0 +1,292 @@
+/*
+ * @file: test_entry_main_batch.c
+ * @brief: 主循环批处理预算测试（命令/事件批量处理、数量预算、时间预算、自适应配比、暂存区复位）
+ * @author: jack liu
+ * @req: REQ-TEST-ENTRY-BATCH
+ * @design: DES-TEST-ENTRY-BATCH
+ * @asil: ASIL-B
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "entry_init.h"
+#include "entry_main.h"
+#include "app_command.h"
+#include "app_cmd_service.h"
+#include "domain_event.h"
+#include "infrastructure_repository_inmem.h"
+
+#define TEST_CMD_PING        ((AegisCommandType)1U)
+#define TEST_EVENT_PONG      ((AegisDomainEventType)(DOMAIN_EVENT_USER_BASE + 1U))
+
+typedef struct {
+    AegisDomainEventBus* bus;
+    AegisScratchArena* scratch;
+    uint32_t executed;
+} TestPingCtx;
+
+typedef struct {
+    uint32_t pong_count;
+} TestEventStats;
+
+static uint32_t test_now_ms(void* ctx) {
+    uint32_t* tick;
+    if (ctx == NULL) {
+        return 0U;
+    }
+    tick = (uint32_t*)ctx;
+    (*tick)++;
+    return *tick;
+}
+
+/* 每次读取前进1个计数，模拟周期计数器 */
+static uint32_t test_clock(void* ctx) {
+    uint32_t* now = (uint32_t*)ctx;
+    (*now)++;
+    return *now;
+}
+
+static AegisEventHandlerResult on_pong(const AegisDomainEvent* event, void* ctx) {
+    TestEventStats* stats;
+    if (event == NULL || ctx == NULL) {
+        return EVENT_HANDLER_ERROR;
+    }
+    stats = (TestEventStats*)ctx;
+    stats->pong_count++;
+    return EVENT_HANDLER_OK;
+}
+
+/* 每条命令发布一个异步事件（事件临时对象取自主循环暂存区） */
+static AegisErrorCode handle_ping(const AegisCommand* cmd, AegisCommandResult* result, void* ctx) {
+    TestPingCtx* c;
+    AegisDomainEvent* ev;
+
+    if (cmd == NULL || result == NULL || ctx == NULL) {
+        return ERR_NULL_PTR;
+    }
+
+    c = (TestPingCtx*)ctx;
+    c->executed++;
+
+    ev = SCRATCH_NEW(c->scratch, AegisDomainEvent);
+    if (ev == NULL) {
+        return ERR_MEM_POOL_FULL;
+    }
+    memset(ev, 0, sizeof(*ev));
+    ev->type = TEST_EVENT_PONG;
+    ev->aggregate_id = cmd->entity_id;
+    (void)aegis_domain_event_publish(c->bus, ev);
+
+    memset(result, 0, sizeof(*result));
+    result->result = ERR_OK;
+    return ERR_OK;
+}
+
+static void enqueue_pings(AegisEntryRuntime* runtime, uint8_t n) {
+    AegisCommand cmd;
+    uint8_t i;
+
+    for (i = 0; i < n; i++) {
+        memset(&cmd, 0, sizeof(cmd));
+        APP_CMD_INIT(&cmd, TEST_CMD_PING);
+        APP_CMD_SET_ENTITY_ID(&cmd, (AegisEntityId)(i + 1U));
+        assert(aegis_app_cmd_enqueue(&runtime->app.cmd_queue, &cmd) == ERR_OK);
+    }
+}
+
+static void publish_pongs(AegisEntryRuntime* runtime, uint8_t n) {
+    AegisDomainEvent ev;
+    uint8_t i;
+
+    for (i = 0; i < n; i++) {
+        memset(&ev, 0, sizeof(ev));
+        ev.type = TEST_EVENT_PONG;
+        assert(aegis_domain_event_publish(&runtime->app.event_bus, &ev) == ERR_OK);
+    }
+}
+
+int main(void) {
+    AegisErrorCode ret;
+    uint32_t tick;
+    uint32_t clock_now;
+    AegisInfrastructureRepositoryInmem repo;
+    AegisEntryRuntime runtime;
+    AegisEntryConfig cfg;
+    AegisEventSubscription subs[1];
+    TestEventStats stats;
+    TestPingCtx ping_ctx;
+    AegisEntryBudget budget;
+    AegisEntryLoopStats loop_stats;
+    const AegisDomainRepositoryWriteInterface* write_repo;
+    AegisDomainEntity entity;
+    AegisEntityId ids[6];
+    uint8_t i;
+
+    printf("========================================\n");
+    printf("  Entry 主循环批处理测试\n");
+    printf("========================================\n");
+
+    tick = 0U;
+    ret = aegis_infrastructure_repository_inmem_init(&repo, test_now_ms, &tick);
+    assert(ret == ERR_OK);
+
+    memset(&stats, 0, sizeof(stats));
+    subs[0].event_type = TEST_EVENT_PONG;
+    subs[0].handler = on_pong;
+    subs[0].ctx = &stats;
+    subs[0].is_sync = FALSE;
+    subs[0].priority = 0U;
+
+    cfg.aegis_trace_now_fn = test_now_ms;
+    cfg.aegis_trace_now_ctx = &tick;
+    cfg.write_repo = aegis_infrastructure_repository_inmem_write(&repo);
+    cfg.event_subscriptions = subs;
+    cfg.event_subscription_count = 1U;
+
+    ret = aegis_entry_init_all(&runtime, &cfg);
+    assert(ret == ERR_OK);
+    assert(runtime.budget.max_commands == (uint16_t)ENTRY_BATCH_MAX_COMMANDS);
+
+    memset(&ping_ctx, 0, sizeof(ping_ctx));
+    ping_ctx.bus = &runtime.app.event_bus;
+    ping_ctx.scratch = &runtime.scratch;
+    ret = aegis_app_cmd_service_register_handler(&runtime.app.cmd_service, TEST_CMD_PING, handle_ping, &ping_ctx);
+    assert(ret == ERR_OK);
+
+    /* 1) 默认预算：一次迭代排空突发命令及其产生的事件 */
+    enqueue_pings(&runtime, 10U);
+    ret = aegis_entry_main_loop_once(&runtime);
+    assert(ret == ERR_OK);
+    assert(runtime.last_stats.commands_executed == 10U);
+    assert(runtime.last_stats.events_processed == 10U);
+    assert(runtime.last_stats.commands_pending == 0U && runtime.last_stats.events_pending == 0U);
+    assert(runtime.last_stats.budget_exhausted == FALSE);
+    assert(stats.pong_count == 10U);
+    printf("  ✓ burst drained in one iteration\n");
+
+    /* 2) 数量预算：超出部分留到下一次迭代 */
+    memset(&budget, 0, sizeof(budget));
+    budget.max_commands = 3U;
+    budget.max_events = 0U;
+    enqueue_pings(&runtime, 10U);
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(loop_stats.commands_executed == 3U);
+    assert(loop_stats.events_processed == 3U);
+    assert(loop_stats.commands_pending == 7U);
+    assert(loop_stats.budget_exhausted == TRUE);
+
+    budget.max_commands = 0U;
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(loop_stats.commands_executed == 7U && loop_stats.commands_pending == 0U);
+    assert(loop_stats.events_pending == 0U && loop_stats.budget_exhausted == FALSE);
+    printf("  ✓ count budget\n");
+
+    /* 3) 时间预算：时钟每次读取前进1，预算4个计数 */
+    clock_now = 0U;
+    memset(&budget, 0, sizeof(budget));
+    budget.time_budget = 4U;
+    budget.clock_fn = test_clock;
+    budget.clock_ctx = &clock_now;
+    enqueue_pings(&runtime, 10U);
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(loop_stats.commands_executed == 4U);
+    assert(loop_stats.elapsed >= 4U);
+    assert(loop_stats.budget_exhausted == TRUE);
+    ret = aegis_entry_main_loop_step(&runtime, NULL, NULL);
+    assert(ret == ERR_OK);
+    printf("  ✓ time budget\n");
+
+    /* 4) 自适应配比：事件积压深时首片偏向事件 */
+    publish_pongs(&runtime, 20U);
+    enqueue_pings(&runtime, 1U);
+    clock_now = 0U;
+    budget.time_budget = 2U;    /* 恰好允许一个交替片 */
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(loop_stats.commands_executed == 1U);
+    assert(loop_stats.events_processed == 7U);
+    ret = aegis_entry_main_loop_step(&runtime, NULL, NULL);
+    assert(ret == ERR_OK);
+
+    /* 命令积压深时首片偏向命令 */
+    enqueue_pings(&runtime, 10U);
+    publish_pongs(&runtime, 1U);
+    clock_now = 0U;
+    budget.time_budget = 8U;
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(loop_stats.commands_executed == 7U);
+    assert(loop_stats.events_processed == 1U);
+    ret = aegis_entry_main_loop_step(&runtime, NULL, NULL);
+    assert(ret == ERR_OK);
+    printf("  ✓ adaptive command/event ratio\n");
+
+    /* 4) 仓储压缩：按 max_compaction 步数在迭代末尾增量执行 */
+    write_repo = cfg.write_repo;
+    for (i = 0; i < 6U; i++) {
+        memset(&entity, 0, sizeof(entity));
+        assert(aegis_domain_entity_init(&entity.base, ENTITY_ID_INVALID, (AegisEntityType)1U) == ERR_OK);
+        assert(write_repo->create(write_repo, &entity) == ERR_OK);
+        ids[i] = entity.base.id;
+    }
+    assert(write_repo->delete_entity(write_repo, ids[0]) == ERR_OK);
+    assert(write_repo->delete_entity(write_repo, ids[2]) == ERR_OK);
+    assert(write_repo->delete_entity(write_repo, ids[3]) == ERR_OK);
+    assert(repo.free_count == 3U);
+
+    memset(&budget, 0, sizeof(budget));
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(repo.free_count == 3U && loop_stats.repo_holes == 0U);
+
+    budget.max_compaction = 1U;
+    ret = aegis_entry_main_loop_step(&runtime, &budget, &loop_stats);
+    assert(ret == ERR_OK);
+    assert(loop_stats.repo_holes == 2U);
+
+    ret = aegis_entry_main_loop_once(&runtime);
+    assert(ret == ERR_OK);
+    assert(runtime.last_stats.repo_holes == 0U);
+    assert(repo.entity_count == 3U);
+    for (i = 0; i < 6U; i++) {
+        AegisDomainEntity* found;
+        AegisErrorCode expected = (i == 0U || i == 2U || i == 3U) ? ERR_NOT_FOUND : ERR_OK;
+        assert(write_repo->read.get(&write_repo->read, ids[i], &found) == expected);
+    }
+    printf("  ✓ budgeted repository compaction\n");
+
+    /* 5) 暂存区：每条命令结束回退，迭代结束整体复位，峰值写入统计 */
+    enqueue_pings(&runtime, 3U);
+    ret = aegis_entry_main_loop_once(&runtime);
+    assert(ret == ERR_OK);
+    assert(runtime.last_stats.commands_executed == 3U && runtime.last_stats.command_errors == 0U);
+    assert(runtime.last_stats.scratch_peak >= (uint32_t)(sizeof(AegisCommandResult) + sizeof(AegisDomainEvent)));
+    assert(runtime.last_stats.scratch_peak < 2U * (uint32_t)(sizeof(AegisCommandResult) + sizeof(AegisDomainEvent)) +
+                                             4U * (uint32_t)SCRATCH_ARENA_ALIGN);
+    assert(runtime.scratch.used == 0U && runtime.scratch.peak == 0U);
+    assert(runtime.scratch.high_water == runtime.last_stats.scratch_peak);
+
+    /* 暂存区被本次迭代更早的分配占满：命令留在队列，复位后下次迭代执行 */
+    assert(aegis_scratch_arena_alloc(&runtime.scratch, (uint32_t)ENTRY_SCRATCH_SIZE - 8U) != NULL);
+    enqueue_pings(&runtime, 1U);
+    ret = aegis_entry_main_loop_once(&runtime);
+    assert(ret == ERR_OK);
+    assert(runtime.last_stats.commands_executed == 0U && runtime.last_stats.commands_pending == 1U);
+    assert(runtime.scratch.failures == 1U && runtime.scratch.used == 0U);
+    assert(!runtime.app.cmd_queue.peeked);      /* 分配失败时未 peek，队首未被借出 */
+    ret = aegis_entry_main_loop_once(&runtime);
+    assert(ret == ERR_OK);
+    assert(runtime.last_stats.commands_executed == 1U && runtime.last_stats.command_errors == 0U);
+    printf("  ✓ per-iteration scratch arena\n");
+
+    /* 参数校验 */
+    assert(aegis_entry_main_loop_step(NULL, NULL, NULL) == ERR_NULL_PTR);
+
+    (void)ret;
+    printf("\n✅ Entry main loop batch tests passed.\n");
+    return 0;
+}
@@ -42,7 +42,8 @@ class LayeringChecker:
         'application': ['app_'],
         'entry': ['entry_'],
         'common': ['types.h', 'error_codes.h', 'critical.h', 'mem_pool.h',
-                   'ring_buffer.h', 'trace.h', 'isr_safety.h']
+                   'ring_buffer.h', 'ring_buffer_spsc.h', 'atomic_ops.h', 'dispatch_index.h',
+                   'trace.h', 'isr_safety.h']
     }
 
     # 事件发布函数（只能在领域层调用）
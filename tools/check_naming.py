@@ -44,8 +44,8 @@ class NamingChecker:
             'paths': ['include/entry', 'src/entry']
         },
         'common': {
-            'function_prefix': ['aegis_mem_pool_', 'aegis_ring_buffer_', 'aegis_trace_', 'aegis_error_code_', 'aegis_critical_'],
-            'type_prefix': ['AegisMemPool', 'AegisRingBuffer', 'AegisTrace', 'AegisErrorCode', 'AegisError'],
+            'function_prefix': ['aegis_mem_pool_', 'aegis_ring_buffer_', 'aegis_trace_', 'aegis_error_code_', 'aegis_critical_', 'aegis_atomic_', 'aegis_dispatch_index_', 'aegis_key_filter_', 'aegis_crc32_', 'aegis_object_pool_', 'aegis_scratch_arena_'],
+            'type_prefix': ['AegisMemPool', 'AegisRingBuffer', 'AegisTrace', 'AegisErrorCode', 'AegisError', 'AegisObjectPool', 'AegisScratchArena'],
             'paths': ['include/common', 'src/common']
         }
     }
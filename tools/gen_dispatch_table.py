@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+静态命令分发表生成器
+根据模块的声明式描述（JSON）生成 const、按类型排序的稠密跳转表（AegisAppCmdStaticTable），
+表放在 Flash，运行时只需 aegis_app_cmd_service_bind_table() 绑定，分发为直接下标。
+
+描述文件示例（examples/minimal_app/demo_dispatch.json）：
+  {
+    "name": "demo",
+    "include": "demo_application.h",
+    "commands": [
+      {"type": "DEMO_CMD_CREATE_CHARGER", "value": 1, "handler": "demo_handle_create_charger"},
+      {"type": "DEMO_CMD_SET_POWER_LEVEL", "value": 2, "handler": "demo_handle_set_power"}
+    ]
+  }
+
+用法：
+  python3 tools/gen_dispatch_table.py --desc examples/minimal_app/demo_dispatch.json --out examples/minimal_app
+
+作者: jack liu
+"""
+
+import argparse
+import json
+import re
+from pathlib import Path
+
+
+IDENT_RE = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+
+# 区间长度超过命令数的该倍数时认为编号过于稀疏（跳转表浪费 Flash）
+MAX_SPARSITY = 4
+
+CMD_TYPE_INVALID = 0xFFFF
+
+
+TABLE_H = """/*
+ * @file: {name}_cmd_table.h
+ * @brief: {name} 模块静态命令分发表（由 tools/gen_dispatch_table.py 生成，请勿手改）
+ * @author: jack liu
+ */
+
+#ifndef {NAME}_CMD_TABLE_H
+#define {NAME}_CMD_TABLE_H
+
+#include "app_cmd_service.h"
+
+#ifdef __cplusplus
+extern "C" {{
+#endif
+
+/* 命令处理器（由模块实现，需为外部链接） */
+{prototypes}
+
+/* 覆盖命令类型 [{first}, {end}) */
+extern const AegisAppCmdStaticTable {name}_cmd_table;
+
+#ifdef __cplusplus
+}}
+#endif
+
+#endif /* {NAME}_CMD_TABLE_H */
+"""
+
+
+TABLE_C = """/*
+ * @file: {name}_cmd_table.c
+ * @brief: {name} 模块静态命令分发表（由 tools/gen_dispatch_table.py 生成，请勿手改）
+ * @author: jack liu
+ */
+
+#include "{name}_cmd_table.h"
+#include "compile_time.h"
+{include}
+/* 描述文件中的类型值必须与头文件中的宏一致 */
+{asserts}
+
+static const AppCmdHandler {name}_cmd_handlers[{count}] = {{
+{entries}
+}};
+
+const AegisAppCmdStaticTable {name}_cmd_table = {{
+    (AegisCommandType){first}U,
+    {count}U,
+    {name}_cmd_handlers
+}};
+"""
+
+
+def load_desc(path: Path) -> dict:
+    desc = json.loads(path.read_text(encoding="utf-8"))
+
+    name = desc.get("name", "")
+    if not isinstance(name, str) or not IDENT_RE.match(name):
+        raise SystemExit(f"{path}: name 不合法（需为 C 标识符）")
+
+    commands = desc.get("commands")
+    if not isinstance(commands, list) or not commands:
+        raise SystemExit(f"{path}: commands 不能为空")
+
+    seen = {}
+    for cmd in commands:
+        value = cmd.get("value")
+        handler = cmd.get("handler", "")
+        type_name = cmd.get("type")
+        if not isinstance(value, int) or value < 0 or value >= CMD_TYPE_INVALID:
+            raise SystemExit(f"{path}: 命令类型值非法: {value!r}")
+        if not isinstance(handler, str) or not IDENT_RE.match(handler):
+            raise SystemExit(f"{path}: handler 不合法: {handler!r}")
+        if type_name is not None and (not isinstance(type_name, str) or not IDENT_RE.match(type_name)):
+            raise SystemExit(f"{path}: type 不合法: {type_name!r}")
+        if value in seen:
+            raise SystemExit(f"{path}: 命令类型值重复: {value}（{seen[value]} / {handler}）")
+        seen[value] = handler
+
+    return desc
+
+
+def render(desc: dict) -> tuple:
+    name = desc["name"]
+    commands = sorted(desc["commands"], key=lambda c: c["value"])
+
+    first = commands[0]["value"]
+    last = commands[-1]["value"]
+    span = last - first + 1
+    if span > MAX_SPARSITY * len(commands):
+        raise SystemExit(f"{name}: 类型编号过于稀疏（区间 {span}，命令 {len(commands)}），请改为连续编号")
+
+    by_value = {c["value"]: c for c in commands}
+
+    prototypes = []
+    for handler in sorted({c["handler"] for c in commands}):
+        prototypes.append(
+            f"AegisErrorCode {handler}(const AegisCommand* cmd, AegisCommandResult* result, void* ctx);")
+
+    entries = []
+    for value in range(first, last + 1):
+        cmd = by_value.get(value)
+        sep = "," if value < last else ""
+        if cmd is None:
+            entries.append(f"    NULL{sep}   /* 0x{value:04X} 未使用 */")
+        else:
+            label = cmd.get("type") or f"0x{value:04X}"
+            entries.append(f"    {cmd['handler']}{sep}   /* {label} */")
+
+    asserts = []
+    for cmd in commands:
+        type_name = cmd.get("type")
+        if type_name:
+            asserts.append(
+                f"FW_STATIC_ASSERT({type_name} == (AegisCommandType){cmd['value']}U, "
+                f"{type_name.lower()}_matches_desc);")
+
+    include = desc.get("include")
+    include_line = f'#include "{include}"\n' if include else ""
+
+    header = TABLE_H.format(name=name, NAME=name.upper(),
+                            prototypes="\n".join(prototypes),
+                            first=first, end=last + 1)
+    source = TABLE_C.format(name=name, include=include_line,
+                            asserts="\n".join(asserts) if asserts else "/* （描述文件未给出类型宏名） */",
+                            count=span, first=first,
+                            entries="\n".join(entries))
+    return header, source
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--desc", required=True, nargs="+", help="模块描述文件（JSON，可多个）")
+    parser.add_argument("--out", required=True, help="输出目录")
+    args = parser.parse_args()
+
+    out_dir = Path(args.out)
+    out_dir.mkdir(parents=True, exist_ok=True)
+
+    for desc_path in args.desc:
+        desc = load_desc(Path(desc_path))
+        header, source = render(desc)
+        name = desc["name"]
+        (out_dir / f"{name}_cmd_table.h").write_text(header, encoding="utf-8")
+        (out_dir / f"{name}_cmd_table.c").write_text(source, encoding="utf-8")
+        print(f"✅ 已生成: {out_dir / (name + '_cmd_table.[ch]')}")
+
+    print("下一步：把生成的 .c 加入目标工程，并在模块注册函数中调用 aegis_app_cmd_service_bind_table()。")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())